@@ -0,0 +1,71 @@
+package org.libpag;
+
+import android.graphics.Bitmap;
+import android.hardware.HardwareBuffer;
+import android.os.Build;
+import android.util.Pair;
+
+import java.util.ArrayList;
+
+/**
+ * A process-wide pool of HardwareBuffer backed bitmaps shared by all PAGImageView instances.
+ * Allocating an AHardwareBuffer per frame shows up as GC churn when many views animate at once;
+ * recycling the wrapped bitmaps keeps the buffers alive in native memory with no Java-heap
+ * involvement beyond the lightweight wrappers.
+ */
+class BitmapPool {
+    // Double buffering across ten simultaneous PAGImageViews is the heaviest scrolling-feed
+    // scenario we size for; anything beyond that closes buffers as before.
+    private static final int MAX_POOL_SIZE = 24;
+    private static final ArrayList<Entry> pool = new ArrayList<>();
+
+    private static class Entry {
+        final Bitmap bitmap;
+        final HardwareBuffer hardwareBuffer;
+
+        Entry(Bitmap bitmap, HardwareBuffer hardwareBuffer) {
+            this.bitmap = bitmap;
+            this.hardwareBuffer = hardwareBuffer;
+        }
+    }
+
+    /**
+     * Returns a pooled bitmap of the requested size, or falls back to BitmapHelper.CreateBitmap()
+     * when the pool has no match. The second element of the pair is the HardwareBuffer backing the
+     * bitmap, or null when only a heap bitmap could be created.
+     */
+    static Pair<Bitmap, Object> acquire(int width, int height,
+                                        boolean needGetHardwareBufferFromNative) {
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.O) {
+            synchronized (pool) {
+                for (int i = pool.size() - 1; i >= 0; i--) {
+                    Entry entry = pool.get(i);
+                    if (entry.bitmap.getWidth() == width && entry.bitmap.getHeight() == height) {
+                        pool.remove(i);
+                        return Pair.create(entry.bitmap, (Object) entry.hardwareBuffer);
+                    }
+                }
+            }
+        }
+        return BitmapHelper.CreateBitmap(width, height, needGetHardwareBufferFromNative);
+    }
+
+    /**
+     * Returns a bitmap to the pool. Only HardwareBuffer backed bitmaps are pooled; heap bitmaps
+     * are left to the garbage collector, and when the pool is full the buffer is closed just like
+     * before pooling existed. The caller must no longer draw the bitmap after releasing it.
+     */
+    static void release(Bitmap bitmap, Object hardwareBuffer) {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.O || bitmap == null
+                || bitmap.isRecycled() || !(hardwareBuffer instanceof HardwareBuffer)) {
+            return;
+        }
+        synchronized (pool) {
+            if (pool.size() < MAX_POOL_SIZE) {
+                pool.add(new Entry(bitmap, (HardwareBuffer) hardwareBuffer));
+                return;
+            }
+        }
+        ((HardwareBuffer) hardwareBuffer).close();
+    }
+}
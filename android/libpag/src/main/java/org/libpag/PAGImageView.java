@@ -553,18 +553,24 @@ public class PAGImageView extends View implements PAGAnimator.Listener {
     private void releaseBitmap() {
         synchronized (bitmapLock) {
             renderBitmap = null;
-            frontBitmap = null;
-            backBitmap = null;
             if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.O) {
-                if (frontHardwareBuffer != null) {
+                // Bitmaps still referenced by the frame cache cannot be recycled, the next
+                // consumer would overwrite pixels the cache may still draw.
+                if (frontBitmap != null && !bitmapCache.containsValue(frontBitmap)) {
+                    BitmapPool.release(frontBitmap, frontHardwareBuffer);
+                } else if (frontHardwareBuffer != null) {
                     frontHardwareBuffer.close();
-                    frontHardwareBuffer = null;
                 }
-                if (backHardwareBuffer != null) {
+                if (backBitmap != null && !bitmapCache.containsValue(backBitmap)) {
+                    BitmapPool.release(backBitmap, backHardwareBuffer);
+                } else if (backHardwareBuffer != null) {
                     backHardwareBuffer.close();
-                    backHardwareBuffer = null;
                 }
+                frontHardwareBuffer = null;
+                backHardwareBuffer = null;
             }
+            frontBitmap = null;
+            backBitmap = null;
         }
     }
 
@@ -630,7 +636,7 @@ public class PAGImageView extends View implements PAGAnimator.Listener {
         }
         synchronized (bitmapLock) {
             if (frontBitmap == null || _cacheAllFramesInMemory) {
-                Pair<Bitmap, Object> pair = BitmapHelper.CreateBitmap(decoderInfo._width,
+                Pair<Bitmap, Object> pair = BitmapPool.acquire(decoderInfo._width,
                         decoderInfo._height, false);
                 if (pair.first == null) {
                     return false;
@@ -647,7 +653,7 @@ public class PAGImageView extends View implements PAGAnimator.Listener {
             Bitmap flushBitmap;
             if (!_cacheAllFramesInMemory) {
                 if (backBitmap == null) {
-                    Pair<Bitmap, Object> pair = BitmapHelper.CreateBitmap(decoderInfo._width, decoderInfo._height, false);
+                    Pair<Bitmap, Object> pair = BitmapPool.acquire(decoderInfo._width, decoderInfo._height, false);
                     if (pair.first == null) {
                         return false;
                     }
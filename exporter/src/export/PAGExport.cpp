@@ -48,12 +48,14 @@ bool PAGExport::ExportFile(const AEGP_ItemH& activeItemH, const std::string& out
     if (bytes->length() == 0) {
       break;
     }
-    if (!FileHelper::WriteToFile(outputPath, reinterpret_cast<char*>(bytes->data()),
-                                 static_cast<std::streamsize>(bytes->length()))) {
+    // Validate the encoded bytes before touching the disk, so a file that fails verification is
+    // never published to the output path.
+    if (!ValidatePAGFile(bytes->data(), bytes->length())) {
       break;
     }
 
-    if (!ValidatePAGFile(bytes->data(), bytes->length())) {
+    if (!FileHelper::WriteToFile(outputPath, reinterpret_cast<char*>(bytes->data()),
+                                 static_cast<std::streamsize>(bytes->length()))) {
       break;
     }
 
@@ -486,4 +486,12 @@ void PAGExportSession::pushWarning(AlertInfoType type, pag::ID compId, pag::ID l
   alertInfoManager.pushWarning(compItemHList, layerHList, type, compId, layerId, addInfo);
 }
 
+std::shared_ptr<WorkerPool> PAGExportSession::getWorkerPool() {
+  std::lock_guard<std::mutex> autoLock(workerPoolLocker);
+  if (workerPool == nullptr) {
+    workerPool = std::make_shared<WorkerPool>();
+  }
+  return workerPool;
+}
+
 }  // namespace exporter
@@ -18,11 +18,13 @@
 
 #pragma once
 #include <memory>
+#include <mutex>
 #include <string>
 #include "../Config/ConfigParam.h"
 #include "AEGP_SuiteHandler.h"
 #include "AE_GeneralPlug.h"
 #include "AlertInfo.h"
+#include "WorkerPool.h"
 #include "pag/file.h"
 #include "pag/types.h"
 
@@ -56,6 +58,13 @@ class PAGExportSession {
   void pushWarning(AlertInfoType type, pag::ID compId, pag::ID layerId,
                    const std::string& addInfo = "");
 
+  /**
+   * Returns the worker pool shared by every composition exported in this session, creating it on
+   * first use. Sequence frame encoding runs here so compositions encode in parallel; AEGP calls
+   * must stay on the main thread and never go through the pool.
+   */
+  std::shared_ptr<WorkerPool> getWorkerPool();
+
   std::vector<char> fileBytes = {};
   const std::vector<char>& getFileBytes();
 
@@ -96,6 +105,9 @@ class PAGExportSession {
   std::vector<std::shared_ptr<pag::Composition>> compositions = {};
 
  private:
+  std::shared_ptr<WorkerPool> workerPool = nullptr;
+  std::mutex workerPoolLocker = {};
+
   std::vector<std::vector<float>> extractFloatArraysByKey(const std::string& xmlContent,
                                                           const std::string& keyName);
   std::vector<pag::AlphaStop> ParseAlphaStops(const std::string& text);
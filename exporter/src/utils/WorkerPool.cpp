@@ -0,0 +1,82 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "WorkerPool.h"
+
+namespace exporter {
+
+WorkerPool::WorkerPool(size_t threadCount) {
+  if (threadCount == 0) {
+    threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) {
+      threadCount = 1;
+    }
+  }
+  workers.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; i++) {
+    workers.emplace_back(&WorkerPool::workLoop, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    quit = true;
+  }
+  taskAvailable.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    tasks.push_back(std::move(task));
+  }
+  taskAvailable.notify_one();
+}
+
+void WorkerPool::waitForAll() {
+  std::unique_lock<std::mutex> autoLock(locker);
+  taskFinished.wait(autoLock, [this] { return tasks.empty() && runningTasks == 0; });
+}
+
+void WorkerPool::workLoop() {
+  while (true) {
+    std::function<void()> task = nullptr;
+    {
+      std::unique_lock<std::mutex> autoLock(locker);
+      taskAvailable.wait(autoLock, [this] { return quit || !tasks.empty(); });
+      if (quit && tasks.empty()) {
+        return;
+      }
+      task = std::move(tasks.front());
+      tasks.pop_front();
+      runningTasks++;
+    }
+    task();
+    {
+      std::lock_guard<std::mutex> autoLock(locker);
+      runningTasks--;
+    }
+    taskFinished.notify_all();
+  }
+}
+
+}  // namespace exporter
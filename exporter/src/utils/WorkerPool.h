@@ -0,0 +1,65 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace exporter {
+
+/**
+ * A fixed-size pool of worker threads for CPU-bound export work, such as sequence frame encoding.
+ * Tasks run in submission order across the workers. Only export steps that never call back into
+ * the AE SDK may be submitted here; AEGP suites are restricted to the main thread.
+ */
+class WorkerPool {
+ public:
+  /**
+   * Creates a pool with one worker per hardware thread when threadCount is 0.
+   */
+  explicit WorkerPool(size_t threadCount = 0);
+
+  ~WorkerPool();
+
+  /**
+   * Enqueues a task for execution on one of the workers.
+   */
+  void submit(std::function<void()> task);
+
+  /**
+   * Blocks until every submitted task has finished running.
+   */
+  void waitForAll();
+
+ private:
+  void workLoop();
+
+  std::vector<std::thread> workers = {};
+  std::deque<std::function<void()>> tasks = {};
+  size_t runningTasks = 0;
+  bool quit = false;
+  std::mutex locker = {};
+  std::condition_variable taskAvailable = {};
+  std::condition_variable taskFinished = {};
+};
+
+}  // namespace exporter
@@ -30,6 +30,16 @@ PAG_API pag_surface* pag_surface_make_offscreen_double_buffered(int width, int h
                                                                 bool tryHardware,
                                                                 void* sharedContext);
 
+/**
+ * Create a new pag_surface for off-screen rendering with a ring of bufferCount surfaces. The
+ * bufferCount is clamped to the range of [2, 4]. A deeper ring lets a consumer hold a presented
+ * buffer for an extra frame or two without stalling the rendering into the next one. Use
+ * pag_player_flush_and_signal_semaphore and pag_player_wait to order the GPU access between both
+ * sides. Release it by pag_release.
+ */
+PAG_API pag_surface* pag_surface_make_offscreen_buffered(int width, int height, bool tryHardware,
+                                                         int bufferCount, void* sharedContext);
+
 /**
  * Returns the front texture of the surface.
  */
@@ -45,4 +45,32 @@ PAG_API bool pag_decoder_read_frame(pag_decoder* decoder, int index, void* pixel
 PAG_API bool pag_decoder_read_frame_to_hardware_buffer(pag_decoder* decoder, int index,
                                                        void* buffer);
 
+/**
+ * Reads the image frames in the range [startIndex, endIndex] asynchronously into a ring of
+ * caller-owned pixel buffers, invoking the callback from a background thread once for each filled
+ * buffer. Buffers are filled in ring order, and a filled buffer is not reused until the caller
+ * returns it with pag_frame_reader_release_buffer(), so decoding stays pipelined while the caller
+ * consumes earlier frames without per-frame calls back into libpag. All buffers must share the
+ * same rowBytes and must stay valid until the returned reader is released by pag_release(), which
+ * cancels any remaining frames and blocks until the background thread exits. Returns nullptr if
+ * the arguments are invalid.
+ */
+PAG_API pag_frame_reader* pag_decoder_read_frames(pag_decoder* decoder, int startIndex,
+                                                  int endIndex, void** buffers, size_t bufferCount,
+                                                  size_t rowBytes, pag_color_type colorType,
+                                                  pag_alpha_type alphaType,
+                                                  pag_frame_reader_callback callback, void* user);
+
+/**
+ * Returns the buffer at bufferIndex to the reader so it can be filled with a later frame. Safe to
+ * call from any thread, including from inside the callback.
+ */
+PAG_API void pag_frame_reader_release_buffer(pag_frame_reader* reader, size_t bufferIndex);
+
+/**
+ * Stops the reader after the frame currently being decoded; no further callbacks are invoked for
+ * the remaining frames. The reader still has to be released by pag_release() afterwards.
+ */
+PAG_API void pag_frame_reader_cancel(pag_frame_reader* reader);
+
 PAG_C_PLUS_PLUS_END_GUARD
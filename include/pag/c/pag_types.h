@@ -136,6 +136,15 @@ typedef struct pag_backend_texture pag_backend_texture;
 typedef struct pag_backend_semaphore pag_backend_semaphore;
 typedef struct pag_decoder PAGDecoder;
 typedef struct pag_animator pag_animator;
+typedef struct pag_frame_reader pag_frame_reader;
+
+/**
+ * Invoked from the reader's background thread once for each buffer that has been filled with a
+ * decoded frame. The buffer at bufferIndex stays checked out to the caller until it is returned
+ * with pag_frame_reader_release_buffer().
+ */
+typedef void (*pag_frame_reader_callback)(pag_frame_reader* reader, int frameIndex,
+                                          size_t bufferIndex, bool success, void* user);
 
 typedef struct pag_animator_listener {
   void (*on_animation_start)(pag_animator* animator, void* user);
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include "pag/types.h"
@@ -145,6 +146,8 @@ enum class RTTR_AUTO_REGISTER_CLASS TagCode {
   StrokeStyle = 92,
   OuterGlowStyle = 93,
   ImageScaleModes = 94,
+  CachedLayerBounds = 95,
+  SequenceFrameBlock = 96,  // one interleaved sequence frame of the progressive profile.
 
   // add new tags here...
 
@@ -201,6 +204,18 @@ class PAG_API PathData {
 
 typedef std::shared_ptr<PathData> PathHandle;
 
+/**
+ * The base class for nodes of the file model. While Codec::Decode is running, new nodes are
+ * bump-allocated from an arena owned by the decoded File, so the whole tag tree lives contiguously
+ * and is released in one shot when the File is destroyed. Outside of decoding, allocation falls
+ * back to the regular heap.
+ */
+class PAG_API ArenaAllocated {
+ public:
+  static void* operator new(size_t size);
+  static void operator delete(void* pointer);
+};
+
 enum class PAG_API KeyframeInterpolationType : uint8_t {
   None = 0,
   Linear = 1,
@@ -209,7 +224,7 @@ enum class PAG_API KeyframeInterpolationType : uint8_t {
 };
 
 template <typename T>
-class RTTR_AUTO_REGISTER_CLASS Keyframe {
+class RTTR_AUTO_REGISTER_CLASS Keyframe : public ArenaAllocated {
  public:
   virtual ~Keyframe() = default;
 
@@ -220,6 +235,14 @@ class RTTR_AUTO_REGISTER_CLASS Keyframe {
     return startValue;
   }
 
+  /**
+   * Returns the eased progress of the animation at the given time, which is always 0 for hold
+   * keyframes.
+   */
+  virtual float getProgressAt(Frame) {
+    return 0.0f;
+  }
+
   bool containsTime(Frame time) const {
     return time >= startTime && time < endTime;
   }
@@ -239,7 +262,7 @@ class RTTR_AUTO_REGISTER_CLASS Keyframe {
  * The Property object contains value information about a particular AE property of a layer.
  */
 template <typename T>
-class RTTR_AUTO_REGISTER_CLASS Property {
+class RTTR_AUTO_REGISTER_CLASS Property : public ArenaAllocated {
  public:
   T value;
   Property() = default;
@@ -281,9 +304,12 @@ class RTTR_AUTO_REGISTER_CLASS AnimatableProperty : public Property<T> {
   explicit AnimatableProperty(const std::vector<Keyframe<T>*>& keyframes)
       : keyframes(keyframes), lastKeyframeIndex(0) {
     this->value = keyframes[0]->startValue;
+    keyTimes.reserve(keyframes.size() + 1);
     for (Keyframe<T>* keyframe : keyframes) {
       keyframe->initialize();
+      keyTimes.push_back(keyframe->startTime);
     }
+    keyTimes.push_back(keyframes.back()->endTime);
   }
 
   ~AnimatableProperty() override {
@@ -318,20 +344,16 @@ class RTTR_AUTO_REGISTER_CLASS AnimatableProperty : public Property<T> {
     if (lastKeyframe->containsTime(frame)) {
       return lastKeyframe->getValueAt(frame);
     }
-    if (frame < lastKeyframe->startTime) {
-      while (lastKeyframeIndexInternal > 0) {
-        lastKeyframeIndexInternal--;
-        if (keyframes[lastKeyframeIndexInternal]->containsTime(frame)) {
-          break;
-        }
+    // The cached index covers sequential playback; random access binary-searches the contiguous
+    // keyTimes array instead of chasing the scattered keyframe objects one by one.
+    auto position = std::upper_bound(keyTimes.begin(), keyTimes.end(), frame);
+    if (position != keyTimes.begin()) {
+      lastKeyframeIndexInternal = static_cast<size_t>(position - keyTimes.begin()) - 1;
+      if (lastKeyframeIndexInternal > keyframes.size() - 1) {
+        lastKeyframeIndexInternal = keyframes.size() - 1;
       }
     } else {
-      while (lastKeyframeIndexInternal < keyframes.size() - 1) {
-        lastKeyframeIndexInternal++;
-        if (keyframes[lastKeyframeIndexInternal]->containsTime(frame)) {
-          break;
-        }
-      }
+      lastKeyframeIndexInternal = 0;
     }
     lastKeyframe = keyframes[lastKeyframeIndexInternal];
     if (frame <= lastKeyframe->startTime) {
@@ -352,11 +374,14 @@ class RTTR_AUTO_REGISTER_CLASS AnimatableProperty : public Property<T> {
 
  private:
   std::atomic_size_t lastKeyframeIndex;
+  // The start time of each keyframe plus the end time of the last one, kept contiguous so that
+  // getValueAt() can binary-search times without touching the keyframe objects.
+  std::vector<Frame> keyTimes = {};
 
   RTTR_ENABLE(Property<T>)
 };
 
-class PAG_API Transform2D {
+class PAG_API Transform2D : public ArenaAllocated {
  public:
   static std::unique_ptr<Transform2D> MakeDefault();
   ~Transform2D();
@@ -374,7 +399,7 @@ class PAG_API Transform2D {
   bool verify() const;
 };
 
-class PAG_API Transform3D {
+class PAG_API Transform3D : public ArenaAllocated {
  public:
   ~Transform3D();
 
@@ -406,7 +431,7 @@ enum class PAG_API MaskMode : uint8_t {
   Accum = 7   // real add, not screen (not exposed in UI!)
 };
 
-class PAG_API MaskData {
+class PAG_API MaskData : public ArenaAllocated {
  public:
   ~MaskData();
 
@@ -439,7 +464,7 @@ enum class RTTR_AUTO_REGISTER_CLASS EffectType {
   HueSaturation,
 };
 
-class PAG_API Effect {
+class PAG_API Effect : public ArenaAllocated {
  public:
   Effect();
 
@@ -879,7 +904,7 @@ enum class RTTR_AUTO_REGISTER_CLASS LayerStyleType { Unknown, DropShadow, Stroke
 
 enum class RTTR_AUTO_REGISTER_CLASS LayerStylePosition { Above, Blow };
 
-class PAG_API LayerStyle {
+class PAG_API LayerStyle : public ArenaAllocated {
  public:
   LayerStyle();
 
@@ -1338,7 +1363,7 @@ enum class RTTR_AUTO_REGISTER_CLASS ShapeType {
   RoundCorners
 };
 
-class PAG_API ShapeElement {
+class PAG_API ShapeElement : public ArenaAllocated {
  public:
   virtual ~ShapeElement() = default;
 
@@ -1725,7 +1750,7 @@ enum class PAG_API CachePolicy : uint8_t {
 /**
  * The Layer object provides access to layers within compositions.
  */
-class PAG_API Layer {
+class PAG_API Layer : public ArenaAllocated {
  public:
   Layer();
 
@@ -1806,6 +1831,13 @@ class PAG_API Layer {
   std::vector<LayerStyle*> layerStyles;
   std::vector<Marker*> markers;
   CachePolicy cachePolicy = CachePolicy::Auto;
+  /**
+   * An optional bounds index embedded by the exporter, storing the pre-measured content bounds of
+   * this layer as keyframed rects in layer content time. Each entry applies from its frame until
+   * the frame of the next entry. When present, measuring the layer bounds becomes a table lookup
+   * instead of a walk over the content tree.
+   */
+  std::vector<std::pair<Frame, Rect>> cachedBounds = {};
 
   Cache* RTTR_SKIP_REGISTER_PROPERTY cache = nullptr;
   std::mutex locker = {};
@@ -1817,6 +1849,12 @@ class PAG_API Layer {
   TimeRange visibleRange();
   virtual Rect getBounds() const;
 
+  /**
+   * Looks up the cached bounds of the specified content frame from the embedded bounds index.
+   * Returns false if the index is absent or does not cover the frame.
+   */
+  bool getCachedBounds(Frame contentFrame, Rect* bounds) const;
+
  private:
   bool verifyExtra() const;
 
@@ -1983,7 +2021,7 @@ class PAG_API CameraLayer : public Layer {
  */
 enum class RTTR_AUTO_REGISTER_CLASS CompositionType { Unknown, Vector, Bitmap, Video };
 
-class PAG_API Composition {
+class PAG_API Composition : public ArenaAllocated {
  public:
   Composition();
 
@@ -2037,6 +2075,13 @@ class PAG_API Composition {
 
   bool staticContent() const;
 
+  /**
+   * Computes staticTimeRanges on first access. Decoding defers this analysis, so compositions that
+   * are never rendered skip it entirely. Safe to call from multiple threads, and a no-op once the
+   * ranges are computed.
+   */
+  void ensureStaticTimeRanges();
+
   /**
    * The type of the Composition.
    */
@@ -2342,7 +2387,7 @@ class PAG_API FileAttributes {
  public:
   bool empty() const {
     return timestamp == 0 && pluginVersion.empty() && aeVersion.empty() && systemVersion.empty() &&
-           author.empty() && scene.empty() && warnings.empty();
+           author.empty() && scene.empty() && warnings.empty() && !progressiveProfile;
   }
 
   int64_t timestamp = 0;
@@ -2352,6 +2397,12 @@ class PAG_API FileAttributes {
   std::string author = "";
   std::string scene = "";
   std::vector<std::string> warnings;
+  /**
+   * Indicates the file uses the streaming-friendly layout: sequence tags carry only their headers,
+   * and the frame payloads follow the composition blocks as SequenceFrameBlock tags interleaved in
+   * playback order. See Codec::EncodeProgressively().
+   */
+  bool progressiveProfile = false;
 };
 
 struct PerformanceData {
@@ -2376,6 +2427,8 @@ struct PerformanceData {
   int64_t graphicsMemory;
 };
 
+class Arena;
+
 class PAG_API File {
  public:
   /**
@@ -2504,10 +2557,17 @@ class PAG_API File {
   // Just references, no need to delete them.
   std::vector<std::vector<ImageLayer*>> imageLayers = {};
 
+  // Backs every node of the decoded tag tree, released after the tree is destroyed.
+  Arena* arena = nullptr;
+
+  // Keeps the source buffer alive for ByteData views borrowed during decoding.
+  std::shared_ptr<ByteData> sourceBytes = nullptr;
+
   File(std::vector<Composition*> compositionList, std::vector<pag::ImageBytes*> imageList);
   void updateEditables(Composition* composition);
 
   friend class Codec;
+  friend class FileLoader;
   friend class SequenceInfo;
   friend class EncryptedCodec;
 };
@@ -2517,6 +2577,68 @@ class PAG_API File {
  */
 int64_t PAG_API CalculateGraphicsMemory(std::shared_ptr<File> file);
 
+/**
+ * The predicted per-frame rendering cost classes of a File.
+ */
+enum class PAG_API FileCostClass : uint8_t {
+  /**
+   * The file renders comfortably on low-end devices.
+   */
+  Low = 0,
+  /**
+   * The file has a noticeable but typically acceptable rendering cost.
+   */
+  Moderate = 1,
+  /**
+   * The file is likely to miss frame deadlines on weaker devices or to exhaust memory budgets.
+   */
+  High = 2
+};
+
+/**
+ * The result of PreflightFile(). All values are estimated from the file's structure alone,
+ * without creating any decoders or rendering resources.
+ */
+struct PAG_API FilePreflightData {
+  /**
+   * The estimated peak graphics memory in bytes, the same value CalculateGraphicsMemory()
+   * returns.
+   */
+  int64_t graphicsMemory = 0;
+  /**
+   * The number of video compositions. Each one needs its own video decoder instance during
+   * playback.
+   */
+  int videoCount = 0;
+  /**
+   * The maximum number of filter passes (effects, layer styles and motion blur) applied along any
+   * layer nesting path. Each pass renders into an offscreen target.
+   */
+  int maxFilterDepth = 0;
+  /**
+   * The total number of effects, layer styles and motion blur flags in the file.
+   */
+  int filterCount = 0;
+  /**
+   * The total number of characters across all text layers, including non-editable ones.
+   */
+  int glyphCount = 0;
+  /**
+   * The total number of layers in the file, including nested compositions.
+   */
+  int layerCount = 0;
+  /**
+   * The predicted per-frame rendering cost class, derived from the values above.
+   */
+  FileCostClass costClass = FileCostClass::Low;
+};
+
+/**
+ * Scans the structure of the file and returns its estimated rendering cost bounds without
+ * rendering anything, so heavy files can be rejected or downgraded at upload time.
+ */
+FilePreflightData PAG_API PreflightFile(std::shared_ptr<File> file);
+
 class CodecContext;
 
 class PAG_API Codec {
@@ -2554,6 +2676,14 @@ class PAG_API Codec {
   static std::shared_ptr<File> Decode(const void* bytes, uint32_t byteLength,
                                       const std::string& path);
 
+  /**
+   * Decode a pag file from the specified byte data, taking ownership of the buffer. The returned
+   * file retains the buffer, and large embedded payloads reference it directly instead of being
+   * copied, halving the peak memory while loading.
+   */
+  static std::shared_ptr<File> Decode(std::shared_ptr<ByteData> fileBytes,
+                                      const std::string& path);
+
   /**
    * Encode a pag file to byte data, return null if the file is null.
    */
@@ -2566,6 +2696,26 @@ class PAG_API Codec {
   static std::unique_ptr<ByteData> Encode(std::shared_ptr<File> pagFile,
                                           std::shared_ptr<PerformanceData> performanceData);
 
+  /**
+   * Encode a pag file to byte data, reusing the unmodified tag bytes of the file it was decoded
+   * from and re-encoding only the specified modified compositions, so saving a small edit costs
+   * time proportional to the edit instead of the file size. The file must retain its source bytes,
+   * see Decode(std::shared_ptr<ByteData>). Whenever the source bytes are absent or cannot be
+   * reused safely, this falls back to a full encode, so the result is always a complete pag file.
+   */
+  static std::unique_ptr<ByteData> EncodeIncrementally(
+      std::shared_ptr<File> file, const std::vector<Composition*>& modifiedCompositions);
+
+  /**
+   * Encode a pag file to byte data in the progressive profile: sequence tags carry only a compact
+   * header, and the frame payloads follow the composition blocks as individual tags interleaved
+   * in playback order. A streaming loader can render the first frame once the early tags and
+   * frames have arrived instead of waiting for whole sequences, which usually means a small
+   * fraction of the file. The layout is marked in FileAttributes, decodes to the same file, and
+   * costs a few bytes of tag headers per frame. Return null if the file is null.
+   */
+  static std::unique_ptr<ByteData> EncodeProgressively(std::shared_ptr<File> file);
+
   /**
    * Read the performance data from the specified byte data, return null if the byte data contains
    * no performance data.
@@ -2576,5 +2726,63 @@ class PAG_API Codec {
  protected:
   static void UpdateFileAttributes(std::shared_ptr<File> file, CodecContext* context,
                                    const std::string& filePath);
+
+ private:
+  static std::shared_ptr<File> DecodeInternal(const void* bytes, uint32_t byteLength,
+                                              const std::string& filePath,
+                                              std::shared_ptr<ByteData> fileBytes);
+};
+
+/**
+ * FileLoader decodes a pag file progressively from byte chunks, e.g. while it is still
+ * downloading, so parsing overlaps the transfer instead of waiting for the last byte. Each tag is
+ * consumed as soon as it has fully arrived, and finish() only installs references and verifies the
+ * already-decoded tree.
+ */
+class PAG_API FileLoader : protected Codec {
+ public:
+  /**
+   * Creates a loader which decodes chunks into a file with the specified path attribute.
+   */
+  static std::shared_ptr<FileLoader> Make(const std::string& filePath = "");
+
+  ~FileLoader();
+
+  /**
+   * Appends the next chunk of the file and parses every tag that has fully arrived. Returns false
+   * if the data received so far is not a valid pag file.
+   */
+  bool feed(const void* bytes, size_t length);
+
+  /**
+   * Returns true once every tag of the file has been parsed.
+   */
+  bool complete() const;
+
+  /**
+   * The number of compositions fully decoded so far. Callers can start preparing resources for
+   * early compositions before the whole file has arrived.
+   */
+  size_t numCompositions() const;
+
+  /**
+   * Installs references, verifies the decoded tree, and returns the file. Returns null if the
+   * received data was invalid or incomplete.
+   */
+  std::shared_ptr<File> finish();
+
+ private:
+  explicit FileLoader(std::string filePath);
+  bool parseTags();
+
+  std::string filePath;
+  std::vector<uint8_t> buffer = {};
+  size_t position = 0;
+  size_t bodyEnd = 0;
+  bool headerParsed = false;
+  bool tagsComplete = false;
+  bool failed = false;
+  CodecContext* context = nullptr;
+  Arena* arena = nullptr;
 };
 }  // namespace pag
@@ -21,6 +21,7 @@
 #include <atomic>
 #include <functional>  // for windows
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include "pag/animation/TextMotionOptions.h"
 #include "pag/animation/TextMotionPreset.h"
@@ -31,6 +32,7 @@
 namespace tgfx {
 struct Rect;
 class Context;
+class Matrix;
 class Surface;
 class ImageInfo;
 }  // namespace tgfx
@@ -77,6 +79,8 @@ class TextMotionPreset;
 class Transform2D;
 class Transform3D;
 
+class PAGLoadRequest;
+
 /**
  * An image used to replace the contents of PAGImageLayers in a PAGFile.
  */
@@ -88,12 +92,44 @@ class PAG_API PAGImage {
    */
   static std::shared_ptr<PAGImage> FromPath(const std::string& filePath);
 
+  /**
+   * Creates a PAGImage object from a path of an image file, scaling the content down to fit
+   * within maxWidth x maxHeight when the decoded dimensions exceed them. Use this for large
+   * replacement images such as gallery photos that display at a small size, so the rasterized
+   * content and its caches are bounded by the displayed size instead of the file's full
+   * resolution. A bound of 0 or less leaves the matching dimension unconstrained. Returns null
+   * if the file does not exist, or it's not a valid image file.
+   */
+  static std::shared_ptr<PAGImage> FromPath(const std::string& filePath, int maxWidth,
+                                            int maxHeight);
+
+  /**
+   * Creates a PAGImage object from a path of an image file asynchronously on the shared render
+   * task pool, so replacing a large photo into an image layer does not stall the caller while it
+   * decodes. The callback is invoked on a worker thread with the created image, or with null if
+   * the file does not exist or it's not a valid image file. maxWidth and maxHeight behave the
+   * same as in FromPath(). Returns a handle which can be used to cancel the request, or null if
+   * the callback is null.
+   */
+  static std::shared_ptr<PAGLoadRequest> FromPathAsync(
+      const std::string& filePath, std::function<void(std::shared_ptr<PAGImage>)> callback,
+      int maxWidth = 0, int maxHeight = 0);
+
   /**
    * Creates a PAGImage object from the specified file bytes, return null if the bytes is empty or
    * it's not a valid image file.
    */
   static std::shared_ptr<PAGImage> FromBytes(const void* bytes, size_t length);
 
+  /**
+   * Creates a PAGImage object from the specified file bytes, scaling the content down to fit
+   * within maxWidth x maxHeight when the decoded dimensions exceed them. A bound of 0 or less
+   * leaves the matching dimension unconstrained. Returns null if the bytes is empty or it's not
+   * a valid image file.
+   */
+  static std::shared_ptr<PAGImage> FromBytes(const void* bytes, size_t length, int maxWidth,
+                                             int maxHeight);
+
   /**
    * Creates a PAGImage object from an array of pixel data, return null if it's not valid pixels.
    * @param pixels The pixel data to copy from.
@@ -189,6 +225,45 @@ class PAG_API PAGImage {
   friend class AudioClip;
 };
 
+class VideoSourceProxy;
+
+/**
+ * PAGVideoSource is a streaming image source for feeding continuously updated frames, such as live
+ * camera output, into image layers. Replace it into a layer once with
+ * PAGImageLayer::replaceImage(), then push frames with setCurrentFrame(). Pushing a frame swaps
+ * the underlying texture in place and only marks the layer content as changed for the next flush,
+ * it does not rebuild the layer's content caches the way replacing a new PAGImage every frame
+ * does.
+ */
+class PAG_API PAGVideoSource : public PAGImage {
+ public:
+  /**
+   * Creates a new PAGVideoSource with the specified content size. Returns null if either dimension
+   * is not greater than zero.
+   */
+  static std::shared_ptr<PAGVideoSource> Make(int width, int height);
+
+  /**
+   * Pushes a video frame as the current content of this source. The hardware buffer is wrapped
+   * directly without copying pixels and should not be written to again until a newer frame has
+   * been pushed and flushed. Passing null clears the content.
+   */
+  void setCurrentFrame(HardwareBufferRef hardwareBuffer);
+
+ protected:
+  std::shared_ptr<Graphic> getGraphic(Frame frame) const override;
+
+  bool isStill() const override;
+
+  Frame getContentFrame(int64_t time) const override;
+
+ private:
+  PAGVideoSource(int width, int height);
+
+  std::shared_ptr<VideoSourceProxy> proxy = nullptr;
+  std::shared_ptr<Graphic> graphic = nullptr;
+};
+
 class PAGComposition;
 
 class PAGImageLayer;
@@ -312,6 +387,23 @@ class PAG_API PAGLayer : public Content {
    */
   void setAlpha(float value);
 
+  /**
+   * Overrides the transform evaluated from the layer's keyframes with the specified matrix and
+   * alpha. The override is applied in the render path after keyframe evaluation and replaces the
+   * animated transform entirely, so the matrix must describe the full placement of the layer
+   * content. Unlike setMatrix() and setAlpha(), none of the layer's caches are invalidated, which
+   * makes it suitable for driving a layer from external data on every frame: each update costs a
+   * single write. Note the override is registered on the underlying file layer and therefore
+   * affects every PAGFile sharing the same loaded file.
+   */
+  void setTransformOverride(const Matrix& matrix, float alpha);
+
+  /**
+   * Clears a transform override previously set by setTransformOverride(), restoring the transform
+   * evaluated from the layer's keyframes.
+   */
+  void clearTransformOverride();
+
   /**
    * Whether or not the layer is visible.
    */
@@ -530,6 +622,13 @@ class PAG_API PAGLayer : public Content {
    * content changed if you pass true in the contentChanged parameter.
    */
   void notifyModified(bool contentChanged = false);
+
+  /**
+   * Marks the structure of the layer tree changed for this layer and all of its ancestors, which
+   * means the set of layers in the tree or their placement on the timeline was modified. Callers
+   * still need notifyModified() to invalidate the rendered content.
+   */
+  void notifyStructureModified();
   virtual bool contentModified() const;
   virtual bool cacheFilters() const;
   virtual Frame frameDuration() const;
@@ -553,7 +652,28 @@ class PAG_API PAGLayer : public Content {
   std::shared_ptr<PAGLayer> _trackMatteLayer = nullptr;
   int _editableIndex = -1;
   uint32_t contentVersion = 0;
+  uint32_t structureVersion = 0;
   std::atomic<uint32_t> audioVersion = {0};
+  // The retained display list of the layer recorded at retainedGraphicFrame, reused by the parent
+  // composition while the layer stays unchanged between frames.
+  std::shared_ptr<Graphic> retainedGraphic = nullptr;
+  Frame retainedGraphicFrame = -1;
+  uint32_t retainedGraphicVersion = 0;
+  Matrix retainedGraphicMatrix = Matrix::I();
+  float retainedGraphicAlpha = 1.0f;
+  // The matte content of this layer recorded at trackMatteContentFrame when it is used as a track
+  // matte, reused by TrackMatteRenderer while the matte stays unchanged between frames.
+  std::shared_ptr<Graphic> trackMatteContent = nullptr;
+  std::shared_ptr<Graphic> trackMatteColorGlyphs = nullptr;
+  Frame trackMatteContentFrame = -1;
+  uint32_t trackMatteContentVersion = 0;
+  Matrix trackMatteContentMatrix = Matrix::I();
+  float trackMatteContentAlpha = 1.0f;
+  // The content frame and device-space bounds of this layer recorded by the last dirty-region
+  // collection, used by PAGPlayer to damage both the old and new positions of a moving layer.
+  Frame damageFrame = -1;
+  bool damageFrameValid = false;
+  Rect damageBounds = Rect::MakeEmpty();
 
   void setVisibleInternal(bool value);
   void setStartTimeInternal(int64_t time);
@@ -910,6 +1030,13 @@ class PAG_API PAGImageLayer : public PAGLayer {
   ImageLayer* emptyImageLayer = nullptr;
   ImageReplacement* replacement = nullptr;
   std::unique_ptr<Property<float>> contentTimeRemap;
+  // Flattens the animatable content time remap into a frame-indexed table, so per-frame content
+  // time lookups avoid keyframe interpolation. Rebuilt together with contentTimeRemap.
+  std::vector<float> contentTimeRemapLUT;
+  // Caches the visible range in the root file, which walks the parent chain's time-stretch
+  // conversions to compute. Invalidated together with contentTimeRemap.
+  TimeRange cachedVisibleRange = {};
+  bool visibleRangeCached = false;
 
   PAGImageLayer(int width, int height, int64_t duration);
   bool hasPAGImage() const;
@@ -940,6 +1067,26 @@ class PreComposeLayer;
 
 class VectorComposition;
 
+class HitTestGrid;
+
+/**
+ * Defines one entry of a batch update applied by PAGComposition::applyTransforms().
+ */
+struct PAGTransformUpdate {
+  /**
+   * The layer to update, which must belong to the composition's layer tree.
+   */
+  std::shared_ptr<PAGLayer> layer = nullptr;
+  /**
+   * The new matrix of the layer.
+   */
+  Matrix matrix = Matrix::I();
+  /**
+   * The new alpha of the layer.
+   */
+  float alpha = 1.0f;
+};
+
 class PAG_API PAGComposition : public PAGLayer {
  public:
   /**
@@ -1068,6 +1215,15 @@ class PAG_API PAGComposition : public PAGLayer {
    */
   std::vector<std::shared_ptr<PAGLayer>> getLayersUnderPoint(float localX, float localY);
 
+  /**
+   * Applies a batch of matrix and alpha updates to layers of this composition's tree under a
+   * single lock with one invalidation pass. Driving many layers from an external animation system
+   * through individual setMatrix() and setAlpha() calls locks and walks the parent chain once per
+   * call; this method does both once per batch. Entries whose layer is null, belongs to a
+   * different tree, or already carries the given values are skipped.
+   */
+  void applyTransforms(const std::vector<PAGTransformUpdate>& updates);
+
  protected:
   int _width = 0;
   int _height = 0;
@@ -1102,11 +1258,18 @@ class PAG_API PAGComposition : public PAGLayer {
 
  private:
   VectorComposition* emptyComposition = nullptr;
+  // A per-frame spatial index over the child layer bounds, rebuilt lazily when the current frame
+  // or the content version changes. It keeps mouse-move hit testing from measuring every layer.
+  std::unique_ptr<HitTestGrid> hitTestGrid = nullptr;
+  Frame hitTestGridFrame = -1;
+  uint32_t hitTestGridVersion = 0;
 
   static void FindLayers(std::function<bool(PAGLayer* pagLayer)> filterFunc,
                          std::vector<std::shared_ptr<PAGLayer>>* result,
                          std::shared_ptr<PAGLayer> pagLayer);
   static void MeasureChildLayer(tgfx::Rect* bounds, PAGLayer* childLayer);
+  static bool RetainedGraphicValid(PAGLayer* childLayer);
+  static bool LayerCoversViewport(PAGLayer* childLayer, const tgfx::Rect& viewport);
   static void DrawChildLayer(Recorder* recorder, PAGLayer* childLayer);
   static bool GetTrackMatteLayerAtPoint(PAGLayer* childLayer, float x, float y,
                                         std::vector<std::shared_ptr<PAGLayer>>* results);
@@ -1115,6 +1278,8 @@ class PAG_API PAGComposition : public PAGLayer {
 
   bool getLayersUnderPointInternal(float x, float y,
                                    std::vector<std::shared_ptr<PAGLayer>>* results);
+  void updateHitTestGrid();
+  void generateChildContents();
   int getLayerIndexInternal(std::shared_ptr<PAGLayer> child) const;
   void doSwapLayerAt(int index1, int index2);
   void doSetLayerIndex(std::shared_ptr<PAGLayer> pagLayer, int index);
@@ -1140,6 +1305,29 @@ class PAG_API PAGComposition : public PAGLayer {
   friend class PAGDecoder;
 };
 
+/**
+ * A handle to an asynchronous loading request created by PAGFile::LoadAsync() or
+ * PAGImage::FromPathAsync().
+ */
+class PAG_API PAGLoadRequest {
+ public:
+  /**
+   * Cancels the request. The callback will not be invoked after cancel() returns. If loading has
+   * already started on a worker thread, its result is discarded when it finishes.
+   */
+  void cancel();
+
+ private:
+  std::mutex locker = {};
+  bool cancelled = false;
+
+  PAGLoadRequest() = default;
+
+  friend class PAGFile;
+
+  friend class PAGImage;
+};
+
 class PAG_API PAGFile : public PAGComposition {
  public:
   /**
@@ -1160,6 +1348,18 @@ class PAG_API PAGFile : public PAGComposition {
   static std::shared_ptr<PAGFile> Load(const std::string& filePath,
                                        const std::string& password = "");
 
+  /**
+   * Loads a pag file from the path asynchronously on the shared render task pool instead of
+   * blocking a caller-owned thread per file. The callback is invoked on a worker thread with the
+   * loaded file, or with null if the file does not exist or the data is not a pag file. If
+   * prefetch is true, the request runs at a lower priority so files needed on screen right now
+   * decode first. Returns a handle which can be used to cancel the request when the user
+   * navigates away, or null if the callback is null.
+   */
+  static std::shared_ptr<PAGLoadRequest> LoadAsync(
+      const std::string& filePath, std::function<void(std::shared_ptr<PAGFile>)> callback,
+      bool prefetch = false, const std::string& password = "");
+
   /**
    * Creates an empty PAGFile with a single VectorComposition containing one PreCompose layer.
    * The composition size and duration match the given parameters.
@@ -1205,6 +1405,14 @@ class PAG_API PAGFile : public PAGComposition {
    */
   void replaceText(int editableTextIndex, std::shared_ptr<TextDocument> textData);
 
+  /**
+   * Replaces the text data of multiple editable indices in one pass. Each entry pairs an editable
+   * text index with its new text data and has the same semantics as replaceText(). All entries are
+   * applied atomically under a single lock, so a concurrent flush sees either none or all of the
+   * replacements, and the new texts are shaped in parallel before this method returns.
+   */
+  void replaceTexts(const std::vector<std::pair<int, std::shared_ptr<TextDocument>>>& batch);
+
   /**
    * Replace file's image content of the specified index with a PAGImage object. The index ranges from
    * 0 to PAGFile.numImages - 1. Passing in null for the image parameter will reset it to default
@@ -1250,7 +1458,9 @@ class PAG_API PAGFile : public PAGComposition {
 
   /**
    * Make a copy of the original file, any modification to current file has no effect on the result
-   * file.
+   * file. The copy shares the immutable file tree with this one, only the per-instance editing
+   * state (replacements, progress, matrices) is allocated, so instantiating many copies of one
+   * template costs kilobytes per copy rather than a full re-decode.
    */
   std::shared_ptr<PAGFile> copyOriginal();
 
@@ -1279,10 +1489,15 @@ class PAG_API PAGFile : public PAGComposition {
                            std::shared_ptr<TextDocument> textData);
   void replaceImageInternal(const std::vector<std::shared_ptr<PAGLayer>>& imageLayers,
                             std::shared_ptr<PAGImage> image);
+  void updateEditableSlots();
 
   Frame _stretchedContentFrame = 0;
   Frame _stretchedFrameDuration = 1;
   PAGTimeStretchMode _timeStretchMode = PAGTimeStretchMode::Repeat;
+  bool editableSlotsValid = false;
+  uint32_t editableSlotsVersion = 0;
+  std::unordered_map<int, std::vector<std::shared_ptr<PAGLayer>>> editableTextSlots = {};
+  std::unordered_map<int, std::vector<std::shared_ptr<PAGLayer>>> editableImageSlots = {};
 
   friend class PAGImageLayer;
 
@@ -1325,10 +1540,22 @@ class PAG_API PAGSurface {
   /**
    *  Creates a new PAGSurface for off-screen rendering. Allocates memory for pixels, based on the
    *  width and height, which can be accessed by readPixels(). Returns null if the specified size
-   *  is not valid.
+   *  is not valid. On platforms without a GPU, such as server containers, the surface falls back
+   *  to a software rendering device automatically. In that case, prefer one surface per worker
+   *  thread so rasterization scales with the available cores.
    */
   static std::shared_ptr<PAGSurface> MakeOffscreen(int width, int height);
 
+  /**
+   * Creates a new PAGSurface for off-screen rendering like MakeOffscreen(width, height). If
+   * useSharedDevice is true, the surface attaches to a process-wide GPU device shared by all
+   * offscreen surfaces created with the same flag, instead of creating its own device. Running
+   * many concurrent players on the shared device saves the memory of duplicate GPU contexts and
+   * lets them reuse context-level resources such as cached programs and glyph textures. The shared
+   * device is released when the last surface using it goes away.
+   */
+  static std::shared_ptr<PAGSurface> MakeOffscreen(int width, int height, bool useSharedDevice);
+
   /**
    * Creates a new PAGSurface from specified hardware buffer. Returns null if the hardware buffer
    * is invalid.
@@ -1358,6 +1585,15 @@ class PAG_API PAGSurface {
    */
   bool clearAll();
 
+  /**
+   * Initializes the GPU context, allocates the backing render target, and compiles the shader
+   * programs of the most common drawing operations ahead of the first flush. Calling it from a
+   * background thread right after creating the surface moves that one-time cost off the first
+   * frame. For surfaces bound to an external GPU context, call it on the thread where that context
+   * is current. Returns false if the surface fails to initialize.
+   */
+  bool warmUp();
+
   /**
    * Free the cache created by the surface immediately. Can be called to reduce memory pressure.
    */
@@ -1392,7 +1628,7 @@ class PAG_API PAGSurface {
   GLRestorer* glRestorer = nullptr;
 
   bool draw(RenderCache* cache, std::shared_ptr<Graphic> graphic, BackendSemaphore* signalSemaphore,
-            bool autoClear = true);
+            bool autoClear = true, const Rect* damageBounds = nullptr);
   bool prepare(RenderCache* cache, std::shared_ptr<Graphic> graphic);
   bool hitTest(RenderCache* cache, std::shared_ptr<Graphic> graphic, float x, float y);
   tgfx::Context* lockContext();
@@ -1413,6 +1649,43 @@ class PAG_API PAGSurface {
 
 class FileReporter;
 
+struct FrameState;
+
+class FrameProfiler;
+
+class ReplayCapture;
+
+/**
+ * FrameProfileNode describes the measured cost of one named stage of rendering a frame. The nodes
+ * form a tree: the root covers a whole flush, and its children break the time down into per-layer
+ * content generation, filter passes, and snapshot generation.
+ */
+struct PAG_API FrameProfileNode {
+  /**
+   * The name of the stage, e.g. the name of the layer or filter it belongs to.
+   */
+  std::string name = "";
+  /**
+   * The time in microseconds spent in this stage, including all of its children.
+   */
+  int64_t totalTime = 0;
+
+  /**
+   * The GPU time in microseconds spent executing the commands issued by this stage, including all
+   * of its children. Only populated when GPU profiling is enabled with setGpuProfilingEnabled(),
+   * zero otherwise.
+   */
+  int64_t gpuTime = 0;
+
+  /**
+   * The number of heap allocations made in this stage, including all of its children. Only
+   * populated in builds with PAG_ALLOCATION_AUDIT defined, zero otherwise.
+   */
+  int64_t allocationCount = 0;
+
+  std::vector<FrameProfileNode> children = {};
+};
+
 class PAG_API PAGPlayer {
  public:
   PAGPlayer();
@@ -1451,6 +1724,18 @@ class PAG_API PAGPlayer {
    */
   void setVideoEnabled(bool value);
 
+  /**
+   * The number of frames each sequence decodes ahead of the displayed frame along the playback
+   * direction. The default value is 1.
+   */
+  int sequenceReadAheadCount();
+
+  /**
+   * Set the value of sequenceReadAheadCount property. Higher values keep fast seeking responsive
+   * at the cost of extra decoding work and memory.
+   */
+  void setSequenceReadAheadCount(int count);
+
   /**
    * If set to true, PAGPlayer caches an internal bitmap representation of the static content for
    * each layer. This caching can increase performance for layers that contain complex vector
@@ -1500,6 +1785,37 @@ class PAG_API PAGPlayer {
    */
   void setMaxFrameRate(float value);
 
+  /**
+   * Returns the current render quality. The default value is PAGRenderQuality::Default.
+   */
+  PAGRenderQuality renderQuality();
+
+  /**
+   * Sets the render quality. PAGRenderQuality::PowerSaving collectively engages the cheaper
+   * rendering paths so a battery-saver framework only needs to flip one switch: filter passes run
+   * at half resolution, large blurs downsample earlier, static snapshots rasterize at half
+   * resolution, and the effective frame rate is capped at 30 fps regardless of maxFrameRate().
+   * The individual tuning knobs keep their configured values and take effect again when the
+   * quality is switched back.
+   */
+  void setRenderQuality(PAGRenderQuality value);
+
+  /**
+   * Returns the frame budget in milliseconds. The default value is 0, which means no budget is
+   * applied.
+   */
+  float frameBudget();
+
+  /**
+   * Sets a soft deadline in milliseconds for each flush(), so playback degrades gracefully
+   * instead of missing vsync when a frame turns out to be expensive. Once the elapsed time of a
+   * frame exceeds the budget, non-critical work is deferred: new snapshot caches are not
+   * generated until the next frame, filters step down to their power-saving paths, and the
+   * end-of-frame image uploads and cache eviction sweeps are postponed. Pass 0 to disable the
+   * budget.
+   */
+  void setFrameBudget(float milliseconds);
+
   /**
    * Returns the current scale mode.
    */
@@ -1540,7 +1856,9 @@ class PAG_API PAGPlayer {
   void preFrame();
 
   /**
-   * Returns the current progress of play position, the value is from 0.0 to 1.0.
+   * Returns the current progress of play position, the value is from 0.0 to 1.0. This reads the
+   * state published by the last flush() or seek on this player without taking the internal lock,
+   * so it never blocks a concurrent flush() on another thread.
    */
   double getProgress();
 
@@ -1551,7 +1869,8 @@ class PAG_API PAGPlayer {
   void setProgress(double percent);
 
   /**
-   * Returns the current frame.
+   * Returns the current frame. Like getProgress(), this reads the state published by the last
+   * flush() or seek without taking the internal lock.
    */
   Frame currentFrame() const;
 
@@ -1566,12 +1885,83 @@ class PAG_API PAGPlayer {
    */
   void setAutoClear(bool value);
 
+  /**
+   * If set to true, PAGPlayer tracks the region changed by each flush() and clips both the
+   * clearing and the drawing to it, instead of redrawing the whole surface. This can greatly
+   * reduce the GPU cost when only a small part of the content animates. The damage region is
+   * computed conservatively from the static time ranges of the layer tree. The default value is
+   * false.
+   */
+  bool dirtyRegionEnabled();
+
+  /**
+   * Sets the dirtyRegionEnabled property.
+   */
+  void setDirtyRegionEnabled(bool value);
+
+  /**
+   * Returns a rectangle in pixels describing the surface area changed by the last flush(), which
+   * can be passed to partial-present extensions such as eglSwapBuffersWithDamageKHR. Returns the
+   * full surface bounds if the dirtyRegionEnabled property is false.
+   */
+  Rect getDamageBounds();
+
+  /**
+   * Returns the current viewport rectangle. Returns an empty rectangle if no viewport is set,
+   * which means the full stage is rendered. The default value is an empty rectangle.
+   */
+  Rect viewportRect();
+
+  /**
+   * Sets a viewport rectangle in the coordinate space of the PAGSurface. When set, layers lying
+   * completely outside the rectangle are culled during content generation and drawing is clipped
+   * to the rectangle, which reduces both CPU and GPU cost when only a cropped region of the
+   * composition is displayed, such as a picture-in-picture view. Pass an empty rectangle to
+   * restore full-stage rendering.
+   */
+  void setViewportRect(const Rect& rect);
+
   /**
    * Prepares the player for the next flush() call. It collects all CPU tasks from the current
    * progress of the composition and runs them asynchronously in parallel. It is usually used for
-   * speeding up the first frame rendering.
+   * speeding up the first frame rendering. If warmUpDecoders is true, demuxers and decoders for
+   * every upcoming video sequence are also initialized on background threads before playback
+   * starts, avoiding the first-frame hitch of lazy decoder creation.
+   */
+  void prepare(bool warmUpDecoders = false);
+
+  /**
+   * Warms the caches for the specified progress without rendering anything. It temporarily seeks
+   * the composition to the progress, collects the CPU tasks of that frame the same way prepare()
+   * does - image decoding, sequence read-ahead, glyph atlas filling and snapshot generation - and
+   * then restores the current progress, so the first flush() after the player becomes visible hits
+   * warm caches. If warmUpDecoders is true, decoders for the upcoming video sequences are also
+   * initialized on background threads.
+   */
+  void prefetch(double progress, bool warmUpDecoders = false);
+
+  /**
+   * Warms the caches of a composition that is about to be shown by this player, without
+   * interrupting the one currently playing. It collects the decoding tasks of the specified
+   * progress on a temporary stage, runs them on background threads, and parks the results in the
+   * same process-level pool used by parkCache(). When the composition is later shown via
+   * setComposition() near the preloaded progress, the next flush() restores the parked content,
+   * so a playlist can switch items without a first-frame hitch. This only takes effect when the
+   * composition is a PAGFile loaded from a file path and is not attached to any player yet.
    */
-  void prepare();
+  void preloadComposition(std::shared_ptr<PAGComposition> composition, double progress = 0);
+
+  /**
+   * Parks the context-independent content of the internal render cache (asset images, decoded
+   * image buffers and sequence frame queues) into a process-level, size-capped pool keyed by the
+   * file path and progress. When a player later displays the same file near the same progress,
+   * the parked content is restored on its next flush, so a list cell scrolled away and back skips
+   * the re-decoding work. Snapshots and text atlases are GPU resources bound to the surface's
+   * context and cannot survive a detach; they are rebuilt from the restored content instead. Call
+   * this right before the view is recycled or its surface is detached. This only takes effect
+   * when the composition is a PAGFile loaded from a file path.
+   */
+  void parkCache();
 
   /**
    * Inserts a GPU semaphore that the current GPU-backed API must wait on before executing any more
@@ -1613,6 +2003,15 @@ class PAG_API PAGPlayer {
    */
   bool flushAndSignalSemaphore(BackendSemaphore* signalSemaphore);
 
+  /**
+   * Runs the deferrable cache maintenance immediately: eviction sweeps, releasing the pooled
+   * offscreen surfaces, and purging the unreferenced GPU resources. Call it while the playback is
+   * paused or finished, typically from PAGAnimator::Listener::onAnimationIdle(), so the deep
+   * cleanup runs between animations instead of competing with visible frames. It has no effect if
+   * this player has no associated surface.
+   */
+  void performIdleMaintenance();
+
   /**
    * Returns a rectangle in pixels that defines the displaying area of the specified layer, which
    * is in the coordinate of the PAGSurface.
@@ -1636,6 +2035,53 @@ class PAG_API PAGPlayer {
   bool hitTestPoint(std::shared_ptr<PAGLayer> pagLayer, float surfaceX, float surfaceY,
                     bool pixelHitTest = false);
 
+  /**
+   * Returns true if frame profiling is enabled. The default value is false.
+   */
+  bool profilingEnabled();
+
+  /**
+   * When enabled, each flush() records a tree of named costs which can be read afterwards with
+   * getFrameProfile(). Profiling adds a small CPU overhead to every flush, so it should stay
+   * disabled outside of diagnostics.
+   */
+  void setProfilingEnabled(bool value);
+
+  /**
+   * Returns the cost tree recorded by the last flush(). Returns an empty node if profiling is
+   * disabled or no flush() has finished since it was enabled.
+   */
+  FrameProfileNode getFrameProfile();
+
+  /**
+   * Returns true if GPU profiling is enabled. The default value is false.
+   */
+  bool gpuProfilingEnabled();
+
+  /**
+   * When enabled together with setProfilingEnabled(), each flush() also measures the GPU time of
+   * the major rendering passes and records it into the gpuTime fields of the frame profile.
+   * Measuring drains the GPU pipeline around every pass, which serializes the CPU and the GPU and
+   * lowers the frame rate noticeably, so this is meant for profiling sessions on test devices
+   * only, never for production.
+   */
+  void setGpuProfilingEnabled(bool value);
+
+  /**
+   * Starts recording the frame-by-frame input sequence of this player: progress values, text and
+   * image replacements, surface sizes, and per-flush snapshot cache statistics. The capture adds
+   * a few string appends per flush and can stay enabled in production builds when a device needs
+   * to be diagnosed.
+   */
+  void startReplayCapture();
+
+  /**
+   * Stops recording and returns the captured log, or an empty string if no capture was started.
+   * The log can be loaded with PAGReplay::Load() to reproduce the recorded scenario against the
+   * same pag file.
+   */
+  std::string stopReplayCapture();
+
   /**
    * The time cost by rendering in microseconds.
    */
@@ -1670,18 +2116,110 @@ class PAG_API PAGPlayer {
  private:
   FileReporter* reporter = nullptr;
   float _maxFrameRate = 60;
+  PAGRenderQuality _renderQuality = PAGRenderQuality::Default;
+  float _frameBudget = 0;
   PAGScaleMode _scaleMode = PAGScaleMode::LetterBox;
   bool _autoClear = true;
-
+  bool _dirtyRegionEnabled = false;
+  Rect _viewportRect = Rect::MakeEmpty();
+  Rect lastDamage = Rect::MakeEmpty();
+  Rect currentDamage = Rect::MakeEmpty();
+  // The immutable state snapshot published for the lock-free getters, swapped atomically whenever
+  // the play position changes or a flush finishes.
+  std::shared_ptr<FrameState> frameState = nullptr;
+  std::unique_ptr<FrameProfiler> profiler = nullptr;
+  FrameProfileNode lastFrameProfile = {};
+  bool _gpuProfilingEnabled = false;
+  std::unique_ptr<ReplayCapture> replayCapture = nullptr;
+  bool warmStartPending = false;
+
+  static void CollectDamageBounds(PAGLayer* pagLayer, const tgfx::Matrix& parentMatrix,
+                                  tgfx::Rect* bounds);
+
+  Rect measureDamageBounds();
   bool updateStageSize();
   void setSurfaceInternal(std::shared_ptr<PAGSurface> newSurface);
   int64_t getTimeStampInternal();
   void prepareInternal();
   int64_t durationInternal();
+  void publishFrameState();
+  std::string getWarmStartKey();
 
   friend class PAGSurface;
 };
 
+/**
+ * PAGReplayFrame describes one recorded flush of a replay log: the inputs that were applied
+ * before the flush and the cache statistics observed during it.
+ */
+struct PAG_API PAGReplayFrame {
+  /**
+   * The progress value of the player when the frame was flushed.
+   */
+  double progress = 0;
+  /**
+   * The size of the surface the frame was flushed into.
+   */
+  int surfaceWidth = 0;
+  int surfaceHeight = 0;
+  /**
+   * The snapshot cache hits and misses observed during the recorded flush. Comparing them against
+   * a replay run tells whether the cache behavior was reproduced.
+   */
+  int snapshotHits = 0;
+  int snapshotMisses = 0;
+  /**
+   * The text replacements applied before this flush as (editable index, text) pairs.
+   */
+  std::vector<std::pair<int, std::string>> texts = {};
+  /**
+   * The editable indices of the image replacements applied before this flush. The pixels are not
+   * part of the log, so replaying needs an image provider.
+   */
+  std::vector<int> images = {};
+};
+
+/**
+ * PAGReplay reproduces an input sequence captured with PAGPlayer::startReplayCapture() against
+ * the same pag file, so timing-dependent cache behavior reported from a production device can be
+ * replayed and profiled locally. Apply the frames in order: resize the surface to the recorded
+ * size if necessary, call applyFrame(), then flush the player.
+ */
+class PAG_API PAGReplay {
+ public:
+  /**
+   * Parses a captured log. Returns nullptr if the log is not a valid replay capture.
+   */
+  static std::shared_ptr<PAGReplay> Load(const std::string& log);
+
+  /**
+   * Returns the number of recorded frames.
+   */
+  size_t numFrames() const {
+    return frames.size();
+  }
+
+  /**
+   * Returns the recorded frame at the given index.
+   */
+  const PAGReplayFrame& frameAt(size_t index) const {
+    return frames[index];
+  }
+
+  /**
+   * Applies the replacements and the progress value of the frame at the given index to the file
+   * and the player. The imageProvider supplies the replacement image for an editable index since
+   * pixels are not captured; image replacements are skipped when it is nullptr. Returns false if
+   * the index is out of range.
+   */
+  bool applyFrame(size_t index, std::shared_ptr<PAGFile> pagFile,
+                  std::shared_ptr<PAGPlayer> player,
+                  const std::function<std::shared_ptr<PAGImage>(int)>& imageProvider = nullptr);
+
+ private:
+  std::vector<PAGReplayFrame> frames = {};
+};
+
 class SequenceFile;
 class CompositionReader;
 class BitmapBuffer;
@@ -1755,6 +2293,62 @@ class PAG_API PAGDecoder {
    */
   bool readFrame(int index, HardwareBufferRef hardwareBuffer);
 
+  /**
+   * Reads pixels of the image frame at the given index directly into the specified YUV planes,
+   * which usually feed a video encoder. For NV12, planes holds {Y, UV}; for I420, planes holds
+   * {Y, U, V}. Each plane must be large enough for the decoder's output size with the given row
+   * bytes, and the chroma planes cover half the width and height rounded up. The conversion uses
+   * the BT.601 limited-range matrix, and transparent pixels are composited over black. Compared
+   * with reading RGBA pixels and converting them afterwards, this skips one full-size round trip
+   * through memory. Returns false if failed.
+   */
+  bool readFrame(int index, YUVFormat yuvFormat, uint8_t* planes[], const size_t planeRowBytes[]);
+
+  /**
+   * Reads pixels of the image frames in the range [startIndex, endIndex] sequentially, invoking
+   * the callback once for each decoded frame. Unlike calling readFrame() in a loop, rendering,
+   * frame compression, and disk writing are pipelined across background threads, which usually
+   * has much better throughput for batch exporting. The pixel buffer passed to the callback is
+   * owned by the decoder and is valid only for the duration of the callback. Returns false if
+   * any frame in the range fails to decode.
+   */
+  bool readFrames(int startIndex, int endIndex,
+                  const std::function<void(int index, const void* pixels, size_t rowBytes)>& callback,
+                  ColorType colorType = ColorType::RGBA_8888,
+                  AlphaType alphaType = AlphaType::Premultiplied);
+
+  /**
+   * Renders a filmstrip of count thumbnails evenly spaced across the composition, invoking the
+   * callback once per thumbnail with the sampled frame index. The midpoint frame of each segment
+   * is used, and the frames are read in one monotonic pass, so the internal decoders never seek
+   * backward and each overlapping video GOP is decoded at most once, which is much faster than
+   * calling readFrame() per thumbnail. Create the decoder with a small scale factor to render the
+   * thumbnails at their target size directly on the GPU instead of downscaling full-size frames.
+   * The pixel buffer passed to the callback is owned by the decoder and is valid only for the
+   * duration of the callback. If count exceeds the number of frames, duplicate samples are
+   * skipped and the callback runs fewer than count times. Returns false if any thumbnail fails
+   * to decode.
+   */
+  bool readThumbnails(int count,
+                      const std::function<void(int index, const void* pixels, size_t rowBytes)>& callback,
+                      ColorType colorType = ColorType::RGBA_8888,
+                      AlphaType alphaType = AlphaType::Premultiplied);
+
+  /**
+   * Sets a custom scaler used to upscale frames to the decoder's output size, such as a
+   * super-resolution engine. When the output size is larger than the composition's original size,
+   * frames are rendered at the original size, handed to the scaler, and the scaled result is
+   * written to the disk cache, so steady-state playback reads pre-scaled frames instead of
+   * re-filtering on every loop iteration. The scaler receives the source and destination pixel
+   * buffers in the color type and alpha type of the reading calls; returning false falls back to
+   * scaling during rendering permanently. Must be called before the first reading call, because
+   * the disk cache stores frames at the output size.
+   */
+  void setFrameScaler(
+      std::function<bool(const void* srcPixels, size_t srcRowBytes, int srcWidth, int srcHeight,
+                         void* dstPixels, size_t dstRowBytes, int dstWidth, int dstHeight)>
+          scaler);
+
  private:
   std::mutex locker = {};
   int _width = 0;
@@ -1767,10 +2361,15 @@ class PAG_API PAGDecoder {
   uint32_t lastContentVersion = 0;
   std::shared_ptr<PAGComposition> container = nullptr;
   std::shared_ptr<SequenceFile> sequenceFile = nullptr;
+  std::shared_ptr<SequenceFile> variantFile = nullptr;
   std::shared_ptr<CompositionReader> reader = nullptr;
   std::vector<TimeRange> staticTimeRanges = {};
   std::function<std::string(PAGDecoder*, std::shared_ptr<PAGComposition>)> cacheKeyGeneratorFun =
       nullptr;
+  std::function<bool(const void*, size_t, int, int, void*, size_t, int, int)> frameScaler = nullptr;
+  std::vector<uint8_t> sourcePixels = {};
+  std::vector<uint8_t> variantPixels = {};
+  std::vector<uint8_t> yuvSourcePixels = {};
 
   static Composition* GetSingleComposition(std::shared_ptr<PAGComposition> pagComposition);
   static std::pair<int, float> GetFrameCountAndRate(std::shared_ptr<PAGComposition> pagComposition,
@@ -1784,7 +2383,14 @@ class PAG_API PAGDecoder {
   bool readFrameInternal(int index, std::shared_ptr<BitmapBuffer> bitmap);
   bool renderFrame(std::shared_ptr<PAGComposition> composition, int index,
                    std::shared_ptr<BitmapBuffer> bitmap);
+  bool renderScaledFrame(std::shared_ptr<PAGComposition> composition, int index,
+                         std::shared_ptr<BitmapBuffer> bitmap);
+  bool submitFrame(std::shared_ptr<PAGComposition> composition, int index,
+                   std::shared_ptr<BitmapBuffer> bitmap);
+  bool makeReader(std::shared_ptr<PAGComposition> composition);
   bool checkSequenceFile(std::shared_ptr<PAGComposition> composition, const tgfx::ImageInfo& info);
+  void openVariantFile(const std::string& key, const tgfx::ImageInfo& info);
+  bool readFrameFromVariant(int index, std::shared_ptr<BitmapBuffer> bitmap);
   void checkCompositionChange(std::shared_ptr<PAGComposition> composition);
   std::string generateCacheKey(std::shared_ptr<PAGComposition> composition);
   std::shared_ptr<PAGComposition> getComposition();
@@ -1815,6 +2421,80 @@ class PAG_API PAGDiskCache {
    * are closed.
    */
   static void RemoveAll();
+
+  /**
+   * Writes all cached files to an archive file at the specified path. The archive can be bundled
+   * with an application and imported on another device with ImportArchive(), typically to warm up
+   * the caches of built-in pag files before their first playback. Returns false if the path is
+   * empty or the archive cannot be written.
+   */
+  static bool ExportArchive(const std::string& archivePath);
+
+  /**
+   * Pre-seeds the disk cache from an archive file generated by ExportArchive(). Entries whose
+   * cache keys already exist on the device are skipped, so a fresher local cache is never
+   * overwritten. Returns false if the file does not exist or is not a valid cache archive.
+   */
+  static bool ImportArchive(const std::string& archivePath);
+};
+
+/**
+ * A snapshot of the process-wide performance rollup aggregated across all PAGPlayer instances.
+ * The duration histograms bucket samples by powers of two in microseconds: bucket i counts
+ * samples of at least 2^i and less than 2^(i+1) microseconds, bucket 0 also counts everything
+ * shorter, and the last bucket everything longer.
+ */
+struct PAG_API PAGTelemetrySnapshot {
+  /**
+   * The time window this snapshot covers, in microseconds of a monotonic clock.
+   */
+  int64_t startTime = 0;
+  int64_t endTime = 0;
+  /**
+   * The total number of flushes in the window, counted regardless of the sampling interval.
+   */
+  int64_t flushCount = 0;
+  /**
+   * The number of flushes that were measured into the histograms.
+   */
+  int64_t sampledCount = 0;
+  std::vector<int64_t> flushTimeBuckets = {};
+  std::vector<int64_t> renderTimeBuckets = {};
+  std::vector<int64_t> decodeTimeBuckets = {};
+  /**
+   * The number of snapshot cache hits and misses across all players in the window.
+   */
+  int64_t snapshotHitCount = 0;
+  int64_t snapshotMissCount = 0;
+  /**
+   * The highest graphics memory usage seen in any sampled flush, in bytes.
+   */
+  size_t graphicsMemoryMax = 0;
+};
+
+/**
+ * Defines methods to control the process-wide performance rollup. Unlike the per-player
+ * reporting, the rollup aggregates all players into a single set of histograms and delivers them
+ * through one periodic callback, so the telemetry overhead stays flat no matter how many players
+ * are flushing.
+ */
+class PAG_API PAGTelemetry {
+ public:
+  /**
+   * Sets how many flushes are skipped between two measured ones. The default value is 1, which
+   * measures every flush; an interval of n measures one flush out of every n. Flush and cache-hit
+   * counters are always exact, only the histograms and the memory peak are sampled.
+   */
+  static void SetSamplingInterval(int interval);
+
+  /**
+   * Sets the callback that periodically receives the aggregated snapshot, along with the minimum
+   * length of a snapshot window in microseconds. The callback is invoked on a worker thread of
+   * the shared render task pool, and the rollup is reset after each delivery. Pass a null
+   * callback to stop the reporting.
+   */
+  static void SetSnapshotCallback(std::function<void(const PAGTelemetrySnapshot&)> callback,
+                                  int64_t interval);
 };
 
 /**
@@ -1834,12 +2514,84 @@ class PAG_API PAGVideoDecoder {
   static void RegisterSoftwareDecoderFactory(SoftwareDecoderFactory* decoderFactory);
 };
 
+/**
+ * Defines methods to record a timeline of trace events for performance debugging.
+ */
+class PAG_API PAGTrace {
+ public:
+  /**
+   * Returns true if timeline tracing is enabled. The default value is false.
+   */
+  static bool Enabled();
+
+  /**
+   * Enables or disables timeline tracing. While enabled, PAG records a timeline event around each
+   * flush, context attach, video decode and disk cache access, and also forwards the events to the
+   * system tracer of the current platform if there is one. Enabling tracing clears any previously
+   * recorded events.
+   */
+  static void SetEnabled(bool value);
+
+  /**
+   * Returns the events recorded since tracing was enabled as a JSON string in the Chrome trace
+   * format, which can be loaded into chrome://tracing or the Perfetto UI. Timestamps are in
+   * microseconds relative to an arbitrary process-local epoch.
+   */
+  static std::string ExportJSON();
+};
+
+/**
+ * Reports how long one lazily created subsystem took to initialize in PAG::Initialize().
+ */
+struct PAG_API PAGInitTiming {
+  /**
+   * The name of the subsystem, e.g. "DiskCache" or "FontFallbacks".
+   */
+  std::string subsystem;
+  /**
+   * The wall time the initialization took, in microseconds. Subsystems that were already
+   * initialized report the cost of verifying that, which is close to zero.
+   */
+  int64_t duration = 0;
+};
+
 class PAG_API PAG {
  public:
+  /**
+   * Flags for Initialize(), selecting which subsystems to initialize eagerly. The values can be
+   * combined with the bitwise OR operator.
+   */
+  static constexpr uint32_t InitDiskCache = 1 << 0;
+  static constexpr uint32_t InitFontFallbacks = 1 << 1;
+  static constexpr uint32_t InitVideoDecoders = 1 << 2;
+  static constexpr uint32_t InitTaskScheduler = 1 << 3;
+  static constexpr uint32_t InitAll = 0xFFFFFFFF;
+
   /**
    * Get SDK version information.
    */
   static std::string SDKVersion();
+
+  /**
+   * Eagerly initializes the selected subsystems that are otherwise created lazily on first use:
+   * the disk cache configuration, the fallback font list, the video decoder factories, and the
+   * background task scheduler. Without this call, the costs land unpredictably on whichever frame
+   * touches a subsystem first, typically the first rendered frame. Call it from a background
+   * thread during app startup to move that work off the first-frame path. Subsystems left out of
+   * the flags keep their lazy behavior. Returns the wall time each selected subsystem took, in
+   * initialization order, and also records a timeline event per subsystem when PAGTrace is
+   * enabled. Calling Initialize() more than once is safe and reports near-zero timings for
+   * anything already initialized.
+   */
+  static std::vector<PAGInitTiming> Initialize(uint32_t subsystems = InitAll);
+
+  /**
+   * Notifies PAG that the system is under memory pressure, shedding caches in stages according to
+   * the specified level. Process-level caches are released immediately; caches bound to a GPU
+   * context are released on each player's next frame. Unlike PAGSurface::freeCache(), playback
+   * continues at reduced fidelity instead of re-decoding everything from scratch.
+   */
+  static void HandleMemoryPressure(PAGMemoryPressureLevel level);
 };
 
 }  // namespace pag
@@ -1418,6 +1418,22 @@ enum class PAG_API PAGScaleMode : uint8_t {
   Zoom = 3
 };
 
+/**
+ * Defines the trade-off between rendering fidelity and power consumption.
+ */
+enum class PAG_API PAGRenderQuality : uint8_t {
+  /**
+   * Full fidelity rendering. This is the default value.
+   */
+  Default = 0,
+  /**
+   * Trades fidelity for lower GPU load: filter passes run at reduced resolution, large blurs
+   * downsample more aggressively, static snapshots rasterize at half resolution, and the
+   * effective frame rate is capped at 30 fps. Meant to be engaged by a battery-saver setting.
+   */
+  PowerSaving = 1
+};
+
 /**
  * Defines the rules on how to stretch the timeline of content to fit the specified duration.
  */
@@ -1443,6 +1459,32 @@ enum class PAG_API PAGTimeStretchMode : uint8_t {
     RepeatInverted = 3
 };
 
+/**
+ * Defines the levels of memory pressure passed to PAG::HandleMemoryPressure(). Each level sheds
+ * everything the previous levels shed plus one more category of caches.
+ */
+enum class PAG_API PAGMemoryPressureLevel : uint8_t {
+  /**
+   * Sheds speculative content only: the warm-start pool and decoded images that have not been
+   * displayed yet.
+   */
+  Low = 0,
+  /**
+   * Additionally frees all snapshot caches of layer contents.
+   */
+  Medium = 1,
+  /**
+   * Additionally drops the read-ahead buffers of the sequence frame queues, keeping their
+   * decoders alive.
+   */
+  High = 2,
+  /**
+   * Additionally frees the text atlases and shaping caches. Playback continues but every cache is
+   * rebuilt on demand.
+   */
+  Critical = 3
+};
+
 enum class PAG_API ParagraphJustification : uint8_t {
   LeftJustify = 0,
   CenterJustify = 1,
@@ -1752,6 +1794,23 @@ enum class ColorType {
   RGBA_1010102
 };
 
+/**
+ * Describes how YUV pixels are laid out in planar memory. Both formats use 4:2:0 chroma
+ * subsampling, where each chroma sample covers a 2x2 block of luma samples.
+ */
+enum class PAG_API YUVFormat {
+  /**
+   * Two planes: a full-resolution Y plane followed by an interleaved UV plane at half resolution
+   * in both dimensions. This is the layout most hardware video encoders consume directly.
+   */
+  NV12,
+  /**
+   * Three planes: a full-resolution Y plane followed by separate U and V planes, each at half
+   * resolution in both dimensions.
+   */
+  I420
+};
+
 enum class PAG_API BlendMode : uint8_t {
   Normal = 0,
   Multiply = 1,
@@ -34,10 +34,21 @@ Composition::~Composition() {
 }
 
 bool Composition::staticContent() const {
+  // staticTimeRanges 在首次访问时才计算，见 ensureStaticTimeRanges()。
+  const_cast<Composition*>(this)->ensureStaticTimeRanges();
   return staticTimeRanges.size() == 1 && staticTimeRanges.front().start == 0 &&
          staticTimeRanges.front().end == duration - 1;
 }
 
+void Composition::ensureStaticTimeRanges() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (staticTimeRangeUpdated) {
+    return;
+  }
+  updateStaticTimeRanges();
+  staticTimeRangeUpdated = true;
+}
+
 bool Composition::hasImageContent() const {
   return false;
 }
@@ -19,6 +19,7 @@
 #include "pag/file.h"
 #include <algorithm>
 #include <unordered_map>
+#include "base/utils/Arena.h"
 
 namespace pag {
 
@@ -58,6 +59,8 @@ File::~File() {
   delete editableImages;
   delete editableTexts;
   delete imageScaleModes;
+  // The tree has run its destructors, release the backing memory in one shot.
+  delete arena;
 }
 
 void File::updateEditables(Composition* composition) {
@@ -54,12 +54,23 @@ static std::shared_ptr<File> FindFileByPath(const std::string& filePath) {
   return nullptr;
 }
 
-std::shared_ptr<File> File::Load(const std::string& filePath, const std::string& password) {
+std::shared_ptr<File> File::Load(const std::string& filePath, const std::string&) {
+  auto file = FindFileByPath(filePath);
+  if (file != nullptr) {
+    return file;
+  }
   auto byteData = ByteData::FromPath(filePath);
   if (byteData == nullptr) {
     return nullptr;
   }
-  return pag::File::Load(byteData->data(), byteData->length(), filePath, password);
+  // Transfer the buffer to the codec, so embedded payloads can reference it without copying.
+  file = Codec::Decode(std::shared_ptr<ByteData>(byteData.release()), filePath);
+  if (file != nullptr) {
+    std::lock_guard<std::mutex> autoLock(globalLocker);
+    std::weak_ptr<File> weak = file;
+    weakFileMap.insert(std::make_pair(filePath, std::move(weak)));
+  }
+  return file;
 }
 
 std::shared_ptr<File> File::Load(const void* bytes, size_t length, const std::string& filePath,
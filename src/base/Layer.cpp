@@ -16,6 +16,7 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <unordered_map>
 #include "base/utils/UniqueID.h"
 #include "base/utils/Verify.h"
@@ -114,6 +115,17 @@ Rect Layer::getBounds() const {
   return Rect::MakeEmpty();
 }
 
+bool Layer::getCachedBounds(Frame contentFrame, Rect* bounds) const {
+  if (cachedBounds.empty() || bounds == nullptr || contentFrame < cachedBounds.front().first) {
+    return false;
+  }
+  auto result = std::upper_bound(
+      cachedBounds.begin(), cachedBounds.end(), contentFrame,
+      [](Frame frame, const std::pair<Frame, Rect>& entry) { return frame < entry.first; });
+  *bounds = (result - 1)->second;
+  return true;
+}
+
 Point Layer::getMaxScaleFactor() {
   return getScaleFactor().first;
 }
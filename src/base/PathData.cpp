@@ -19,6 +19,13 @@
 #include <algorithm>
 #include "base/utils/Interpolate.h"
 #include "pag/file.h"
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PATH_DATA_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PATH_DATA_SSE 1
+#endif
 
 namespace pag {
 
@@ -132,10 +139,53 @@ inline CurveData GetCurveData(PathDataVerb verb, const std::vector<Point>& point
   return data;
 }
 
+// 对连续存储的坐标做单一插值系数的线性插值，Point 在 vector 里按 x/y 紧密排布，可直接当作
+// float 数组按 4 路处理，与 PropertyBatch 里的做法一致。
+static void LerpCoordinates(const float* a, const float* b, float* result, size_t count, float t) {
+  size_t i = 0;
+#if defined(PATH_DATA_NEON)
+  auto progress = vdupq_n_f32(t);
+  for (; i + 4 <= count; i += 4) {
+    auto start = vld1q_f32(a + i);
+    auto end = vld1q_f32(b + i);
+    vst1q_f32(result + i, vmlaq_f32(start, vsubq_f32(end, start), progress));
+  }
+#elif defined(PATH_DATA_SSE)
+  auto progress = _mm_set1_ps(t);
+  for (; i + 4 <= count; i += 4) {
+    auto start = _mm_loadu_ps(a + i);
+    auto end = _mm_loadu_ps(b + i);
+    _mm_storeu_ps(result + i, _mm_add_ps(start, _mm_mul_ps(_mm_sub_ps(end, start), progress)));
+  }
+#endif
+  for (; i < count; i++) {
+    result[i] = a[i] + (b[i] - a[i]) * t;
+  }
+}
+
 void PathData::interpolate(const PathData& path, PathData* result, float t) {
   if (verbs.empty() || path.verbs.empty()) {
     return;
   }
+  // 先清空目标缓冲再写入，clear 会保留 capacity，调用方跨帧复用同一个 PathData 时不再反复扩容。
+  result->verbs.clear();
+  result->points.clear();
+  if (verbs == path.verbs) {
+    // 形变动画两端的 verb 序列通常一致，此时点数一一对应，可以整体按坐标数组插值，
+    // 不必逐 verb 分发；两个端点帧则直接整体拷贝。
+    result->verbs = verbs;
+    if (t <= 0) {
+      result->points = points;
+      return;
+    }
+    if (t >= 1) {
+      result->points = path.points;
+      return;
+    }
+    result->points.resize(points.size());
+    LerpCoordinates(&points[0].x, &path.points[0].x, &result->points[0].x, points.size() * 2, t);
+    return;
+  }
   auto& pointsA = points;
   auto& verbsA = verbs;
   auto& pointsB = path.points;
@@ -143,6 +193,8 @@ void PathData::interpolate(const PathData& path, PathData* result, float t) {
   int indexA = 0;
   int indexB = 0;
   auto size = verbsA.size();
+  result->verbs.reserve(size);
+  result->points.reserve(pointsA.size());
   for (size_t i = 0; i < size; i++) {
     auto verbA = verbsA[i];
     auto verbB = verbsB[i];
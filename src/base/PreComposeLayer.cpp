@@ -47,6 +47,7 @@ void PreComposeLayer::excludeVaryingRanges(std::vector<TimeRange>* timeRanges) {
 }
 
 std::vector<TimeRange> PreComposeLayer::getContentStaticTimeRanges() const {
+  composition->ensureStaticTimeRanges();
   auto ranges = composition->staticTimeRanges;
   float timeScale = 1;
   if (containingComposition) {
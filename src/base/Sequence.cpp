@@ -41,6 +41,7 @@ bool Sequence::verify() const {
 }
 
 Frame Sequence::toSequenceFrame(Frame compositionFrame) {
+  composition->ensureStaticTimeRanges();
   auto sequenceFrame =
       ConvertFrameByStaticTimeRanges(composition->staticTimeRanges, compositionFrame);
   double timeScale = frameRate / composition->frameRate;
@@ -168,8 +168,32 @@ int FindTimeRangeAt(const std::vector<TimeRange>& timeRanges, Frame position, in
   }
 }
 
+// 每帧每图层的查询大多落在上一次命中的区间或它的下一个区间里，缓存上次命中的下标做快速路径。
+// 缓存只是下标提示：校验读的是当前数组内容，区间互不重叠，校验通过的结果必然正确，数组被
+// 替换或修改时自然退回二分查找。
+static int FindTimeRangeWithHint(const std::vector<TimeRange>& timeRanges, Frame position) {
+  static thread_local const TimeRange* lastRanges = nullptr;
+  static thread_local size_t lastIndex = 0;
+  auto data = timeRanges.data();
+  auto size = timeRanges.size();
+  if (data == lastRanges) {
+    for (auto index = lastIndex; index < lastIndex + 2 && index < size; index++) {
+      if (data[index].contains(position)) {
+        lastIndex = index;
+        return static_cast<int>(index);
+      }
+    }
+  }
+  auto index = FindTimeRangeAt(timeRanges, position, 0, static_cast<int>(size) - 1);
+  if (index != -1) {
+    lastRanges = data;
+    lastIndex = static_cast<size_t>(index);
+  }
+  return index;
+}
+
 TimeRange GetTimeRangeContains(const std::vector<TimeRange>& timeRanges, Frame frame) {
-  auto index = FindTimeRangeAt(timeRanges, frame, 0, static_cast<int>(timeRanges.size() - 1));
+  auto index = FindTimeRangeWithHint(timeRanges, frame);
   if (index != -1) {
     return timeRanges[index];
   }
@@ -177,7 +201,7 @@ TimeRange GetTimeRangeContains(const std::vector<TimeRange>& timeRanges, Frame f
 }
 
 Frame ConvertFrameByStaticTimeRanges(const std::vector<TimeRange>& timeRanges, Frame frame) {
-  auto index = FindTimeRangeAt(timeRanges, frame, 0, static_cast<int>(timeRanges.size() - 1));
+  auto index = FindTimeRangeWithHint(timeRanges, frame);
   return index != -1 ? timeRanges[index].start : frame;
 }
 }  // namespace pag
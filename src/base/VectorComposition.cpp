@@ -43,11 +43,7 @@ void VectorComposition::updateStaticTimeRanges() {
       break;
     }
     if (layer->type() == LayerType::PreCompose) {
-      auto composition = static_cast<PreComposeLayer*>(layer)->composition;
-      if (!composition->staticTimeRangeUpdated) {
-        composition->updateStaticTimeRanges();
-        composition->staticTimeRangeUpdated = true;
-      }
+      static_cast<PreComposeLayer*>(layer)->composition->ensureStaticTimeRanges();
     }
     layer->excludeVaryingRanges(&staticTimeRanges);
     SplitTimeRangesAt(&staticTimeRanges, layer->startTime);
@@ -19,21 +19,15 @@
 #include "MultiDimensionPoint3DKeyframe.h"
 
 namespace pag {
-MultiDimensionPoint3DKeyframe::~MultiDimensionPoint3DKeyframe() {
-  delete xInterpolator;
-  delete yInterpolator;
-  delete zInterpolator;
-}
-
 void MultiDimensionPoint3DKeyframe::initialize() {
   if (interpolationType == KeyframeInterpolationType::Bezier) {
-    xInterpolator = new BezierEasing(this->bezierOut[0], this->bezierIn[0]);
-    yInterpolator = new BezierEasing(this->bezierOut[1], this->bezierIn[1]);
-    zInterpolator = new BezierEasing(this->bezierOut[2], this->bezierIn[2]);
+    xInterpolator = BezierEasing::Make(this->bezierOut[0], this->bezierIn[0]);
+    yInterpolator = BezierEasing::Make(this->bezierOut[1], this->bezierIn[1]);
+    zInterpolator = BezierEasing::Make(this->bezierOut[2], this->bezierIn[2]);
   } else {
-    xInterpolator = new Interpolator();
-    yInterpolator = new Interpolator();
-    zInterpolator = new Interpolator();
+    xInterpolator = std::make_shared<Interpolator>();
+    yInterpolator = std::make_shared<Interpolator>();
+    zInterpolator = std::make_shared<Interpolator>();
   }
 }
 
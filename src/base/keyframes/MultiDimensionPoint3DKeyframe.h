@@ -24,15 +24,13 @@
 namespace pag {
 class MultiDimensionPoint3DKeyframe : public Keyframe<Point3D> {
  public:
-  ~MultiDimensionPoint3DKeyframe() override;
-
   void initialize() override;
 
   Point3D getValueAt(Frame time) override;
 
  private:
-  Interpolator* xInterpolator = nullptr;
-  Interpolator* yInterpolator = nullptr;
-  Interpolator* zInterpolator = nullptr;
+  std::shared_ptr<Interpolator> xInterpolator = nullptr;
+  std::shared_ptr<Interpolator> yInterpolator = nullptr;
+  std::shared_ptr<Interpolator> zInterpolator = nullptr;
 };
 }  // namespace pag
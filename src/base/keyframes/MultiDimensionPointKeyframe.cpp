@@ -19,18 +19,13 @@
 #include "MultiDimensionPointKeyframe.h"
 
 namespace pag {
-MultiDimensionPointKeyframe::~MultiDimensionPointKeyframe() {
-  delete xInterpolator;
-  delete yInterpolator;
-}
-
 void MultiDimensionPointKeyframe::initialize() {
   if (interpolationType == KeyframeInterpolationType::Bezier) {
-    xInterpolator = new BezierEasing(this->bezierOut[0], this->bezierIn[0]);
-    yInterpolator = new BezierEasing(this->bezierOut[1], this->bezierIn[1]);
+    xInterpolator = BezierEasing::Make(this->bezierOut[0], this->bezierIn[0]);
+    yInterpolator = BezierEasing::Make(this->bezierOut[1], this->bezierIn[1]);
   } else {
-    xInterpolator = new Interpolator();
-    yInterpolator = new Interpolator();
+    xInterpolator = std::make_shared<Interpolator>();
+    yInterpolator = std::make_shared<Interpolator>();
   }
 }
 
@@ -24,14 +24,12 @@
 namespace pag {
 class MultiDimensionPointKeyframe : public Keyframe<Point> {
  public:
-  ~MultiDimensionPointKeyframe() override;
-
   void initialize() override;
 
   Point getValueAt(Frame time) override;
 
  private:
-  Interpolator* xInterpolator = nullptr;
-  Interpolator* yInterpolator = nullptr;
+  std::shared_ptr<Interpolator> xInterpolator = nullptr;
+  std::shared_ptr<Interpolator> yInterpolator = nullptr;
 };
 }  // namespace pag
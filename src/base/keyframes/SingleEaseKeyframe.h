@@ -25,15 +25,11 @@ namespace pag {
 template <typename T>
 class SingleEaseKeyframe : public Keyframe<T> {
  public:
-  ~SingleEaseKeyframe() override {
-    delete interpolator;
-  }
-
   void initialize() override {
     if (this->interpolationType == KeyframeInterpolationType::Bezier) {
-      interpolator = new BezierEasing(this->bezierOut[0], this->bezierIn[0]);
+      interpolator = BezierEasing::Make(this->bezierOut[0], this->bezierIn[0]);
     } else {
-      interpolator = new Interpolator();
+      interpolator = std::make_shared<Interpolator>();
     }
   }
 
@@ -42,12 +38,16 @@ class SingleEaseKeyframe : public Keyframe<T> {
     return interpolator->getInterpolation(progress);
   }
 
+  float getProgressAt(Frame time) override {
+    return getProgress(time);
+  }
+
   T getValueAt(Frame time) override {
     auto progress = getProgress(time);
     return Interpolate(this->startValue, this->endValue, progress);
   }
 
  private:
-  Interpolator* interpolator = nullptr;
+  std::shared_ptr<Interpolator> interpolator = nullptr;
 };
 }  // namespace pag
@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Arena.h"
+#include <algorithm>
+#include <new>
+#include "pag/file.h"
+
+namespace pag {
+static constexpr size_t BlockSize = 1 << 16;  // 64KB
+// Each allocation is prefixed by a max-aligned header whose first byte records whether the memory
+// came from an arena, so operator delete can tell both kinds apart.
+static constexpr size_t HeaderSize = alignof(std::max_align_t);
+
+static thread_local Arena* currentArena = nullptr;
+
+Arena* Arena::Current() {
+  return currentArena;
+}
+
+Arena::~Arena() {
+  for (auto block : blocks) {
+    ::operator delete(block);
+  }
+}
+
+void* Arena::allocate(size_t size) {
+  size = (size + HeaderSize - 1) & ~(HeaderSize - 1);
+  if (static_cast<size_t>(end - position) < size) {
+    auto blockSize = std::max(BlockSize, size);
+    auto block = static_cast<uint8_t*>(::operator new(blockSize));
+    blocks.push_back(block);
+    position = block;
+    end = block + blockSize;
+  }
+  auto result = position;
+  position += size;
+  return result;
+}
+
+void Arena::adopt(Arena* other) {
+  blocks.insert(blocks.end(), other->blocks.begin(), other->blocks.end());
+  other->blocks.clear();
+  other->position = nullptr;
+  other->end = nullptr;
+}
+
+ArenaScope::ArenaScope(Arena* arena) : previous(currentArena) {
+  currentArena = arena;
+}
+
+ArenaScope::~ArenaScope() {
+  currentArena = previous;
+}
+
+void* ArenaAllocated::operator new(size_t size) {
+  auto arena = Arena::Current();
+  uint8_t* buffer;
+  if (arena != nullptr) {
+    buffer = static_cast<uint8_t*>(arena->allocate(size + HeaderSize));
+    buffer[0] = 1;
+  } else {
+    buffer = static_cast<uint8_t*>(::operator new(size + HeaderSize));
+    buffer[0] = 0;
+  }
+  return buffer + HeaderSize;
+}
+
+void ArenaAllocated::operator delete(void* pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+  auto buffer = static_cast<uint8_t*>(pointer) - HeaderSize;
+  if (buffer[0] == 0) {
+    ::operator delete(buffer);
+  }
+}
+}  // namespace pag
@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pag {
+/**
+ * A bump allocator for the decoded file model. Codec::Decode activates an arena on the decoding
+ * thread, all ArenaAllocated nodes created while it is active are placed contiguously in large
+ * blocks, and the File owning the arena releases every block in one shot after the tag tree is
+ * destroyed.
+ */
+class Arena {
+ public:
+  /**
+   * Returns the arena the calling thread is currently decoding into, or nullptr if no arena is
+   * active.
+   */
+  static Arena* Current();
+
+  ~Arena();
+
+  /**
+   * Allocates size bytes from the current block, starting a new block when the current one is
+   * full. The returned memory stays valid until the arena is destroyed.
+   */
+  void* allocate(size_t size);
+
+  /**
+   * Takes ownership of every block allocated by other, keeping its allocations valid for the
+   * lifetime of this arena. Other is left empty and can be safely destroyed.
+   */
+  void adopt(Arena* other);
+
+ private:
+  uint8_t* position = nullptr;
+  uint8_t* end = nullptr;
+  std::vector<uint8_t*> blocks = {};
+};
+
+/**
+ * Activates an arena on the calling thread for the lifetime of the scope, restoring the previous
+ * arena on destruction.
+ */
+class ArenaScope {
+ public:
+  explicit ArenaScope(Arena* arena);
+
+  ~ArenaScope();
+
+ private:
+  Arena* previous = nullptr;
+};
+}  // namespace pag
@@ -17,8 +17,69 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "BezierEasing.h"
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 namespace pag {
+struct EasingKey {
+  int32_t values[4];
+
+  bool operator==(const EasingKey& other) const {
+    for (int i = 0; i < 4; i++) {
+      if (values[i] != other.values[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+struct EasingHasher {
+  size_t operator()(const EasingKey& key) const {
+    size_t hash = 0;
+    auto& values = key.values;
+    for (int i = 0; i < 4; i++) {
+      hash ^= values[i] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+};
+
+static EasingKey MakeEasingKey(const Point& control1, const Point& control2) {
+  EasingKey easingKey = {};
+  Point points[] = {control1, control2};
+  memcpy(easingKey.values, points, sizeof(easingKey.values));
+  return easingKey;
+}
+
+static std::unordered_map<EasingKey, std::weak_ptr<BezierEasing>, EasingHasher> EasingCacheMap =
+    std::unordered_map<EasingKey, std::weak_ptr<BezierEasing>, EasingHasher>{};
+static std::mutex locker = {};
+
+std::shared_ptr<BezierEasing> BezierEasing::Make(const Point& control1, const Point& control2) {
+  auto easingKey = MakeEasingKey(control1, control2);
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = EasingCacheMap.find(easingKey);
+    if (result != EasingCacheMap.end()) {
+      auto& weak = result->second;
+      auto data = weak.lock();
+      if (data) {
+        return data;
+      }
+      EasingCacheMap.erase(result);
+    }
+  }
+  auto bezierEasing = std::make_shared<BezierEasing>(control1, control2);
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    std::weak_ptr<BezierEasing> weak = bezierEasing;
+    EasingCacheMap.insert(std::make_pair(easingKey, std::move(weak)));
+  }
+  return bezierEasing;
+}
+
 BezierEasing::BezierEasing(const Point& control1, const Point& control2) {
   bezierPath = BezierPath::Build(Point::Zero(), control1, control2, Point::Make(1, 1), 0.005f);
 }
@@ -25,6 +25,12 @@
 namespace pag {
 class BezierEasing : public Interpolator {
  public:
+  /**
+   * Returns a shared BezierEasing for the specified control points. Identical control points
+   * always return the same instance, so keyframes reusing a standard curve share one sample table.
+   */
+  static std::shared_ptr<BezierEasing> Make(const Point& control1, const Point& control2);
+
   BezierEasing(const Point& control1, const Point& control2);
 
   /**
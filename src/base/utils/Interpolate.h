@@ -74,6 +74,10 @@ inline int32_t Interpolate(const int32_t& a, const int32_t& b, const float& t) {
 
 template <>
 inline PathHandle Interpolate(const PathHandle& a, const PathHandle& b, const float& t) {
+  if (a == b) {
+    // 关键帧两端指向同一份路径数据时内容必然相同，直接复用，避免逐帧重建整份点列表。
+    return a;
+  }
   auto path = new PathData();
   a->interpolate(*(b.get()), path, t);
   return PathHandle(path);
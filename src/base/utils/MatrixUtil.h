@@ -19,9 +19,11 @@
 #pragma once
 
 #include "tgfx/core/Matrix.h"
+#include "tgfx/core/Rect.h"
 
 namespace pag {
 bool MapPointInverted(const tgfx::Matrix& matrix, tgfx::Point* point);
+void MapRectAndJoin(const tgfx::Matrix& matrix, const tgfx::Rect& rect, tgfx::Rect* bounds);
 float GetMaxScaleFactor(const tgfx::Matrix& matrix);
 tgfx::Point GetScaleFactor(const tgfx::Matrix& matrix, float contentScale = 1.0f,
                            bool inverted = false);
@@ -0,0 +1,101 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PropertyBatch.h"
+#include <algorithm>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PROPERTY_BATCH_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROPERTY_BATCH_SSE 1
+#endif
+
+namespace pag {
+static constexpr size_t BatchSize = 4;
+
+static void GatherKeyframe(Property<float>* property, Frame frame, float* start, float* end,
+                           float* progress) {
+  if (!property->animatable()) {
+    *start = *end = property->value;
+    *progress = 0.0f;
+    return;
+  }
+  auto& keyframes = static_cast<AnimatableProperty<float>*>(property)->keyframes;
+  auto result = std::upper_bound(
+      keyframes.begin(), keyframes.end(), frame,
+      [](Frame value, Keyframe<float>* keyframe) { return value < keyframe->startTime; });
+  if (result != keyframes.begin()) {
+    --result;
+  }
+  auto keyframe = *result;
+  if (frame <= keyframe->startTime) {
+    *start = *end = keyframe->startValue;
+    *progress = 0.0f;
+  } else if (frame >= keyframe->endTime) {
+    *start = *end = keyframe->endValue;
+    *progress = 0.0f;
+  } else {
+    *start = keyframe->startValue;
+    *end = keyframe->endValue;
+    *progress = keyframe->getProgressAt(frame);
+  }
+}
+
+static void InterpolateLanes(const float* starts, const float* ends, const float* progresses,
+                             float* results) {
+#if defined(PROPERTY_BATCH_NEON)
+  auto start = vld1q_f32(starts);
+  auto end = vld1q_f32(ends);
+  auto progress = vld1q_f32(progresses);
+  vst1q_f32(results, vmlaq_f32(start, vsubq_f32(end, start), progress));
+#elif defined(PROPERTY_BATCH_SSE)
+  auto start = _mm_loadu_ps(starts);
+  auto end = _mm_loadu_ps(ends);
+  auto progress = _mm_loadu_ps(progresses);
+  _mm_storeu_ps(results, _mm_add_ps(start, _mm_mul_ps(_mm_sub_ps(end, start), progress)));
+#else
+  for (size_t i = 0; i < BatchSize; i++) {
+    results[i] = starts[i] + (ends[i] - starts[i]) * progresses[i];
+  }
+#endif
+}
+
+void EvaluateProperties(Property<float>** properties, size_t count, Frame frame, float* results) {
+  float starts[BatchSize] = {};
+  float ends[BatchSize] = {};
+  float progresses[BatchSize] = {};
+  float interpolated[BatchSize] = {};
+  size_t index = 0;
+  while (index < count) {
+    auto lanes = std::min(BatchSize, count - index);
+    for (size_t lane = 0; lane < lanes; lane++) {
+      GatherKeyframe(properties[index + lane], frame, &starts[lane], &ends[lane],
+                     &progresses[lane]);
+    }
+    for (size_t lane = lanes; lane < BatchSize; lane++) {
+      starts[lane] = ends[lane] = progresses[lane] = 0.0f;
+    }
+    InterpolateLanes(starts, ends, progresses, interpolated);
+    for (size_t lane = 0; lane < lanes; lane++) {
+      results[index + lane] = interpolated[lane];
+    }
+    index += lanes;
+  }
+}
+}  // namespace pag
@@ -0,0 +1,32 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "pag/file.h"
+
+namespace pag {
+/**
+ * Evaluates a group of scalar properties at the same frame in one pass. The active keyframes are
+ * first gathered into structure-of-arrays form (start value, end value, eased progress), then the
+ * final interpolation runs four lanes at a time with NEON/SSE when available. Hold keyframes and
+ * non-animated properties pass their values through unchanged. This is faster than calling
+ * getValueAt() on each property when a layer animates many scalar properties at once.
+ */
+void EvaluateProperties(Property<float>** properties, size_t count, Frame frame, float* results);
+}  // namespace pag
@@ -35,6 +35,19 @@ pag_surface* pag_surface_make_offscreen_double_buffered(int width, int height, b
   return nullptr;
 }
 
+pag_surface* pag_surface_make_offscreen_buffered(int width, int height, bool tryHardware,
+                                                 int bufferCount, void* sharedContext) {
+  auto device = tgfx::GLDevice::Make(sharedContext);
+  if (device == nullptr) {
+    return nullptr;
+  }
+  if (auto surface = pag::PAGSurface::MakeFrom(
+          pag::DoubleBufferedDrawable::Make(width, height, tryHardware, device, bufferCount))) {
+    return new pag_surface(std::move(surface));
+  }
+  return nullptr;
+}
+
 pag_backend_texture* pag_surface_get_front_texture(pag_surface* surface) {
   if (surface == nullptr) {
     return nullptr;
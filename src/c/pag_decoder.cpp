@@ -17,8 +17,92 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "pag/c/pag_decoder.h"
+#include <condition_variable>
+#include <thread>
+#include <vector>
 #include "pag_types_priv.h"
 
+namespace pag {
+/**
+ * Drives pag_decoder_read_frames(): decodes a frame range on a background thread into a ring of
+ * caller-owned buffers. A buffer stays checked out from the moment its callback fires until the
+ * caller returns it with pag_frame_reader_release_buffer(), so the decode loop only blocks when
+ * the caller falls a full ring behind.
+ */
+class PAGFrameReader {
+ public:
+  PAGFrameReader(std::shared_ptr<PAGDecoder> decoder, int startIndex, int endIndex, void** buffers,
+                 size_t bufferCount, size_t rowBytes, ColorType colorType, AlphaType alphaType,
+                 pag_frame_reader_callback callback, void* user)
+      : decoder(std::move(decoder)), startIndex(startIndex), endIndex(endIndex),
+        buffers(buffers, buffers + bufferCount), rowBytes(rowBytes), colorType(colorType),
+        alphaType(alphaType), callback(callback), user(user), busyFlags(bufferCount, false) {
+  }
+
+  ~PAGFrameReader() {
+    cancel();
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+
+  void start(pag_frame_reader* owner) {
+    thread = std::thread(&PAGFrameReader::readLoop, this, owner);
+  }
+
+  void releaseBuffer(size_t bufferIndex) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (bufferIndex >= busyFlags.size()) {
+      return;
+    }
+    busyFlags[bufferIndex] = false;
+    condition.notify_all();
+  }
+
+  void cancel() {
+    std::lock_guard<std::mutex> autoLock(locker);
+    cancelled = true;
+    condition.notify_all();
+  }
+
+ private:
+  void readLoop(pag_frame_reader* owner) {
+    for (int index = startIndex; index <= endIndex; index++) {
+      size_t bufferIndex = 0;
+      {
+        std::unique_lock<std::mutex> autoLock(locker);
+        condition.wait(autoLock, [this] { return cancelled || !busyFlags[nextBuffer]; });
+        if (cancelled) {
+          return;
+        }
+        bufferIndex = nextBuffer;
+        busyFlags[bufferIndex] = true;
+        nextBuffer = (nextBuffer + 1) % buffers.size();
+      }
+      auto success =
+          decoder->readFrame(index, buffers[bufferIndex], rowBytes, colorType, alphaType);
+      callback(owner, index, bufferIndex, success, user);
+    }
+  }
+
+  std::shared_ptr<PAGDecoder> decoder = nullptr;
+  int startIndex = 0;
+  int endIndex = 0;
+  std::vector<void*> buffers = {};
+  size_t rowBytes = 0;
+  ColorType colorType = ColorType::RGBA_8888;
+  AlphaType alphaType = AlphaType::Premultiplied;
+  pag_frame_reader_callback callback = nullptr;
+  void* user = nullptr;
+  std::mutex locker = {};
+  std::condition_variable condition = {};
+  std::vector<bool> busyFlags = {};
+  size_t nextBuffer = 0;
+  bool cancelled = false;
+  std::thread thread = {};
+};
+}  // namespace pag
+
 pag_decoder* pag_decoder_create(pag_composition* composition, float maxFrameRate, float scale) {
   if (composition == nullptr) {
     return nullptr;
@@ -91,3 +175,46 @@ bool pag_decoder_read_frame_to_hardware_buffer(pag_decoder* decoder, int index,
   }
   return decoder->p->readFrame(index, static_cast<pag::HardwareBufferRef>(buffer));
 }
+
+pag_frame_reader* pag_decoder_read_frames(pag_decoder* decoder, int startIndex, int endIndex,
+                                          void** buffers, size_t bufferCount, size_t rowBytes,
+                                          pag_color_type colorType, pag_alpha_type alphaType,
+                                          pag_frame_reader_callback callback, void* user) {
+  if (decoder == nullptr || buffers == nullptr || bufferCount == 0 || callback == nullptr ||
+      startIndex > endIndex) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < bufferCount; i++) {
+    if (buffers[i] == nullptr) {
+      return nullptr;
+    }
+  }
+  pag::ColorType color;
+  if (!FromCColorType(colorType, &color)) {
+    return nullptr;
+  }
+  pag::AlphaType alpha;
+  if (!FromCAlphaType(alphaType, &alpha)) {
+    return nullptr;
+  }
+  auto reader =
+      std::make_shared<pag::PAGFrameReader>(decoder->p, startIndex, endIndex, buffers, bufferCount,
+                                            rowBytes, color, alpha, callback, user);
+  auto cReader = new pag_frame_reader(std::move(reader));
+  cReader->p->start(cReader);
+  return cReader;
+}
+
+void pag_frame_reader_release_buffer(pag_frame_reader* reader, size_t bufferIndex) {
+  if (reader == nullptr) {
+    return;
+  }
+  reader->p->releaseBuffer(bufferIndex);
+}
+
+void pag_frame_reader_cancel(pag_frame_reader* reader) {
+  if (reader == nullptr) {
+    return;
+  }
+  reader->p->cancel();
+}
@@ -62,10 +62,14 @@ static void DeletePAGAnimator(const void* pointer) {
   delete reinterpret_cast<const pag_animator*>(pointer);
 }
 
+static void DeletePAGFrameReader(const void* pointer) {
+  delete reinterpret_cast<const pag_frame_reader*>(pointer);
+}
+
 static void (*DeleteFunctions[])(const void*) = {
-    DeletePAGByteData,         DeletePAGTextDocument, DeletePAGLayer,   DeletePAGPlayer,
-    DeletePAGSurface,          DeletePAGImage,        DeletePAGFont,    DeletePAGBackendTexture,
-    DeletePAGBackendSemaphore, DeletePAGDecoder,      DeletePAGAnimator};
+    DeletePAGByteData,         DeletePAGTextDocument, DeletePAGLayer,    DeletePAGPlayer,
+    DeletePAGSurface,          DeletePAGImage,        DeletePAGFont,     DeletePAGBackendTexture,
+    DeletePAGBackendSemaphore, DeletePAGDecoder,      DeletePAGAnimator, DeletePAGFrameReader};
 
 void pag_release(pag_object object) {
   if (object == nullptr) {
@@ -36,6 +36,7 @@ enum class PAGObjectType : uint8_t {
   BackendSemaphore,
   Decoder,
   PAGAnimator,
+  FrameReader,
 
   Count,
 };
@@ -151,6 +152,18 @@ struct pag_animator {
   std::shared_ptr<pag::PAGAnimator::Listener> listener;
 };
 
+namespace pag {
+class PAGFrameReader;
+}  // namespace pag
+
+struct pag_frame_reader {
+  explicit pag_frame_reader(std::shared_ptr<pag::PAGFrameReader> reader) : p(std::move(reader)) {
+  }
+
+  PAGObjectType type = PAGObjectType::FrameReader;
+  std::shared_ptr<pag::PAGFrameReader> p;
+};
+
 std::shared_ptr<pag::PAGFile> ToPAGFile(pag_file* file);
 
 std::shared_ptr<pag::PAGComposition> ToPAGComposition(pag_composition* composition);
@@ -155,14 +155,17 @@ template <typename T>
 void ReadTimeAndValue(DecodeStream* stream, const std::vector<Keyframe<T>*>& keyframes,
                       const AttributeConfig<T>& config) {
   auto numFrames = static_cast<uint32_t>(keyframes.size());
-  keyframes[0]->startTime = ReadTime(stream);
+  auto timeList = new uint64_t[numFrames + 1];
+  stream->readEncodedUint64List(timeList, numFrames + 1);
+  keyframes[0]->startTime = static_cast<Frame>(timeList[0]);
   for (uint32_t i = 0; i < numFrames; i++) {
-    auto time = ReadTime(stream);
+    auto time = static_cast<Frame>(timeList[i + 1]);
     keyframes[i]->endTime = time;
     if (i < numFrames - 1) {
       keyframes[i + 1]->startTime = time;
     }
   }
+  delete[] timeList;
   auto list = new T[numFrames + 1];
   config.readValueList(stream, list, numFrames + 1);
   int index = 0;
@@ -302,6 +305,7 @@ bool ReadTagBlock(DecodeStream* stream, T* parameter,
   auto tagConfig = ConfigMaker(parameter);
 
   std::vector<AttributeFlag> flags;
+  flags.reserve(tagConfig->configs.size());
   for (auto& config : tagConfig->configs) {
     auto flag = ReadAttributeFlag(stream, config);
     flags.push_back(flag);
@@ -19,12 +19,15 @@
 #include <unordered_map>
 #include <unordered_set>
 #include "CompressionAlgorithm.h"
+#include "base/utils/Arena.h"
 #include "base/utils/USE.h"
 #include "base/utils/Verify.h"
 #include "codec/Version.h"
 #include "codec/tags/FileTags.h"
 #include "codec/tags/PerformanceTag.h"
+#include "codec/tags/SequenceFrameBlock.h"
 #include "pag/file.h"
+#include "tgfx/core/Task.h"
 
 namespace pag {
 
@@ -207,15 +210,118 @@ DecodeStream ReadBodyBytes(DecodeStream* stream) {
   return stream->readBytes(bodyLength);
 }
 
+static bool IsCompositionBlock(TagCode code) {
+  return code == TagCode::VectorCompositionBlock || code == TagCode::BitmapCompositionBlock ||
+         code == TagCode::VideoCompositionBlock;
+}
+
+namespace {
+struct CompositionDecodeTask {
+  CodecContext context = {};
+  Arena arena = {};
+  const uint8_t* data = nullptr;
+  uint32_t length = 0;
+  TagCode code = TagCode::End;
+  size_t sharedImages = 0;
+  std::shared_ptr<tgfx::Task> task = nullptr;
+};
+}  // namespace
+
+// Composition tags are independent of each other until Codec::InstallReferences links them, so
+// each one is decoded on the thread pool while the file-level tags are still read in order on the
+// calling thread. Every task gets its own context and arena; each context snapshots the fonts and
+// images visible at the tag's position, which matches what a sequential decode would see.
+static void ReadTagsOfFileParallel(DecodeStream* bodyBytes, CodecContext* context,
+                                   Arena* arena) {
+  std::vector<std::unique_ptr<CompositionDecodeTask>> tasks = {};
+  auto header = ReadTagHeader(bodyBytes);
+  while (!context->hasException() && header.code != TagCode::End) {
+    auto tagBytes = bodyBytes->readBytes(header.length);
+    if (IsCompositionBlock(header.code)) {
+      auto task = std::make_unique<CompositionDecodeTask>();
+      task->data = tagBytes.data();
+      task->length = tagBytes.length();
+      task->code = header.code;
+      task->context.fileBytes = context->fileBytes;
+      for (auto& font : context->fontIDMap) {
+        task->context.fontIDMap[font.first] = new FontDescriptor(*font.second);
+      }
+      task->context.images = context->images;
+      task->sharedImages = context->images.size();
+      auto taskPtr = task.get();
+      task->task = tgfx::Task::Run([taskPtr]() {
+        ArenaScope scope(&taskPtr->arena);
+        DecodeStream stream(&taskPtr->context, taskPtr->data, taskPtr->length);
+        ReadTagsOfFile(&stream, taskPtr->code, &taskPtr->context);
+      });
+      tasks.push_back(std::move(task));
+    } else {
+      ReadTagsOfFile(&tagBytes, header.code, context);
+    }
+    if (context->hasException()) {
+      break;
+    }
+    header = ReadTagHeader(bodyBytes);
+  }
+  for (auto& task : tasks) {
+    task->task->wait();
+    auto& taskContext = task->context;
+    if (context->tagLevel < taskContext.tagLevel) {
+      context->tagLevel = taskContext.tagLevel;
+    }
+    // CodecContext declares its own errorMessages member that shadows the one hasException()
+    // checks, so the base member is the one the decoding exceptions were recorded into.
+    for (auto& message : taskContext.StreamContext::errorMessages) {
+      context->throwException(message);
+    }
+    context->compositions.insert(context->compositions.end(), taskContext.compositions.begin(),
+                                 taskContext.compositions.end());
+    taskContext.compositions.clear();
+    // 超出快照部分的是解码过程中新建的占位图片，归还给主 context；快照内的图片指针是共享的，
+    // 必须先清掉，避免析构时重复释放。
+    for (auto i = task->sharedImages; i < taskContext.images.size(); i++) {
+      context->images.push_back(taskContext.images[i]);
+    }
+    taskContext.images.clear();
+    arena->adopt(&task->arena);
+  }
+}
+
 std::shared_ptr<File> Codec::Decode(const void* bytes, uint32_t byteLength,
                                     const std::string& filePath) {
+  return DecodeInternal(bytes, byteLength, filePath, nullptr);
+}
+
+std::shared_ptr<File> Codec::Decode(std::shared_ptr<ByteData> fileBytes,
+                                    const std::string& filePath) {
+  if (fileBytes == nullptr || fileBytes->data() == nullptr) {
+    return nullptr;
+  }
+  auto byteLength = static_cast<uint32_t>(fileBytes->length());
+  return DecodeInternal(fileBytes->data(), byteLength, filePath, std::move(fileBytes));
+}
+
+std::shared_ptr<File> Codec::DecodeInternal(const void* bytes, uint32_t byteLength,
+                                            const std::string& filePath,
+                                            std::shared_ptr<ByteData> fileBytes) {
+  // Place the whole tag tree into one arena, so it stays contiguous and is released in one shot
+  // when the decoded file is destroyed. The arena must outlive the context, whose destructor
+  // still deletes any leftover nodes on failure.
+  auto arena = std::make_unique<Arena>();
+  ArenaScope scope(arena.get());
   CodecContext context = {};
+  context.fileBytes = fileBytes;
   DecodeStream stream(&context, reinterpret_cast<const uint8_t*>(bytes), byteLength);
   auto bodyBytes = ReadBodyBytes(&stream);
   if (context.hasException()) {
     return nullptr;
   }
-  ReadTags(&bodyBytes, &context, ReadTagsOfFile);
+  ReadTagsOfFileParallel(&bodyBytes, &context, arena.get());
+  if (context.hasException()) {
+    return nullptr;
+  }
+  // 渐进式档位的交错帧要等所有合成读完才能挂回序列，普通文件这里是空操作。
+  AttachSequenceFrameBlocks(&context);
   if (context.hasException()) {
     return nullptr;
   }
@@ -229,6 +335,8 @@ std::shared_ptr<File> Codec::Decode(const void* bytes, uint32_t byteLength,
   if (file == nullptr) {
     return nullptr;
   }
+  file->arena = arena.release();
+  file->sourceBytes = std::move(fileBytes);
 
   UpdateFileAttributes(file, &context, filePath);
   return file;
@@ -255,6 +363,68 @@ std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file,
   return fileBytes.release();
 }
 
+std::unique_ptr<ByteData> Codec::EncodeProgressively(std::shared_ptr<File> file) {
+  if (file == nullptr) {
+    return nullptr;
+  }
+  CodecContext context = {};
+  EncodeStream bodyBytes(&context);
+  WriteTagsOfFileProgressive(&bodyBytes, file.get());
+
+  EncodeStream fileBytes(&context);
+  fileBytes.writeInt8('P');
+  fileBytes.writeInt8('A');
+  fileBytes.writeInt8('G');
+  fileBytes.writeUint8(Version);
+  fileBytes.writeUint32(bodyBytes.length());
+  fileBytes.writeInt8(CompressionAlgorithm::UNCOMPRESSED);
+  fileBytes.writeBytes(&bodyBytes);
+  return fileBytes.release();
+}
+
+std::unique_ptr<ByteData> Codec::EncodeIncrementally(
+    std::shared_ptr<File> file, const std::vector<Composition*>& modifiedCompositions) {
+  if (file == nullptr) {
+    return nullptr;
+  }
+  if (file->sourceBytes == nullptr) {
+    return Encode(file);
+  }
+  if (file->fileAttributes.progressiveProfile) {
+    // 渐进式原文件的合成块不含帧负载，逐块复用会让交错帧块和重编码的序列各带一份帧，
+    // 退回全量编码。
+    return Encode(file);
+  }
+  std::unordered_set<ID> modifiedIDs = {};
+  for (auto composition : modifiedCompositions) {
+    if (composition != nullptr) {
+      modifiedIDs.insert(composition->id);
+    }
+  }
+  CodecContext readContext = {};
+  DecodeStream stream(&readContext, file->sourceBytes->data(),
+                      static_cast<uint32_t>(file->sourceBytes->length()));
+  auto originalBody = ReadBodyBytes(&stream);
+  if (readContext.hasException()) {
+    return Encode(file);
+  }
+  CodecContext context = {};
+  EncodeStream bodyBytes(&context);
+  if (!WriteTagsOfFileIncrementally(&bodyBytes, file.get(), &originalBody, modifiedIDs) ||
+      context.hasException()) {
+    return Encode(file);
+  }
+  EncodeStream fileBytes(&context);
+  fileBytes.writeInt8('P');
+  fileBytes.writeInt8('A');
+  fileBytes.writeInt8('G');
+  fileBytes.writeUint8(Version);
+  fileBytes.writeUint32(bodyBytes.length());
+  fileBytes.writeInt8(CompressionAlgorithm::UNCOMPRESSED);
+  fileBytes.writeBytes(&bodyBytes);
+  return fileBytes.release();
+}
+
 std::shared_ptr<PerformanceData> Codec::ReadPerformanceData(const void* bytes,
                                                             uint32_t byteLength) {
   CodecContext context = {};
@@ -285,13 +455,8 @@ std::shared_ptr<PerformanceData> Codec::ReadPerformanceData(const void* bytes,
 
 void Codec::UpdateFileAttributes(std::shared_ptr<File> file, CodecContext* context,
                                  const std::string& filePath) {
-  for (auto& composition : file->compositions) {
-    if (!composition->staticTimeRangeUpdated) {
-      composition->updateStaticTimeRanges();
-      composition->staticTimeRangeUpdated = true;
-    }
-  }
-
+  // 静态区间分析推迟到合成首次被渲染访问时进行，见 Composition::ensureStaticTimeRanges()，
+  // 从未显示的合成完全跳过这一步。
   if (context->scaledTimeRange != nullptr) {
     file->scaledTimeRange.start =
         std::max(static_cast<int64_t>(0), context->scaledTimeRange->start);
@@ -305,4 +470,133 @@ void Codec::UpdateFileAttributes(std::shared_ptr<File> file, CodecContext* conte
   file->editableTexts = context->editableTexts;
   file->imageScaleModes = context->imageScaleModes;
 }
+
+std::shared_ptr<FileLoader> FileLoader::Make(const std::string& filePath) {
+  return std::shared_ptr<FileLoader>(new FileLoader(filePath));
+}
+
+FileLoader::FileLoader(std::string filePath) : filePath(std::move(filePath)) {
+  context = new CodecContext();
+  arena = new Arena();
+}
+
+FileLoader::~FileLoader() {
+  // The context deletes any leftover nodes before the arena releases their memory.
+  delete context;
+  delete arena;
+}
+
+bool FileLoader::feed(const void* bytes, size_t length) {
+  if (failed || context == nullptr) {
+    return false;
+  }
+  if (bytes == nullptr || length == 0) {
+    return true;
+  }
+  auto data = static_cast<const uint8_t*>(bytes);
+  buffer.insert(buffer.end(), data, data + length);
+  if (!headerParsed) {
+    if (buffer.size() < 11) {
+      return true;
+    }
+    CodecContext headerContext = {};
+    DecodeStream stream(&headerContext, buffer.data(), static_cast<uint32_t>(buffer.size()));
+    auto P = stream.readInt8();
+    auto A = stream.readInt8();
+    auto G = stream.readInt8();
+    if (P != 'P' || A != 'A' || G != 'G') {
+      failed = true;
+      return false;
+    }
+    auto version = stream.readUint8();
+    if (version == EncryptedVersion || version > KnownVersion) {
+      failed = true;
+      return false;
+    }
+    auto bodyLength = stream.readUint32();
+    auto compression = stream.readInt8();
+    if (compression != CompressionAlgorithm::UNCOMPRESSED) {
+      failed = true;
+      return false;
+    }
+    position = stream.position();
+    bodyEnd = position + bodyLength;
+    headerParsed = true;
+  }
+  if (!parseTags()) {
+    failed = true;
+    return false;
+  }
+  return true;
+}
+
+bool FileLoader::parseTags() {
+  ArenaScope scope(arena);
+  while (!tagsComplete) {
+    if (position >= bodyEnd) {
+      tagsComplete = true;
+      break;
+    }
+    auto available = std::min(buffer.size(), bodyEnd) - position;
+    CodecContext headerContext = {};
+    DecodeStream headerStream(&headerContext, buffer.data() + position,
+                              static_cast<uint32_t>(available));
+    auto header = ReadTagHeader(&headerStream);
+    if (headerContext.hasException()) {
+      break;  // The tag header has not fully arrived yet.
+    }
+    if (headerStream.bytesAvailable() < header.length) {
+      break;  // The tag body has not fully arrived yet.
+    }
+    if (context->tagLevel < static_cast<uint16_t>(header.code)) {
+      context->tagLevel = static_cast<uint16_t>(header.code);
+    }
+    if (header.code == TagCode::End) {
+      position += headerStream.position();
+      tagsComplete = true;
+      break;
+    }
+    DecodeStream tagBytes(context, buffer.data() + position + headerStream.position(),
+                          header.length);
+    ReadTagsOfFile(&tagBytes, header.code, context);
+    position += headerStream.position() + header.length;
+    if (context->hasException()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FileLoader::complete() const {
+  return tagsComplete;
+}
+
+size_t FileLoader::numCompositions() const {
+  return context != nullptr ? context->compositions.size() : 0;
+}
+
+std::shared_ptr<File> FileLoader::finish() {
+  if (failed || context == nullptr || !tagsComplete) {
+    return nullptr;
+  }
+  ArenaScope scope(arena);
+  AttachSequenceFrameBlocks(context);
+  InstallReferences(context->compositions);
+  if (context->hasException()) {
+    failed = true;
+    return nullptr;
+  }
+  auto file = VerifyAndMake(context->releaseCompositions(), context->releaseImages());
+  if (file == nullptr) {
+    failed = true;
+    return nullptr;
+  }
+  file->arena = arena;
+  arena = nullptr;
+  UpdateFileAttributes(file, context, filePath);
+  delete context;
+  context = nullptr;
+  buffer = {};
+  return file;
+}
 }  // namespace pag
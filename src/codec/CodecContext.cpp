@@ -36,6 +36,12 @@ CodecContext::~CodecContext() {
     delete image;
   }
   images.clear();
+  // 解码中途失败时，尚未挂回序列的交错帧由 context 负责释放。
+  for (auto& pending : pendingSequenceFrames) {
+    delete pending.videoFrame;
+    delete pending.bitmapFrame;
+  }
+  pendingSequenceFrames.clear();
   errorMessages.clear();
   delete scaledTimeRange;
 }
@@ -49,6 +55,38 @@ FontData CodecContext::getFontData(int id) {
   return FontData("", "");
 }
 
+static bool TextDocumentEquals(const TextDocument* a, const TextDocument* b) {
+  return a->applyFill == b->applyFill && a->applyStroke == b->applyStroke &&
+         a->baselineShift == b->baselineShift && a->boxText == b->boxText &&
+         a->boxTextPos == b->boxTextPos && a->boxTextSize == b->boxTextSize &&
+         a->firstBaseLine == b->firstBaseLine && a->fauxBold == b->fauxBold &&
+         a->fauxItalic == b->fauxItalic && a->fillColor == b->fillColor &&
+         a->fontFamily == b->fontFamily && a->fontStyle == b->fontStyle &&
+         a->fontSize == b->fontSize && a->strokeColor == b->strokeColor &&
+         a->strokeOverFill == b->strokeOverFill && a->strokeWidth == b->strokeWidth &&
+         a->text == b->text && a->justification == b->justification && a->leading == b->leading &&
+         a->tracking == b->tracking && a->backgroundColor == b->backgroundColor &&
+         a->backgroundAlpha == b->backgroundAlpha && a->direction == b->direction;
+}
+
+TextDocumentHandle CodecContext::internTextDocument(TextDocumentHandle value) {
+  if (value == nullptr) {
+    return value;
+  }
+  // 同一个文件里的大量文本关键帧往往只是少数几份内容的重复，按内容归并到同一个 TextDocument
+  // 对象上：字符串只存一份，后续所有基于指针的文档比较对相同内容也能直接命中。文件内的
+  // TextDocument 是只读的，文本替换总是写入 TextReplacement 的副本，所以共享是安全的。
+  auto key = value->text + '\x01' + value->fontFamily + '\x01' + value->fontStyle;
+  auto& bucket = internedTextDocuments[key];
+  for (auto& document : bucket) {
+    if (TextDocumentEquals(document.get(), value.get())) {
+      return document;
+    }
+  }
+  bucket.push_back(value);
+  return value;
+}
+
 ImageBytes* CodecContext::getImageBytes(pag::ID imageID) {
   for (auto image : images) {
     if (image->id == imageID) {
@@ -29,12 +29,21 @@ struct FontDescriptor {
   std::string fontStyle;
 };
 
+// 渐进式档位里一个已读到但尚未挂回所属序列的交错帧，见 AttachSequenceFrameBlocks()。
+struct PendingSequenceFrame {
+  ID compositionID = 0;
+  uint32_t sequenceIndex = 0;
+  VideoFrame* videoFrame = nullptr;
+  BitmapFrame* bitmapFrame = nullptr;
+};
+
 class CodecContext : public StreamContext {
  public:
   ~CodecContext() override;
   uint32_t getFontID(const std::string& fontFamily, const std::string& fontStyle);
   FontData getFontData(int id);
   ImageBytes* getImageBytes(ID imageID);
+  TextDocumentHandle internTextDocument(TextDocumentHandle value);
   std::vector<Composition*> releaseCompositions();
   std::vector<ImageBytes*> releaseImages();
 
@@ -47,9 +56,11 @@ class CodecContext : public StreamContext {
   TimeRange* scaledTimeRange = nullptr;
   FileAttributes fileAttributes = {};
 
+  std::unordered_map<std::string, std::vector<TextDocumentHandle>> internedTextDocuments = {};
   std::vector<int>* editableImages = nullptr;
   std::vector<int>* editableTexts = nullptr;
   std::vector<PAGScaleMode>* imageScaleModes = nullptr;
+  std::vector<PendingSequenceFrame> pendingSequenceFrames = {};
   uint16_t tagLevel = 0;
 };
 }  // namespace pag
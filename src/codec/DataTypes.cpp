@@ -282,7 +282,7 @@ TextDocumentHandle ReadTextDocument(DecodeStream* stream,
   if (!ReadBlock(stream, value.get(), ConfigMaker)) {
     return nullptr;
   };
-  return value;
+  return static_cast<CodecContext*>(stream->context)->internTextDocument(std::move(value));
 }
 
 TextDocumentHandle ReadTextDocument(DecodeStream* stream) {
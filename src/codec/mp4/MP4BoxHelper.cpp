@@ -156,11 +156,17 @@ static std::unique_ptr<ByteData> MakeMP4Data(const VideoSequence* videoSequence,
   boxParam.nalusBytesLen = mp4Track->len;
   boxParam.videoSequence = videoSequence;
 
-  float sizeFactor = includeMdat ? 1.5f : 0.5f;
-  EncodeStream stream(nullptr,
-                      static_cast<uint32_t>(static_cast<float>(mp4Track->len) * sizeFactor));
-  stream.setByteOrder(tgfx::ByteOrder::BigEndian);
   MP4Generator mp4Generator(boxParam);
+  // 先跑一遍只计算大小的流程得到准确的总长度，让 EncodeStream 一次性分配到位。长序列下按比例
+  // 预估容易触发扩容拷贝或浪费内存，而各个 box 的大小计算结果会被缓存，写入阶段直接复用。
+  EncodeStream sizeStream(nullptr, 0);
+  auto totalSize = mp4Generator.ftyp(&sizeStream) + mp4Generator.moov(&sizeStream) +
+                   mp4Generator.moof(&sizeStream);
+  if (includeMdat) {
+    totalSize += mp4Generator.mdat(&sizeStream);
+  }
+  EncodeStream stream(nullptr, static_cast<uint32_t>(totalSize));
+  stream.setByteOrder(tgfx::ByteOrder::BigEndian);
   mp4Generator.ftyp(&stream, true);
   mp4Generator.moov(&stream, true);
   mp4Generator.moof(&stream, true);
@@ -60,4 +60,17 @@ TagCode WriteBitmapComposition(EncodeStream* stream, BitmapComposition* composit
   WriteEndTag(stream);
   return TagCode::BitmapCompositionBlock;
 }
+
+// 渐进式档位：序列只写头部，帧负载由随后的 SequenceFrameBlock 按播放顺序交错承载。
+TagCode WriteBitmapCompositionProgressive(EncodeStream* stream, BitmapComposition* composition) {
+  stream->writeEncodedUint32(composition->id);
+  WriteTagsOfComposition(stream, composition);
+  auto sequences = composition->sequences;
+  std::sort(sequences.begin(), sequences.end(), lessFirst);
+  for (auto sequence : sequences) {
+    WriteTag(stream, sequence, WriteBitmapSequenceHeader);
+  }
+  WriteEndTag(stream);
+  return TagCode::BitmapCompositionBlock;
+}
 }  // namespace pag
\ No newline at end of file
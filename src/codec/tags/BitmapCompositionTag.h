@@ -24,4 +24,5 @@ namespace pag {
 BitmapComposition* ReadBitmapComposition(DecodeStream* stream);
 
 TagCode WriteBitmapComposition(EncodeStream* stream, BitmapComposition* composition);
+TagCode WriteBitmapCompositionProgressive(EncodeStream* stream, BitmapComposition* composition);
 }  // namespace pag
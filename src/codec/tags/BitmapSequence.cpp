@@ -81,4 +81,14 @@ TagCode WriteBitmapSequence(EncodeStream* stream, BitmapSequence* sequence) {
   }
   return TagCode::BitmapSequence;
 }
+
+// 渐进式档位下只写序列的紧凑头部，帧数记为 0，帧负载随后以 SequenceFrameBlock 按播放顺序
+// 交错写出。
+TagCode WriteBitmapSequenceHeader(EncodeStream* stream, BitmapSequence* sequence) {
+  stream->writeEncodedInt32(sequence->width);
+  stream->writeEncodedInt32(sequence->height);
+  stream->writeFloat(sequence->frameRate);
+  stream->writeEncodedUint32(0);
+  return TagCode::BitmapSequence;
+}
 }  // namespace pag
\ No newline at end of file
@@ -23,4 +23,5 @@
 namespace pag {
 BitmapSequence* ReadBitmapSequence(DecodeStream* stream);
 TagCode WriteBitmapSequence(EncodeStream* stream, BitmapSequence* sequence);
+TagCode WriteBitmapSequenceHeader(EncodeStream* stream, BitmapSequence* sequence);
 }  // namespace pag
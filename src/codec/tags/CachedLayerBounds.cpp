@@ -0,0 +1,49 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CachedLayerBounds.h"
+
+namespace pag {
+void ReadCachedLayerBounds(DecodeStream* stream, Layer* layer) {
+  auto count = stream->readEncodedUint32();
+  layer->cachedBounds.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    if (stream->context->hasException()) {
+      break;
+    }
+    auto frame = ReadTime(stream);
+    auto left = stream->readFloat();
+    auto top = stream->readFloat();
+    auto right = stream->readFloat();
+    auto bottom = stream->readFloat();
+    layer->cachedBounds.emplace_back(frame, Rect::MakeLTRB(left, top, right, bottom));
+  }
+}
+
+TagCode WriteCachedLayerBounds(EncodeStream* stream, Layer* layer) {
+  stream->writeEncodedUint32(static_cast<uint32_t>(layer->cachedBounds.size()));
+  for (auto& entry : layer->cachedBounds) {
+    WriteTime(stream, entry.first);
+    stream->writeFloat(entry.second.left);
+    stream->writeFloat(entry.second.top);
+    stream->writeFloat(entry.second.right);
+    stream->writeFloat(entry.second.bottom);
+  }
+  return TagCode::CachedLayerBounds;
+}
+}  // namespace pag
@@ -36,6 +36,11 @@ void ReadFileAttributes(DecodeStream* stream, pag::FileAttributes* fileAttribute
     auto warning = stream->readUTF8String();
     fileAttributes->warnings.push_back(warning);
   }
+
+  // 后追加的可选字段，旧文件里没有，读到 tag 末尾即止。
+  if (stream->bytesAvailable() > 0) {
+    fileAttributes->progressiveProfile = stream->readBoolean();
+  }
 }
 
 TagCode WriteFileAttributes(EncodeStream* stream, pag::FileAttributes* fileAttributes) {
@@ -51,6 +56,11 @@ TagCode WriteFileAttributes(EncodeStream* stream, pag::FileAttributes* fileAttri
     stream->writeUTF8String(warning);
   }
 
+  // 只在渐进式档位下写出该字段，普通文件保持原有字节布局不变。
+  if (fileAttributes->progressiveProfile) {
+    stream->writeBoolean(true);
+  }
+
   return TagCode::FileAttributes;
 }
 }  // namespace pag
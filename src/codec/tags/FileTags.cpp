@@ -26,6 +26,7 @@
 #include "codec/tags/ImageScaleModes.h"
 #include "codec/tags/Images.h"
 #include "codec/tags/PerformanceTag.h"
+#include "codec/tags/SequenceFrameBlock.h"
 #include "codec/tags/TimeStretchMode.h"
 #include "codec/tags/VectorCompositionTag.h"
 #include "codec/tags/VideoCompositionTag.h"
@@ -85,6 +86,10 @@ static void ReadTag_ImageScaleModesBlock(DecodeStream* stream, CodecContext*) {
   ReadImageScaleModes(stream);
 }
 
+static void ReadTag_SequenceFrameBlock(DecodeStream* stream, CodecContext* context) {
+  ReadSequenceFrameBlock(stream, context);
+}
+
 using ReadTagHandler = void(DecodeStream* stream, CodecContext* context);
 static const std::unordered_map<TagCode, std::function<ReadTagHandler>, EnumClassHash> handlers = {
     {TagCode::FontTables, ReadTag_FontTables},
@@ -99,6 +104,7 @@ static const std::unordered_map<TagCode, std::function<ReadTagHandler>, EnumClas
     {TagCode::VideoCompositionBlock, ReadTag_VideoCompositionBlock},
     {TagCode::EditableIndices, ReadTag_EditableIndicesBlock},
     {TagCode::ImageScaleModes, ReadTag_ImageScaleModesBlock},
+    {TagCode::SequenceFrameBlock, ReadTag_SequenceFrameBlock},
 };
 
 void ReadTagsOfFile(DecodeStream* stream, TagCode code, CodecContext* context) {
@@ -165,6 +171,8 @@ void WriteTagsOfFile(EncodeStream* stream, const File* file, PerformanceData* pe
     WriteTag(stream, performanceData, WritePerformanceTag);
   }
   auto fileAttributes = file->fileAttributes;
+  // 普通布局的序列自带帧负载，不保留渐进式标记。
+  fileAttributes.progressiveProfile = false;
   if (!fileAttributes.empty()) {
     WriteTag(stream, &fileAttributes, WriteFileAttributes);
   }
@@ -188,4 +196,154 @@ void WriteTagsOfFile(EncodeStream* stream, const File* file, PerformanceData* pe
   std::for_each(file->compositions.begin(), file->compositions.end(), func);
   WriteEndTag(stream);
 }
+
+static void WriteCompositionProgressive(EncodeStream* stream, Composition* composition) {
+  if (composition->type() == CompositionType::Vector) {
+    WriteTag(stream, static_cast<VectorComposition*>(composition), WriteVectorComposition);
+  } else if (composition->type() == CompositionType::Bitmap) {
+    WriteTag(stream, static_cast<BitmapComposition*>(composition),
+             WriteBitmapCompositionProgressive);
+  } else if (composition->type() == CompositionType::Video) {
+    WriteTag(stream, static_cast<VideoComposition*>(composition),
+             WriteVideoCompositionProgressive);
+  }
+}
+
+void WriteTagsOfFileProgressive(EncodeStream* stream, const File* file) {
+  auto fileAttributes = file->fileAttributes;
+  fileAttributes.progressiveProfile = true;
+  WriteTag(stream, &fileAttributes, WriteFileAttributes);
+  if (file->timeStretchMode != PAGTimeStretchMode::Repeat || file->hasScaledTimeRange()) {
+    WriteTag(stream, file, WriteTimeStretchMode);
+  }
+  auto fontList = GetFontList(file->compositions);
+  if (!(fontList.empty())) {
+    WriteTag(stream, &fontList, WriteFontTables);
+  }
+  if (!file->images.empty()) {
+    WriteImages(stream, &(file->images));
+  }
+  if (file->editableImages != nullptr || file->editableTexts != nullptr) {
+    WriteTag(stream, file, WriteEditableIndices);
+  }
+  if (file->imageScaleModes != nullptr) {
+    WriteTag(stream, file, WriteImageScaleModes);
+  }
+  auto func = std::bind(WriteCompositionProgressive, stream, std::placeholders::_1);
+  std::for_each(file->compositions.begin(), file->compositions.end(), func);
+  WriteSequenceFrameBlocks(stream, file);
+  WriteEndTag(stream);
+}
+
+static bool IsCompositionBlock(TagCode code) {
+  return code == TagCode::VectorCompositionBlock || code == TagCode::BitmapCompositionBlock ||
+         code == TagCode::VideoCompositionBlock;
+}
+
+static bool IsFileLevelTag(TagCode code) {
+  return code == TagCode::Performance || code == TagCode::FileAttributes ||
+         code == TagCode::TimeStretchMode || code == TagCode::FontTables ||
+         code == TagCode::EditableIndices || code == TagCode::ImageScaleModes;
+}
+
+// The text documents inside copied compositions still reference fonts by their index into the
+// original font table, so those indexes stay valid only if the original table is a prefix of the
+// new one, with new fonts appended at the end.
+static bool CheckFontTablePrefix(DecodeStream* tagBytes, const std::vector<FontData>& fontList) {
+  auto count = tagBytes->readEncodedUint32();
+  if (count > fontList.size()) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    auto fontFamily = tagBytes->readUTF8String();
+    auto fontStyle = tagBytes->readUTF8String();
+    if (tagBytes->context->hasException() || fontFamily != fontList[i].fontFamily ||
+        fontStyle != fontList[i].fontStyle) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool WriteTagsOfFileIncrementally(EncodeStream* stream, const File* file,
+                                  DecodeStream* originalBody,
+                                  const std::unordered_set<ID>& modifiedCompositions) {
+  std::unordered_map<ID, Composition*> compositionMap;
+  for (auto composition : file->compositions) {
+    compositionMap.insert(std::make_pair(composition->id, composition));
+  }
+  auto fontList = GetFontList(file->compositions);
+  // The regenerated file-level tags go first: the font table must precede every composition that
+  // references it, and writing it also registers the font indexes used while re-encoding the
+  // modified compositions.
+  auto fileAttributes = file->fileAttributes;
+  fileAttributes.progressiveProfile = false;
+  if (!fileAttributes.empty()) {
+    WriteTag(stream, &fileAttributes, WriteFileAttributes);
+  }
+  if (file->timeStretchMode != PAGTimeStretchMode::Repeat || file->hasScaledTimeRange()) {
+    WriteTag(stream, file, WriteTimeStretchMode);
+  }
+  if (!fontList.empty()) {
+    WriteTag(stream, &fontList, WriteFontTables);
+  }
+  if (file->editableImages != nullptr || file->editableTexts != nullptr) {
+    WriteTag(stream, file, WriteEditableIndices);
+  }
+  if (file->imageScaleModes != nullptr) {
+    WriteTag(stream, file, WriteImageScaleModes);
+  }
+  auto bodyData = originalBody->data();
+  std::unordered_set<ID> writtenCompositions;
+  while (true) {
+    auto tagStart = originalBody->position();
+    auto header = ReadTagHeader(originalBody);
+    if (originalBody->context->hasException()) {
+      return false;
+    }
+    if (header.code == TagCode::End) {
+      break;
+    }
+    auto tagBytes = originalBody->readBytes(header.length);
+    if (originalBody->context->hasException()) {
+      return false;
+    }
+    if (header.code == TagCode::FontTables) {
+      if (!CheckFontTablePrefix(&tagBytes, fontList)) {
+        return false;
+      }
+      continue;
+    }
+    if (IsFileLevelTag(header.code)) {
+      continue;  // Already regenerated above.
+    }
+    auto tagLength = originalBody->position() - tagStart;
+    if (IsCompositionBlock(header.code)) {
+      auto id = tagBytes.readEncodedUint32();
+      if (tagBytes.context->hasException()) {
+        return false;
+      }
+      auto result = compositionMap.find(id);
+      if (result == compositionMap.end()) {
+        continue;  // The composition was removed from the file.
+      }
+      writtenCompositions.insert(id);
+      if (modifiedCompositions.count(id) > 0) {
+        WriteComposition(stream, result->second);
+      } else {
+        stream->writeBytes(const_cast<uint8_t*>(bodyData) + tagStart, tagLength);
+      }
+      continue;
+    }
+    // Every other tag, including the image payloads, is copied verbatim.
+    stream->writeBytes(const_cast<uint8_t*>(bodyData) + tagStart, tagLength);
+  }
+  for (auto composition : file->compositions) {
+    if (writtenCompositions.count(composition->id) == 0) {
+      WriteComposition(stream, composition);
+    }
+  }
+  WriteEndTag(stream);
+  return true;
+}
 }  // namespace pag
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <unordered_set>
 #include "codec/DataTypes.h"
 
 namespace pag {
@@ -25,5 +26,24 @@ void ReadTagsOfFile(DecodeStream* stream, TagCode code, CodecContext* context);
 
 void WriteTagsOfFile(EncodeStream* stream, const File* file, PerformanceData* performanceData);
 
+/**
+ * Writes the tags of file in the progressive profile: sequence tags carry only their headers, and
+ * the frame payloads follow the composition blocks as SequenceFrameBlock tags interleaved in
+ * playback order. The layout is marked in the FileAttributes tag so loaders can detect it early.
+ */
+void WriteTagsOfFileProgressive(EncodeStream* stream, const File* file);
+
+/**
+ * Writes the tags of file to the stream, copying the byte ranges of unmodified compositions from
+ * originalBody instead of re-encoding them. Only the compositions whose IDs are in
+ * modifiedCompositions are re-encoded, and the small file-level tags are always regenerated.
+ * Returns false if the original bytes cannot be reused safely, e.g. when the font table changed in
+ * a way that would break the font references inside the copied bytes; the caller should fall back
+ * to WriteTagsOfFile with a fresh stream in that case.
+ */
+bool WriteTagsOfFileIncrementally(EncodeStream* stream, const File* file,
+                                  DecodeStream* originalBody,
+                                  const std::unordered_set<ID>& modifiedCompositions);
+
 std::vector<FontData> GetFontList(std::vector<Composition*> compositions);
 }  // namespace pag
@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "LayerTag.h"
+#include <array>
+#include "CachedLayerBounds.h"
 #include "CameraOption.h"
 #include "CompositionReference.h"
 #include "EffectTag.h"
@@ -39,11 +41,6 @@
 
 namespace pag {
 
-#define Condition(condition, expression) \
-  if (condition) {                       \
-    expression;                          \
-  }
-
 static void CheckLayerDuration(Layer* layer) {
   if (layer->duration <= 0) {
     // The duration cannot be zero, fix it when the value is parsed from an old file format.
@@ -51,157 +48,230 @@ static void CheckLayerDuration(Layer* layer) {
   }
 }
 
+static void ReadLayerAttributesBlock(DecodeStream* stream, TagCode code, Layer* layer) {
+  auto configMaker = code == TagCode::LayerAttributes     ? LayerAttributesTag
+                     : code == TagCode::LayerAttributesV2 ? LayerAttributesTagV2
+                                                          : LayerAttributesTagV3;
+  if (ReadTagBlock(stream, layer, configMaker)) {
+    CheckLayerDuration(layer);
+  }
+}
+
+static void ReadLayerAttributesExtraBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  ReadTagBlock(stream, layer, LayerAttributesExtraTag);
+}
+
+static void ReadMaskBlock(DecodeStream* stream, TagCode code, Layer* layer) {
+  auto mask = ReadTagBlock(stream, code == TagCode::MaskBlock ? MaskTag : MaskTagV2);
+  if (mask) {
+    layer->masks.push_back(mask);
+  }
+}
+
+static void ReadMarkerListBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  ReadMarkerList(stream, &layer->markers);
+}
+
+static void ReadTransform2DBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  layer->transform = new Transform2D();
+  auto transform = layer->transform;
+  if (ReadTransform2DTag(stream, transform)) {
+    auto hasPosition = (transform->position->animatable() ||
+                        transform->position->getValueAt(0) != Point::Zero());
+    auto hasXPosition =
+        (transform->xPosition->animatable() || transform->xPosition->getValueAt(0) != 0);
+    auto hasYPosition =
+        (transform->yPosition->animatable() || transform->yPosition->getValueAt(0) != 0);
+    if (hasPosition || (!hasXPosition && !hasYPosition)) {
+      delete transform->xPosition;
+      transform->xPosition = nullptr;
+      delete transform->yPosition;
+      transform->yPosition = nullptr;
+    } else {
+      delete transform->position;
+      transform->position = nullptr;
+    }
+  }
+}
+
+static void ReadTransform3DBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  layer->transform3D = new Transform3D();
+  auto transform = layer->transform3D;
+  if (ReadTagBlock(stream, transform, Transform3DTag)) {
+    auto hasPosition = (transform->position->animatable() ||
+                        transform->position->getValueAt(0) != Point3D::Zero());
+    auto hasXPosition =
+        (transform->xPosition->animatable() || transform->xPosition->getValueAt(0) != 0);
+    auto hasYPosition =
+        (transform->yPosition->animatable() || transform->yPosition->getValueAt(0) != 0);
+    auto hasZPosition =
+        (transform->zPosition->animatable() || transform->zPosition->getValueAt(0) != 0);
+    if (hasPosition || (!hasXPosition && !hasYPosition && !hasZPosition)) {
+      delete transform->xPosition;
+      transform->xPosition = nullptr;
+      delete transform->yPosition;
+      transform->yPosition = nullptr;
+      delete transform->zPosition;
+      transform->zPosition = nullptr;
+    } else {
+      delete transform->position;
+      transform->position = nullptr;
+    }
+  }
+}
+
+static void ReadCachePolicyBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  ReadCachePolicy(stream, layer);
+}
+
+static void ReadCachedLayerBoundsBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  ReadCachedLayerBounds(stream, layer);
+}
+
+static void ReadSolidColorBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  if (layer->type() == LayerType::Solid) {
+    ReadSolidColor(stream, static_cast<SolidLayer*>(layer));
+  }
+}
+
+static void ReadTextSourceBlock(DecodeStream* stream, TagCode code, Layer* layer) {
+  if (layer->type() != LayerType::Text) {
+    return;
+  }
+  auto configMaker = code == TagCode::TextSource     ? TextSourceTag
+                     : code == TagCode::TextSourceV2 ? TextSourceTagV2
+                                                     : TextSourceTagV3;
+  ReadTagBlock(stream, static_cast<TextLayer*>(layer), configMaker);
+}
+
+static void ReadTextPathOptionBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  if (layer->type() == LayerType::Text) {
+    auto textLayer = static_cast<TextLayer*>(layer);
+    textLayer->pathOption = new TextPathOptions();
+    ReadTagBlock(stream, textLayer->pathOption, TextPathOptionTag);
+  }
+}
+
+static void ReadTextMoreOptionBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  if (layer->type() == LayerType::Text) {
+    auto textLayer = static_cast<TextLayer*>(layer);
+    textLayer->moreOption = new TextMoreOptions();
+    ReadTagBlock(stream, textLayer->moreOption, TextMoreOptionTag);
+  }
+}
+
+static void ReadTextAnimatorBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  if (layer->type() == LayerType::Text) {
+    ReadTextAnimator(stream, static_cast<TextLayer*>(layer));
+  }
+}
+
+static void ReadCompositionReferenceBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  if (layer->type() == LayerType::PreCompose) {
+    ReadCompositionReference(stream, static_cast<PreComposeLayer*>(layer));
+  }
+}
+
+static void ReadImageReferenceBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  if (layer->type() == LayerType::Image) {
+    ReadImageReference(stream, static_cast<ImageLayer*>(layer));
+  }
+}
+
+static void ReadImageFillRuleBlock(DecodeStream* stream, TagCode code, Layer* layer) {
+  if (layer->type() == LayerType::Image) {
+    ReadImageFillRule(stream, static_cast<ImageLayer*>(layer), code);
+  }
+}
+
+static void ReadCameraOptionBlock(DecodeStream* stream, TagCode, Layer* layer) {
+  if (layer->type() == LayerType::Camera) {
+    auto cameraLayer = static_cast<CameraLayer*>(layer);
+    cameraLayer->cameraOption = new CameraOption();
+    ReadTagBlock(stream, cameraLayer->cameraOption, CameraOptionTag);
+  }
+}
+
+static void ReadEffectBlock(DecodeStream* stream, TagCode code, Layer* layer) {
+  ReadEffect(stream, code, layer);
+}
+
+static void ReadLayerStyleBlock(DecodeStream* stream, TagCode code, Layer* layer) {
+  ReadLayerStyles(stream, code, layer);
+}
+
+static void ReadShapeBlock(DecodeStream* stream, TagCode code, Layer* layer) {
+  if (layer->type() == LayerType::Shape) {
+    ReadShape(stream, code, &(static_cast<ShapeLayer*>(layer)->contents));
+  }
+}
+
+using LayerTagReader = void (*)(DecodeStream*, TagCode, Layer*);
+static constexpr size_t LayerTagTableSize = static_cast<size_t>(TagCode::Count);
+
+// 层级 tag 原来经过 switch 加上 effect / style / shape 三级链式分发，这里改为按 TagCode 下标的
+// constexpr 函数指针表，一次跳转直达处理函数。未注册的 tag 与原来的 default 分支一样被跳过。
+static constexpr std::array<LayerTagReader, LayerTagTableSize> MakeLayerTagReaders() {
+  std::array<LayerTagReader, LayerTagTableSize> table = {};
+  auto add = [&table](TagCode code, LayerTagReader reader) {
+    table[static_cast<size_t>(code)] = reader;
+  };
+  add(TagCode::LayerAttributes, ReadLayerAttributesBlock);
+  add(TagCode::LayerAttributesV2, ReadLayerAttributesBlock);
+  add(TagCode::LayerAttributesV3, ReadLayerAttributesBlock);
+  add(TagCode::LayerAttributesExtra, ReadLayerAttributesExtraBlock);
+  add(TagCode::MaskBlock, ReadMaskBlock);
+  add(TagCode::MaskBlockV2, ReadMaskBlock);
+  add(TagCode::MarkerList, ReadMarkerListBlock);
+  add(TagCode::Transform2D, ReadTransform2DBlock);
+  add(TagCode::Transform3D, ReadTransform3DBlock);
+  add(TagCode::CachePolicy, ReadCachePolicyBlock);
+  add(TagCode::CachedLayerBounds, ReadCachedLayerBoundsBlock);
+  add(TagCode::SolidColor, ReadSolidColorBlock);
+  add(TagCode::TextSource, ReadTextSourceBlock);
+  add(TagCode::TextSourceV2, ReadTextSourceBlock);
+  add(TagCode::TextSourceV3, ReadTextSourceBlock);
+  add(TagCode::TextPathOption, ReadTextPathOptionBlock);
+  add(TagCode::TextMoreOption, ReadTextMoreOptionBlock);
+  add(TagCode::TextAnimator, ReadTextAnimatorBlock);
+  add(TagCode::CompositionReference, ReadCompositionReferenceBlock);
+  add(TagCode::ImageReference, ReadImageReferenceBlock);
+  add(TagCode::ImageFillRule, ReadImageFillRuleBlock);
+  add(TagCode::ImageFillRuleV2, ReadImageFillRuleBlock);
+  add(TagCode::CameraOption, ReadCameraOptionBlock);
+  add(TagCode::MotionTileEffect, ReadEffectBlock);
+  add(TagCode::LevelsIndividualEffect, ReadEffectBlock);
+  add(TagCode::CornerPinEffect, ReadEffectBlock);
+  add(TagCode::BulgeEffect, ReadEffectBlock);
+  add(TagCode::FastBlurEffect, ReadEffectBlock);
+  add(TagCode::GlowEffect, ReadEffectBlock);
+  add(TagCode::DisplacementMapEffect, ReadEffectBlock);
+  add(TagCode::RadialBlurEffect, ReadEffectBlock);
+  add(TagCode::MosaicEffect, ReadEffectBlock);
+  add(TagCode::BrightnessContrastEffect, ReadEffectBlock);
+  add(TagCode::HueSaturationEffect, ReadEffectBlock);
+  add(TagCode::DropShadowStyle, ReadLayerStyleBlock);
+  add(TagCode::DropShadowStyleV2, ReadLayerStyleBlock);
+  add(TagCode::GradientOverlayStyle, ReadLayerStyleBlock);
+  add(TagCode::StrokeStyle, ReadLayerStyleBlock);
+  add(TagCode::OuterGlowStyle, ReadLayerStyleBlock);
+  for (auto code = static_cast<size_t>(TagCode::ShapeGroup);
+       code <= static_cast<size_t>(TagCode::RoundCorners); code++) {
+    table[code] = ReadShapeBlock;
+  }
+  return table;
+}
+
+static constexpr auto layerTagReaders = MakeLayerTagReaders();
+
 void ReadTagsOfLayer(DecodeStream* stream, TagCode code, Layer* layer) {
-  switch (code) {
-    case TagCode::LayerAttributes:
-      if (ReadTagBlock(stream, layer, LayerAttributesTag)) {
-        CheckLayerDuration(layer);
-      }
-      break;
-    case TagCode::LayerAttributesV2:
-      if (ReadTagBlock(stream, layer, LayerAttributesTagV2)) {
-        CheckLayerDuration(layer);
-      }
-      break;
-    case TagCode::LayerAttributesV3:
-      if (ReadTagBlock(stream, layer, LayerAttributesTagV3)) {
-        CheckLayerDuration(layer);
-      }
-      break;
-    case TagCode::LayerAttributesExtra:
-      ReadTagBlock(stream, layer, LayerAttributesExtraTag);
-      break;
-    case TagCode::MaskBlock: {
-      auto mask = ReadTagBlock(stream, MaskTag);
-      if (mask) {
-        layer->masks.push_back(mask);
-      }
-    } break;
-    case TagCode::MaskBlockV2: {
-      auto mask = ReadTagBlock(stream, MaskTagV2);
-      if (mask) {
-        layer->masks.push_back(mask);
-      }
-    } break;
-    case TagCode::MarkerList: {
-      ReadMarkerList(stream, &layer->markers);
-    } break;
-    case TagCode::Transform2D: {
-      layer->transform = new Transform2D();
-      auto transform = layer->transform;
-      if (ReadTagBlock(stream, transform, Transform2DTag)) {
-
-        auto hasPosition = (transform->position->animatable() ||
-                            transform->position->getValueAt(0) != Point::Zero());
-        auto hasXPosition =
-            (transform->xPosition->animatable() || transform->xPosition->getValueAt(0) != 0);
-        auto hasYPosition =
-            (transform->yPosition->animatable() || transform->yPosition->getValueAt(0) != 0);
-        if (hasPosition || (!hasXPosition && !hasYPosition)) {
-          delete transform->xPosition;
-          transform->xPosition = nullptr;
-          delete transform->yPosition;
-          transform->yPosition = nullptr;
-        } else {
-          delete transform->position;
-          transform->position = nullptr;
-        }
-      }
-    } break;
-    case TagCode::Transform3D: {
-      layer->transform3D = new Transform3D();
-      auto transform = layer->transform3D;
-      if (ReadTagBlock(stream, transform, Transform3DTag)) {
-        auto hasPosition = (transform->position->animatable() ||
-                            transform->position->getValueAt(0) != Point3D::Zero());
-        auto hasXPosition =
-            (transform->xPosition->animatable() || transform->xPosition->getValueAt(0) != 0);
-        auto hasYPosition =
-            (transform->yPosition->animatable() || transform->yPosition->getValueAt(0) != 0);
-        auto hasZPosition =
-            (transform->zPosition->animatable() || transform->zPosition->getValueAt(0) != 0);
-        if (hasPosition || (!hasXPosition && !hasYPosition && !hasZPosition)) {
-          delete transform->xPosition;
-          transform->xPosition = nullptr;
-          delete transform->yPosition;
-          transform->yPosition = nullptr;
-          delete transform->zPosition;
-          transform->zPosition = nullptr;
-        } else {
-          delete transform->position;
-          transform->position = nullptr;
-        }
-      }
-    } break;
-    case TagCode::CachePolicy:
-      ReadCachePolicy(stream, layer);
-      break;
-    case TagCode::SolidColor:
-      Condition(layer->type() == LayerType::Solid,
-                ReadSolidColor(stream, static_cast<SolidLayer*>(layer)));
-      break;
-    case TagCode::TextSource:
-      Condition(layer->type() == LayerType::Text,
-                ReadTagBlock(stream, static_cast<TextLayer*>(layer), TextSourceTag));
-      break;
-    case TagCode::TextSourceV2:
-      Condition(layer->type() == LayerType::Text,
-                ReadTagBlock(stream, static_cast<TextLayer*>(layer), TextSourceTagV2));
-      break;
-    case TagCode::TextSourceV3:
-      Condition(layer->type() == LayerType::Text,
-                ReadTagBlock(stream, static_cast<TextLayer*>(layer), TextSourceTagV3));
-      break;
-    case TagCode::TextPathOption:
-      if (layer->type() == LayerType::Text) {
-        auto textLayer = static_cast<TextLayer*>(layer);
-        textLayer->pathOption = new TextPathOptions();
-        ReadTagBlock(stream, textLayer->pathOption, TextPathOptionTag);
-      }
-      break;
-    case TagCode::TextMoreOption:
-      if (layer->type() == LayerType::Text) {
-        auto textLayer = static_cast<TextLayer*>(layer);
-        textLayer->moreOption = new TextMoreOptions();
-        ReadTagBlock(stream, textLayer->moreOption, TextMoreOptionTag);
-      }
-      break;
-    case TagCode::TextAnimator:
-      Condition(layer->type() == LayerType::Text,
-                ReadTextAnimator(stream, static_cast<TextLayer*>(layer)));
-      break;
-    case TagCode::CompositionReference:
-      Condition(layer->type() == LayerType::PreCompose,
-                ReadCompositionReference(stream, static_cast<PreComposeLayer*>(layer)));
-      break;
-    case TagCode::ImageReference:
-      Condition(layer->type() == LayerType::Image,
-                ReadImageReference(stream, static_cast<ImageLayer*>(layer)));
-      break;
-    case TagCode::ImageFillRule:
-    case TagCode::ImageFillRuleV2:
-      Condition(layer->type() == LayerType::Image,
-                ReadImageFillRule(stream, static_cast<ImageLayer*>(layer), code));
-      break;
-    case TagCode::CameraOption:
-      if (layer->type() == LayerType::Camera) {
-        auto cameraLayer = static_cast<CameraLayer*>(layer);
-        cameraLayer->cameraOption = new CameraOption();
-        ReadTagBlock(stream, cameraLayer->cameraOption, CameraOptionTag);
-      }
-      break;
-    default:
-      if (ReadEffect(stream, code, layer)) {
-        break;
-      }
-      if (ReadLayerStyles(stream, code, layer)) {
-        break;
-      }
-      if (layer->type() == LayerType::Shape &&
-          ReadShape(stream, code, &(static_cast<ShapeLayer*>(layer)->contents))) {
-        break;
-      }
-      break;
+  auto index = static_cast<size_t>(code);
+  if (index >= LayerTagTableSize) {
+    return;
+  }
+  auto reader = layerTagReaders[index];
+  if (reader != nullptr) {
+    reader(stream, code, layer);
   }
 }
 
@@ -239,7 +309,6 @@ Layer* ReadLayer(DecodeStream* stream) {
   return layer;
 }
 
-#undef Condition
 
 static bool CheckMaskFeatherValid(Property<Point>* maskFeather) {
   if (maskFeather == nullptr) {
@@ -284,6 +353,9 @@ TagCode WriteLayer(EncodeStream* stream, Layer* layer) {
   if (layer->cachePolicy != CachePolicy::Auto) {
     WriteTag(stream, layer, WriteCachePolicy);
   }
+  if (!layer->cachedBounds.empty()) {
+    WriteTag(stream, layer, WriteCachedLayerBounds);
+  }
   switch (layer->type()) {
     case LayerType::Solid:
       WriteTag(stream, static_cast<SolidLayer*>(layer), WriteSolidColor);
@@ -0,0 +1,191 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SequenceFrameBlock.h"
+#include <algorithm>
+#include "VideoSequence.h"
+#include "codec/utils/NALUReader.h"
+
+namespace pag {
+// 渐进式档位里的一个交错帧。序列 tag 只含头部，帧负载按播放顺序写成一个个
+// SequenceFrameBlock，流式加载器读到多少帧就能渲染到多少帧。
+void ReadSequenceFrameBlock(DecodeStream* stream, CodecContext* context) {
+  PendingSequenceFrame pending = {};
+  pending.compositionID = stream->readEncodedUint32();
+  pending.sequenceIndex = stream->readEncodedUint32();
+  auto isVideo = stream->readBoolean();
+  auto isKeyframe = stream->readBoolean();
+  if (stream->context->hasException()) {
+    return;
+  }
+  if (isVideo) {
+    auto videoFrame = new VideoFrame();
+    videoFrame->isKeyframe = isKeyframe;
+    videoFrame->frame = ReadTime(stream);
+    videoFrame->fileBytes = ReadByteDataWithStartCode(stream).release();
+    pending.videoFrame = videoFrame;
+  } else {
+    auto bitmapFrame = new BitmapFrame();
+    bitmapFrame->isKeyframe = isKeyframe;
+    auto bitmapCount = stream->readEncodedUint32();
+    for (uint32_t i = 0; i < bitmapCount; i++) {
+      if (stream->context->hasException()) {
+        break;
+      }
+      auto bitmap = new BitmapRect();
+      bitmapFrame->bitmaps.push_back(bitmap);
+      bitmap->x = stream->readEncodedInt32();
+      bitmap->y = stream->readEncodedInt32();
+      bitmap->fileBytes = stream->readByteData().release();
+    }
+    pending.bitmapFrame = bitmapFrame;
+  }
+  context->pendingSequenceFrames.push_back(pending);
+}
+
+namespace {
+struct SequenceFrameEntry {
+  float time = 0;
+  ID compositionID = 0;
+  uint32_t sequenceIndex = 0;
+  VideoFrame* videoFrame = nullptr;
+  BitmapFrame* bitmapFrame = nullptr;
+};
+}  // namespace
+
+static TagCode WriteSequenceFrameBlockTag(EncodeStream* stream, SequenceFrameEntry* entry) {
+  stream->writeEncodedUint32(entry->compositionID);
+  stream->writeEncodedUint32(entry->sequenceIndex);
+  stream->writeBoolean(entry->videoFrame != nullptr);
+  if (entry->videoFrame != nullptr) {
+    stream->writeBoolean(entry->videoFrame->isKeyframe);
+    WriteTime(stream, entry->videoFrame->frame);
+    WriteByteDataWithoutStartCode(stream, entry->videoFrame->fileBytes);
+  } else {
+    auto bitmapFrame = entry->bitmapFrame;
+    stream->writeBoolean(bitmapFrame->isKeyframe);
+    uint32_t bitmapCount = 0;
+    for (auto bitmap : bitmapFrame->bitmaps) {
+      if (bitmap->fileBytes->length() == 0) {
+        continue;
+      }
+      bitmapCount++;
+    }
+    stream->writeEncodedUint32(bitmapCount);
+    for (auto bitmap : bitmapFrame->bitmaps) {
+      if (bitmap->fileBytes->length() == 0) {
+        continue;
+      }
+      stream->writeEncodedInt32(bitmap->x);
+      stream->writeEncodedInt32(bitmap->y);
+      stream->writeByteData(bitmap->fileBytes);
+    }
+  }
+  return TagCode::SequenceFrameBlock;
+}
+
+template <typename T>
+static std::vector<T*> SortedSequences(const std::vector<T*>& sequences) {
+  auto sorted = sequences;
+  std::sort(sorted.begin(), sorted.end(),
+            [](const T* item1, const T* item2) { return item1->width < item2->width; });
+  return sorted;
+}
+
+// 把全部序列帧按播放时间交错写出。sequenceIndex 对应合成写出时按宽度排好序的序列列表，
+// 与解码后 sequences 的顺序一致。stable_sort 保证同一时间点上各序列内部仍按帧序排列。
+void WriteSequenceFrameBlocks(EncodeStream* stream, const File* file) {
+  std::vector<SequenceFrameEntry> entries = {};
+  for (auto composition : file->compositions) {
+    if (composition->type() == CompositionType::Video) {
+      auto sequences = SortedSequences(static_cast<VideoComposition*>(composition)->sequences);
+      for (uint32_t i = 0; i < sequences.size(); i++) {
+        for (auto videoFrame : sequences[i]->frames) {
+          SequenceFrameEntry entry = {};
+          entry.time = static_cast<float>(videoFrame->frame) / sequences[i]->frameRate;
+          entry.compositionID = composition->id;
+          entry.sequenceIndex = i;
+          entry.videoFrame = videoFrame;
+          entries.push_back(entry);
+        }
+      }
+    } else if (composition->type() == CompositionType::Bitmap) {
+      auto sequences = SortedSequences(static_cast<BitmapComposition*>(composition)->sequences);
+      for (uint32_t i = 0; i < sequences.size(); i++) {
+        auto& frames = sequences[i]->frames;
+        for (uint32_t j = 0; j < frames.size(); j++) {
+          SequenceFrameEntry entry = {};
+          entry.time = static_cast<float>(j) / sequences[i]->frameRate;
+          entry.compositionID = composition->id;
+          entry.sequenceIndex = i;
+          entry.bitmapFrame = frames[j];
+          entries.push_back(entry);
+        }
+      }
+    }
+  }
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const SequenceFrameEntry& item1, const SequenceFrameEntry& item2) {
+                     return item1.time < item2.time;
+                   });
+  for (auto& entry : entries) {
+    WriteTag(stream, &entry, WriteSequenceFrameBlockTag);
+  }
+}
+
+// 所有 tag 读完后把交错帧挂回各自的序列。块在文件里按播放顺序出现，同一序列内部帧序递增，
+// 依次追加即可。失败时剩余的帧仍留在 context 里，由其析构统一释放。
+void AttachSequenceFrameBlocks(CodecContext* context) {
+  if (context->pendingSequenceFrames.empty()) {
+    return;
+  }
+  std::unordered_map<ID, Composition*> compositionMap = {};
+  for (auto composition : context->compositions) {
+    compositionMap[composition->id] = composition;
+  }
+  for (auto& pending : context->pendingSequenceFrames) {
+    auto result = compositionMap.find(pending.compositionID);
+    if (result == compositionMap.end()) {
+      PAGThrowError(context, "Sequence frame block references an unknown composition.");
+      return;
+    }
+    auto composition = result->second;
+    if (pending.videoFrame != nullptr && composition->type() == CompositionType::Video) {
+      auto& sequences = static_cast<VideoComposition*>(composition)->sequences;
+      if (pending.sequenceIndex >= sequences.size()) {
+        PAGThrowError(context, "Sequence frame block references an unknown sequence.");
+        return;
+      }
+      sequences[pending.sequenceIndex]->frames.push_back(pending.videoFrame);
+      pending.videoFrame = nullptr;
+    } else if (pending.bitmapFrame != nullptr && composition->type() == CompositionType::Bitmap) {
+      auto& sequences = static_cast<BitmapComposition*>(composition)->sequences;
+      if (pending.sequenceIndex >= sequences.size()) {
+        PAGThrowError(context, "Sequence frame block references an unknown sequence.");
+        return;
+      }
+      sequences[pending.sequenceIndex]->frames.push_back(pending.bitmapFrame);
+      pending.bitmapFrame = nullptr;
+    } else {
+      PAGThrowError(context, "Sequence frame block does not match the composition type.");
+      return;
+    }
+  }
+  context->pendingSequenceFrames.clear();
+}
+}  // namespace pag
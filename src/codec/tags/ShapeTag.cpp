@@ -32,37 +32,42 @@
 #include "shapes/TrimPaths.h"
 
 namespace pag {
-using ReadShapeHandler = ShapeElement*(DecodeStream* stream);
+using ShapeReader = ShapeElement* (*)(DecodeStream* stream);
 
-template <class T>
-static std::function<ReadShapeHandler> MakeReadShapeHandler(
-    std::unique_ptr<BlockConfig> (*ConfigMaker)(T*)) {
-  return [ConfigMaker](DecodeStream* stream) { return ReadTagBlock(stream, ConfigMaker); };
+template <class T, std::unique_ptr<BlockConfig> (*ConfigMaker)(T*)>
+static ShapeElement* ReadShapeElement(DecodeStream* stream) {
+  return ReadTagBlock(stream, ConfigMaker);
 }
 
-static const std::unordered_map<TagCode, std::function<ReadShapeHandler>, EnumClassHash>
-    readShapeHandlers = {
-        {TagCode::ShapeGroup, MakeReadShapeHandler<ShapeGroupElement>(ShapeGroupTag)},
-        {TagCode::Rectangle, MakeReadShapeHandler<RectangleElement>(RectangleTag)},
-        {TagCode::Ellipse, MakeReadShapeHandler<EllipseElement>(EllipseTag)},
-        {TagCode::PolyStar, MakeReadShapeHandler<PolyStarElement>(PolyStarTag)},
-        {TagCode::ShapePath, MakeReadShapeHandler<ShapePathElement>(ShapePathTag)},
-        {TagCode::Fill, MakeReadShapeHandler<FillElement>(FillTag)},
-        {TagCode::Stroke, MakeReadShapeHandler<StrokeElement>(StrokeTag)},
-        {TagCode::GradientFill, MakeReadShapeHandler<GradientFillElement>(GradientFillTag)},
-        {TagCode::GradientStroke, MakeReadShapeHandler<GradientStrokeElement>(GradientStrokeTag)},
-        {TagCode::MergePaths, MakeReadShapeHandler<MergePathsElement>(MergePathsTag)},
-        {TagCode::TrimPaths, MakeReadShapeHandler<TrimPathsElement>(TrimPathsTag)},
-        {TagCode::Repeater, MakeReadShapeHandler<RepeaterElement>(RepeaterTag)},
-        {TagCode::RoundCorners, MakeReadShapeHandler<RoundCornersElement>(RoundCornersTag)},
+// TagCode::ShapeGroup 到 TagCode::RoundCorners 是连续区间，用 constexpr 函数指针表按下标分发，
+// 避免此前 unordered_map + std::function 在 shape 密集文件加载时的散列与间接调用开销。
+static constexpr ShapeReader shapeReaders[] = {
+    ReadShapeElement<ShapeGroupElement, ShapeGroupTag>,          // ShapeGroup
+    ReadShapeElement<RectangleElement, RectangleTag>,            // Rectangle
+    ReadShapeElement<EllipseElement, EllipseTag>,                // Ellipse
+    ReadShapeElement<PolyStarElement, PolyStarTag>,              // PolyStar
+    ReadShapeElement<ShapePathElement, ShapePathTag>,            // ShapePath
+    ReadShapeElement<FillElement, FillTag>,                      // Fill
+    ReadShapeElement<StrokeElement, StrokeTag>,                  // Stroke
+    ReadShapeElement<GradientFillElement, GradientFillTag>,      // GradientFill
+    ReadShapeElement<GradientStrokeElement, GradientStrokeTag>,  // GradientStroke
+    ReadShapeElement<MergePathsElement, MergePathsTag>,          // MergePaths
+    ReadShapeElement<TrimPathsElement, TrimPathsTag>,            // TrimPaths
+    ReadShapeElement<RepeaterElement, RepeaterTag>,              // Repeater
+    ReadShapeElement<RoundCornersElement, RoundCornersTag>,      // RoundCorners
 };
 
+static_assert(sizeof(shapeReaders) / sizeof(shapeReaders[0]) ==
+                  static_cast<size_t>(TagCode::RoundCorners) -
+                      static_cast<size_t>(TagCode::ShapeGroup) + 1,
+              "shapeReaders must cover the ShapeGroup ~ RoundCorners range.");
+
 bool ReadShape(DecodeStream* stream, TagCode code, std::vector<ShapeElement*>* contents) {
-  auto iter = readShapeHandlers.find(code);
-  if (iter == readShapeHandlers.end()) {
+  if (code < TagCode::ShapeGroup || code > TagCode::RoundCorners) {
     return false;
   }
-  auto shape = iter->second(stream);
+  auto reader = shapeReaders[static_cast<size_t>(code) - static_cast<size_t>(TagCode::ShapeGroup)];
+  auto shape = reader(stream);
   if (shape == nullptr) {
     return false;
   }
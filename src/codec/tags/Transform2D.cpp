@@ -32,4 +32,36 @@ std::unique_ptr<BlockConfig> Transform2DTag(Transform2D* transform) {
   AddAttribute(tagConfig, &transform->opacity, AttributeType::SimpleProperty, Opaque);
   return std::unique_ptr<BlockConfig>(tagConfig);
 }
+
+bool ReadTransform2DTag(DecodeStream* stream, Transform2D* transform) {
+  // 属性配置本身不依赖目标对象，做成共享常量后每次读取不再堆分配 BlockConfig 和各属性配置。
+  // 属性顺序必须与 Transform2DTag() 保持一致。
+  static const AttributeConfig<Point> anchorPointConfig = {AttributeType::SpatialProperty,
+                                                           Point::Zero()};
+  static const AttributeConfig<Point> positionConfig = {AttributeType::SpatialProperty,
+                                                        Point::Zero()};
+  static const AttributeConfig<float> xPositionConfig = {AttributeType::SimpleProperty, 0.0f};
+  static const AttributeConfig<float> yPositionConfig = {AttributeType::SimpleProperty, 0.0f};
+  static const AttributeConfig<Point> scaleConfig = {AttributeType::MultiDimensionProperty,
+                                                     Point::Make(1, 1)};
+  static const AttributeConfig<float> rotationConfig = {AttributeType::SimpleProperty, 0.0f};
+  static const AttributeConfig<Opacity> opacityConfig = {AttributeType::SimpleProperty, Opaque};
+  static constexpr int AttributeCount = 7;
+  const AttributeBase* configs[AttributeCount] = {
+      &anchorPointConfig, &positionConfig, &xPositionConfig, &yPositionConfig,
+      &scaleConfig,       &rotationConfig, &opacityConfig};
+  void* targets[AttributeCount] = {
+      &transform->anchorPoint, &transform->position, &transform->xPosition,
+      &transform->yPosition,   &transform->scale,    &transform->rotation,
+      &transform->opacity};
+  AttributeFlag flags[AttributeCount] = {};
+  for (int i = 0; i < AttributeCount; i++) {
+    flags[i] = ReadAttributeFlag(stream, configs[i]);
+  }
+  stream->alignWithBytes();
+  for (int i = 0; i < AttributeCount; i++) {
+    configs[i]->readAttribute(stream, flags[i], targets[i]);
+  }
+  return !stream->context->hasException();
+}
 }  // namespace pag
\ No newline at end of file
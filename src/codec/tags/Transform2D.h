@@ -22,4 +22,11 @@
 
 namespace pag {
 std::unique_ptr<BlockConfig> Transform2DTag(Transform2D* transform);
+
+/**
+ * Reads a Transform2D block through a flattened set of shared attribute configs instead of
+ * building a BlockConfig per call. Transform2D is read once per layer, which makes it one of the
+ * hottest blocks during file loading.
+ */
+bool ReadTransform2DTag(DecodeStream* stream, Transform2D* transform);
 }
\ No newline at end of file
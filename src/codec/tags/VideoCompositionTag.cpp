@@ -82,4 +82,27 @@ TagCode WriteVideoComposition(EncodeStream* stream, VideoComposition* compositio
   WriteEndTag(stream);
   return TagCode::VideoCompositionBlock;
 }
+
+// 渐进式档位：序列只写头部，帧负载由随后的 SequenceFrameBlock 按播放顺序交错承载。
+TagCode WriteVideoCompositionProgressive(EncodeStream* stream, VideoComposition* composition) {
+  auto sequences = composition->sequences;
+  std::sort(sequences.begin(), sequences.end(), lessFirst);
+  auto hasAlpha =
+      !sequences.empty() && (sequences[0]->alphaStartY > 0 || sequences[0]->alphaStartX > 0);
+  stream->writeEncodedUint32(composition->id);
+  stream->writeBoolean(hasAlpha);
+  WriteTagsOfComposition(stream, composition);
+  for (auto sequence : sequences) {
+    auto parameter = std::make_pair(sequence, hasAlpha);
+    WriteTag(stream, &parameter, WriteVideoSequenceHeader);
+  }
+  for (auto sequence : sequences) {
+    if (sequence->MP4Header == nullptr) {
+      break;
+    }
+    WriteTag(stream, sequence->MP4Header, WriteMp4Header);
+  }
+  WriteEndTag(stream);
+  return TagCode::VideoCompositionBlock;
+}
 }  // namespace pag
\ No newline at end of file
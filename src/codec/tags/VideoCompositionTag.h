@@ -24,4 +24,5 @@ namespace pag {
 VideoComposition* ReadVideoComposition(DecodeStream* stream);
 
 TagCode WriteVideoComposition(EncodeStream* stream, VideoComposition* composition);
+TagCode WriteVideoCompositionProgressive(EncodeStream* stream, VideoComposition* composition);
 }  // namespace pag
\ No newline at end of file
@@ -70,7 +70,7 @@ VideoSequence* ReadVideoSequence(DecodeStream* stream, bool hasAlpha) {
   return sequence;
 }
 
-static void WriteByteDataWithoutStartCode(EncodeStream* stream, ByteData* byteData) {
+void WriteByteDataWithoutStartCode(EncodeStream* stream, ByteData* byteData) {
   auto length = static_cast<uint32_t>(byteData->length());
   if (length < 4) {
     length = 0;
@@ -117,6 +117,34 @@ TagCode WriteVideoSequence(EncodeStream* stream, std::pair<VideoSequence*, bool>
   return TagCode::VideoSequence;
 }
 
+// 渐进式档位下只写序列的紧凑头部：帧数记为 0，帧负载随后以 SequenceFrameBlock 按播放顺序
+// 交错写出。普通 ReadVideoSequence 读出一个零帧序列，帧在所有块读完后再挂回来。
+TagCode WriteVideoSequenceHeader(EncodeStream* stream, std::pair<VideoSequence*, bool>* parameter) {
+  auto sequence = parameter->first;
+  auto hasAlpha = parameter->second;
+  stream->writeEncodedInt32(sequence->width);
+  stream->writeEncodedInt32(sequence->height);
+  stream->writeFloat(sequence->frameRate);
+
+  if (hasAlpha) {
+    stream->writeEncodedInt32(sequence->alphaStartX);
+    stream->writeEncodedInt32(sequence->alphaStartY);
+  }
+
+  WriteByteDataWithoutStartCode(stream, sequence->headers[0]);  // sps
+  WriteByteDataWithoutStartCode(stream, sequence->headers[1]);  // pps
+
+  stream->writeEncodedUint32(0);
+
+  stream->writeEncodedUint32(static_cast<uint32_t>(sequence->staticTimeRanges.size()));
+  for (auto staticTimeRange : sequence->staticTimeRanges) {
+    WriteTime(stream, staticTimeRange.start);
+    WriteTime(stream, staticTimeRange.end);
+  }
+
+  return TagCode::VideoSequence;
+}
+
 ByteData* ReadMp4Header(DecodeStream* stream) {
   auto length = stream->readEncodedUint32();
   auto bytes = stream->readBytes(length);
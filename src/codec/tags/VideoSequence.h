@@ -23,6 +23,8 @@
 namespace pag {
 VideoSequence* ReadVideoSequence(DecodeStream* stream, bool hasAlpha);
 TagCode WriteVideoSequence(EncodeStream* stream, std::pair<VideoSequence*, bool>* parameter);
+TagCode WriteVideoSequenceHeader(EncodeStream* stream, std::pair<VideoSequence*, bool>* parameter);
+void WriteByteDataWithoutStartCode(EncodeStream* stream, ByteData* byteData);
 ByteData* ReadMp4Header(DecodeStream* stream);
 TagCode WriteMp4Header(EncodeStream* stream, ByteData* byteData);
 }  // namespace pag
@@ -147,6 +147,12 @@ std::unique_ptr<ByteData> DecodeStream::readByteData() {
   if (length == 0 || length > bytes.length() || context->hasException()) {
     return nullptr;
   }
+  auto fileBytes = context->fileBytes.get();
+  if (fileBytes != nullptr && bytes.data() >= fileBytes->data() &&
+      bytes.data() + length <= fileBytes->data() + fileBytes->length()) {
+    // Borrow a view of the source buffer, which the decoded File keeps alive.
+    return ByteData::MakeWithoutCopy(const_cast<uint8_t*>(bytes.data()), length);
+  }
   return ByteData::MakeCopy(bytes.data(), length);
 }
 
@@ -251,41 +257,111 @@ uint32_t DecodeStream::readUBits(uint8_t numBits) {
   return value;
 }
 
+void DecodeStream::readEncodedUint64List(uint64_t* values, uint32_t count) {
+  static const uint64_t valueMask = 127;
+  static const uint8_t hasNext = 128;
+  auto bytes = dataView.bytes();
+  auto length = dataView.size();
+  auto position = _position;
+  for (uint32_t i = 0; i < count; i++) {
+    uint64_t value = 0;
+    uint64_t byte = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (position >= length) {
+        PAGThrowError(context, "End of file was encountered.");
+        for (uint32_t j = i; j < count; j++) {
+          values[j] = 0;
+        }
+        _position = position;
+        positionChanged(0);
+        return;
+      }
+      byte = bytes[position++];
+      value |= (byte & valueMask) << shift;
+      if ((byte & hasNext) == 0) {
+        break;
+      }
+    }
+    values[i] = value;
+  }
+  _position = position;
+  positionChanged(0);
+}
+
+// 一次校验整段位长后批量提取定长位段，关键帧密集文件的加载时间大多花在这些列表读取上。
+bool DecodeStream::readUBitsRun(uint8_t numBits, uint32_t* values, uint32_t count) {
+  auto totalBits = static_cast<uint64_t>(numBits) * count;
+  auto length = dataView.size();
+  if (_bitPosition + totalBits > static_cast<uint64_t>(length) * 8) {
+    PAGThrowError(context, "End of file was encountered.");
+    for (uint32_t i = 0; i < count; i++) {
+      values[i] = 0;
+    }
+    return false;
+  }
+  auto bytes = dataView.bytes();
+  auto mask = numBits == 32 ? 0xFFFFFFFFu : ((1u << numBits) - 1);
+  auto bitPosition = _bitPosition;
+  for (uint32_t i = 0; i < count; i++) {
+    auto bytePosition = bitPosition >> 3;
+    // 以小端字节序拼出 64 位窗口，足以覆盖任意位偏移下的 32 位值，小端平台上编译器会合并为一次加载。
+    auto available = std::min<size_t>(8, length - bytePosition);
+    uint64_t window = 0;
+    for (size_t b = 0; b < available; b++) {
+      window |= static_cast<uint64_t>(bytes[bytePosition + b]) << (b * 8);
+    }
+    values[i] = static_cast<uint32_t>(window >> (bitPosition & 7)) & mask;
+    bitPosition += numBits;
+  }
+  _bitPosition = bitPosition;
+  bitPositionChanged(0);
+  return true;
+}
+
 void DecodeStream::readInt32List(int32_t* values, uint32_t count) {
   auto numBits = readNumBits();
+  if (!readUBitsRun(numBits, reinterpret_cast<uint32_t*>(values), count)) {
+    return;
+  }
+  auto shift = 32 - numBits;
   for (uint32_t i = 0; i < count; i++) {
-    values[i] = readBits(numBits);
+    values[i] = static_cast<int32_t>(static_cast<uint32_t>(values[i]) << shift) >> shift;
   }
 }
 
 void DecodeStream::readUint32List(uint32_t* values, uint32_t count) {
   auto numBits = readNumBits();
-  for (uint32_t i = 0; i < count; i++) {
-    values[i] = readUBits(numBits);
-  }
+  readUBitsRun(numBits, values, count);
 }
 
 void DecodeStream::readFloatList(float* values, uint32_t count, float precision) {
   auto numBits = readNumBits();
-  for (uint32_t i = 0; i < count; i++) {
-    values[i] = readBits(numBits) * precision;
+  auto shift = 32 - numBits;
+  uint32_t buffer[64];
+  uint32_t index = 0;
+  while (index < count) {
+    auto run = std::min<uint32_t>(64, count - index);
+    if (!readUBitsRun(numBits, buffer, run)) {
+      for (uint32_t i = index; i < count; i++) {
+        values[i] = 0;
+      }
+      return;
+    }
+    for (uint32_t i = 0; i < run; i++) {
+      values[index + i] =
+          static_cast<float>(static_cast<int32_t>(buffer[i] << shift) >> shift) * precision;
+    }
+    index += run;
   }
 }
+
 void DecodeStream::readPoint2DList(Point* points, uint32_t count, float precision) {
-  auto numBits = readNumBits();
-  for (uint32_t i = 0; i < count; i++) {
-    points[i].x = readBits(numBits) * precision;
-    points[i].y = readBits(numBits) * precision;
-  }
+  // Point 的 x、y 连续存放，按平铺的 float 列表整段读取。
+  readFloatList(&points[0].x, count * 2, precision);
 }
 
 void DecodeStream::readPoint3DList(Point3D* points, uint32_t count, float precision) {
-  auto numBits = readNumBits();
-  for (uint32_t i = 0; i < count; i++) {
-    points[i].x = readBits(numBits) * precision;
-    points[i].y = readBits(numBits) * precision;
-    points[i].z = readBits(numBits) * precision;
-  }
+  readFloatList(&points[0].x, count * 3, precision);
 }
 
 void DecodeStream::bitPositionChanged(size_t offset) {
@@ -197,6 +197,12 @@ class DecodeStream final {
     return static_cast<uint8_t>(readUBits(LENGTH_FOR_STORE_NUM_BITS) + 1);
   }
 
+  /**
+   * Reads a list of encoded unsigned 64-bit integers from the byte stream in one pass, without
+   * re-entering the per-value bounds checks.
+   */
+  void readEncodedUint64List(uint64_t* values, uint32_t count);
+
   /**
    * Reads a list of int32_t values from the stream.
    */
@@ -242,5 +248,7 @@ class DecodeStream final {
   void positionChanged(size_t offset);
 
   bool checkEndOfFile(uint32_t bytesToRead);
+
+  bool readUBitsRun(uint8_t numBits, uint32_t* values, uint32_t count);
 };
 }  // namespace pag
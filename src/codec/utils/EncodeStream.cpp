@@ -18,15 +18,74 @@
 
 #include "EncodeStream.h"
 #include <cstring>
+#include <vector>
 
 namespace pag {
+// Encoding a file creates a short-lived EncodeStream for every tag, so the backing buffers are
+// recycled through a thread-local pool instead of being freed and reallocated on each WriteTag
+// call. Buffers handed out by release() leave the pool and are owned by the returned ByteData.
+static constexpr size_t MAX_POOLED_BUFFERS = 16;
+static constexpr size_t MAX_POOLED_BUFFER_SIZE = 1 << 24;  // 16MB
+
+class EncodeBufferPool {
+ public:
+  ~EncodeBufferPool() {
+    for (auto& buffer : buffers) {
+      delete[] buffer.bytes;
+    }
+  }
+
+  /**
+   * Returns a buffer of at least *capacity bytes, preferring the smallest pooled buffer that
+   * fits. On success, *capacity is updated to the actual capacity of the returned buffer.
+   */
+  uint8_t* acquire(size_t* capacity) {
+    auto result = buffers.end();
+    for (auto item = buffers.begin(); item != buffers.end(); item++) {
+      if (item->capacity >= *capacity &&
+          (result == buffers.end() || item->capacity < result->capacity)) {
+        result = item;
+      }
+    }
+    if (result != buffers.end()) {
+      auto bytes = result->bytes;
+      *capacity = result->capacity;
+      buffers.erase(result);
+      return bytes;
+    }
+    return new (std::nothrow) uint8_t[*capacity];
+  }
+
+  void recycle(uint8_t* bytes, size_t capacity) {
+    if (capacity > MAX_POOLED_BUFFER_SIZE || buffers.size() >= MAX_POOLED_BUFFERS) {
+      delete[] bytes;
+      return;
+    }
+    buffers.push_back({bytes, capacity});
+  }
+
+ private:
+  struct PooledBuffer {
+    uint8_t* bytes = nullptr;
+    size_t capacity = 0;
+  };
+
+  std::vector<PooledBuffer> buffers = {};
+};
+
+static EncodeBufferPool& BufferPool() {
+  static thread_local EncodeBufferPool pool = {};
+  return pool;
+}
 
 EncodeStream::EncodeStream(StreamContext* context, uint32_t cap) : context(context) {
   checkCapacity(cap);
 }
 
 EncodeStream::~EncodeStream() {
-  delete[] bytes;
+  if (bytes != nullptr) {
+    BufferPool().recycle(bytes, capacity);
+  }
 }
 
 std::unique_ptr<ByteData> EncodeStream::release() {
@@ -319,14 +378,14 @@ bool EncodeStream::expandCapacity(size_t length) {
   while (newCapacity < length) {
     newCapacity = newCapacity / 2 * 3;
   }
-  auto newBytes = new (std::nothrow) uint8_t[newCapacity];
+  auto newBytes = BufferPool().acquire(&newCapacity);
   if (newBytes == nullptr) {
     PAGThrowError(context, "Failed to allocate memory for EncodedStream!.");
     return false;
   }
   if (bytes != nullptr) {
     memcpy(newBytes, bytes, _length);
-    delete[] bytes;
+    BufferPool().recycle(bytes, capacity);
   }
   capacity = newCapacity;
   bytes = newBytes;
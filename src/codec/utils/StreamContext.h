@@ -20,9 +20,11 @@
 
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include "base/utils/Log.h"
+#include "pag/types.h"
 
 namespace pag {
 static constexpr uint8_t LENGTH_FOR_STORE_NUM_BITS = 5;
@@ -44,6 +46,13 @@ class StreamContext {
   }
 
   std::vector<std::string> errorMessages;
+
+  /**
+   * The whole source buffer of the file being decoded. When set, DecodeStream::readByteData
+   * returns borrowed views of this buffer instead of copies, and the decoded File retains it so
+   * the views stay valid.
+   */
+  std::shared_ptr<ByteData> fileBytes = nullptr;
 };
 
 inline size_t BitsToBytes(size_t capacity) {
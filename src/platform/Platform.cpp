@@ -36,6 +36,12 @@ NALUType Platform::naluType() const {
 void Platform::traceImage(const tgfx::ImageInfo&, const void*, const std::string&) const {
 }
 
+void Platform::traceEventBegin(const char*) const {
+}
+
+void Platform::traceEventEnd() const {
+}
+
 std::vector<ShapedGlyph> Platform::shapeText(const std::string&,
                                              std::shared_ptr<tgfx::Typeface>) const {
   return {};
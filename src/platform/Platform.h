@@ -68,6 +68,19 @@ class Platform {
   virtual void traceImage(const tgfx::ImageInfo& info, const void* pixels,
                           const std::string& tag) const;
 
+  /**
+   * Notifies the platform that a timeline trace event has begun on the calling thread. The default
+   * implementation does nothing. Platforms can forward the events to a system tracer such as
+   * ATrace on Android or os_signpost on Apple platforms.
+   */
+  virtual void traceEventBegin(const char* name) const;
+
+  /**
+   * Notifies the platform that the most recent timeline trace event of the calling thread has
+   * ended.
+   */
+  virtual void traceEventEnd() const;
+
   /**
    * Returns the absolute path to the platform-specific cache directory on the filesystem.
    */
@@ -26,7 +26,6 @@
 #import "PAGFile.h"
 #import "platform/cocoa/PAGDiskCache.h"
 #import "platform/cocoa/private/PAGAnimator.h"
-#import "platform/cocoa/private/PixelBufferUtil.h"
 #import "platform/ios/private/PAGContentVersion.h"
 
 namespace pag {
@@ -79,7 +78,7 @@ static const float DEFAULT_MAX_FRAMERATE = 30.0;
 
   NSMutableDictionary<NSNumber*, UIImage*>* imagesMap;
   std::mutex imageViewLock;
-  CVPixelBufferPoolRef diskBufferPool;
+  CVPixelBufferPoolRef bufferPool;
 }
 
 @synthesize memoryCacheEnabled = _memoryCacheEnabled;
@@ -174,8 +173,8 @@ static const float DEFAULT_MAX_FRAMERATE = 30.0;
   }
 }
 
-- (CVPixelBufferRef)getDiskCacheCVPixelBuffer {
-  if (diskBufferPool == nil) {
+- (CVPixelBufferRef)getPooledCVPixelBuffer {
+  if (bufferPool == nil) {
     NSDictionary* options = @{
       (id)kCVPixelBufferIOSurfacePropertiesKey : @{},
       (id)kCVPixelBufferWidthKey : @(width),
@@ -183,15 +182,15 @@ static const float DEFAULT_MAX_FRAMERATE = 30.0;
       (id)kCVPixelBufferPixelFormatTypeKey : @(kCVPixelFormatType_32BGRA)
     };
     CVReturn status = CVPixelBufferPoolCreate(kCFAllocatorDefault, nil, (CFDictionaryRef)options,
-                                              &diskBufferPool);
-    if (status != kCVReturnSuccess || diskBufferPool == nil) {
+                                              &bufferPool);
+    if (status != kCVReturnSuccess || bufferPool == nil) {
+      NSLog(@"PAGImageView: CVPixelBufferPool create failed!");
       return nil;
     }
   }
   CVPixelBufferRef pixelBuffer;
   CVReturn status =
-      CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, diskBufferPool, &pixelBuffer);
-  CVPixelBufferPoolFlush(diskBufferPool, kCVPixelBufferPoolFlushExcessBuffers);
+      CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, bufferPool, &pixelBuffer);
   if (status != kCVReturnSuccess) {
     return nil;
   }
@@ -199,16 +198,6 @@ static const float DEFAULT_MAX_FRAMERATE = 30.0;
   return pixelBuffer;
 }
 
-- (CVPixelBufferRef)getMemoryCacheCVPixelBuffer {
-  CVPixelBufferRef pixelBuffer =
-      pag::PixelBufferUtil::Make(static_cast<int>(width), static_cast<int>(height));
-  if (pixelBuffer == nil) {
-    NSLog(@"PAGImageView: CVPixelBufferRef create failed!");
-    return nil;
-  }
-  return pixelBuffer;
-}
-
 - (void)updatePAGDecoder {
   if (pagDecoder == nil) {
     float scaleFactor;
@@ -342,9 +331,9 @@ static const float DEFAULT_MAX_FRAMERATE = 30.0;
     imagesMap = nil;
     self.memeoryCacheFinished = NO;
   }
-  if (diskBufferPool) {
-    CVPixelBufferPoolRelease(diskBufferPool);
-    diskBufferPool = nil;
+  if (bufferPool) {
+    CVPixelBufferPoolRelease(bufferPool);
+    bufferPool = nil;
   }
   if (pagDecoder) {
     [pagDecoder release];
@@ -607,8 +596,9 @@ static const float DEFAULT_MAX_FRAMERATE = 30.0;
     return NO;
   }
   [self checkPAGCompositionChanged];
-  CVPixelBufferRef pixelBuffer = self.memoryCacheEnabled ? [self getMemoryCacheCVPixelBuffer]
-                                                         : [self getDiskCacheCVPixelBuffer];
+  // 内存缓存模式下缓存的 UIImage 会一直引用各自的 CVPixelBuffer，这些 buffer 在缓存清空前
+  // 不会回到池里，池此时只是统一的分配器；非缓存模式下上一帧释放后 IOSurface 立即被复用。
+  CVPixelBufferRef pixelBuffer = [self getPooledCVPixelBuffer];
   if (pixelBuffer == nil) {
     self.currentUIImage = nil;
     [self submitToImageView];
@@ -18,7 +18,10 @@
 
 #include "JPAGView.h"
 #include <ace/xcomponent/native_interface_xcomponent.h>
+#include <algorithm>
 #include <cstdint>
+#include <mutex>
+#include <vector>
 #include "base/utils/UniqueID.h"
 #include "platform/ohos/GPUDrawable.h"
 #include "platform/ohos/JPAGLayerHandle.h"
@@ -29,6 +32,102 @@ namespace pag {
 
 static std::unordered_map<std::string, std::shared_ptr<JPAGView>> ViewMap = {};
 
+// 所有视图的进度回调合并到同一个 threadsafe function：同一个 vsync 周期里 N 个视图各自跨一次
+// ArkTS 桥的开销，合并后变成一次跨桥再在 JS 线程内逐个调用各视图注册的回调。
+class ProgressDispatcher {
+ public:
+  static ProgressDispatcher* GetInstance() {
+    static auto& instance = *new ProgressDispatcher();
+    return &instance;
+  }
+
+  void setCallback(napi_env env, const std::string& id, napi_value callback) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (dispatchFunction == nullptr) {
+      napi_value resourceName = nullptr;
+      napi_create_string_utf8(env, "PAGViewProgressDispatch", NAPI_AUTO_LENGTH, &resourceName);
+      napi_create_threadsafe_function(env, nullptr, nullptr, resourceName, 0, 1, nullptr, nullptr,
+                                      this, &ProgressDispatcher::Dispatch, &dispatchFunction);
+    }
+    auto iter = callbacks.find(id);
+    if (iter != callbacks.end()) {
+      napi_delete_reference(env, iter->second);
+    }
+    napi_ref reference = nullptr;
+    napi_create_reference(env, callback, 1, &reference);
+    callbacks[id] = reference;
+  }
+
+  void removeCallback(const std::string& id) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto iter = callbacks.find(id);
+    if (iter == callbacks.end()) {
+      return;
+    }
+    // 引用只能在 JS 线程上删除，挂到待删除列表里等下一次分发处理。
+    releasedReferences.push_back(iter->second);
+    callbacks.erase(iter);
+    pendingViews.erase(std::remove(pendingViews.begin(), pendingViews.end(), id),
+                       pendingViews.end());
+  }
+
+  void notify(const std::string& id) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (dispatchFunction == nullptr ||
+        std::find(pendingViews.begin(), pendingViews.end(), id) != pendingViews.end()) {
+      return;
+    }
+    pendingViews.push_back(id);
+    if (!scheduled) {
+      scheduled = true;
+      napi_call_threadsafe_function(dispatchFunction, nullptr,
+                                    napi_threadsafe_function_call_mode::napi_tsfn_nonblocking);
+    }
+  }
+
+ private:
+  static void Dispatch(napi_env env, napi_value, void* context, void*) {
+    static_cast<ProgressDispatcher*>(context)->dispatch(env);
+  }
+
+  void dispatch(napi_env env) {
+    std::vector<napi_ref> currentReferences = {};
+    std::vector<napi_ref> toDelete = {};
+    {
+      std::lock_guard<std::mutex> autoLock(locker);
+      scheduled = false;
+      for (auto& id : pendingViews) {
+        auto iter = callbacks.find(id);
+        if (iter != callbacks.end()) {
+          currentReferences.push_back(iter->second);
+        }
+      }
+      pendingViews.clear();
+      toDelete = std::move(releasedReferences);
+      releasedReferences = {};
+    }
+    for (auto reference : toDelete) {
+      napi_delete_reference(env, reference);
+    }
+    napi_value undefined = nullptr;
+    napi_get_undefined(env, &undefined);
+    for (auto reference : currentReferences) {
+      napi_value callback = nullptr;
+      napi_get_reference_value(env, reference, &callback);
+      if (callback != nullptr) {
+        napi_call_function(env, undefined, callback, 0, nullptr, nullptr);
+      }
+    }
+  }
+
+  std::mutex locker = {};
+  std::unordered_map<std::string, napi_ref> callbacks = {};
+  std::vector<std::string> pendingViews = {};
+  std::vector<napi_ref> releasedReferences = {};
+  bool scheduled = false;
+  napi_threadsafe_function dispatchFunction = nullptr;
+};
+
 static napi_value Flush(napi_env env, napi_callback_info info) {
   napi_value jsView = nullptr;
   size_t argc = 0;
@@ -280,12 +379,6 @@ static napi_value SetStateChangeCallback(napi_env env, napi_callback_info info)
   return nullptr;
 }
 
-static void ProgressCallback(napi_env env, napi_value callback, void*, void*) {
-  napi_value undefined;
-  napi_get_undefined(env, &undefined);
-  napi_call_function(env, undefined, callback, 0, nullptr, nullptr);
-}
-
 static napi_value SetProgressUpdateCallback(napi_env env, napi_callback_info info) {
   napi_value jsView = nullptr;
   size_t argc = 1;
@@ -296,10 +389,9 @@ static napi_value SetProgressUpdateCallback(napi_env env, napi_callback_info inf
   }
   JPAGView* view = nullptr;
   napi_unwrap(env, jsView, reinterpret_cast<void**>(&view));
-  napi_value resourceName = nullptr;
-  napi_create_string_utf8(env, "PAGViewProgressCallback", NAPI_AUTO_LENGTH, &resourceName);
-  napi_create_threadsafe_function(env, args[0], nullptr, resourceName, 0, 1, nullptr, nullptr,
-                                  nullptr, ProgressCallback, &view->progressCallback);
+  if (view != nullptr) {
+    ProgressDispatcher::GetInstance()->setCallback(env, view->id, args[0]);
+  }
   return nullptr;
 }
 
@@ -856,12 +948,17 @@ void JPAGView::onAnimationRepeat(PAGAnimator*) {
   }
 }
 
-void JPAGView::onAnimationUpdate(PAGAnimator* animator) {
+void JPAGView::onAnimationIdle(PAGAnimator*) {
   std::lock_guard lock_guard(locker);
-  if (progressCallback) {
-    napi_call_threadsafe_function(progressCallback, nullptr,
-                                  napi_threadsafe_function_call_mode::napi_tsfn_nonblocking);
+  if (player) {
+    // 播放暂停或结束后做深度缓存清理，不与可见帧竞争。
+    player->performIdleMaintenance();
   }
+}
+
+void JPAGView::onAnimationUpdate(PAGAnimator* animator) {
+  std::lock_guard lock_guard(locker);
+  ProgressDispatcher::GetInstance()->notify(id);
 
   if (player) {
     player->setProgress(animator->progress());
@@ -899,10 +996,7 @@ void JPAGView::onSurfaceDestroyed() {
 
 void JPAGView::release() {
   std::lock_guard lock_guard(locker);
-  if (progressCallback != nullptr) {
-    napi_release_threadsafe_function(progressCallback, napi_tsfn_abort);
-    progressCallback = nullptr;
-  }
+  ProgressDispatcher::GetInstance()->removeCallback(id);
   if (playingStateCallback != nullptr) {
     napi_release_threadsafe_function(playingStateCallback, napi_tsfn_abort);
     playingStateCallback = nullptr;
@@ -43,6 +43,8 @@ class JPAGView : public PAGAnimator::Listener, public XComponentListener {
 
   void onAnimationRepeat(PAGAnimator*) override;
 
+  void onAnimationIdle(PAGAnimator*) override;
+
   void onAnimationUpdate(PAGAnimator* animator) override;
 
   void onSurfaceCreated(NativeWindow* window) override;
@@ -59,7 +61,6 @@ class JPAGView : public PAGAnimator::Listener, public XComponentListener {
 
   std::string id;
 
-  napi_threadsafe_function progressCallback = nullptr;
   napi_threadsafe_function playingStateCallback = nullptr;
 
  private:
@@ -17,26 +17,76 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "NativeDisplayLink.h"
+// clang-format off
+#include <native_vsync/native_vsync.h>
+// clang-format on
+#include <cstring>
+#include <mutex>
+#include <vector>
 
 namespace pag {
+// 进程内所有动画视图共享同一个 NativeVSync 订阅。每个视图单独订阅时，多个视图同屏会让合成器
+// 每个 vsync 逐个唤醒 N 条回调链路；合并后每个 vsync 只唤醒一次，再统一分发给活跃的 DisplayLink。
+class VSyncHub {
+ public:
+  static VSyncHub* GetInstance() {
+    static auto& instance = *new VSyncHub();
+    return &instance;
+  }
 
-void NativeDisplayLink::PAGVSyncCallback(long long, void* data) {
-  auto displayLink = static_cast<NativeDisplayLink*>(data);
-  displayLink->callback();
-  if (displayLink->playing) {
-    OH_NativeVSync_RequestFrame(displayLink->vSync, &PAGVSyncCallback, displayLink);
+  void requestFrame(std::shared_ptr<NativeDisplayLink> link) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    links.push_back(link);
+    if (!frameRequested) {
+      frameRequested = true;
+      OH_NativeVSync_RequestFrame(vSync, &OnVSync, this);
+    }
+  }
+
+ private:
+  VSyncHub() {
+    char name[] = "pag_vsync";
+    vSync = OH_NativeVSync_Create(name, strlen(name));
+  }
+
+  static void OnVSync(long long, void* data) {
+    static_cast<VSyncHub*>(data)->dispatch();
   }
-}
+
+  void dispatch() {
+    std::vector<std::weak_ptr<NativeDisplayLink>> currentLinks = {};
+    {
+      std::lock_guard<std::mutex> autoLock(locker);
+      frameRequested = false;
+      currentLinks = std::move(links);
+      links = {};
+    }
+    for (auto& weakLink : currentLinks) {
+      // 弱引用保证分发过程中被销毁的视图不会被访问到，锁定成功则对象在回调期间保持存活。
+      auto link = weakLink.lock();
+      if (link == nullptr || !link->playing) {
+        continue;
+      }
+      link->callback();
+      if (link->playing) {
+        requestFrame(link);
+      }
+    }
+  }
+
+  std::mutex locker = {};
+  std::vector<std::weak_ptr<NativeDisplayLink>> links = {};
+  bool frameRequested = false;
+  OH_NativeVSync* vSync = nullptr;
+};
 
 NativeDisplayLink::NativeDisplayLink(std::function<void()> callback) : callback(callback) {
-  char name[] = "pag_vsync";
-  vSync = OH_NativeVSync_Create(name, strlen(name));
 }
 
 void NativeDisplayLink::start() {
   if (playing == false) {
     playing = true;
-    OH_NativeVSync_RequestFrame(vSync, &PAGVSyncCallback, this);
+    VSyncHub::GetInstance()->requestFrame(shared_from_this());
   }
 }
 
@@ -44,8 +94,4 @@ void NativeDisplayLink::stop() {
   playing = false;
 }
 
-NativeDisplayLink::~NativeDisplayLink() {
-  OH_NativeVSync_Destroy(vSync);
-}
-
-}  // namespace pag
\ No newline at end of file
+}  // namespace pag
@@ -18,27 +18,24 @@
 
 #pragma once
 
-// clang-format off
-#include <stdint.h>
-#include <native_vsync/native_vsync.h>
-// clang-format on
+#include <atomic>
 #include <functional>
-#include <mutex>
+#include <memory>
 #include "rendering/utils/DisplayLink.h"
 namespace pag {
 
-class NativeDisplayLink : public DisplayLink {
+class NativeDisplayLink : public DisplayLink,
+                          public std::enable_shared_from_this<NativeDisplayLink> {
  public:
   explicit NativeDisplayLink(std::function<void()> callback);
-  ~NativeDisplayLink() override;
 
   void start() override;
   void stop() override;
 
  private:
-  static void PAGVSyncCallback(long long timestamp, void* data);
-  OH_NativeVSync* vSync = nullptr;
   std::function<void()> callback = nullptr;
   std::atomic<bool> playing = false;
+
+  friend class VSyncHub;
 };
 }  // namespace pag
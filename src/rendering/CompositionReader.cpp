@@ -53,10 +53,38 @@ void CompositionReader::setComposition(std::shared_ptr<PAGComposition> compositi
 
 bool CompositionReader::readFrame(double progress, std::shared_ptr<BitmapBuffer> bitmap) {
   std::lock_guard<std::mutex> autoLock(locker);
+  drawable->setAsyncReadback(false);
   drawable->setBitmap(std::move(bitmap));
   return renderFrame(progress);
 }
 
+bool CompositionReader::submitFrame(double progress, std::shared_ptr<BitmapBuffer> bitmap) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  drawable->setAsyncReadback(true);
+  drawable->setBitmap(std::move(bitmap));
+  pagPlayer->setProgress(progress);
+  pagPlayer->flush();
+  return drawable->hasPendingReadback() && drawable->lastReadbackSucceeded();
+}
+
+bool CompositionReader::finishFrame() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (!drawable->hasPendingReadback()) {
+    return true;
+  }
+  auto device = drawable->getDevice();
+  if (device == nullptr) {
+    return false;
+  }
+  auto context = device->lockContext();
+  if (context == nullptr) {
+    return false;
+  }
+  auto result = drawable->finishPendingReadback();
+  device->unlock();
+  return result;
+}
+
 bool CompositionReader::renderFrame(double progress) {
   pagPlayer->setProgress(progress);
   pagPlayer->flush();
@@ -43,6 +43,19 @@ class CompositionReader {
 
   bool readFrame(double progress, std::shared_ptr<BitmapBuffer> bitmap);
 
+  /**
+   * Renders a frame into the bitmap without waiting for the pixels. Submitting a frame completes
+   * the readback of the previously submitted one, so reading back frame N overlaps with rendering
+   * frame N+1. Returns false if the frame could not be submitted or the previous readback failed.
+   */
+  bool submitFrame(double progress, std::shared_ptr<BitmapBuffer> bitmap);
+
+  /**
+   * Blocks until the pixels of the last submitted frame are copied into its bitmap. Returns true
+   * if the copy succeeded or no frame was pending.
+   */
+  bool finishFrame();
+
  private:
   std::mutex locker = {};
   PAGPlayer* pagPlayer = nullptr;
@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CompositionReaderPool.h"
+
+namespace pag {
+// 空闲 reader 持有 GPU 上下文和离屏目标，数量封顶，超出的归还直接销毁。
+static constexpr size_t MAX_IDLE_READERS = 10;
+
+static int64_t MakeSizeKey(int width, int height) {
+  return (static_cast<int64_t>(width) << 32) | static_cast<uint32_t>(height);
+}
+
+CompositionReaderPool* CompositionReaderPool::GetInstance() {
+  static auto& instance = *new CompositionReaderPool();
+  return &instance;
+}
+
+std::shared_ptr<CompositionReader> CompositionReaderPool::acquire(int width, int height) {
+  std::shared_ptr<CompositionReader> reader = nullptr;
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = idleReaders.find(MakeSizeKey(width, height));
+    if (result != idleReaders.end() && !result->second.empty()) {
+      reader = result->second.back();
+      result->second.pop_back();
+      idleCount--;
+    }
+  }
+  if (reader == nullptr) {
+    reader = CompositionReader::Make(width, height);
+    if (reader == nullptr) {
+      return nullptr;
+    }
+  }
+  // 外层指针释放时把内层的 reader 归还回池，调用方无需感知池的存在。
+  return std::shared_ptr<CompositionReader>(
+      reader.get(), [reader](CompositionReader*) mutable {
+        CompositionReaderPool::GetInstance()->recycle(std::move(reader));
+      });
+}
+
+void CompositionReaderPool::recycle(std::shared_ptr<CompositionReader> reader) {
+  // 回池前结清未完成的异步读回并解绑合成，reader 不再引用调用方的任何对象。
+  reader->finishFrame();
+  reader->setComposition(nullptr);
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (idleCount >= MAX_IDLE_READERS) {
+    return;
+  }
+  idleReaders[MakeSizeKey(reader->width(), reader->height())].push_back(std::move(reader));
+  idleCount++;
+}
+
+void CompositionReaderPool::releaseAll() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  idleReaders.clear();
+  idleCount = 0;
+}
+}  // namespace pag
@@ -0,0 +1,53 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "rendering/CompositionReader.h"
+
+namespace pag {
+/**
+ * 复用 CompositionReader 的进程级对象池。每个 reader 实例都带着完整的 PAGPlayer、离屏
+ * Surface 和 GPU 上下文，频繁创建销毁（例如批量生成缩略图）时每次初始化要花数十毫秒。
+ * 归还池中的 reader 保留暖的上下文和各级缓存，按尺寸分桶等待下一次复用。
+ */
+class CompositionReaderPool {
+ public:
+  static CompositionReaderPool* GetInstance();
+
+  /**
+   * 返回指定尺寸的 reader，优先复用池中的空闲实例。返回的智能指针释放时 reader 自动回池，
+   * 池满则直接销毁。
+   */
+  std::shared_ptr<CompositionReader> acquire(int width, int height);
+
+  /**
+   * 立即销毁池中所有空闲 reader，释放它们占用的 GPU 资源。可在内存紧张时调用。
+   */
+  void releaseAll();
+
+ private:
+  std::mutex locker = {};
+  std::unordered_map<int64_t, std::vector<std::shared_ptr<CompositionReader>>> idleReaders = {};
+  size_t idleCount = 0;
+
+  void recycle(std::shared_ptr<CompositionReader> reader);
+};
+}  // namespace pag
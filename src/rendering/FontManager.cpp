@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "FontManager.h"
+#include <cstdio>
 #include "base/utils/USE.h"
 #include "pag/file.h"
 #include "platform/Platform.h"
@@ -38,6 +39,13 @@ std::shared_ptr<TypefaceHolder> TypefaceHolder::MakeFromFile(const std::string&
   return std::shared_ptr<TypefaceHolder>(holder);
 }
 
+std::shared_ptr<TypefaceHolder> TypefaceHolder::MakeFromTypeface(
+    std::shared_ptr<tgfx::Typeface> typeface) {
+  auto holder = new TypefaceHolder();
+  holder->typeface = std::move(typeface);
+  return std::shared_ptr<TypefaceHolder>(holder);
+}
+
 std::shared_ptr<tgfx::Typeface> TypefaceHolder::getTypeface() {
   std::lock_guard<std::mutex> autoLock(locker);
   if (typeface == nullptr) {
@@ -62,6 +70,19 @@ bool FontManager::hasFallbackFonts() {
 
 PAGFont FontManager::registerFont(const std::string& fontPath, int ttcIndex,
                                   const std::string& fontFamily, const std::string& fontStyle) {
+  if (!fontFamily.empty()) {
+    // 指定了字体名时不需要打开文件就能注册，首次用到时才创建 Typeface。路径加载的字体数据由
+    // 平台字体后端以内存映射方式访问，只有实际触达的字表才会驻留内存，注册多个 CJK 回退字体
+    // 不再一次性抬高 RSS。这里只校验文件是否可读，保持路径错误时返回空 PAGFont 的语义。
+    auto fontFile = fopen(fontPath.c_str(), "rb");
+    if (fontFile == nullptr) {
+      return {"", ""};
+    }
+    fclose(fontFile);
+    std::lock_guard<std::mutex> autoLock(locker);
+    return registerHolder(TypefaceHolder::MakeFromFile(fontPath, ttcIndex), fontFamily, fontStyle);
+  }
+  // 未指定字体名时需要从文件里读取 family 和 style 作为注册键，只能立即打开。
   std::lock_guard<std::mutex> autoLock(locker);
   auto typeface = tgfx::Typeface::MakeFromPath(fontPath, ttcIndex);
   return registerFont(typeface, fontFamily, fontStyle);
@@ -89,13 +110,18 @@ PAGFont FontManager::registerFont(std::shared_ptr<tgfx::Typeface> typeface,
     family = fontFamily;
     style = fontStyle;
   }
-  auto key = PAGFontRegisterKey(family, style);
+  return registerHolder(TypefaceHolder::MakeFromTypeface(std::move(typeface)), family, style);
+}
+
+PAGFont FontManager::registerHolder(std::shared_ptr<TypefaceHolder> holder,
+                                    const std::string& fontFamily, const std::string& fontStyle) {
+  auto key = PAGFontRegisterKey(fontFamily, fontStyle);
   auto iter = registeredFontMap.find(key);
   if (iter != registeredFontMap.end()) {
     registeredFontMap.erase(iter);
   }
-  registeredFontMap[key] = std::move(typeface);
-  return {family, style};
+  registeredFontMap[key] = std::move(holder);
+  return {fontFamily, fontStyle};
 }
 
 void FontManager::unregisterFont(const PAGFont& font) {
@@ -143,9 +169,56 @@ std::vector<std::shared_ptr<TypefaceHolder>> FontManager::getFallbackTypefaces()
   return fallbackFontList;
 }
 
+// 相邻的码点（emoji、同一书写系统的文字）通常由同一个回退字体覆盖，按 64 个码点一组缓存解析结果，
+// 避免每个字符都线性扫描整个回退列表。
+static constexpr int32_t FALLBACK_BUCKET_BITS = 6;
+
+std::shared_ptr<tgfx::Typeface> FontManager::getFallbackTypeface(const std::string& character,
+                                                                 int32_t codepoint,
+                                                                 tgfx::GlyphID* glyphID) {
+  auto bucket = codepoint >> FALLBACK_BUCKET_BITS;
+  std::shared_ptr<TypefaceHolder> cachedHolder = nullptr;
+  std::vector<std::shared_ptr<TypefaceHolder>> holders = {};
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = fallbackCache.find(bucket);
+    if (result != fallbackCache.end()) {
+      cachedHolder = result->second;
+    }
+    holders = fallbackFontList;
+  }
+  if (cachedHolder != nullptr) {
+    auto face = cachedHolder->getTypeface();
+    if (face != nullptr) {
+      auto cachedGlyphID = face->getGlyphID(character);
+      if (cachedGlyphID != 0) {
+        *glyphID = cachedGlyphID;
+        return face;
+      }
+    }
+  }
+  for (auto& holder : holders) {
+    auto face = holder->getTypeface();
+    if (face == nullptr) {
+      continue;
+    }
+    auto faceGlyphID = face->getGlyphID(character);
+    if (faceGlyphID == 0) {
+      continue;
+    }
+    std::lock_guard<std::mutex> autoLock(locker);
+    fallbackCache[bucket] = holder;
+    *glyphID = faceGlyphID;
+    return face;
+  }
+  *glyphID = 0;
+  return nullptr;
+}
+
 void FontManager::setFallbackFontNames(const std::vector<std::string>& fontNames) {
   std::lock_guard<std::mutex> autoLock(locker);
   fallbackFontList.clear();
+  fallbackCache.clear();
   for (auto& fontFamily : fontNames) {
     auto holder = TypefaceHolder::MakeFromName(fontFamily, "");
     fallbackFontList.push_back(holder);
@@ -156,6 +229,7 @@ void FontManager::setFallbackFontPaths(const std::vector<std::string>& fontPaths
                                        const std::vector<int>& ttcIndices) {
   std::lock_guard<std::mutex> autoLock(locker);
   fallbackFontList.clear();
+  fallbackCache.clear();
   int index = 0;
   for (auto& fontPath : fontPaths) {
     auto holder = TypefaceHolder::MakeFromFile(fontPath, ttcIndices[index]);
@@ -166,12 +240,16 @@ void FontManager::setFallbackFontPaths(const std::vector<std::string>& fontPaths
 
 std::shared_ptr<tgfx::Typeface> FontManager::getTypefaceFromCache(const std::string& fontFamily,
                                                                   const std::string& fontStyle) {
-  std::lock_guard<std::mutex> autoLock(locker);
-  auto result = registeredFontMap.find(PAGFontRegisterKey(fontFamily, fontStyle));
-  if (result != registeredFontMap.end()) {
-    return result->second;
+  std::shared_ptr<TypefaceHolder> holder = nullptr;
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = registeredFontMap.find(PAGFontRegisterKey(fontFamily, fontStyle));
+    if (result != registeredFontMap.end()) {
+      holder = result->second;
+    }
   }
-  return nullptr;
+  // 在锁外解析 Typeface，首次打开字体文件可能较慢，不能阻塞其他字体查询。
+  return holder != nullptr ? holder->getTypeface() : nullptr;
 }
 
 static FontManager fontManager = {};
@@ -194,6 +272,14 @@ std::vector<std::shared_ptr<TypefaceHolder>> FontManager::GetFallbackTypefaces()
   return fontManager.getFallbackTypefaces();
 }
 
+std::shared_ptr<tgfx::Typeface> FontManager::GetFallbackTypeface(const std::string& character,
+                                                                 int32_t codepoint,
+                                                                 tgfx::GlyphID* glyphID) {
+  static auto registered = RegisterFallbackFonts();
+  USE(registered);
+  return fontManager.getFallbackTypeface(character, codepoint, glyphID);
+}
+
 PAGFont FontManager::RegisterFont(const std::string& fontPath, int ttcIndex,
                                   const std::string& fontFamily, const std::string& fontStyle) {
   return fontManager.registerFont(fontPath, ttcIndex, fontFamily, fontStyle);
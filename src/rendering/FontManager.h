@@ -31,6 +31,8 @@ class TypefaceHolder {
   static std::shared_ptr<TypefaceHolder> MakeFromFile(const std::string& fontPath,
                                                       int ttcIndex = 0);
 
+  static std::shared_ptr<TypefaceHolder> MakeFromTypeface(std::shared_ptr<tgfx::Typeface> typeface);
+
   std::shared_ptr<tgfx::Typeface> getTypeface();
 
  private:
@@ -49,6 +51,10 @@ class FontManager {
 
   static std::vector<std::shared_ptr<TypefaceHolder>> GetFallbackTypefaces();
 
+  static std::shared_ptr<tgfx::Typeface> GetFallbackTypeface(const std::string& character,
+                                                             int32_t codepoint,
+                                                             tgfx::GlyphID* glyphID);
+
   static PAGFont RegisterFont(const std::string& fontPath, int ttcIndex,
                               const std::string& fontFamily, const std::string& fontStyle);
 
@@ -83,13 +89,20 @@ class FontManager {
 
   std::vector<std::shared_ptr<TypefaceHolder>> getFallbackTypefaces();
 
+  std::shared_ptr<tgfx::Typeface> getFallbackTypeface(const std::string& character,
+                                                      int32_t codepoint, tgfx::GlyphID* glyphID);
+
   void setFallbackFontNames(const std::vector<std::string>& fontNames);
 
   void setFallbackFontPaths(const std::vector<std::string>& fontPaths,
                             const std::vector<int>& ttcIndices);
 
-  std::unordered_map<std::string, std::shared_ptr<tgfx::Typeface>> registeredFontMap;
+  PAGFont registerHolder(std::shared_ptr<TypefaceHolder> holder, const std::string& fontFamily,
+                         const std::string& fontStyle);
+
+  std::unordered_map<std::string, std::shared_ptr<TypefaceHolder>> registeredFontMap;
   std::vector<std::shared_ptr<TypefaceHolder>> fallbackFontList;
+  std::unordered_map<int32_t, std::shared_ptr<TypefaceHolder>> fallbackCache;
   std::mutex locker = {};
 
   std::shared_ptr<tgfx::Typeface> getTypefaceFromCache(const std::string& fontFamily,
@@ -17,6 +17,16 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "pag/pag.h"
+#include "rendering/caches/DiskCache.h"
+#include "rendering/caches/FrameMemoryCache.h"
+#include "rendering/caches/ImageBytesCache.h"
+#include "rendering/caches/RenderCache.h"
+#include "rendering/caches/WarmStartCache.h"
+#include "rendering/utils/RenderTaskScheduler.h"
+#include "rendering/utils/Trace.h"
+#include "rendering/utils/shaper/TextShaper.h"
+#include "rendering/video/VideoDecoderFactory.h"
+#include "tgfx/core/Clock.h"
 
 namespace pag {
 
@@ -25,4 +35,51 @@ static const char sdkVersion[] = "4.0.0";
 std::string PAG::SDKVersion() {
   return sdkVersion;
 }
+
+template <typename InitFunction>
+static void InitializeSubsystem(uint32_t subsystems, uint32_t flag, const char* name,
+                                InitFunction&& init, std::vector<PAGInitTiming>* timings) {
+  if ((subsystems & flag) == 0) {
+    return;
+  }
+  TraceEvent traceEvent(name);
+  auto startTime = tgfx::Clock::Now();
+  init();
+  PAGInitTiming timing = {};
+  timing.subsystem = name;
+  timing.duration = tgfx::Clock::Now() - startTime;
+  timings->push_back(timing);
+}
+
+std::vector<PAGInitTiming> PAG::Initialize(uint32_t subsystems) {
+  std::vector<PAGInitTiming> timings = {};
+  // FindCacheKeys() 会同步等到缓存配置加载完成，首次调用的耗时就是磁盘探测的真实成本。
+  InitializeSubsystem(
+      subsystems, InitDiskCache, "DiskCache", [] { DiskCache::FindCacheKeys(""); }, &timings);
+  // 用一个空格触发回退字体列表的构建，这是平台字体枚举的主要开销所在。
+  InitializeSubsystem(
+      subsystems, InitFontFallbacks, "FontFallbacks", [] { TextShaper::Shape(" ", nullptr); },
+      &timings);
+  InitializeSubsystem(
+      subsystems, InitVideoDecoders, "VideoDecoders",
+      [] {
+        VideoDecoderFactory::SoftwareAVCDecoderFactory();
+        VideoDecoderFactory::HasExternalSoftwareDecoder();
+      },
+      &timings);
+  InitializeSubsystem(
+      subsystems, InitTaskScheduler, "TaskScheduler",
+      [] { RenderTaskScheduler::GetInstance(); }, &timings);
+  return timings;
+}
+
+void PAG::HandleMemoryPressure(PAGMemoryPressureLevel level) {
+  WarmStartCache::GetInstance()->purgeAll();
+  FrameMemoryCache::GetInstance()->purgeAll();
+  ImageBytesCache::PurgeScavengePool();
+  if (level >= PAGMemoryPressureLevel::Critical) {
+    TextShaper::PurgeCaches();
+  }
+  RenderCache::NotifyMemoryPressure(level);
+}
 }  // namespace pag
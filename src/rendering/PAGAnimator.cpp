@@ -17,7 +17,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "PAGAnimator.h"
+#include <algorithm>
 #include "base/utils/TimeUtil.h"
+#include "pag/file.h"
 #include "platform/Platform.h"
 #include "rendering/utils/DisplayLinkWrapper.h"
 #include "tgfx/core/Clock.h"
@@ -74,18 +76,22 @@ class AnimationTicker {
   std::mutex locker = {};
   std::shared_ptr<DisplayLink> displayLink = nullptr;
   std::vector<std::shared_ptr<PAGAnimator>> animators = {};
+  // 每次 tick 复用同一个缓冲区遍历，几十个动画同时运行时不必每帧都重新分配列表。
+  std::vector<std::shared_ptr<PAGAnimator>> tickingAnimators = {};
 
   void onFrameAvailable() {
     locker.lock();
-    auto listCopy = animators;
+    tickingAnimators.assign(animators.begin(), animators.end());
     locker.unlock();
-    for (auto& animator : listCopy) {
+    for (auto& animator : tickingAnimators) {
       if (animator.use_count() == 1) {
         animator->cancelAnimation();
         continue;
       }
       animator->advance();
     }
+    // 及时释放引用，避免在两次 tick 之间延长已移除动画的生命周期。
+    tickingAnimators.clear();
   }
 };
 
@@ -167,6 +173,45 @@ void PAGAnimator::setProgress(double value) {
   resetStartTime();
 }
 
+float PAGAnimator::maxFrameRate() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _maxFrameRate;
+}
+
+void PAGAnimator::setMaxFrameRate(float value) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (value < 0) {
+    value = 0;
+  }
+  _maxFrameRate = value;
+  nextUpdateTime = INT64_MIN;
+}
+
+void PAGAnimator::setStaticTimeRanges(std::vector<TimeRange> timeRanges, Frame totalFrames) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  staticTimeRanges = std::move(timeRanges);
+  staticTotalFrames = totalFrames;
+  lastFlushedFrame = -1;
+}
+
+bool PAGAnimator::checkFrameChanged() {
+  if (staticTimeRanges.empty() || staticTotalFrames <= 0) {
+    return true;
+  }
+  auto currentFrame = ProgressToFrame(_progress, staticTotalFrames);
+  if (currentFrame == lastFlushedFrame) {
+    return false;
+  }
+  if (lastFlushedFrame != -1) {
+    auto timeRange = GetTimeRangeContains(staticTimeRanges, currentFrame);
+    if (timeRange.contains(lastFlushedFrame)) {
+      return false;
+    }
+  }
+  lastFlushedFrame = currentFrame;
+  return true;
+}
+
 bool PAGAnimator::isRunning() {
   std::lock_guard<std::mutex> autoLock(locker);
   return _isRunning;
@@ -204,6 +249,7 @@ void PAGAnimator::cancel() {
   auto listener = weakListener.lock();
   if (listener) {
     listener->onAnimationCancel(this);
+    listener->onAnimationIdle(this);
   }
 }
 
@@ -221,12 +267,15 @@ void PAGAnimator::advance() {
     switch (type) {
       case AnimationTypeEnd:
         listener->onAnimationEnd(this);
+        // 自然播完后动画器不再驱动更新，通知监听者进入空闲，适合做不与帧竞争的缓存维护。
+        listener->onAnimationIdle(this);
         break;
       case AnimationTypeRepeat:
         listener->onAnimationRepeat(this);
         break;
       case AnimationTypeUpdate:
         doUpdate(true);
+        break;
       default:
         break;
     }
@@ -268,11 +317,36 @@ std::vector<int> PAGAnimator::doAdvance() {
       playedCount = count;
       events.push_back(AnimationTypeRepeat);
     }
-    events.push_back(AnimationTypeUpdate);
+    if (checkUpdateDue()) {
+      events.push_back(AnimationTypeUpdate);
+    }
+  }
+  // 节拍推进、限频和静态区间过滤都在同一次加锁内完成，几十个动画共享一次 tick 时，
+  // 每个动画只需要在这里获取一次锁。
+  auto update = std::find(events.begin(), events.end(), AnimationTypeUpdate);
+  if (update != events.end() && !checkFrameChanged()) {
+    events.erase(update);
   }
   return events;
 }
 
+bool PAGAnimator::checkUpdateDue() {
+  // 所有动画共享同一个 displayLink，以屏幕刷新率统一驱动。设置了帧率上限的动画在这里跳过
+  // 中间的节拍，后台的小组件可以降到较低帧率运行而不影响其他动画。
+  if (_maxFrameRate <= 0) {
+    return true;
+  }
+  auto now = tgfx::Clock::Now();
+  if (nextUpdateTime != INT64_MIN && now < nextUpdateTime) {
+    return false;
+  }
+  auto interval = static_cast<int64_t>(1000000.0f / _maxFrameRate);
+  // 下一次到期时间按固定间隔累加，避免 vsync 节拍无法整除时实际帧率越跑越低。
+  nextUpdateTime =
+      nextUpdateTime == INT64_MIN ? now + interval : std::max(nextUpdateTime + interval, now);
+  return true;
+}
+
 void PAGAnimator::doUpdate(bool setStartTime) {
   locker.lock();
   if (task != nullptr && task->status() == tgfx::TaskStatus::Executing) {
@@ -62,6 +62,15 @@ class PAGAnimator {
     virtual void onAnimationRepeat(PAGAnimator*) {
     }
 
+    /**
+     * Notifies that the animator has stopped driving update notifications until the next start()
+     * call. This is called right after onAnimationEnd() or onAnimationCancel(), from the same
+     * thread as those notifications, and is the right place to run cache maintenance that should
+     * not compete with visible frames, such as PAGPlayer::performIdleMaintenance().
+     */
+    virtual void onAnimationIdle(PAGAnimator*) {
+    }
+
     /**
      * Notifies another frame of the animation will occur. This will only be called from the UI
      * thread. Note: onAnimationWillUpdate and onAnimationUpdate will always appear in pairs.
@@ -125,6 +134,28 @@ class PAGAnimator {
    */
   void setProgress(double value);
 
+  /**
+   * The maximum number of update notifications per second, used to throttle this animator on the
+   * shared display link. All animators are driven by one display link at the native refresh rate;
+   * lowering the value makes this animator skip the ticks in between, so less important content,
+   * such as background widgets, can run at a reduced frame rate without affecting the others. A
+   * value of 0 disables the throttling, which is the default.
+   */
+  float maxFrameRate();
+
+  /**
+   * Sets the maximum number of update notifications per second.
+   */
+  void setMaxFrameRate(float value);
+
+  /**
+   * Sets the static time ranges of the displayed content, measured in frame indices of the given
+   * total frame count. While the animation stays inside one static range, the animator suppresses
+   * the update notifications entirely, avoiding needless flushes and GPU wakeups during the idle
+   * spans of the content. Passing an empty vector disables the behavior, which is the default.
+   */
+  void setStaticTimeRanges(std::vector<TimeRange> timeRanges, Frame totalFrames);
+
   /**
    * Indicates whether the animation is running.
    */
@@ -165,9 +196,16 @@ class PAGAnimator {
   bool isAnimating = false;
   bool isEnded = false;
   int playedCount = 0;
+  std::vector<TimeRange> staticTimeRanges = {};
+  Frame staticTotalFrames = 0;
+  Frame lastFlushedFrame = -1;
+  float _maxFrameRate = 0;
+  int64_t nextUpdateTime = INT64_MIN;
 
   explicit PAGAnimator(std::weak_ptr<Listener> listener);
   void advance();
+  bool checkFrameChanged();
+  bool checkUpdateDue();
   std::vector<int> doAdvance();
   void doUpdate(bool setStartTime);
   void onFlush(bool setStartTime);
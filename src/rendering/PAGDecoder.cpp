@@ -17,18 +17,69 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <platform/Platform.h>
+#include <unordered_map>
 #include "base/utils/Log.h"
 #include "base/utils/TGFXCast.h"
 #include "base/utils/TimeUtil.h"
 #include "pag/pag.h"
-#include "rendering/CompositionReader.h"
+#include "rendering/CompositionReaderPool.h"
 #include "rendering/caches/DiskCache.h"
+#include "rendering/caches/FrameMemoryCache.h"
 #include "rendering/layers/ContentVersion.h"
 #include "rendering/utils/BitmapBuffer.h"
 #include "rendering/utils/LockGuard.h"
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/Stream.h"
+#include "tgfx/core/Task.h"
 
 namespace pag {
 
+static uint64_t HashFileContent(tgfx::Stream* stream) {
+  // FNV-1a，与 ImageBytesCache 里的内容哈希保持同一套约定。
+  uint64_t hash = 14695981039346656037ULL;
+  tgfx::Buffer buffer(65536);
+  auto remaining = stream->size();
+  while (remaining > 0) {
+    auto readLength = stream->read(buffer.data(), std::min(remaining, buffer.size()));
+    if (readLength == 0) {
+      return 0;
+    }
+    auto bytes = buffer.bytes();
+    for (size_t i = 0; i < readLength; i++) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+    remaining -= readLength;
+  }
+  hash ^= static_cast<uint64_t>(stream->size());
+  hash *= 1099511628211ULL;
+  return hash;
+}
+
+static uint64_t GetContentHash(const std::string& filePath) {
+  // 进程内的 path → hash 索引，同一路径只哈希一次。文件大小变化时重新计算，新的进程从空索引
+  // 开始，所以同路径更新后的模板总会落到新的缓存键上。
+  static auto& locker = *new std::mutex();
+  static auto& hashIndex = *new std::unordered_map<std::string, std::pair<size_t, uint64_t>>();
+  auto stream = tgfx::Stream::MakeFromFile(filePath);
+  if (stream == nullptr) {
+    return 0;
+  }
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = hashIndex.find(filePath);
+    if (result != hashIndex.end() && result->second.first == stream->size()) {
+      return result->second.second;
+    }
+  }
+  auto hash = HashFileContent(stream.get());
+  if (hash != 0) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    hashIndex[filePath] = {stream->size(), hash};
+  }
+  return hash;
+}
+
 static std::string DefaultCacheKeyGeneratorFunc(PAGDecoder* decoder,
                                                 std::shared_ptr<PAGComposition> composition) {
   if (!composition->isPAGFile() || pag::ContentVersion::Get(composition) > 0) {
@@ -39,7 +90,13 @@ static std::string DefaultCacheKeyGeneratorFunc(PAGDecoder* decoder,
   if (filePath.empty()) {
     return "";
   }
-  return filePath + "." + std::to_string(decoder->width()) + "x" +
+  // 用内容哈希而不是路径作为缓存键：同路径下更新过的模板会落到新键上，不会读到旧缓存；
+  // 改名后的相同文件仍然命中同一份缓存，不会重复占用磁盘。
+  auto contentHash = GetContentHash(filePath);
+  if (contentHash == 0) {
+    return "";
+  }
+  return "pag.hash." + std::to_string(contentHash) + "." + std::to_string(decoder->width()) + "x" +
          std::to_string(decoder->height());
 }
 
@@ -167,6 +224,254 @@ bool PAGDecoder::readFrame(int index, HardwareBufferRef hardwareBuffer) {
   return readFrameInternal(index, bitmap);
 }
 
+// BT.601 limited-range 的整数近似：Y ∈ [16, 235]，UV ∈ [16, 240]。输入是预乘像素，透明区域
+// 等价于叠加在黑色背景上。色度按 2x2 块先平均 RGB 再转换，最右列和最下行的奇数边缘复用相邻
+// 像素，系数本身保证结果落在合法区间内，无需额外截断。
+static void ConvertRGBAToYUV420(const tgfx::ImageInfo& srcInfo, const uint8_t* srcPixels,
+                                YUVFormat yuvFormat, uint8_t* planes[],
+                                const size_t planeRowBytes[]) {
+  auto width = srcInfo.width();
+  auto height = srcInfo.height();
+  for (int y = 0; y < height; y++) {
+    auto srcRow = srcPixels + static_cast<size_t>(y) * srcInfo.rowBytes();
+    auto dstRow = planes[0] + static_cast<size_t>(y) * planeRowBytes[0];
+    for (int x = 0; x < width; x++) {
+      auto pixel = srcRow + static_cast<size_t>(x) * 4;
+      dstRow[x] = static_cast<uint8_t>(
+          ((66 * pixel[0] + 129 * pixel[1] + 25 * pixel[2] + 128) >> 8) + 16);
+    }
+  }
+  auto chromaWidth = (width + 1) / 2;
+  auto chromaHeight = (height + 1) / 2;
+  for (int y = 0; y < chromaHeight; y++) {
+    auto top = y * 2;
+    auto bottom = std::min(top + 2, height);
+    for (int x = 0; x < chromaWidth; x++) {
+      auto left = x * 2;
+      auto right = std::min(left + 2, width);
+      int sum[3] = {0, 0, 0};
+      for (auto sy = top; sy < bottom; sy++) {
+        auto pixel = srcPixels + static_cast<size_t>(sy) * srcInfo.rowBytes() +
+                     static_cast<size_t>(left) * 4;
+        for (auto sx = left; sx < right; sx++) {
+          sum[0] += pixel[0];
+          sum[1] += pixel[1];
+          sum[2] += pixel[2];
+          pixel += 4;
+        }
+      }
+      auto count = (bottom - top) * (right - left);
+      auto r = sum[0] / count;
+      auto g = sum[1] / count;
+      auto b = sum[2] / count;
+      auto u = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+      auto v = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+      if (yuvFormat == YUVFormat::NV12) {
+        auto dstUV = planes[1] + static_cast<size_t>(y) * planeRowBytes[1];
+        dstUV[x * 2] = u;
+        dstUV[x * 2 + 1] = v;
+      } else {
+        planes[1][static_cast<size_t>(y) * planeRowBytes[1] + x] = u;
+        planes[2][static_cast<size_t>(y) * planeRowBytes[2] + x] = v;
+      }
+    }
+  }
+}
+
+bool PAGDecoder::readFrame(int index, YUVFormat yuvFormat, uint8_t* planes[],
+                           const size_t planeRowBytes[]) {
+  std::lock_guard<std::mutex> auoLock(locker);
+  auto planeCount = yuvFormat == YUVFormat::I420 ? 3 : 2;
+  if (planes == nullptr || planeRowBytes == nullptr) {
+    LOGE("PAGDecoder::readFrame() The planes are null!");
+    return false;
+  }
+  for (int i = 0; i < planeCount; i++) {
+    if (planes[i] == nullptr || planeRowBytes[i] == 0) {
+      LOGE("PAGDecoder::readFrame() The planes are invalid!");
+      return false;
+    }
+  }
+  // 渲染路径和磁盘缓存都是 RGBA 帧，先渲染进内部的 RGBA 缓冲区，再一次性转换写入调用方的
+  // YUV 平面，相比调用方先 readFrame 再自行转换省掉一整次全尺寸像素的往返。
+  auto info = tgfx::ImageInfo::Make(_width, _height, tgfx::ColorType::RGBA_8888,
+                                    tgfx::AlphaType::Premultiplied);
+  if (yuvSourcePixels.size() != info.byteSize()) {
+    yuvSourcePixels.resize(info.byteSize());
+  }
+  auto bitmap = BitmapBuffer::Wrap(info, yuvSourcePixels.data());
+  if (!readFrameInternal(index, bitmap)) {
+    return false;
+  }
+  ConvertRGBAToYUV420(info, yuvSourcePixels.data(), yuvFormat, planes, planeRowBytes);
+  return true;
+}
+
+bool PAGDecoder::readFrames(
+    int startIndex, int endIndex,
+    const std::function<void(int index, const void* pixels, size_t rowBytes)>& callback,
+    ColorType colorType, AlphaType alphaType) {
+  std::lock_guard<std::mutex> auoLock(locker);
+  if (callback == nullptr) {
+    LOGE("PAGDecoder::readFrames() The callback is null!");
+    return false;
+  }
+  auto composition = getComposition();
+  checkCompositionChange(composition);
+  if (startIndex < 0 || endIndex >= _numFrames || startIndex > endIndex) {
+    LOGE("PAGDecoder::readFrames() The index range is out of range!");
+    return false;
+  }
+  auto info = tgfx::ImageInfo::Make(_width, _height, ToTGFX(colorType), ToTGFX(alphaType));
+  if (!checkSequenceFile(composition, info)) {
+    return false;
+  }
+  // Use two pixel buffers so that rendering the next frame can overlap with compressing and
+  // writing the previous one on a background thread.
+  tgfx::Buffer buffers[2] = {tgfx::Buffer(info.byteSize()), tgfx::Buffer(info.byteSize())};
+  if (buffers[0].isEmpty() || buffers[1].isEmpty()) {
+    LOGE("PAGDecoder::readFrames() Failed to allocate the pixel buffers!");
+    return false;
+  }
+  std::shared_ptr<tgfx::Task> writeTasks[2] = {nullptr, nullptr};
+  auto success = true;
+  int pendingIndex = -1;
+  // Hands a rendered frame whose pixels are ready to the disk cache and the callback.
+  auto deliverFrame = [&](int index) {
+    auto bufferIndex = index & 1;
+    auto bitmap = BitmapBuffer::Wrap(info, buffers[bufferIndex].data());
+    writeTasks[bufferIndex] = tgfx::Task::Run([file = sequenceFile, index, bitmap]() {
+      if (!file->writeFrame(index, bitmap)) {
+        LOGE("PAGDecoder::readFrames() Failed to write frame to SequenceFile!");
+      }
+    });
+    callback(index, buffers[bufferIndex].data(), info.rowBytes());
+    lastReadIndex = index;
+  };
+  for (int index = startIndex; index <= endIndex; index++) {
+    auto bufferIndex = index & 1;
+    if (writeTasks[bufferIndex] != nullptr) {
+      writeTasks[bufferIndex]->wait();
+      writeTasks[bufferIndex] = nullptr;
+    }
+    auto bitmap = BitmapBuffer::Wrap(info, buffers[bufferIndex].data());
+    if (sequenceFile->readFrame(index, bitmap)) {
+      // Cached frames bypass rendering; drain the in-flight frame first to keep the callbacks in
+      // order.
+      if (pendingIndex >= 0) {
+        if (reader == nullptr || !reader->finishFrame()) {
+          success = false;
+          break;
+        }
+        deliverFrame(pendingIndex);
+        pendingIndex = -1;
+      }
+      callback(index, buffers[bufferIndex].data(), info.rowBytes());
+      lastReadIndex = index;
+      continue;
+    }
+    if (readFrameFromVariant(index, bitmap)) {
+      // 变体补出的帧同样绕过渲染，先排空在途帧保持回调顺序，随后照常写入本分辨率的缓存。
+      if (pendingIndex >= 0) {
+        if (reader == nullptr || !reader->finishFrame()) {
+          success = false;
+          break;
+        }
+        deliverFrame(pendingIndex);
+        pendingIndex = -1;
+      }
+      deliverFrame(index);
+      continue;
+    }
+    if (frameScaler != nullptr) {
+      // 自定义放大走同步渲染，帧在交付前就放大完成，放大器本身通常已经是异步硬件。
+      if (!renderFrame(composition, index, bitmap)) {
+        success = false;
+        break;
+      }
+      deliverFrame(index);
+      continue;
+    }
+    // Submitting frame N also completes the readback of frame N-1, so the copy of one frame
+    // overlaps with the rendering of the next.
+    if (!submitFrame(composition, index, bitmap)) {
+      success = false;
+      break;
+    }
+    if (pendingIndex >= 0) {
+      deliverFrame(pendingIndex);
+    }
+    pendingIndex = index;
+  }
+  if (pendingIndex >= 0 && success) {
+    if (reader != nullptr && reader->finishFrame()) {
+      deliverFrame(pendingIndex);
+    } else {
+      success = false;
+    }
+  }
+  for (auto& task : writeTasks) {
+    if (task != nullptr) {
+      task->wait();
+    }
+  }
+  if (sequenceFile->isComplete() && composition != nullptr) {
+    variantFile = nullptr;
+    if (reader != nullptr) {
+      reader = nullptr;
+      if (composition.use_count() != 1) {
+        container->addLayer(composition);
+      }
+    } else if (composition.use_count() <= 2) {
+      container->removeAllLayers();
+    }
+  }
+  return success;
+}
+
+bool PAGDecoder::readThumbnails(
+    int count, const std::function<void(int index, const void* pixels, size_t rowBytes)>& callback,
+    ColorType colorType, AlphaType alphaType) {
+  std::lock_guard<std::mutex> auoLock(locker);
+  if (callback == nullptr) {
+    LOGE("PAGDecoder::readThumbnails() The callback is null!");
+    return false;
+  }
+  auto composition = getComposition();
+  checkCompositionChange(composition);
+  if (count <= 0 || _numFrames <= 0) {
+    LOGE("PAGDecoder::readThumbnails() The count is invalid!");
+    return false;
+  }
+  auto info = tgfx::ImageInfo::Make(_width, _height, ToTGFX(colorType), ToTGFX(alphaType));
+  tgfx::Buffer buffer(info.byteSize());
+  if (buffer.isEmpty()) {
+    LOGE("PAGDecoder::readThumbnails() Failed to allocate the pixel buffer!");
+    return false;
+  }
+  // 取每个等分区间的中点帧，比区间起点更能代表该段画面。采样序号天然递增，逐帧顺序读取时
+  // 内部的视频解码器不会回退，重叠的 GOP 至多解码一次。
+  int lastIndex = -1;
+  for (int i = 0; i < count; i++) {
+    auto sample = static_cast<int64_t>(2 * i + 1) * _numFrames / (2 * static_cast<int64_t>(count));
+    auto index = static_cast<int>(sample);
+    if (index >= _numFrames) {
+      index = _numFrames - 1;
+    }
+    if (index == lastIndex) {
+      // count 超过总帧数时会采到重复帧，跳过即可。
+      continue;
+    }
+    lastIndex = index;
+    auto bitmap = BitmapBuffer::Wrap(info, buffer.data());
+    if (!readFrameInternal(index, bitmap)) {
+      return false;
+    }
+    callback(index, buffer.data(), info.rowBytes());
+  }
+  return true;
+}
+
 bool PAGDecoder::readFrameInternal(int index, std::shared_ptr<BitmapBuffer> bitmap) {
   if (bitmap == nullptr) {
     LOGE("PAGDecoder::readFrame() The specified bitmap buffer is invalid!");
@@ -181,17 +486,28 @@ bool PAGDecoder::readFrameInternal(int index, std::shared_ptr<BitmapBuffer> bitm
   if (!checkSequenceFile(composition, bitmap->info())) {
     return false;
   }
-  auto success = sequenceFile->readFrame(index, bitmap);
+  // 静态区间内的帧共享同一份缓存像素，内存缓存以区间首帧为键。
+  auto timeRange = GetTimeRangeContains(staticTimeRanges, index);
+  auto cacheIndex = timeRange.contains(index) ? static_cast<int>(timeRange.start) : index;
+  auto frameCache = FrameMemoryCache::GetInstance();
+  auto success = frameCache->readFrame(sequenceFile->uniqueID(), cacheIndex, _numFrames, bitmap);
   if (!success) {
-    success = renderFrame(composition, index, bitmap);
-    if (success) {
-      success = sequenceFile->writeFrame(index, bitmap);
+    success = sequenceFile->readFrame(index, bitmap);
+    if (!success) {
+      success = readFrameFromVariant(index, bitmap);
       if (!success) {
+        success = renderFrame(composition, index, bitmap);
+      }
+      if (success && !sequenceFile->writeFrameAsync(index, bitmap)) {
         LOGE("PAGDecoder::readFrame() Failed to write frame to SequenceFile!");
       }
     }
+    if (success) {
+      frameCache->writeFrame(sequenceFile->uniqueID(), cacheIndex, _numFrames, bitmap);
+    }
   }
   if (sequenceFile->isComplete() && composition != nullptr) {
+    variantFile = nullptr;
     if (reader != nullptr) {
       reader = nullptr;
       if (composition.use_count() != 1) {
@@ -207,8 +523,7 @@ bool PAGDecoder::readFrameInternal(int index, std::shared_ptr<BitmapBuffer> bitm
   return success;
 }
 
-bool PAGDecoder::renderFrame(std::shared_ptr<PAGComposition> composition, int index,
-                             std::shared_ptr<BitmapBuffer> bitmap) {
+bool PAGDecoder::makeReader(std::shared_ptr<PAGComposition> composition) {
   if (composition == nullptr) {
     reader = nullptr;
     LOGE(
@@ -217,17 +532,175 @@ bool PAGDecoder::renderFrame(std::shared_ptr<PAGComposition> composition, int in
     return false;
   }
   if (reader == nullptr) {
-    reader = CompositionReader::Make(_width, _height);
+    reader = CompositionReaderPool::GetInstance()->acquire(_width, _height);
     if (reader == nullptr) {
       LOGE("PAGDecoder::renderFrame() Failed to create a CompositionReader!");
       return false;
     }
     reader->setComposition(composition);
   }
+  return true;
+}
+
+bool PAGDecoder::renderFrame(std::shared_ptr<PAGComposition> composition, int index,
+                             std::shared_ptr<BitmapBuffer> bitmap) {
+  if (frameScaler != nullptr && composition != nullptr && composition->width() < _width &&
+      composition->height() < _height) {
+    if (renderScaledFrame(composition, index, bitmap)) {
+      return true;
+    }
+    // 自定义放大失败：丢弃按原始尺寸创建的 reader，本帧起回退到直接按输出尺寸渲染。
+    frameScaler = nullptr;
+    reader = nullptr;
+  }
+  if (!makeReader(composition)) {
+    return false;
+  }
   auto progress = FrameToProgress(static_cast<Frame>(index), _numFrames);
   return reader->readFrame(progress, bitmap);
 }
 
+bool PAGDecoder::renderScaledFrame(std::shared_ptr<PAGComposition> composition, int index,
+                                   std::shared_ptr<BitmapBuffer> bitmap) {
+  auto srcWidth = composition->width();
+  auto srcHeight = composition->height();
+  if (reader == nullptr) {
+    reader = CompositionReaderPool::GetInstance()->acquire(srcWidth, srcHeight);
+    if (reader == nullptr) {
+      LOGE("PAGDecoder::renderFrame() Failed to create a CompositionReader!");
+      return false;
+    }
+    reader->setComposition(composition);
+  }
+  auto& dstInfo = bitmap->info();
+  auto srcInfo =
+      tgfx::ImageInfo::Make(srcWidth, srcHeight, dstInfo.colorType(), dstInfo.alphaType());
+  if (sourcePixels.size() < srcInfo.byteSize()) {
+    sourcePixels.resize(srcInfo.byteSize());
+  }
+  auto sourceBitmap = BitmapBuffer::Wrap(srcInfo, sourcePixels.data());
+  auto progress = FrameToProgress(static_cast<Frame>(index), _numFrames);
+  if (!reader->readFrame(progress, sourceBitmap)) {
+    return false;
+  }
+  auto dstPixels = bitmap->lockPixels();
+  if (dstPixels == nullptr) {
+    return false;
+  }
+  // 放大后的像素随后照常写入 SequenceFile，磁盘缓存补齐后每次循环读到的都是放大好的帧。
+  auto result = frameScaler(sourcePixels.data(), srcInfo.rowBytes(), srcWidth, srcHeight, dstPixels,
+                            dstInfo.rowBytes(), dstInfo.width(), dstInfo.height());
+  bitmap->unlockPixels();
+  return result;
+}
+
+bool PAGDecoder::submitFrame(std::shared_ptr<PAGComposition> composition, int index,
+                             std::shared_ptr<BitmapBuffer> bitmap) {
+  if (!makeReader(composition)) {
+    return false;
+  }
+  auto progress = FrameToProgress(static_cast<Frame>(index), _numFrames);
+  return reader->submitFrame(progress, bitmap);
+}
+
+// 逐通道的盒式滤波下采样。缓存帧都是预乘或不透明像素，对每个通道直接取平均即可。
+static void ScaleDownPixels(const tgfx::ImageInfo& srcInfo, const uint8_t* srcPixels,
+                            const tgfx::ImageInfo& dstInfo, uint8_t* dstPixels) {
+  auto channels = dstInfo.bytesPerPixel();
+  auto srcWidth = srcInfo.width();
+  auto srcHeight = srcInfo.height();
+  auto dstWidth = dstInfo.width();
+  auto dstHeight = dstInfo.height();
+  for (int y = 0; y < dstHeight; y++) {
+    auto top = y * srcHeight / dstHeight;
+    auto bottom = std::max(top + 1, (y + 1) * srcHeight / dstHeight);
+    auto dstRow = dstPixels + static_cast<size_t>(y) * dstInfo.rowBytes();
+    for (int x = 0; x < dstWidth; x++) {
+      auto left = x * srcWidth / dstWidth;
+      auto right = std::max(left + 1, (x + 1) * srcWidth / dstWidth);
+      uint32_t sum[4] = {0, 0, 0, 0};
+      for (auto sy = top; sy < bottom; sy++) {
+        auto srcPixel = srcPixels + static_cast<size_t>(sy) * srcInfo.rowBytes() +
+                        static_cast<size_t>(left) * channels;
+        for (auto sx = left; sx < right; sx++) {
+          for (size_t i = 0; i < channels; i++) {
+            sum[i] += srcPixel[i];
+          }
+          srcPixel += channels;
+        }
+      }
+      auto count = static_cast<uint32_t>((bottom - top) * (right - left));
+      auto dstPixel = dstRow + static_cast<size_t>(x) * channels;
+      for (size_t i = 0; i < channels; i++) {
+        dstPixel[i] = static_cast<uint8_t>(sum[i] / count);
+      }
+    }
+  }
+}
+
+void PAGDecoder::openVariantFile(const std::string& key, const tgfx::ImageInfo& info) {
+  variantFile = nullptr;
+  // 逐通道取平均只对预乘或不透明的像素正确，非预乘输出不走变体补帧。
+  if (info.alphaType() == tgfx::AlphaType::Unpremultiplied || info.bytesPerPixel() > 4) {
+    return;
+  }
+  // 默认缓存键以 <width>x<height> 结尾，去掉尺寸后缀就是同一内容的逻辑键。自定义键没有这个
+  // 约定，变体查找自然不生效。
+  auto suffix = std::to_string(_width) + "x" + std::to_string(_height);
+  if (key.size() <= suffix.size() ||
+      key.compare(key.size() - suffix.size(), suffix.size(), suffix) != 0) {
+    return;
+  }
+  auto prefix = key.substr(0, key.size() - suffix.size());
+  auto candidates = DiskCache::FindCacheKeys(prefix);
+  std::string bestKey = {};
+  tgfx::ImageInfo bestInfo = {};
+  for (auto& candidate : candidates) {
+    if (candidate == key) {
+      continue;
+    }
+    auto variantInfo =
+        DiskCache::PeekSequenceInfo(candidate, _numFrames, _frameRate, staticTimeRanges);
+    if (variantInfo.isEmpty() || variantInfo.colorType() != info.colorType() ||
+        variantInfo.alphaType() != info.alphaType() || variantInfo.width() < _width ||
+        variantInfo.height() < _height) {
+      continue;
+    }
+    // 选择足够大的变体里最小的那个，解压带宽随像素数线性增长。
+    if (bestKey.empty() ||
+        variantInfo.width() * variantInfo.height() < bestInfo.width() * bestInfo.height()) {
+      bestKey = candidate;
+      bestInfo = variantInfo;
+    }
+  }
+  if (bestKey.empty()) {
+    return;
+  }
+  variantFile = DiskCache::OpenSequence(bestKey, bestInfo, _numFrames, _frameRate,
+                                        staticTimeRanges);
+}
+
+bool PAGDecoder::readFrameFromVariant(int index, std::shared_ptr<BitmapBuffer> bitmap) {
+  if (variantFile == nullptr) {
+    return false;
+  }
+  auto srcInfo = variantFile->info();
+  if (variantPixels.size() < srcInfo.byteSize()) {
+    variantPixels.resize(srcInfo.byteSize());
+  }
+  auto srcBitmap = BitmapBuffer::Wrap(srcInfo, variantPixels.data());
+  if (!variantFile->readFrame(index, srcBitmap)) {
+    return false;
+  }
+  auto dstPixels = reinterpret_cast<uint8_t*>(bitmap->lockPixels());
+  if (dstPixels == nullptr) {
+    return false;
+  }
+  ScaleDownPixels(srcInfo, variantPixels.data(), bitmap->info(), dstPixels);
+  bitmap->unlockPixels();
+  return true;
+}
+
 bool PAGDecoder::checkSequenceFile(std::shared_ptr<PAGComposition> composition,
                                    const tgfx::ImageInfo& info) {
   if (sequenceFile != nullptr) {
@@ -251,6 +724,10 @@ bool PAGDecoder::checkSequenceFile(std::shared_ptr<PAGComposition> composition,
     LOGE("PAGDecoder: Failed to open SequenceFile!");
     return false;
   }
+  if (!sequenceFile->isComplete()) {
+    // 缓存尚未补齐时，查找同一内容更大分辨率的缓存变体，缺失的帧用它降采样补齐，省去重新渲染。
+    openVariantFile(key, info);
+  }
   *lastImageInfo = info;
   return true;
 }
@@ -264,6 +741,7 @@ void PAGDecoder::checkCompositionChange(std::shared_ptr<PAGComposition> composit
     return;
   }
   sequenceFile = nullptr;
+  variantFile = nullptr;
   lastContentVersion = contentVersion;
   lastReadIndex = -1;
   auto result = GetFrameCountAndRate(composition, maxFrameRate);
@@ -292,4 +770,16 @@ void PAGDecoder::setCacheKeyGeneratorFun(
   cacheKeyGeneratorFun = fun;
 }
 
+void PAGDecoder::setFrameScaler(
+    std::function<bool(const void* srcPixels, size_t srcRowBytes, int srcWidth, int srcHeight,
+                       void* dstPixels, size_t dstRowBytes, int dstWidth, int dstHeight)>
+        scaler) {
+  std::lock_guard<std::mutex> auoLock(locker);
+  if (reader != nullptr || sequenceFile != nullptr) {
+    LOGE("PAGDecoder::setFrameScaler() must be called before the first reading call!");
+    return;
+  }
+  frameScaler = std::move(scaler);
+}
+
 }  // namespace pag
@@ -18,21 +18,51 @@
 
 #include "base/utils/TGFXCast.h"
 #include "base/utils/TimeUtil.h"
+#include "base/utils/USE.h"
 #include "pag/file.h"
 #include "rendering/FileReporter.h"
+#include "rendering/FontManager.h"
+#include "rendering/ReportAggregator.h"
+#include "rendering/caches/DiskCache.h"
+#include "rendering/caches/LayerCache.h"
 #include "rendering/caches/RenderCache.h"
+#include "rendering/caches/WarmStartCache.h"
 #include "rendering/drawables/Drawable.h"
+#include "rendering/filters/FilterModifier.h"
 #include "rendering/layers/PAGStage.h"
 #include "rendering/utils/ApplyScaleMode.h"
+#include "rendering/utils/FrameProfiler.h"
 #include "rendering/utils/LockGuard.h"
+#include "rendering/utils/ReplayCapture.h"
 #include "rendering/utils/ScopedLock.h"
+#include "rendering/utils/Trace.h"
 #include "tgfx/core/Clock.h"
+#include "tgfx/core/Task.h"
 
 namespace pag {
+/**
+ * An immutable snapshot of the play position, published via atomic shared_ptr swap so that
+ * getters on other threads can read it without taking the rootLocker.
+ */
+struct FrameState {
+  double progress = 0;
+  Frame currentFrame = 0;
+};
+
 PAGPlayer::PAGPlayer() {
   stage = PAGStage::Make(0, 0);
   rootLocker = stage->rootLocker;
   renderCache = new RenderCache(stage.get());
+  // 进程内首个 PAGPlayer 创建时在后台预热一次性的初始化：磁盘缓存配置加载和系统回退字体注册,
+  // 首次 flush 不再被这些准备工作拖慢冷启动首帧。
+  static auto warmedUp = [] {
+    tgfx::Task::Run([]() {
+      DiskCache::Preload();
+      FontManager::GetFallbackTypefaces();
+    });
+    return true;
+  }();
+  USE(warmedUp);
 }
 
 PAGPlayer::~PAGPlayer() {
@@ -67,6 +97,9 @@ void PAGPlayer::setComposition(std::shared_ptr<PAGComposition> newComposition) {
     reporter = FileReporter::Make(pagComposition).release();
     updateScaleModeIfNeed();
   }
+  // 下一次 flush 时尝试从 WarmStartCache 恢复同一文件之前停放的解码内容。
+  warmStartPending = pagComposition != nullptr;
+  publishFrameState();
 }
 
 std::shared_ptr<PAGSurface> PAGPlayer::getSurface() {
@@ -113,6 +146,16 @@ void PAGPlayer::setVideoEnabled(bool value) {
   renderCache->setVideoEnabled(value);
 }
 
+int PAGPlayer::sequenceReadAheadCount() {
+  LockGuard autoLock(rootLocker);
+  return renderCache->sequenceReadAheadCount();
+}
+
+void PAGPlayer::setSequenceReadAheadCount(int count) {
+  LockGuard autoLock(rootLocker);
+  renderCache->setSequenceReadAheadCount(count);
+}
+
 bool PAGPlayer::cacheEnabled() {
   LockGuard autoLock(rootLocker);
   return renderCache->snapshotEnabled();
@@ -156,6 +199,33 @@ void PAGPlayer::setMaxFrameRate(float value) {
   _maxFrameRate = value;
 }
 
+PAGRenderQuality PAGPlayer::renderQuality() {
+  LockGuard autoLock(rootLocker);
+  return _renderQuality;
+}
+
+void PAGPlayer::setRenderQuality(PAGRenderQuality value) {
+  LockGuard autoLock(rootLocker);
+  if (_renderQuality == value) {
+    return;
+  }
+  _renderQuality = value;
+  renderCache->renderQuality = value;
+  // 画质切换会改变滤镜和快照的生成路径，通知舞台让下一次 flush() 真正重绘。
+  stage->notifyModified(true);
+}
+
+float PAGPlayer::frameBudget() {
+  LockGuard autoLock(rootLocker);
+  return _frameBudget;
+}
+
+void PAGPlayer::setFrameBudget(float milliseconds) {
+  LockGuard autoLock(rootLocker);
+  _frameBudget = milliseconds < 0 ? 0 : milliseconds;
+  renderCache->frameBudget = static_cast<int64_t>(_frameBudget * 1000.0f);
+}
+
 PAGScaleMode PAGPlayer::scaleMode() {
   LockGuard autoLock(rootLocker);
   return _scaleMode;
@@ -202,6 +272,7 @@ void PAGPlayer::nextFrame() {
   if (pagComposition) {
     pagComposition->nextFrameInternal();
   }
+  publishFrameState();
 }
 
 void PAGPlayer::preFrame() {
@@ -210,12 +281,12 @@ void PAGPlayer::preFrame() {
   if (pagComposition) {
     pagComposition->preFrameInternal();
   }
+  publishFrameState();
 }
 
 double PAGPlayer::getProgress() {
-  LockGuard autoLock(rootLocker);
-  auto pagComposition = stage->getRootComposition();
-  return pagComposition ? pagComposition->getProgressInternal() : 0;
+  auto state = std::atomic_load(&frameState);
+  return state ? state->progress : 0;
 }
 
 void PAGPlayer::setProgress(double percent) {
@@ -226,21 +297,38 @@ void PAGPlayer::setProgress(double percent) {
   }
   auto realProgress = percent;
   auto frameRate = pagComposition->frameRateInternal();
-  if (_maxFrameRate < frameRate && _maxFrameRate > 0) {
+  auto maxFrameRate = _maxFrameRate;
+  if (_renderQuality == PAGRenderQuality::PowerSaving && (maxFrameRate > 30 || maxFrameRate <= 0)) {
+    // 省电模式下帧率上限压到 30，用户配置的 maxFrameRate 不被覆盖，切回默认画质时继续生效。
+    maxFrameRate = 30;
+  }
+  if (maxFrameRate < frameRate && maxFrameRate > 0) {
     auto duration = pagComposition->durationInternal();
     auto totalFrames = TimeToFrame(duration, frameRate);
-    auto numFrames = ceilf(totalFrames * _maxFrameRate / frameRate);
+    auto numFrames = ceilf(totalFrames * maxFrameRate / frameRate);
     // 首先计算在maxFrameRate的帧号，之后重新计算progress
     auto targetFrame = ProgressToFrame(realProgress, numFrames);
     realProgress = FrameToProgress(targetFrame, numFrames);
   }
   pagComposition->setProgressInternal(realProgress);
+  publishFrameState();
 }
 
 Frame PAGPlayer::currentFrame() const {
-  LockGuard autoLock(rootLocker);
+  auto state = std::atomic_load(&frameState);
+  return state ? state->currentFrame : 0;
+}
+
+void PAGPlayer::publishFrameState() {
+  auto state = std::make_shared<FrameState>();
   auto pagComposition = stage->getRootComposition();
-  return pagComposition ? pagComposition->currentFrameInternal() : 0;
+  if (pagComposition) {
+    state->progress = pagComposition->getProgressInternal();
+    state->currentFrame = pagComposition->currentFrameInternal();
+  }
+  // The old state stays valid for readers that already loaded it; they just see the previous
+  // frame for one call.
+  std::atomic_store(&frameState, std::move(state));
 }
 
 bool PAGPlayer::autoClear() {
@@ -257,22 +345,219 @@ void PAGPlayer::setAutoClear(bool value) {
   stage->notifyModified(true);
 }
 
-void PAGPlayer::prepare() {
+bool PAGPlayer::dirtyRegionEnabled() {
+  LockGuard autoLock(rootLocker);
+  return _dirtyRegionEnabled;
+}
+
+void PAGPlayer::setDirtyRegionEnabled(bool value) {
+  LockGuard autoLock(rootLocker);
+  if (_dirtyRegionEnabled == value) {
+    return;
+  }
+  _dirtyRegionEnabled = value;
+  lastDamage = Rect::MakeEmpty();
+  currentDamage = Rect::MakeEmpty();
+  // Force a full redraw on the next flush so the surface is consistent before clipping starts.
+  stage->notifyModified(true);
+}
+
+Rect PAGPlayer::viewportRect() {
+  LockGuard autoLock(rootLocker);
+  return _viewportRect;
+}
+
+void PAGPlayer::setViewportRect(const Rect& rect) {
+  LockGuard autoLock(rootLocker);
+  if (_viewportRect == rect) {
+    return;
+  }
+  _viewportRect = rect;
+  // 视口会影响遍历期间的剔除结果，内容需要在下一次 flush 时重新生成。
+  stage->notifyModified(true);
+}
+
+Rect PAGPlayer::getDamageBounds() {
+  LockGuard autoLock(rootLocker);
+  if (!_dirtyRegionEnabled) {
+    return Rect::MakeWH(static_cast<float>(stage->widthInternal()),
+                        static_cast<float>(stage->heightInternal()));
+  }
+  return currentDamage;
+}
+
+void PAGPlayer::CollectDamageBounds(PAGLayer* pagLayer, const tgfx::Matrix& parentMatrix,
+                                    tgfx::Rect* bounds) {
+  auto matrix = parentMatrix;
+  matrix.preConcat(ToTGFX(pagLayer->getTotalMatrixInternal()));
+  auto layerCache = LayerCache::Get(pagLayer->layer);
+  auto contentFrame = pagLayer->contentFrame;
+  // 上一次 flush 的帧未必是 contentFrame - 1（seek、丢帧），按图层记录的上次采集帧比较，
+  // 否则跳帧后留在画面上的旧内容不会被标脏。
+  auto firstCollect = !pagLayer->damageFrameValid;
+  auto lastFrame = firstCollect ? contentFrame - 1 : pagLayer->damageFrame;
+  pagLayer->damageFrame = contentFrame;
+  pagLayer->damageFrameValid = true;
+  auto frameChanged = firstCollect || pagLayer->contentModified() ||
+                      layerCache->checkFrameChanged(contentFrame, lastFrame);
+  if (!frameChanged) {
+    return;
+  }
+  if (pagLayer->layerType() == LayerType::PreCompose && !firstCollect &&
+      !layerCache->transformFrameChanged(contentFrame, lastFrame)) {
+    // The composition holds still while some of its children animate, visit the children so only
+    // the animating ones contribute to the damage.
+    auto composition = static_cast<PAGComposition*>(pagLayer);
+    if (!composition->layers.empty() && !composition->contentModified()) {
+      for (auto& childLayer : composition->layers) {
+        CollectDamageBounds(childLayer.get(), matrix, bounds);
+      }
+      return;
+    }
+  }
+  tgfx::Rect layerBounds = {};
+  pagLayer->measureBounds(&layerBounds);
+  // measureBounds() 只覆盖内容本身，阴影、发光、运动模糊等滤镜输出会超出内容区域，
+  // 损伤区域要按滤镜链扩展，否则滤镜溢出的部分不会被重绘。
+  auto boundsModifier = FilterModifier::Make(pagLayer);
+  if (boundsModifier != nullptr) {
+    boundsModifier->applyToBounds(&layerBounds);
+  }
+  matrix.mapRect(&layerBounds);
+  bounds->join(layerBounds);
+  // 图层移动或形变后旧位置也要重绘，否则上一帧的残影会留在原地，把上次采集时占据的
+  // 区域一并并入；空矩形的 join 是空操作。
+  bounds->join(ToTGFX(pagLayer->damageBounds));
+  pagLayer->damageBounds = ToPAG(layerBounds);
+}
+
+Rect PAGPlayer::measureDamageBounds() {
+  tgfx::Rect bounds = tgfx::Rect::MakeEmpty();
+  for (auto& childLayer : stage->layers) {
+    CollectDamageBounds(childLayer.get(), tgfx::Matrix::I(), &bounds);
+  }
+  auto stageBounds = tgfx::Rect::MakeWH(static_cast<float>(stage->widthInternal()),
+                                        static_cast<float>(stage->heightInternal()));
+  if (!bounds.intersect(stageBounds)) {
+    bounds.setEmpty();
+  }
+  // The back buffer may be two frames old after a swap, so the damage of this flush has to cover
+  // the previous one as well.
+  auto damage = ToPAG(bounds);
+  auto flushDamage = damage;
+  flushDamage.join(lastDamage);
+  lastDamage = damage;
+  currentDamage = flushDamage;
+  return flushDamage;
+}
+
+void PAGPlayer::prepare(bool warmUpDecoders) {
   LockGuard autoLock(rootLocker);
   prepareInternal();
   if (pagSurface != nullptr && pagSurface->prepare(renderCache, lastGraphic)) {
     return;
   }
-  renderCache->prepareLayers();
+  renderCache->prepareLayers(warmUpDecoders);
+}
+
+void PAGPlayer::prefetch(double progress, bool warmUpDecoders) {
+  LockGuard autoLock(rootLocker);
+  auto pagComposition = stage->getRootComposition();
+  if (pagComposition == nullptr) {
+    return;
+  }
+  auto currentProgress = pagComposition->getProgressInternal();
+  pagComposition->setProgressInternal(progress);
+  prepareInternal();
+  if (pagSurface == nullptr || !pagSurface->prepare(renderCache, lastGraphic)) {
+    renderCache->prepareLayers(warmUpDecoders);
+  }
+  // 恢复当前进度，预热只填充缓存，不发布帧状态，也不改变可见内容。
+  pagComposition->setProgressInternal(currentProgress);
+  prepareInternal();
+}
+
+void PAGPlayer::preloadComposition(std::shared_ptr<PAGComposition> composition, double progress) {
+  LockGuard autoLock(rootLocker);
+  if (composition == nullptr || composition->stage != nullptr || !composition->isPAGFile()) {
+    return;
+  }
+  auto path = std::static_pointer_cast<PAGFile>(composition)->path();
+  if (path.empty()) {
+    return;
+  }
+  // 在临时舞台上收集目标进度的解码任务并停放到 WarmStartCache，正在播放的合成不受任何影响。
+  // 之后 setComposition() 切换到该合成时，下一次 flush 直接恢复停放内容，首帧不再重新解码。
+  auto tempStage = PAGStage::Make(composition->widthInternal(), composition->heightInternal());
+  auto tempCache = new RenderCache(tempStage.get());
+  tempStage->doAddLayer(composition, 0);
+  auto currentProgress = composition->getProgressInternal();
+  composition->setProgressInternal(progress);
+  tempCache->beginFrame();
+  tempCache->prepareLayers(true);
+  auto content = tempCache->parkContent();
+  if (content != nullptr) {
+    WarmStartCache::GetInstance()->park(WarmStartCache::MakeKey(path, progress),
+                                        std::move(content));
+  }
+  composition->setProgressInternal(currentProgress);
+  delete tempCache;
+  tempStage->doRemoveLayer(0);
+}
+
+void PAGPlayer::parkCache() {
+  LockGuard autoLock(rootLocker);
+  auto key = getWarmStartKey();
+  if (key.empty()) {
+    return;
+  }
+  auto content = renderCache->parkContent();
+  if (content != nullptr) {
+    WarmStartCache::GetInstance()->park(key, std::move(content));
+  }
+}
+
+std::string PAGPlayer::getWarmStartKey() {
+  auto pagComposition = stage->getRootComposition();
+  if (pagComposition == nullptr || !pagComposition->isPAGFile()) {
+    return "";
+  }
+  auto path = std::static_pointer_cast<PAGFile>(pagComposition)->path();
+  if (path.empty()) {
+    return "";
+  }
+  return WarmStartCache::MakeKey(path, pagComposition->getProgressInternal());
 }
 
 void PAGPlayer::prepareInternal() {
   renderCache->beginFrame();
+  if (warmStartPending) {
+    warmStartPending = false;
+    auto key = getWarmStartKey();
+    if (!key.empty()) {
+      renderCache->restoreContent(WarmStartCache::GetInstance()->restore(key));
+    }
+  }
   auto result = updateStageSize();
   if (result && contentVersion != stage->getContentVersion()) {
     contentVersion = stage->getContentVersion();
     Recorder recorder = {};
+    auto viewport = ToTGFX(_viewportRect);
+    // 没有设置视口时，舞台边界本身就是剔除范围：从远处屏幕外移入的图层在进入可见区域之前，
+    // 内容生成、滤镜和缓存的开销全部跳过。
+    auto cullRect = viewport.isEmpty()
+                        ? tgfx::Rect::MakeWH(static_cast<float>(stage->widthInternal()),
+                                             static_cast<float>(stage->heightInternal()))
+                        : viewport;
+    recorder.setCullRect(cullRect);
+    if (!viewport.isEmpty()) {
+      // 视口外的图层在遍历时整个剔除，视口内的内容再用裁剪约束到视口范围。
+      recorder.saveClip(viewport.x(), viewport.y(), viewport.width(), viewport.height());
+    }
     stage->draw(&recorder);
+    if (!viewport.isEmpty()) {
+      recorder.restore();
+    }
     lastGraphic = recorder.makeGraphic();
   }
 }
@@ -295,14 +580,37 @@ bool PAGPlayer::flush() {
   return flushInternal(nullptr);
 }
 
+void PAGPlayer::performIdleMaintenance() {
+  LockGuard autoLock(rootLocker);
+  if (pagSurface == nullptr) {
+    return;
+  }
+  auto context = pagSurface->lockContext();
+  if (context == nullptr) {
+    return;
+  }
+  renderCache->performIdleMaintenance(context);
+  pagSurface->unlockContext();
+}
+
 bool PAGPlayer::flushInternal(BackendSemaphore* signalSemaphore) {
   if (pagSurface == nullptr) {
     return false;
   }
+  TraceEvent traceEvent("PAGPlayer::flushInternal");
   tgfx::Clock clock = {};
+  if (profiler != nullptr) {
+    profiler->begin();
+  }
   prepareInternal();
+  Rect damageBounds = Rect::MakeEmpty();
+  const Rect* damage = nullptr;
+  if (_dirtyRegionEnabled) {
+    damageBounds = measureDamageBounds();
+    damage = &damageBounds;
+  }
   clock.mark("rendering");
-  if (!pagSurface->draw(renderCache, lastGraphic, signalSemaphore, _autoClear)) {
+  if (!pagSurface->draw(renderCache, lastGraphic, signalSemaphore, _autoClear, damage)) {
     return false;
   }
   clock.mark("presenting");
@@ -318,6 +626,17 @@ bool PAGPlayer::flushInternal(BackendSemaphore* signalSemaphore) {
   if (reporter) {
     reporter->recordPerformance(renderCache);
   }
+  ReportAggregator::GetInstance()->recordFlush(renderCache);
+  if (replayCapture != nullptr) {
+    auto pagComposition = stage->getRootComposition();
+    auto progress = pagComposition ? pagComposition->getProgressInternal() : 0;
+    replayCapture->recordFlush(progress, pagSurface->width(), pagSurface->height(), renderCache);
+  }
+  if (profiler != nullptr) {
+    profiler->end();
+    lastFrameProfile = profiler->makeProfile();
+  }
+  publishFrameState();
   return true;
 }
 
@@ -331,19 +650,21 @@ Rect PAGPlayer::getBounds(std::shared_ptr<PAGLayer> pagLayer) {
   pagLayer->measureBounds(&bounds);
   auto layer = pagLayer.get();
   bool contains = false;
+  // 先把祖先矩阵拼成一个再映射一次，避免每级都对包围盒取一次外接矩形，旋转时结果也更紧。
+  auto totalMatrix = tgfx::Matrix::I();
   while (layer) {
     if (layer == stage.get()) {
       contains = true;
       break;
     }
-    auto layerMatrix = ToTGFX(layer->getTotalMatrixInternal());
-    layerMatrix.mapRect(&bounds);
+    totalMatrix.postConcat(ToTGFX(layer->getTotalMatrixInternal()));
     if (layer->_parent == nullptr && layer->trackMatteOwner) {
       layer = layer->trackMatteOwner->_parent;
     } else {
       layer = layer->_parent;
     }
   }
+  totalMatrix.mapRect(&bounds);
   return contains ? ToPAG(bounds) : Rect::MakeEmpty();
 }
 
@@ -386,6 +707,66 @@ int64_t PAGPlayer::getTimeStampInternal() {
   return static_cast<int64_t>(ceil(progress * duration));
 }
 
+bool PAGPlayer::profilingEnabled() {
+  LockGuard autoLock(rootLocker);
+  return profiler != nullptr;
+}
+
+void PAGPlayer::setProfilingEnabled(bool value) {
+  LockGuard autoLock(rootLocker);
+  if (value == (profiler != nullptr)) {
+    return;
+  }
+  if (value) {
+    profiler = std::make_unique<FrameProfiler>();
+    profiler->recordGpuCost = _gpuProfilingEnabled;
+  } else {
+    profiler = nullptr;
+    lastFrameProfile = {};
+  }
+  // Layers and caches reach the profiler through the stage and the render cache while drawing.
+  stage->profiler = profiler.get();
+  renderCache->profiler = profiler.get();
+}
+
+void PAGPlayer::startReplayCapture() {
+  LockGuard autoLock(rootLocker);
+  if (replayCapture != nullptr) {
+    return;
+  }
+  replayCapture = std::make_unique<ReplayCapture>();
+  stage->replayCapture = replayCapture.get();
+}
+
+std::string PAGPlayer::stopReplayCapture() {
+  LockGuard autoLock(rootLocker);
+  if (replayCapture == nullptr) {
+    return "";
+  }
+  auto log = replayCapture->makeLog();
+  stage->replayCapture = nullptr;
+  replayCapture = nullptr;
+  return log;
+}
+
+bool PAGPlayer::gpuProfilingEnabled() {
+  LockGuard autoLock(rootLocker);
+  return _gpuProfilingEnabled;
+}
+
+void PAGPlayer::setGpuProfilingEnabled(bool value) {
+  LockGuard autoLock(rootLocker);
+  _gpuProfilingEnabled = value;
+  if (profiler != nullptr) {
+    profiler->recordGpuCost = value;
+  }
+}
+
+FrameProfileNode PAGPlayer::getFrameProfile() {
+  LockGuard autoLock(rootLocker);
+  return lastFrameProfile;
+}
+
 int64_t PAGPlayer::renderingTime() {
   LockGuard autoLock(rootLocker);
   // TODO(domrjchen): update the performance monitoring panel of PAGViewer to display the new
@@ -23,9 +23,11 @@
 #include "rendering/drawables/Drawable.h"
 #include "rendering/graphics/Recorder.h"
 #include "rendering/utils/GLRestorer.h"
+#include "rendering/utils/GpuPassTimer.h"
 #include "rendering/utils/LockGuard.h"
 #include "rendering/utils/shaper/TextShaper.h"
 #include "tgfx/core/Clock.h"
+#include "tgfx/core/Shader.h"
 
 namespace pag {
 
@@ -46,9 +48,10 @@ int PAGSurface::height() {
 
 void PAGSurface::updateSize() {
   LockGuard autoLock(rootLocker);
-  TextShaper::PurgeCaches();
+  // 尺寸变化只让随缩放生成的缓存失效，排版结果、解码后的资产图片和序列帧与分辨率无关，
+  // 保留下来让旋转屏幕后的首帧直接复用，不再经历逐帧重建。
   if (pagPlayer) {
-    pagPlayer->renderCache->releaseAll();
+    pagPlayer->renderCache->releaseScaledCaches();
   }
   drawable->freeSurface();
   drawable->updateSize();
@@ -93,6 +96,41 @@ bool PAGSurface::clearAll() {
   return true;
 }
 
+bool PAGSurface::warmUp() {
+  LockGuard autoLock(rootLocker);
+  auto context = lockContext();
+  if (!context) {
+    return false;
+  }
+  auto surface = drawable->getSurface(context, false);
+  if (surface == nullptr) {
+    unlockContext();
+    return false;
+  }
+  // 在 1x1 的裁剪区域内画一遍最常见的绘制组合（清屏、实色和渐变填充），促使上下文提前编译
+  // 对应的着色器程序，首帧 flush 就只剩真正的内容绘制。画完后恢复为透明，且不做 present，
+  // 不会影响窗口上已有的内容。
+  auto canvas = surface->getCanvas();
+  auto warmUpRect = tgfx::Rect::MakeWH(1, 1);
+  canvas->save();
+  canvas->clipRect(warmUpRect);
+  canvas->clear();
+  tgfx::Paint paint = {};
+  paint.setColor(tgfx::Color::White());
+  canvas->drawRect(warmUpRect, paint);
+  std::vector<tgfx::Color> colors = {tgfx::Color::White(), tgfx::Color::Black()};
+  std::vector<float> positions = {0.0f, 1.0f};
+  paint.setShader(
+      tgfx::Shader::MakeLinearGradient(tgfx::Point::Zero(), {1, 1}, colors, positions));
+  canvas->drawRect(warmUpRect, paint);
+  canvas->clear();
+  canvas->restore();
+  context->flush();
+  context->submit();
+  unlockContext();
+  return true;
+}
+
 HardwareBufferRef PAGSurface::getHardwareBuffer() {
   LockGuard autoLock(rootLocker);
   auto context = lockContext();
@@ -193,7 +231,8 @@ bool PAGSurface::readPixels(ColorType colorType, AlphaType alphaType, void* dstP
 }
 
 bool PAGSurface::draw(RenderCache* cache, std::shared_ptr<Graphic> graphic,
-                      BackendSemaphore* signalSemaphore, bool autoClear) {
+                      BackendSemaphore* signalSemaphore, bool autoClear,
+                      const Rect* damageBounds) {
   auto context = lockContext();
   if (!context) {
     return false;
@@ -214,10 +253,24 @@ bool PAGSurface::draw(RenderCache* cache, std::shared_ptr<Graphic> graphic,
   contentVersion = cache->getContentVersion();
   cache->attachToContext(context);
   auto canvas = surface->getCanvas();
+  if (damageBounds != nullptr) {
+    // Scissor both the clearing and the drawing to the damaged region, the rest of the surface
+    // still holds the previous frame.
+    canvas->save();
+    canvas->clipRect(ToTGFX(*damageBounds));
+  }
   if (autoClear) {
     canvas->clear();
   }
-  onDraw(graphic, surface, cache);
+  {
+    // 合成走一个独立的剖析作用域，滤镜节点会嵌套在它下面，GPU 耗时可以按滤镜和基础合成拆开。
+    ProfileScope profileScope(cache->profiler, "compositing");
+    GpuPassTimer gpuPassTimer(cache->profiler, context);
+    onDraw(graphic, surface, cache);
+  }
+  if (damageBounds != nullptr) {
+    canvas->restore();
+  }
   if (signalSemaphore == nullptr) {
     context->flush();
   } else {
@@ -67,6 +67,12 @@ std::shared_ptr<PAGSurface> PAGSurface::MakeOffscreen(int width, int height) {
   return MakeFrom(drawable);
 }
 
+std::shared_ptr<PAGSurface> PAGSurface::MakeOffscreen(int width, int height,
+                                                      bool useSharedDevice) {
+  auto drawable = OffscreenDrawable::Make(width, height, useSharedDevice);
+  return MakeFrom(drawable);
+}
+
 std::shared_ptr<PAGSurface> PAGSurface::MakeFrom(HardwareBufferRef hardwareBuffer) {
   auto drawable = HardwareBufferDrawable::MakeFrom(hardwareBuffer);
   return MakeFrom(drawable);
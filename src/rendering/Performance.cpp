@@ -51,6 +51,7 @@ void Performance::resetPerformance() {
 
   hardwareDecodingInitialTime = 0;
   softwareDecodingInitialTime = 0;
+  videoSeekingTime = 0;
   totalTime = 0;
 }
 }  // namespace pag
\ No newline at end of file
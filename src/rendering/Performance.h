@@ -38,6 +38,11 @@ class Performance {
 
   int64_t hardwareDecodingInitialTime = 0;
   int64_t softwareDecodingInitialTime = 0;
+  /**
+   * The total time spent on video seeking, which includes flushing the decoder and decoding from
+   * the prior keyframe up to the target frame.
+   */
+  int64_t videoSeekingTime = 0;
   int64_t totalTime = 0;
 
   /**
@@ -0,0 +1,113 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ReportAggregator.h"
+#include <algorithm>
+#include "rendering/caches/RenderCache.h"
+#include "rendering/utils/RenderTaskScheduler.h"
+#include "tgfx/core/Clock.h"
+
+namespace pag {
+// 20 个 2 的幂次桶覆盖 1µs 到约半秒，再长的都落在最后一个桶里。
+static constexpr size_t TIME_BUCKET_COUNT = 20;
+
+void PAGTelemetry::SetSamplingInterval(int interval) {
+  ReportAggregator::GetInstance()->setSamplingInterval(interval);
+}
+
+void PAGTelemetry::SetSnapshotCallback(std::function<void(const PAGTelemetrySnapshot&)> callback,
+                                       int64_t interval) {
+  ReportAggregator::GetInstance()->setSnapshotCallback(std::move(callback), interval);
+}
+
+static size_t GetTimeBucket(int64_t time) {
+  size_t index = 0;
+  while (time > 1 && index < TIME_BUCKET_COUNT - 1) {
+    time >>= 1;
+    index++;
+  }
+  return index;
+}
+
+ReportAggregator* ReportAggregator::GetInstance() {
+  static auto& instance = *new ReportAggregator();
+  return &instance;
+}
+
+ReportAggregator::ReportAggregator() {
+  resetWindow(tgfx::Clock::Now());
+}
+
+void ReportAggregator::resetWindow(int64_t startTime) {
+  window = {};
+  window.startTime = startTime;
+  window.flushTimeBuckets.resize(TIME_BUCKET_COUNT, 0);
+  window.renderTimeBuckets.resize(TIME_BUCKET_COUNT, 0);
+  window.decodeTimeBuckets.resize(TIME_BUCKET_COUNT, 0);
+}
+
+void ReportAggregator::setSamplingInterval(int interval) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  samplingInterval = std::max(interval, 1);
+}
+
+void ReportAggregator::setSnapshotCallback(
+    std::function<void(const PAGTelemetrySnapshot&)> snapshotCallback, int64_t interval) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  callback = std::move(snapshotCallback);
+  snapshotInterval = interval;
+  resetWindow(tgfx::Clock::Now());
+}
+
+void ReportAggregator::recordFlush(RenderCache* cache) {
+  std::function<void(const PAGTelemetrySnapshot&)> pendingCallback = nullptr;
+  PAGTelemetrySnapshot snapshot = {};
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    window.flushCount++;
+    window.snapshotHitCount += cache->snapshotHitCount;
+    window.snapshotMissCount += cache->snapshotMissCount;
+    if (window.flushCount % samplingInterval == 0) {
+      window.sampledCount++;
+      window.flushTimeBuckets[GetTimeBucket(cache->totalTime)]++;
+      window.renderTimeBuckets[GetTimeBucket(cache->totalTime - cache->presentingTime)]++;
+      auto decodingTime =
+          cache->imageDecodingTime + cache->hardwareDecodingTime + cache->softwareDecodingTime;
+      if (decodingTime > 0) {
+        window.decodeTimeBuckets[GetTimeBucket(decodingTime)]++;
+      }
+      window.graphicsMemoryMax = std::max(window.graphicsMemoryMax, cache->memoryUsage());
+    }
+    auto now = tgfx::Clock::Now();
+    if (callback != nullptr && snapshotInterval > 0 && now - window.startTime >= snapshotInterval) {
+      window.endTime = now;
+      snapshot = window;
+      pendingCallback = callback;
+      resetWindow(now);
+    }
+  }
+  if (pendingCallback != nullptr) {
+    // 回调可能做序列化或上报，放到共享任务池上执行，flush 线程只负责拷贝一次快照。
+    RenderTaskScheduler::GetInstance()->submit(
+        [snapshot = std::move(snapshot), pendingCallback = std::move(pendingCallback)]() {
+          pendingCallback(snapshot);
+        },
+        TaskPriority::Speculative);
+  }
+}
+}  // namespace pag
@@ -0,0 +1,58 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include "pag/pag.h"
+
+namespace pag {
+class RenderCache;
+
+/**
+ * ReportAggregator rolls the per-flush performance data of every player in the process into one
+ * set of histograms and delivers them through a single periodic callback. The flush path only
+ * pays for a few counter increments under a short lock; the callback itself runs on the shared
+ * render task pool.
+ */
+class ReportAggregator {
+ public:
+  static ReportAggregator* GetInstance();
+
+  /**
+   * Records the performance data of a finished flush into the current window.
+   */
+  void recordFlush(RenderCache* cache);
+
+  void setSamplingInterval(int interval);
+
+  void setSnapshotCallback(std::function<void(const PAGTelemetrySnapshot&)> callback,
+                           int64_t interval);
+
+ private:
+  std::mutex locker = {};
+  int samplingInterval = 1;
+  int64_t snapshotInterval = 0;
+  std::function<void(const PAGTelemetrySnapshot&)> callback = nullptr;
+  PAGTelemetrySnapshot window = {};
+
+  ReportAggregator();
+
+  void resetWindow(int64_t startTime);
+};
+}  // namespace pag
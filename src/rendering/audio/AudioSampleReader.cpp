@@ -0,0 +1,122 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "AudioSampleReader.h"
+#include <algorithm>
+#include "base/utils/TimeUtil.h"
+
+namespace pag {
+// ADTS 固定每帧 1024 个 PCM 采样。
+static constexpr int64_t SAMPLES_PER_FRAME = 1024;
+static constexpr size_t ADTS_HEADER_SIZE = 7;
+
+static const int SAMPLE_RATES[] = {96000, 88200, 64000, 48000, 44100, 32000, 24000,
+                                   22050, 16000, 12000, 11025, 8000,  7350};
+
+std::unique_ptr<AudioSampleReader> AudioSampleReader::Make(std::shared_ptr<File> file,
+                                                           Composition* composition) {
+  if (file == nullptr || composition == nullptr || composition->audioBytes == nullptr ||
+      composition->audioBytes->length() < ADTS_HEADER_SIZE) {
+    return nullptr;
+  }
+  auto startTime = FrameToTime(composition->audioStartTime, composition->frameRate);
+  auto reader = std::unique_ptr<AudioSampleReader>(
+      new AudioSampleReader(std::move(file), composition->audioBytes));
+  if (!reader->buildSampleIndex(startTime)) {
+    return nullptr;
+  }
+  return reader;
+}
+
+AudioSampleReader::AudioSampleReader(std::shared_ptr<File> file, ByteData* audioBytes)
+    : file(std::move(file)), audioBytes(audioBytes) {
+}
+
+bool AudioSampleReader::buildSampleIndex(int64_t startTime) {
+  auto bytes = audioBytes->data();
+  auto length = audioBytes->length();
+  size_t offset = 0;
+  int64_t sampleCount = 0;
+  while (offset + ADTS_HEADER_SIZE <= length) {
+    if (bytes[offset] != 0xFF || (bytes[offset + 1] & 0xF0) != 0xF0) {
+      return false;
+    }
+    auto sampleRateIndex = (bytes[offset + 2] >> 2) & 0x0F;
+    if (sampleRateIndex >= 13) {
+      return false;
+    }
+    auto frameLength = static_cast<size_t>(((bytes[offset + 3] & 0x03) << 11) |
+                                           (bytes[offset + 4] << 3) | (bytes[offset + 5] >> 5));
+    if (frameLength < ADTS_HEADER_SIZE || offset + frameLength > length) {
+      return false;
+    }
+    if (_sampleRate == 0) {
+      _sampleRate = SAMPLE_RATES[sampleRateIndex];
+      _channels = ((bytes[offset + 2] & 0x01) << 2) | (bytes[offset + 3] >> 6);
+    }
+    SampleEntry entry = {};
+    entry.offset = offset;
+    entry.length = frameLength;
+    entry.time = startTime + sampleCount * SAMPLES_PER_FRAME * 1000000 / _sampleRate;
+    sampleEntries.push_back(entry);
+    offset += frameLength;
+    sampleCount++;
+  }
+  return !sampleEntries.empty() && _sampleRate > 0;
+}
+
+int64_t AudioSampleReader::duration() const {
+  auto& lastEntry = sampleEntries.back();
+  return lastEntry.time + SAMPLES_PER_FRAME * 1000000 / _sampleRate;
+}
+
+AudioSample AudioSampleReader::nextSample() {
+  AudioSample sample = {};
+  if (sampleIndex >= sampleEntries.size()) {
+    return sample;
+  }
+  auto& entry = sampleEntries[sampleIndex];
+  sample.data = audioBytes->data() + entry.offset;
+  sample.length = entry.length;
+  sample.time = entry.time;
+  sampleIndex++;
+  return sample;
+}
+
+size_t AudioSampleReader::findSampleIndexAt(int64_t targetTime) const {
+  auto position =
+      std::upper_bound(sampleEntries.begin(), sampleEntries.end(), targetTime,
+                       [](int64_t time, const SampleEntry& entry) { return time < entry.time; });
+  if (position == sampleEntries.begin()) {
+    return 0;
+  }
+  return static_cast<size_t>(position - sampleEntries.begin()) - 1;
+}
+
+int64_t AudioSampleReader::getSampleTimeAt(int64_t targetTime) {
+  return sampleEntries[findSampleIndexAt(targetTime)].time;
+}
+
+void AudioSampleReader::seekTo(int64_t targetTime) {
+  sampleIndex = findSampleIndexAt(targetTime);
+}
+
+void AudioSampleReader::reset() {
+  sampleIndex = 0;
+}
+}  // namespace pag
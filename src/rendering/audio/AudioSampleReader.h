@@ -0,0 +1,119 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "pag/file.h"
+
+namespace pag {
+/**
+ * This structure stores encoded audio sample data. The data pointer refers into the audio bytes
+ * owned by the File and stays valid as long as the reader is alive, no copy is made.
+ */
+struct AudioSample {
+  /**
+   * The byte data of the sample.
+   */
+  void* data = nullptr;
+  /**
+   * The size in bytes of the data.
+   */
+  size_t length = 0;
+
+  /**
+   * Sample's presentation time in microseconds.
+   */
+  int64_t time = 0;
+};
+
+/**
+ * AudioSampleReader 按时间增量地读出合成音轨里的 AAC 采样，与 VideoSequenceDemuxer 的取样
+ * 方式对应。创建时扫描一遍 ADTS 帧头建好 (偏移, 长度, 时间) 索引，之后的顺序读取和按时间
+ * 定位都只是查表，采样数据零拷贝地指向 File 持有的 audioBytes，播放器不必再整块复制
+ * 几兆的音频负载。
+ */
+class AudioSampleReader {
+ public:
+  /**
+   * 为合成的音轨创建 reader。合成没有音频或负载不是合法的 ADTS 流时返回 nullptr。
+   */
+  static std::unique_ptr<AudioSampleReader> Make(std::shared_ptr<File> file,
+                                                 Composition* composition);
+
+  /**
+   * 音频的采样率（Hz）。
+   */
+  int sampleRate() const {
+    return _sampleRate;
+  }
+
+  /**
+   * 声道数。
+   */
+  int channels() const {
+    return _channels;
+  }
+
+  /**
+   * 音轨的总时长（微秒），含 audioStartTime 偏移。
+   */
+  int64_t duration() const;
+
+  /**
+   * 返回下一个采样，没有更多采样时返回空的 AudioSample。返回的数据在 reader 存活期间有效。
+   */
+  AudioSample nextSample();
+
+  /**
+   * 返回不晚于目标时间的最近一个采样的时间。
+   */
+  int64_t getSampleTimeAt(int64_t targetTime);
+
+  /**
+   * 把读取位置定位到目标时间所在的采样。音频帧之间没有依赖，定位只是移动下标。
+   */
+  void seekTo(int64_t targetTime);
+
+  /**
+   * 回到第一个采样。
+   */
+  void reset();
+
+ private:
+  struct SampleEntry {
+    size_t offset = 0;
+    size_t length = 0;
+    int64_t time = 0;
+  };
+
+  // 与 VideoSequenceDemuxer 一样持有 File 的引用，防止读取期间 Composition 被释放。
+  std::shared_ptr<File> file = nullptr;
+  ByteData* audioBytes = nullptr;
+  std::vector<SampleEntry> sampleEntries = {};
+  size_t sampleIndex = 0;
+  int _sampleRate = 0;
+  int _channels = 0;
+
+  AudioSampleReader(std::shared_ptr<File> file, ByteData* audioBytes);
+
+  bool buildSampleIndex(int64_t startTime);
+  size_t findSampleIndexAt(int64_t targetTime) const;
+};
+}  // namespace pag
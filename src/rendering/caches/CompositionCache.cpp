@@ -22,6 +22,8 @@
 namespace pag {
 
 CompositionCache* CompositionCache::Get(Composition* composition) {
+  // 静态区间是惰性计算的，首次渲染访问时在这里补算，必须在持有 locker 之前完成。
+  composition->ensureStaticTimeRanges();
   std::lock_guard<std::mutex> autoLock(composition->locker);
   if (composition->cache == nullptr) {
     composition->cache = new CompositionCache(composition);
@@ -40,11 +42,20 @@ std::shared_ptr<Graphic> CompositionCache::getContent(Frame contentFrame) {
   if (contentFrame < 0) {
     contentFrame = 0;
   }
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto cache = frames[contentFrame];
+    if (cache != nullptr) {
+      return cache;
+    }
+  }
+  // 共享同一个 File 的多个实例可能并发渲染同一合成，内容构建只读取不可变的模型，放到锁外执行，
+  // 避免实例之间在这里相互串行；并发构建同一帧时只保留先写入的那份。
+  auto content = createContent(contentFrame);
   std::lock_guard<std::mutex> autoLock(locker);
-  auto cache = frames[contentFrame];
+  auto& cache = frames[contentFrame];
   if (cache == nullptr) {
-    cache = createContent(contentFrame);
-    frames[contentFrame] = cache;
+    cache = content;
   }
   return cache;
 }
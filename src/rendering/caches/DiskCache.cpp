@@ -25,6 +25,10 @@
 #include "tgfx/core/Stream.h"
 
 namespace pag {
+// The header of a cache archive file ('PAGA'), followed by entries of
+// [keyLength, dataLength, key, data] with both lengths stored as uint32.
+static constexpr uint32_t CacheArchiveMagic = 0x50414741;
+
 class FileInfo {
  public:
   FileInfo(std::string cacheKey, uint32_t fileID, size_t fileSize = 0)
@@ -49,6 +53,14 @@ void PAGDiskCache::RemoveAll() {
   DiskCache::GetInstance()->removeAll();
 }
 
+bool PAGDiskCache::ExportArchive(const std::string& archivePath) {
+  return DiskCache::GetInstance()->exportArchive(archivePath);
+}
+
+bool PAGDiskCache::ImportArchive(const std::string& archivePath) {
+  return DiskCache::GetInstance()->importArchive(archivePath);
+}
+
 DiskCache* DiskCache::GetInstance() {
   static auto& diskCache = *new DiskCache();
   return &diskCache;
@@ -60,6 +72,15 @@ std::shared_ptr<SequenceFile> DiskCache::OpenSequence(
   return GetInstance()->openSequence(key, info, frameCount, frameRate, staticTimeRanges);
 }
 
+std::vector<std::string> DiskCache::FindCacheKeys(const std::string& prefix) {
+  return GetInstance()->findCacheKeys(prefix);
+}
+
+tgfx::ImageInfo DiskCache::PeekSequenceInfo(const std::string& key, int frameCount, float frameRate,
+                                            const std::vector<TimeRange>& staticTimeRanges) {
+  return GetInstance()->peekSequenceInfo(key, frameCount, frameRate, staticTimeRanges);
+}
+
 std::shared_ptr<tgfx::Data> DiskCache::ReadFile(const std::string& key) {
   return GetInstance()->readFile(key);
 }
@@ -68,24 +89,65 @@ bool DiskCache::WriteFile(const std::string& key, std::shared_ptr<tgfx::Data> da
   return GetInstance()->writeFile(key, data);
 }
 
+size_t DiskCache::BufferMemoryUsage() {
+  return GetInstance()->bufferMemoryUsage();
+}
+
+size_t DiskCache::bufferMemoryUsage() {
+  std::vector<std::shared_ptr<SequenceFile>> files = {};
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    for (auto& item : openedFiles) {
+      auto sequenceFile = item.second.lock();
+      if (sequenceFile != nullptr) {
+        files.push_back(std::move(sequenceFile));
+      }
+    }
+  }
+  // SequenceFile 在持有自身锁时会回调 DiskCache，这里先释放自己的锁再查询，避免锁序相反造成死锁。
+  size_t usage = 0;
+  for (auto& sequenceFile : files) {
+    usage += sequenceFile->bufferMemoryUsage();
+  }
+  return usage;
+}
+
+void DiskCache::Preload() {
+  GetInstance();
+}
+
 DiskCache::DiskCache() {
   auto cacheDir = Platform::Current()->getCacheDir();
   if (!cacheDir.empty()) {
     configPath = Directory::JoinPath(cacheDir, "cache.cfg");
     cacheFolder = Directory::JoinPath(cacheDir, "files");
-    if (!readConfig()) {
-      Directory::VisitFiles(cacheFolder,
-                            [&](const std::string& path, size_t) { remove(path.c_str()); });
-    }
+    // 读取配置和配置损坏时的目录清理都是磁盘 IO，放到后台任务执行，所有缓存操作入口会先通过
+    // waitForInit() 等待加载完成，冷启动首帧不再直接付出磁盘探测的开销。
+    initTask = tgfx::Task::Run([this]() { loadConfig(); });
+  }
+}
+
+void DiskCache::loadConfig() {
+  if (!readConfig()) {
+    Directory::VisitFiles(cacheFolder,
+                          [&](const std::string& path, size_t) { remove(path.c_str()); });
+  }
+}
+
+void DiskCache::waitForInit() {
+  if (initTask != nullptr) {
+    initTask->wait();
   }
 }
 
 size_t DiskCache::getMaxDiskSize() {
+  waitForInit();
   std::lock_guard<std::mutex> autoLock(locker);
   return maxDiskSize;
 }
 
 void DiskCache::setMaxDiskSize(size_t size) {
+  waitForInit();
   std::lock_guard<std::mutex> autoLock(locker);
   if (maxDiskSize == size) {
     return;
@@ -97,6 +159,7 @@ void DiskCache::setMaxDiskSize(size_t size) {
 }
 
 void DiskCache::removeAll() {
+  waitForInit();
   std::lock_guard<std::mutex> autoLock(locker);
   if (cacheFolder.empty()) {
     return;
@@ -111,14 +174,107 @@ void DiskCache::removeAll() {
   cachedFileIDs.clear();
   cachedFiles.clear();
   cachedFileInfos.clear();
+  pendingRemovals.clear();
   totalDiskSize = 0;
   saveConfig();
   LOGI("DiskCache::removeAll() all cached files have been removed!");
 }
 
+bool DiskCache::exportArchive(const std::string& archivePath) {
+  waitForInit();
+  // Snapshot the keys and paths under the lock, then read the files without it so the export
+  // never blocks other cache operations on disk I/O.
+  std::vector<std::pair<std::string, std::string>> entries = {};
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (cacheFolder.empty() || archivePath.empty()) {
+      return false;
+    }
+    for (auto& item : cachedFiles) {
+      if (item->fileSize == 0) {
+        continue;
+      }
+      entries.emplace_back(item->cacheKey, fileIDToPath(item->fileID));
+    }
+  }
+  Directory::CreateRecursively(Directory::GetParentDirectory(archivePath));
+  auto file = fopen(archivePath.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  uint8_t header[4];
+  tgfx::DataView headerView(header, sizeof(header));
+  headerView.setUint32(0, CacheArchiveMagic);
+  fwrite(header, 1, sizeof(header), file);
+  for (auto& entry : entries) {
+    auto stream = tgfx::Stream::MakeFromFile(entry.second);
+    if (stream == nullptr) {
+      continue;
+    }
+    tgfx::Buffer buffer(stream->size());
+    if (stream->read(buffer.data(), buffer.size()) != buffer.size()) {
+      continue;
+    }
+    uint8_t entryHeader[8];
+    tgfx::DataView entryView(entryHeader, sizeof(entryHeader));
+    entryView.setUint32(0, static_cast<uint32_t>(entry.first.size()));
+    entryView.setUint32(4, static_cast<uint32_t>(buffer.size()));
+    fwrite(entryHeader, 1, sizeof(entryHeader), file);
+    fwrite(entry.first.data(), 1, entry.first.size(), file);
+    fwrite(buffer.data(), 1, buffer.size(), file);
+  }
+  fclose(file);
+  return true;
+}
+
+bool DiskCache::importArchive(const std::string& archivePath) {
+  waitForInit();
+  auto stream = tgfx::Stream::MakeFromFile(archivePath);
+  if (stream == nullptr) {
+    return false;
+  }
+  tgfx::Buffer buffer(stream->size());
+  if (stream->read(buffer.data(), buffer.size()) != buffer.size()) {
+    return false;
+  }
+  tgfx::DataView dataView(buffer.bytes(), buffer.size());
+  if (dataView.size() < 4 || dataView.getUint32(0) != CacheArchiveMagic) {
+    return false;
+  }
+  size_t pos = 4;
+  auto imported = false;
+  while (pos + 8 <= dataView.size()) {
+    auto keyLength = dataView.getUint32(pos);
+    auto dataLength = dataView.getUint32(pos + 4);
+    pos += 8;
+    if (pos + keyLength + dataLength > dataView.size()) {
+      break;
+    }
+    auto key = std::string(reinterpret_cast<const char*>(dataView.bytes()) + pos, keyLength);
+    pos += keyLength;
+    auto hasFile = false;
+    {
+      std::lock_guard<std::mutex> autoLock(locker);
+      auto result = cachedFileIDs.find(key);
+      hasFile = result != cachedFileIDs.end() && cachedFileInfos.count(result->second) > 0;
+    }
+    if (!hasFile) {
+      // The local cache for an existing key may be fresher than the archived one, so only the
+      // missing entries are filled in.
+      auto data = tgfx::Data::MakeWithCopy(dataView.bytes() + pos, dataLength);
+      if (writeFile(key, std::move(data))) {
+        imported = true;
+      }
+    }
+    pos += dataLength;
+  }
+  return imported;
+}
+
 std::shared_ptr<SequenceFile> DiskCache::openSequence(
     const std::string& key, const tgfx::ImageInfo& info, int frameCount, float frameRate,
     const std::vector<TimeRange>& staticTimeRanges) {
+  waitForInit();
   std::lock_guard<std::mutex> autoLock(locker);
   if (cacheFolder.empty()) {
     return nullptr;
@@ -136,6 +292,7 @@ std::shared_ptr<SequenceFile> DiskCache::openSequence(
       fileID = getFileID(key);
     }
   }
+  cancelPendingRemoval(fileID);
   auto filePath = fileIDToPath(fileID);
   auto sequenceFile = SequenceFile::Open(filePath, info, frameCount, frameRate, staticTimeRanges);
   if (sequenceFile == nullptr) {
@@ -159,13 +316,55 @@ std::shared_ptr<SequenceFile> DiskCache::openSequence(
   return sequenceFile;
 }
 
-std::shared_ptr<tgfx::Data> DiskCache::readFile(const std::string& key) {
+std::vector<std::string> DiskCache::findCacheKeys(const std::string& prefix) {
+  waitForInit();
   std::lock_guard<std::mutex> autoLock(locker);
-  if (cacheFolder.empty() || key.empty()) {
-    return nullptr;
+  std::vector<std::string> keys = {};
+  if (prefix.empty()) {
+    return keys;
+  }
+  for (auto& item : cachedFileIDs) {
+    if (item.first.size() > prefix.size() && item.first.compare(0, prefix.size(), prefix) == 0 &&
+        cachedFileInfos.count(item.second) > 0) {
+      keys.push_back(item.first);
+    }
+  }
+  return keys;
+}
+
+tgfx::ImageInfo DiskCache::peekSequenceInfo(const std::string& key, int frameCount, float frameRate,
+                                            const std::vector<TimeRange>& staticTimeRanges) {
+  waitForInit();
+  std::string filePath;
+  {
+    // 只有键的查找需要加锁，读文件头本身可以和其他缓存操作并发进行。
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (cacheFolder.empty() || key.empty()) {
+      return {};
+    }
+    auto result = cachedFileIDs.find(key);
+    if (result == cachedFileIDs.end() || cachedFileInfos.count(result->second) == 0) {
+      return {};
+    }
+    filePath = fileIDToPath(result->second);
+  }
+  return SequenceFile::ReadInfo(filePath, frameCount, frameRate, staticTimeRanges);
+}
+
+std::shared_ptr<tgfx::Data> DiskCache::readFile(const std::string& key) {
+  waitForInit();
+  std::string filePath;
+  {
+    // Only the key lookup needs the lock, reading the file itself can run concurrently with other
+    // cache operations.
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (cacheFolder.empty() || key.empty()) {
+      return nullptr;
+    }
+    auto fileID = getFileID(key);
+    cancelPendingRemoval(fileID);
+    filePath = fileIDToPath(fileID);
   }
-  auto fileID = getFileID(key);
-  auto filePath = fileIDToPath(fileID);
   auto stream = tgfx::Stream::MakeFromFile(filePath);
   if (stream == nullptr) {
     return nullptr;
@@ -179,6 +378,7 @@ std::shared_ptr<tgfx::Data> DiskCache::readFile(const std::string& key) {
 }
 
 bool DiskCache::writeFile(const std::string& key, std::shared_ptr<tgfx::Data> data) {
+  waitForInit();
   std::lock_guard<std::mutex> autoLock(locker);
   if (cacheFolder.empty() || key.empty() || data == nullptr) {
     return false;
@@ -191,6 +391,7 @@ bool DiskCache::writeFile(const std::string& key, std::shared_ptr<tgfx::Data> da
     return false;
   }
   auto fileID = getFileID(key);
+  cancelPendingRemoval(fileID);
   auto filePath = fileIDToPath(fileID);
   Directory::CreateRecursively(Directory::GetParentDirectory(filePath));
   auto file = fopen(filePath.c_str(), "wb");
@@ -230,15 +431,54 @@ bool DiskCache::checkDiskSpace(size_t maxSize) {
     if (openedFiles.count(fileInfo->fileID) > 0) {
       break;
     }
-    auto filePath = fileIDToPath(fileInfo->fileID);
-    remove(filePath.c_str());
+    // Only the bookkeeping happens here, the actual file deletion runs on a background task so
+    // eviction never blocks a caller on disk I/O.
+    pendingRemovals[fileInfo->fileID] = fileIDToPath(fileInfo->fileID);
     totalDiskSize -= fileInfo->fileSize;
     removeFromCachedFiles(fileInfo);
     changed = true;
   }
+  scheduleRemovals();
   return changed;
 }
 
+void DiskCache::scheduleRemovals() {
+  if (removingPending || pendingRemovals.empty()) {
+    return;
+  }
+  removingPending = true;
+  removalTask = tgfx::Task::Run([this]() { removePendingFiles(); });
+}
+
+void DiskCache::removePendingFiles() {
+  while (true) {
+    std::string filePath;
+    {
+      std::lock_guard<std::mutex> autoLock(locker);
+      if (pendingRemovals.empty()) {
+        removingPending = false;
+        return;
+      }
+      auto iter = pendingRemovals.begin();
+      filePath = iter->second;
+      pendingRemovals.erase(iter);
+    }
+    remove(filePath.c_str());
+  }
+}
+
+void DiskCache::cancelPendingRemoval(uint32_t fileID) {
+  auto result = pendingRemovals.find(fileID);
+  if (result == pendingRemovals.end()) {
+    return;
+  }
+  // The evicted file is being reused before the background task got to it. Delete it inline so
+  // the caller starts from an empty file, the same as if the eviction had already happened.
+  auto filePath = result->second;
+  pendingRemovals.erase(result);
+  remove(filePath.c_str());
+}
+
 void DiskCache::addToCachedFiles(std::shared_ptr<FileInfo> fileInfo) {
   cachedFiles.push_front(fileInfo);
   fileInfo->cachedPosition = cachedFiles.begin();
@@ -37,6 +37,21 @@ class DiskCache {
       const std::string& key, const tgfx::ImageInfo& info, int frameCount, float frameRate,
       const std::vector<TimeRange>& staticTimeRanges = {});
 
+  /**
+   * Returns the keys of all cached files whose key starts with the specified prefix, typically to
+   * discover the resolution variants of one logical cache entry. Returns an empty vector if the
+   * prefix is empty.
+   */
+  static std::vector<std::string> FindCacheKeys(const std::string& prefix);
+
+  /**
+   * Reads the ImageInfo recorded in the head of the cached sequence file with the specified key,
+   * without opening or modifying the file. Returns an empty ImageInfo if no such file exists or
+   * its head does not match the given frame count, frame rate, and static time ranges.
+   */
+  static tgfx::ImageInfo PeekSequenceInfo(const std::string& key, int frameCount, float frameRate,
+                                          const std::vector<TimeRange>& staticTimeRanges = {});
+
   /**
    * Reads a file from the disk cache by the specified key. Returns nullptr if the key is empty or
    * the cache does not exist.
@@ -49,6 +64,19 @@ class DiskCache {
    */
   static bool WriteFile(const std::string& key, std::shared_ptr<tgfx::Data> data);
 
+  /**
+   * Returns the total byte size of the in-memory staging buffers held by all opened sequence
+   * files in the process.
+   */
+  static size_t BufferMemoryUsage();
+
+  /**
+   * Starts loading the cache configuration on a background task if it has not started yet, so the
+   * first cache access does not block on disk probing. Calling this is optional, all cache
+   * operations wait for the loading to finish before touching any state.
+   */
+  static void Preload();
+
  private:
   std::mutex locker = {};
   std::string configPath;
@@ -60,6 +88,10 @@ class DiskCache {
   std::unordered_map<uint32_t, std::shared_ptr<FileInfo>> cachedFileInfos = {};
   std::list<std::shared_ptr<FileInfo>> cachedFiles = {};
   std::unordered_map<uint32_t, std::weak_ptr<SequenceFile>> openedFiles = {};
+  std::unordered_map<uint32_t, std::string> pendingRemovals = {};
+  bool removingPending = false;
+  std::shared_ptr<tgfx::Task> removalTask = nullptr;
+  std::shared_ptr<tgfx::Task> initTask = nullptr;
 
   static DiskCache* GetInstance();
 
@@ -68,17 +100,28 @@ class DiskCache {
   size_t getMaxDiskSize();
   void setMaxDiskSize(size_t size);
   void removeAll();
+  bool exportArchive(const std::string& archivePath);
+  bool importArchive(const std::string& archivePath);
   std::shared_ptr<SequenceFile> openSequence(const std::string& key, const tgfx::ImageInfo& info,
                                              int frameCount, float frameRate,
                                              const std::vector<TimeRange>& staticTimeRanges);
+  std::vector<std::string> findCacheKeys(const std::string& prefix);
+  tgfx::ImageInfo peekSequenceInfo(const std::string& key, int frameCount, float frameRate,
+                                   const std::vector<TimeRange>& staticTimeRanges);
   std::shared_ptr<tgfx::Data> readFile(const std::string& key);
   bool writeFile(const std::string& key, std::shared_ptr<tgfx::Data> data);
+  size_t bufferMemoryUsage();
 
   bool checkDiskSpace(size_t maxSize);
+  void scheduleRemovals();
+  void removePendingFiles();
+  void cancelPendingRemoval(uint32_t fileID);
   void addToCachedFiles(std::shared_ptr<FileInfo> fileInfo);
   void removeFromCachedFiles(std::shared_ptr<FileInfo> fileInfo);
   void moveToFront(std::shared_ptr<FileInfo> fileInfo);
   void moveToBeforeOpenedFiles(std::shared_ptr<FileInfo> fileInfo);
+  void loadConfig();
+  void waitForInit();
   bool readConfig();
   void saveConfig();
   uint32_t getFileID(const std::string& key);
@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FrameMemoryCache.h"
+#include <climits>
+#include <cstring>
+
+namespace pag {
+static constexpr size_t DEFAULT_FRAME_CACHE_SIZE = 67108864;  // 64MB
+
+static uint64_t MakeFrameKey(ID sequenceID, int index) {
+  return (static_cast<uint64_t>(sequenceID) << 32) | static_cast<uint32_t>(index);
+}
+
+FrameMemoryCache* FrameMemoryCache::GetInstance() {
+  static auto& instance = *new FrameMemoryCache();
+  return &instance;
+}
+
+FrameMemoryCache::FrameMemoryCache() : _maxBytes(DEFAULT_FRAME_CACHE_SIZE) {
+}
+
+size_t FrameMemoryCache::maxBytes() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _maxBytes;
+}
+
+void FrameMemoryCache::setMaxBytes(size_t bytes) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  _maxBytes = bytes;
+  evictToFit();
+}
+
+void FrameMemoryCache::purgeAll() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  frames.clear();
+  playheads.clear();
+  totalBytes = 0;
+}
+
+void FrameMemoryCache::updatePlayhead(ID sequenceID, int index, int numFrames) {
+  auto& playhead = playheads[sequenceID];
+  if (playhead.index >= 0 && numFrames > 0 && index != playhead.index) {
+    // 按环形最短路径判断播放方向，从结尾回绕到开头仍算正向循环。
+    auto forward = index - playhead.index;
+    if (forward < 0) {
+      forward += numFrames;
+    }
+    playhead.direction = forward <= numFrames - forward ? 1 : -1;
+  }
+  playhead.index = index;
+  playhead.numFrames = numFrames;
+}
+
+int FrameMemoryCache::forwardDistance(const CachedFrame& frame) const {
+  auto playhead = playheads.find(frame.sequenceID);
+  if (playhead == playheads.end() || playhead->second.numFrames <= 0) {
+    return INT_MAX;
+  }
+  auto& state = playhead->second;
+  auto distance = (frame.index - state.index) * state.direction;
+  if (distance < 0) {
+    distance += state.numFrames;
+  }
+  return distance;
+}
+
+void FrameMemoryCache::evictToFit() {
+  while (totalBytes > _maxBytes && !frames.empty()) {
+    // 淘汰沿播放方向离播放头最远的帧。循环播放时这正是刚播过的帧，它要等整整一圈之后才会
+    // 再次用到，而播放头前方马上要用的帧始终保持最高优先级。
+    auto victim = frames.begin();
+    auto victimDistance = -1;
+    for (auto item = frames.begin(); item != frames.end(); ++item) {
+      auto distance = forwardDistance(item->second);
+      if (distance > victimDistance) {
+        victimDistance = distance;
+        victim = item;
+      }
+    }
+    totalBytes -= victim->second.pixels->size();
+    frames.erase(victim);
+  }
+}
+
+bool FrameMemoryCache::readFrame(ID sequenceID, int index, int numFrames,
+                                 std::shared_ptr<BitmapBuffer> bitmap) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (_maxBytes == 0) {
+    return false;
+  }
+  updatePlayhead(sequenceID, index, numFrames);
+  auto result = frames.find(MakeFrameKey(sequenceID, index));
+  if (result == frames.end() || result->second.info != bitmap->info()) {
+    return false;
+  }
+  auto dstPixels = bitmap->lockPixels();
+  if (dstPixels == nullptr) {
+    return false;
+  }
+  memcpy(dstPixels, result->second.pixels->data(), result->second.pixels->size());
+  bitmap->unlockPixels();
+  return true;
+}
+
+void FrameMemoryCache::writeFrame(ID sequenceID, int index, int numFrames,
+                                  std::shared_ptr<BitmapBuffer> bitmap) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto byteSize = bitmap->info().byteSize();
+  if (_maxBytes == 0 || byteSize > _maxBytes) {
+    return;
+  }
+  auto key = MakeFrameKey(sequenceID, index);
+  if (frames.count(key) > 0) {
+    return;
+  }
+  auto srcPixels = bitmap->lockPixels();
+  if (srcPixels == nullptr) {
+    return;
+  }
+  auto pixels = tgfx::Data::MakeWithCopy(srcPixels, byteSize);
+  bitmap->unlockPixels();
+  if (pixels == nullptr) {
+    return;
+  }
+  updatePlayhead(sequenceID, index, numFrames);
+  frames[key] = {sequenceID, index, bitmap->info(), std::move(pixels)};
+  totalBytes += byteSize;
+  evictToFit();
+}
+}  // namespace pag
@@ -0,0 +1,94 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include "pag/types.h"
+#include "rendering/utils/BitmapBuffer.h"
+#include "tgfx/core/Data.h"
+
+namespace pag {
+/**
+ * FrameMemoryCache is a process-level memory tier above the disk cache, holding recently decoded
+ * frames as raw pixels and shared by every PAGDecoder in the process. Eviction is aware of the
+ * playback direction: when the byte budget is exceeded, the entry whose next use lies farthest
+ * ahead along its sequence's playback direction is dropped first. For looping playback that is
+ * the frame just behind the playhead, so the frames the next loop iteration needs soonest stay
+ * resident.
+ */
+class FrameMemoryCache {
+ public:
+  static FrameMemoryCache* GetInstance();
+
+  /**
+   * Returns the size limit of the frame memory cache in bytes. The default value is 64 MB.
+   */
+  size_t maxBytes();
+
+  /**
+   * Sets the size limit of the frame memory cache in bytes. Setting it to 0 disables the memory
+   * tier entirely and releases all cached frames.
+   */
+  void setMaxBytes(size_t bytes);
+
+  /**
+   * Copies the cached pixels of the specified frame into the bitmap and advances the sequence's
+   * playhead. Returns false if the frame is not cached or its ImageInfo does not match the bitmap.
+   */
+  bool readFrame(ID sequenceID, int index, int numFrames, std::shared_ptr<BitmapBuffer> bitmap);
+
+  /**
+   * Copies the pixels of the bitmap into the cache for the specified frame, evicting other frames
+   * if the byte budget is exceeded. Does nothing if the frame is already cached or its size alone
+   * exceeds the budget.
+   */
+  void writeFrame(ID sequenceID, int index, int numFrames, std::shared_ptr<BitmapBuffer> bitmap);
+
+  /**
+   * Removes all cached frames, e.g. on memory pressure.
+   */
+  void purgeAll();
+
+ private:
+  struct CachedFrame {
+    ID sequenceID = 0;
+    int index = 0;
+    tgfx::ImageInfo info = {};
+    std::shared_ptr<tgfx::Data> pixels = nullptr;
+  };
+
+  struct PlayheadState {
+    int index = -1;
+    int direction = 1;
+    int numFrames = 0;
+  };
+
+  std::mutex locker = {};
+  size_t _maxBytes;
+  size_t totalBytes = 0;
+  std::unordered_map<uint64_t, CachedFrame> frames = {};
+  std::unordered_map<ID, PlayheadState> playheads = {};
+
+  FrameMemoryCache();
+  void updatePlayhead(ID sequenceID, int index, int numFrames);
+  void evictToFit();
+  int forwardDistance(const CachedFrame& frame) const;
+};
+}  // namespace pag
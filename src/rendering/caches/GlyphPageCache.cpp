@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GlyphPageCache.h"
+
+namespace pag {
+static constexpr size_t MaxGlyphPageCacheBytes = 32 * 1024 * 1024;
+
+GlyphPageCache* GlyphPageCache::GetInstance() {
+  static auto& glyphPageCache = *new GlyphPageCache();
+  return &glyphPageCache;
+}
+
+std::shared_ptr<tgfx::ImageBuffer> GlyphPageCache::find(const tgfx::BytesKey& pageKey) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto result = pages.find(pageKey);
+  if (result == pages.end()) {
+    return nullptr;
+  }
+  pageLRU.erase(result->second.position);
+  pageLRU.push_front(pageKey);
+  result->second.position = pageLRU.begin();
+  return result->second.buffer;
+}
+
+void GlyphPageCache::add(const tgfx::BytesKey& pageKey, std::shared_ptr<tgfx::ImageBuffer> buffer) {
+  if (buffer == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (pages.find(pageKey) != pages.end()) {
+    return;
+  }
+  pageLRU.push_front(pageKey);
+  totalBytes += static_cast<size_t>(buffer->width()) * static_cast<size_t>(buffer->height());
+  pages[pageKey] = {std::move(buffer), pageLRU.begin()};
+  purgeToFit();
+}
+
+void GlyphPageCache::purgeToFit() {
+  while (totalBytes > MaxGlyphPageCacheBytes && !pageLRU.empty()) {
+    auto result = pages.find(pageLRU.back());
+    if (result != pages.end()) {
+      auto& buffer = result->second.buffer;
+      totalBytes -= static_cast<size_t>(buffer->width()) * static_cast<size_t>(buffer->height());
+      pages.erase(result);
+    }
+    pageLRU.pop_back();
+  }
+}
+}  // namespace pag
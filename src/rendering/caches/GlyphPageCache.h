@@ -0,0 +1,62 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include "tgfx/core/BytesKey.h"
+#include "tgfx/core/ImageBuffer.h"
+
+namespace pag {
+/**
+ * GlyphPageCache is a process-wide cache of rasterized glyph atlas pages, shared by every
+ * RenderCache so that short-lived PAGPlayer instances do not re-rasterize identical glyphs. The
+ * cached pages are keyed by the typefaces, sizes, styles, and glyph layout of the page, and
+ * evicted in LRU order once the cache exceeds its byte limit.
+ */
+class GlyphPageCache {
+ public:
+  static GlyphPageCache* GetInstance();
+
+  /**
+   * Returns the cached page for the given key and marks it as recently used. Returns nullptr if
+   * the page is not cached.
+   */
+  std::shared_ptr<tgfx::ImageBuffer> find(const tgfx::BytesKey& pageKey);
+
+  /**
+   * Adds a rasterized page to the cache, evicting the least recently used pages if the byte limit
+   * is exceeded. Does nothing if the key is already cached or the buffer is nullptr.
+   */
+  void add(const tgfx::BytesKey& pageKey, std::shared_ptr<tgfx::ImageBuffer> buffer);
+
+ private:
+  struct PageEntry {
+    std::shared_ptr<tgfx::ImageBuffer> buffer = nullptr;
+    std::list<tgfx::BytesKey>::iterator position;
+  };
+
+  std::mutex locker = {};
+  size_t totalBytes = 0;
+  std::list<tgfx::BytesKey> pageLRU = {};
+  tgfx::BytesKeyMap<PageEntry> pages = {};
+
+  void purgeToFit();
+};
+}  // namespace pag
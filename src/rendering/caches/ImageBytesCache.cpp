@@ -17,8 +17,147 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ImageBytesCache.h"
+#include <unordered_map>
+#include "tgfx/core/Clock.h"
 
 namespace pag {
+static constexpr size_t DEFAULT_SCAVENGE_POOL_SIZE = 16 * 1024 * 1024;  // 16MB
+static constexpr int64_t DEFAULT_SCAVENGE_TTL = 2000000;                // 2 秒（微秒）。
+
+static uint64_t HashImagePayload(const uint8_t* data, size_t length) {
+  // FNV-1a，64 位足以区分不同的编码图片内容。
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
+  }
+  hash ^= static_cast<uint64_t>(length);
+  hash *= 1099511628211ULL;
+  return hash;
+}
+
+struct ScavengeEntry {
+  std::shared_ptr<tgfx::Image> image = nullptr;
+  size_t byteSize = 0;
+  int64_t lastUsedTime = 0;
+};
+
+// 进程级的解码图片共享池。imageMap 以内容哈希保存弱引用，活跃的 File 之间共享同一个
+// tgfx::Image；scavengePool 额外持有一份强引用并记录最近一次使用时间，File 全部释放后
+// 解码结果还能在池内存活一小段时间，覆盖 tab 切换这类先卸载再重新加载的场景。
+// 真正离开的图片在 TTL 到期或字节预算超限时按最久未用的顺序回收。
+class SharedImagePool {
+ public:
+  std::shared_ptr<tgfx::Image> getImage(ImageBytes* imageBytes) {
+    auto hash = HashImagePayload(imageBytes->fileBytes->data(), imageBytes->fileBytes->length());
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto currentTime = tgfx::Clock::Now();
+    scavengeExpired(currentTime);
+    auto result = imageMap.find(hash);
+    if (result != imageMap.end()) {
+      auto image = result->second.lock();
+      if (image != nullptr) {
+        touch(hash, image, currentTime);
+        return image;
+      }
+    }
+    auto fileBytes =
+        tgfx::Data::MakeWithCopy(imageBytes->fileBytes->data(), imageBytes->fileBytes->length());
+    auto image = tgfx::Image::MakeFromEncoded(std::move(fileBytes));
+    if (image != nullptr) {
+      // 顺便清理已经全部释放的旧条目，避免弱引用长期堆积。
+      for (auto item = imageMap.begin(); item != imageMap.end();) {
+        if (item->second.expired()) {
+          item = imageMap.erase(item);
+        } else {
+          item++;
+        }
+      }
+      imageMap[hash] = image;
+      touch(hash, image, currentTime);
+    }
+    return image;
+  }
+
+  void setLimits(size_t maxBytesValue, int64_t ttlValue) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    maxBytes = maxBytesValue;
+    ttl = ttlValue;
+    scavengeExpired(tgfx::Clock::Now());
+  }
+
+  void purgeAll() {
+    std::lock_guard<std::mutex> autoLock(locker);
+    scavengePool.clear();
+    totalBytes = 0;
+  }
+
+ private:
+  std::mutex locker = {};
+  std::unordered_map<uint64_t, std::weak_ptr<tgfx::Image>> imageMap = {};
+  std::unordered_map<uint64_t, ScavengeEntry> scavengePool = {};
+  size_t totalBytes = 0;
+  size_t maxBytes = DEFAULT_SCAVENGE_POOL_SIZE;
+  int64_t ttl = DEFAULT_SCAVENGE_TTL;
+
+  void touch(uint64_t hash, const std::shared_ptr<tgfx::Image>& image, int64_t currentTime) {
+    if (maxBytes == 0) {
+      return;
+    }
+    auto result = scavengePool.find(hash);
+    if (result != scavengePool.end()) {
+      result->second.lastUsedTime = currentTime;
+      return;
+    }
+    ScavengeEntry entry = {};
+    entry.image = image;
+    entry.byteSize = static_cast<size_t>(image->width()) * static_cast<size_t>(image->height()) * 4;
+    entry.lastUsedTime = currentTime;
+    if (entry.byteSize > maxBytes) {
+      return;
+    }
+    totalBytes += entry.byteSize;
+    scavengePool[hash] = entry;
+    evictToFit();
+  }
+
+  void scavengeExpired(int64_t currentTime) {
+    for (auto item = scavengePool.begin(); item != scavengePool.end();) {
+      if (currentTime - item->second.lastUsedTime > ttl) {
+        totalBytes -= item->second.byteSize;
+        item = scavengePool.erase(item);
+      } else {
+        item++;
+      }
+    }
+  }
+
+  void evictToFit() {
+    while (totalBytes > maxBytes && !scavengePool.empty()) {
+      auto victim = scavengePool.begin();
+      for (auto item = scavengePool.begin(); item != scavengePool.end(); item++) {
+        if (item->second.lastUsedTime < victim->second.lastUsedTime) {
+          victim = item;
+        }
+      }
+      totalBytes -= victim->second.byteSize;
+      scavengePool.erase(victim);
+    }
+  }
+};
+
+static SharedImagePool* GetPool() {
+  static auto& pool = *new SharedImagePool();
+  return &pool;
+}
+
+void ImageBytesCache::SetScavengePoolLimits(size_t maxBytes, int64_t ttlMicroseconds) {
+  GetPool()->setLimits(maxBytes, ttlMicroseconds);
+}
+
+void ImageBytesCache::PurgeScavengePool() {
+  GetPool()->purgeAll();
+}
 
 ImageBytesCache* ImageBytesCache::Get(ImageBytes* imageBytes) {
   std::lock_guard<std::mutex> autoLock(imageBytes->locker);
@@ -26,9 +165,8 @@ ImageBytesCache* ImageBytesCache::Get(ImageBytes* imageBytes) {
     return static_cast<ImageBytesCache*>(imageBytes->cache);
   }
   auto cache = new ImageBytesCache();
-  auto fileBytes =
-      tgfx::Data::MakeWithCopy(imageBytes->fileBytes->data(), imageBytes->fileBytes->length());
-  auto image = tgfx::Image::MakeFromEncoded(std::move(fileBytes));
+  auto image = GetPool()->getImage(imageBytes);
+  // Picture 带有各自的 uniqueID，缩放和锚点也属于单个 ImageBytes，只有解码源可以共享。
   auto picture = Picture::MakeFrom(imageBytes->uniqueID, image);
   auto matrix = tgfx::Matrix::MakeScale(1 / imageBytes->scaleFactor);
   matrix.postTranslate(static_cast<float>(-imageBytes->anchorX),
@@ -25,6 +25,19 @@ namespace pag {
 class ImageBytesCache : public Cache {
  public:
   static ImageBytesCache* Get(ImageBytes* imageBytes);
+
+  /**
+   * Sets the limits of the scavenge pool that keeps decoded images alive for a short while after
+   * the last File referencing them is released. A maxBytes of 0 disables the pool. The default
+   * limits are 16MB and 2 seconds.
+   */
+  static void SetScavengePoolLimits(size_t maxBytes, int64_t ttlMicroseconds);
+
+  /**
+   * Releases all decoded images currently held by the scavenge pool.
+   */
+  static void PurgeScavengePool();
+
   std::shared_ptr<Graphic> graphic = nullptr;
 };
 }  // namespace pag
\ No newline at end of file
@@ -83,9 +83,24 @@ LayerCache::~LayerCache() {
 }
 
 Transform* LayerCache::getTransform(Frame contentFrame) {
+  std::lock_guard<std::mutex> autoLock(overrideLocker);
+  if (overrideValid) {
+    return &overrideTransform;
+  }
   return transformCache->getCache(contentFrame);
 }
 
+void LayerCache::setTransformOverride(const tgfx::Matrix& matrix, float alpha) {
+  std::lock_guard<std::mutex> autoLock(overrideLocker);
+  overrideTransform = Transform(matrix, alpha);
+  overrideValid = true;
+}
+
+void LayerCache::clearTransformOverride() {
+  std::lock_guard<std::mutex> autoLock(overrideLocker);
+  overrideValid = false;
+}
+
 tgfx::Path* LayerCache::getMasks(Frame contentFrame) {
   auto mask = maskCache ? maskCache->getCache(contentFrame) : nullptr;
   if (mask && mask->isEmpty()) {
@@ -127,6 +142,16 @@ bool LayerCache::checkFrameChanged(Frame contentFrame, Frame lastContentFrame) {
   return contentFrame != lastContentFrame;
 }
 
+bool LayerCache::transformFrameChanged(Frame contentFrame, Frame lastContentFrame) {
+  if (contentFrame == lastContentFrame) {
+    return false;
+  }
+  auto ranges = transformCache->getStaticTimeRanges();
+  contentFrame = ConvertFrameByStaticTimeRanges(*ranges, contentFrame);
+  lastContentFrame = ConvertFrameByStaticTimeRanges(*ranges, lastContentFrame);
+  return contentFrame != lastContentFrame;
+}
+
 bool LayerCache::contentVisible(Frame contentFrame) {
   if (contentFrame < 0 || contentFrame >= layer->duration) {
     return false;
@@ -138,6 +163,33 @@ bool LayerCache::contentVisible(Frame contentFrame) {
   return layerTransform->visible();
 }
 
+bool LayerCache::composedGraphicShareable() const {
+  // 矢量预合成的 staticTimeRanges 只覆盖图层自身（见 updateStaticTimeRanges），子合成的动画
+  // 不在其中，整层合成结果不能按它共享；子合成的内容本身已经在 CompositionCache 里按帧去重。
+  return !(layer->type() == LayerType::PreCompose &&
+           static_cast<PreComposeLayer*>(layer)->composition->type() == CompositionType::Vector);
+}
+
+std::shared_ptr<Graphic> LayerCache::getComposedGraphic(Frame contentFrame) {
+  if (contentFrame < 0 || contentFrame >= layer->duration) {
+    return nullptr;
+  }
+  contentFrame = ConvertFrameByStaticTimeRanges(staticTimeRanges, contentFrame);
+  std::lock_guard<std::mutex> autoLock(composedLocker);
+  auto result = composedGraphics.find(contentFrame);
+  return result != composedGraphics.end() ? result->second : nullptr;
+}
+
+void LayerCache::cacheComposedGraphic(Frame contentFrame, std::shared_ptr<Graphic> graphic) {
+  if (graphic == nullptr || contentFrame < 0 || contentFrame >= layer->duration ||
+      !composedGraphicShareable()) {
+    return;
+  }
+  contentFrame = ConvertFrameByStaticTimeRanges(staticTimeRanges, contentFrame);
+  std::lock_guard<std::mutex> autoLock(composedLocker);
+  composedGraphics[contentFrame] = std::move(graphic);
+}
+
 void LayerCache::updateStaticTimeRanges() {
   staticTimeRanges.clear();
   // layer->startTime is excluded from all time ranges.
@@ -186,6 +238,8 @@ void LayerCache::rebuildTransformAndStaticRanges() {
   transformCache = new TransformCache(layer);
   // Recompute static time ranges merged with new transform static ranges and other elements.
   updateStaticTimeRanges();
+  std::lock_guard<std::mutex> autoLock(composedLocker);
+  composedGraphics.clear();
 }
 
 void LayerCache::invalidateContentCache() {
@@ -194,6 +248,8 @@ void LayerCache::invalidateContentCache() {
   }
   contentCache->invalidate();
   updateStaticTimeRanges();
+  std::lock_guard<std::mutex> autoLock(composedLocker);
+  composedGraphics.clear();
 }
 
 std::vector<TimeRange> LayerCache::getTrackMatteStaticTimeRanges() {
@@ -33,6 +33,19 @@ class LayerCache : public Cache {
 
   Transform* getTransform(Frame contentFrame);
 
+  /**
+   * Overrides the transform evaluated from the layer's keyframes with the specified matrix and
+   * alpha. The override is applied in the render path after keyframe evaluation and does not
+   * invalidate any cache, so updating it every frame from external data costs a single write.
+   */
+  void setTransformOverride(const tgfx::Matrix& matrix, float alpha);
+
+  /**
+   * Clears a transform override previously set by setTransformOverride(), restoring the keyframe
+   * evaluation result.
+   */
+  void clearTransformOverride();
+
   tgfx::Path* getMasks(Frame contentFrame);
 
   std::shared_ptr<Modifier> getFeatherMask(Frame contentFrame);
@@ -45,8 +58,27 @@ class LayerCache : public Cache {
 
   bool checkFrameChanged(Frame contentFrame, Frame lastContentFrame);
 
+  /**
+   * Returns true if the layer's own transform changes between the two content frames, regardless
+   * of whether the layer content itself is static.
+   */
+  bool transformFrameChanged(Frame contentFrame, Frame lastContentFrame);
+
   bool contentVisible(Frame contentFrame);
 
+  /**
+   * Returns the composed graphic of the whole layer cached for the specified content frame, or
+   * nullptr if there is none. All frames inside one static time range share a single entry, so
+   * consecutive cached composition frames reference the same sub-tree instead of duplicating it.
+   */
+  std::shared_ptr<Graphic> getComposedGraphic(Frame contentFrame);
+
+  /**
+   * Caches the composed graphic of the whole layer for the specified content frame. Does nothing
+   * if the composed output of this layer cannot be shared by its static time ranges.
+   */
+  void cacheComposedGraphic(Frame contentFrame, std::shared_ptr<Graphic> graphic);
+
   bool contentStatic() const {
     return contentCache->contentStatic();
   }
@@ -77,7 +109,13 @@ class LayerCache : public Cache {
   ContentCache* contentCache = nullptr;
   std::pair<tgfx::Point, tgfx::Point> scaleFactor = {};
   std::vector<TimeRange> staticTimeRanges;
+  std::mutex composedLocker = {};
+  std::unordered_map<Frame, std::shared_ptr<Graphic>> composedGraphics = {};
+  std::mutex overrideLocker = {};
+  bool overrideValid = false;
+  Transform overrideTransform = {};
   explicit LayerCache(Layer* layer);
+  bool composedGraphicShareable() const;
   void updateStaticTimeRanges();
   std::vector<TimeRange> getTrackMatteStaticTimeRanges();
   std::vector<TimeRange> getFilterStaticTimeRanges();
@@ -21,8 +21,68 @@
 
 namespace pag {
 
+static bool IsStaticIdentityTransform(const Transform2D* transform) {
+  if (transform == nullptr) {
+    return false;
+  }
+  if (transform->anchorPoint->animatable() || transform->position->animatable() ||
+      transform->xPosition->animatable() || transform->yPosition->animatable() ||
+      transform->scale->animatable() || transform->rotation->animatable() ||
+      transform->opacity->animatable()) {
+    return false;
+  }
+  auto& anchorPoint = transform->anchorPoint->value;
+  auto& position = transform->position->value;
+  auto& scale = transform->scale->value;
+  return anchorPoint.x == 0 && anchorPoint.y == 0 && position.x == 0 && position.y == 0 &&
+         transform->xPosition->value == 0 && transform->yPosition->value == 0 && scale.x == 1 &&
+         scale.y == 1 && transform->rotation->value == 0 && transform->opacity->value == Opaque;
+}
+
+// 判断 composition 是否只是通向更深一层预合成的普通中转：唯一图层、铺满整个合成、不带任何会改变
+// 渲染结果的属性。这类中转层在设计侧的深层嵌套里很常见，渲染时可以安全跳过。
+static PreComposeLayer* GetTrivialPreComposeLayer(VectorComposition* composition) {
+  if (composition->layers.size() != 1) {
+    return nullptr;
+  }
+  auto layer = composition->layers.front();
+  if (layer->type() != LayerType::PreCompose || !layer->isActive) {
+    return nullptr;
+  }
+  if (layer->startTime > 0 || layer->startTime + layer->duration < composition->duration) {
+    return nullptr;
+  }
+  if (!layer->masks.empty() || !layer->effects.empty() || !layer->layerStyles.empty() ||
+      layer->trackMatteLayer != nullptr || layer->blendMode != BlendMode::Normal ||
+      layer->motionBlur || layer->timeRemap != nullptr || layer->transform3D != nullptr ||
+      layer->stretch != DefaultRatio) {
+    return nullptr;
+  }
+  if (!IsStaticIdentityTransform(layer->transform)) {
+    return nullptr;
+  }
+  auto preComposeLayer = static_cast<PreComposeLayer*>(layer);
+  auto inner = preComposeLayer->composition;
+  if (inner == nullptr || inner->frameRate != composition->frameRate ||
+      inner->width != composition->width || inner->height != composition->height) {
+    return nullptr;
+  }
+  return preComposeLayer;
+}
+
 PreComposeContentCache::PreComposeContentCache(PreComposeLayer* layer) : ContentCache(layer) {
-  compositionCache = CompositionCache::Get(layer->composition);
+  // 深层嵌套的预合成链每帧都要逐级查缓存并叠加矩阵。这里在建缓存时先把只做中转的层级折叠掉，
+  // 直接指向链上最深的有效合成，每跳过一级只需累计它的帧偏移（帧率相同，时间缩放恒为 1）。
+  auto composition = layer->composition;
+  while (composition->type() == CompositionType::Vector) {
+    auto childLayer = GetTrivialPreComposeLayer(static_cast<VectorComposition*>(composition));
+    if (childLayer == nullptr) {
+      break;
+    }
+    frameOffset += childLayer->compositionStartTime;
+    composition = childLayer->composition;
+  }
+  compositionCache = CompositionCache::Get(composition);
 }
 
 void PreComposeContentCache::excludeVaryingRanges(std::vector<TimeRange>* timeRanges) const {
@@ -31,7 +91,7 @@ void PreComposeContentCache::excludeVaryingRanges(std::vector<TimeRange>* timeRa
 
 GraphicContent* PreComposeContentCache::createContent(Frame layerFrame) const {
   auto compositionFrame = static_cast<PreComposeLayer*>(layer)->getCompositionFrame(layerFrame);
-  auto graphic = compositionCache->getContent(compositionFrame);
+  auto graphic = compositionCache->getContent(compositionFrame - frameOffset);
   return new GraphicContent(graphic);
 }
 }  // namespace pag
\ No newline at end of file
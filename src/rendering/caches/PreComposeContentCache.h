@@ -32,5 +32,7 @@ class PreComposeContentCache : public ContentCache {
 
  private:
   CompositionCache* compositionCache = nullptr;
+  // 折叠掉的中间预合成链在帧映射上的累计偏移，见构造函数。
+  Frame frameOffset = 0;
 };
 }  // namespace pag
@@ -17,16 +17,22 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "RenderCache.h"
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include "base/utils/TimeUtil.h"
 #include "base/utils/UniqueID.h"
+#include "rendering/caches/DiskCache.h"
 #include "rendering/caches/ImageContentCache.h"
 #include "rendering/caches/LayerCache.h"
 #include "rendering/editing/ImageReplacement.h"
 #include "rendering/filters/utils/Filter3DFactory.h"
 #include "rendering/renderers/FilterRenderer.h"
+#include "rendering/caches/WarmStartCache.h"
 #include "rendering/sequences/SequenceImageProxy.h"
 #include "rendering/sequences/SequenceInfo.h"
+#include "rendering/utils/FrameProfiler.h"
+#include "rendering/utils/Trace.h"
 #include "tgfx/core/Clock.h"
 
 namespace pag {
@@ -36,7 +42,23 @@ static constexpr int PURGEABLE_GRAPHICS_MEMORY = 20971520;  // 20M
 static constexpr int PURGEABLE_EXPIRED_FRAME = 10;
 static constexpr float SCALE_FACTOR_PRECISION = 0.001f;
 static constexpr float MIPMAP_ENABLED_THRESHOLD = 0.4f;
+
+// Snapshot 的缩放档位按 sqrt(2) 为步长向上取整。缩放动画期间 scaleFactor 每帧都在变，
+// 量化之后只会跨越少数几个档位，面积上最多多渲染一倍。
+static float GetSnapshotScaleBucket(float scaleFactor) {
+  if (scaleFactor < SCALE_FACTOR_PRECISION) {
+    return scaleFactor;
+  }
+  auto level = ceilf(log2f(scaleFactor) * 2.0f);
+  return powf(2.0f, level * 0.5f);
+}
 static constexpr int64_t DECODING_VISIBLE_DISTANCE = 500000;  // 提前 500ms 开始解码。
+// 每帧最多提前上传的图片数量。模板切场景时经常有十几张图片同帧首次显示，限量后上传开销
+// 摊到前面 500ms 的各帧里，而不是在切换那一帧集中爆发。
+static constexpr int MAX_PREUPLOADS_PER_FRAME = 2;
+// Offscreen surface sizes are rounded up to this alignment, so that slightly different filter
+// bounds across frames still hit the same pool bucket.
+static constexpr int SURFACE_POOL_ALIGNMENT = 64;
 
 RenderCache::RenderCache(PAGStage* stage) : _uniqueID(UniqueID::Next()), stage(stage) {
 }
@@ -61,25 +83,51 @@ void RenderCache::setVideoEnabled(bool value) {
   clearAllSequenceCaches();
 }
 
-void RenderCache::prepareLayers() {
+int RenderCache::sequenceReadAheadCount() const {
+  return _sequenceReadAheadCount;
+}
+
+void RenderCache::setSequenceReadAheadCount(int count) {
+  count = count < 1 ? 1 : count;
+  if (_sequenceReadAheadCount == count) {
+    return;
+  }
+  _sequenceReadAheadCount = count;
+  for (auto& item : sequenceCaches) {
+    for (auto queue : item.second) {
+      queue->setReadAheadCount(count);
+    }
+  }
+}
+
+void RenderCache::prepareLayers(bool warmUpDecoders) {
   int64_t timeDistance = DECODING_VISIBLE_DISTANCE;
 #ifdef PAG_BUILD_FOR_WEB
   // always prepare the whole timeline on the web platoform.
   timeDistance = INT64_MAX;
 #endif
+  if (warmUpDecoders) {
+    // Warm up every upcoming sequence, not only the nearly visible ones.
+    timeDistance = INT64_MAX;
+  }
   auto layerDistances = stage->findNearlyVisibleLayersIn(timeDistance);
   for (auto& item : layerDistances) {
+    prepareTimeDistance = item.first;
     for (auto pagLayer : item.second) {
       if (pagLayer->layerType() == LayerType::PreCompose) {
-        preparePreComposeLayer(static_cast<PreComposeLayer*>(pagLayer->layer));
+        preparePreComposeLayer(static_cast<PreComposeLayer*>(pagLayer->layer), warmUpDecoders);
       } else if (pagLayer->layerType() == LayerType::Image) {
         prepareImageLayer(static_cast<PAGImageLayer*>(pagLayer));
+      } else if (pagLayer->layerType() == LayerType::Text) {
+        prepareTextLayer(pagLayer);
       }
+      prepareLayerFilters(pagLayer);
     }
   }
+  prepareTimeDistance = 0;
 }
 
-void RenderCache::preparePreComposeLayer(PreComposeLayer* layer) {
+void RenderCache::preparePreComposeLayer(PreComposeLayer* layer, bool warmUpDecoders) {
   auto composition = layer->composition;
   if (composition->type() != CompositionType::Video &&
       composition->type() != CompositionType::Bitmap) {
@@ -99,6 +147,9 @@ void RenderCache::preparePreComposeLayer(PreComposeLayer* layer) {
   }
   auto queue = makeSequenceImageQueue(info);
   if (queue) {
+    if (warmUpDecoders) {
+      queue->warmUpDecoder();
+    }
     queue->prepareNextImage();
   }
 }
@@ -117,8 +168,35 @@ void RenderCache::prepareImageLayer(PAGImageLayer* pagLayer) {
   }
 }
 
+void RenderCache::prepareTextLayer(PAGLayer* pagLayer) {
+  auto layerCache = LayerCache::Get(pagLayer->layer);
+  auto content = static_cast<GraphicContent*>(layerCache->getContent(pagLayer->contentFrame));
+  if (content != nullptr && content->graphic != nullptr) {
+    content->graphic->prepare(this);
+  }
+}
+
+void RenderCache::prepareLayerFilters(PAGLayer* pagLayer) {
+  if (context == nullptr) {
+    return;
+  }
+  auto layer = pagLayer->layer;
+  if (!layer->motionBlur && layer->effects.empty() && layer->layerStyles.empty()) {
+    return;
+  }
+  // Warm each layer's filter chain once per context; the compiled programs stay shared in the
+  // FilterProgramCache afterwards.
+  if (warmedFilterLayers.count(layer->uniqueID) > 0) {
+    return;
+  }
+  warmedFilterLayers.insert(layer->uniqueID);
+  auto layerFrame = pagLayer->contentFrame + layer->startTime;
+  FilterRenderer::PrepareFilters(this, layer, layerFrame);
+}
+
 void RenderCache::prepareNextFrame() {
-#ifndef PAG_BUILD_FOR_WEB
+// 多线程的 wasm 构建下序列预读和软解一样跑在 pthread 工作线程里，与原生平台行为一致。
+#if !defined(PAG_BUILD_FOR_WEB) || defined(PAG_USE_WASM_THREADS)
   for (auto& item : usedSequences) {
     for (auto& map : item.second) {
       map.second->prepareNextImage();
@@ -151,13 +229,133 @@ void RenderCache::setSnapshotEnabled(bool value) {
   clearAllSnapshots();
 }
 
+size_t RenderCache::snapshotByteBudget() const {
+  return _snapshotByteBudget;
+}
+
+void RenderCache::setSnapshotByteBudget(size_t budget) {
+  if (_snapshotByteBudget == budget) {
+    return;
+  }
+  _snapshotByteBudget = budget;
+  purgeSnapshotsOverBudget();
+}
+
+float RenderCache::staticSnapshotScale() const {
+  return _staticSnapshotScale;
+}
+
+void RenderCache::setStaticSnapshotScale(float value) {
+  value = std::max(0.25f, std::min(value, 1.0f));
+  if (fabsf(_staticSnapshotScale - value) <= SCALE_FACTOR_PRECISION) {
+    return;
+  }
+  _staticSnapshotScale = value;
+  // 旧比例生成的档位不立即清除，后续绘制会按新档位补渲染，旧档位交给预算和 LRU 逐出。
+}
+
+static std::atomic_uint32_t globalPressureGeneration = {0};
+static std::atomic<uint8_t> globalPressureLevel = {0};
+
+void RenderCache::NotifyMemoryPressure(PAGMemoryPressureLevel level) {
+  // 先写级别再自增代数，applyMemoryPressure() 按相反顺序读取，保证看到新代数时级别已经就绪。
+  globalPressureLevel = static_cast<uint8_t>(level);
+  globalPressureGeneration++;
+}
+
+void RenderCache::applyMemoryPressure() {
+  auto generation = globalPressureGeneration.load();
+  if (generation == pressureGeneration) {
+    return;
+  }
+  pressureGeneration = generation;
+  auto level = static_cast<PAGMemoryPressureLevel>(globalPressureLevel.load());
+  decodedAssetImages.clear();
+  if (level < PAGMemoryPressureLevel::Medium) {
+    return;
+  }
+  clearAllSnapshots();
+  if (level < PAGMemoryPressureLevel::High) {
+    return;
+  }
+  for (auto& item : sequenceCaches) {
+    for (auto queue : item.second) {
+      queue->releaseReadAheadBuffers();
+    }
+  }
+  if (level < PAGMemoryPressureLevel::Critical) {
+    return;
+  }
+  clearAllTextAtlas();
+}
+
+size_t RenderCache::memoryUsage() const {
+  return profileMemoryUsage().total();
+}
+
+CacheMemoryUsage RenderCache::profileMemoryUsage() const {
+  CacheMemoryUsage usage = {};
+  usage.snapshots = snapshotMemory;
+  usage.textAtlases = atlasMemory;
+  for (auto& item : decodedAssetImages) {
+    usage.decodedImages += static_cast<size_t>(item.second->width()) *
+                           static_cast<size_t>(item.second->height()) * 4;
+  }
+  for (auto& item : sequenceCaches) {
+    for (auto queue : item.second) {
+      auto frameCount = queue->preparedImages.size() + (queue->currentImage != nullptr ? 1 : 0);
+      usage.sequenceFrames += static_cast<size_t>(queue->sequence->width()) *
+                              static_cast<size_t>(queue->sequence->height()) * 4 * frameCount;
+    }
+  }
+  usage.diskCacheBuffers = DiskCache::BufferMemoryUsage();
+  return usage;
+}
+
+void RenderCache::setMemoryWarningListener(size_t threshold,
+                                           std::function<void(const CacheMemoryUsage&)> listener) {
+  memoryWarningThreshold = threshold;
+  memoryWarningListener = std::move(listener);
+  memoryWarningReported = false;
+}
+
+void RenderCache::checkMemoryWarning() {
+  if (memoryWarningListener == nullptr || memoryWarningThreshold == 0) {
+    return;
+  }
+  auto usage = profileMemoryUsage();
+  if (usage.total() <= memoryWarningThreshold) {
+    memoryWarningReported = false;
+    return;
+  }
+  if (memoryWarningReported) {
+    return;
+  }
+  memoryWarningReported = true;
+  memoryWarningListener(usage);
+}
+
+bool RenderCache::overBudget() const {
+  return frameBudget > 0 && tgfx::Clock::Now() - frameStartTime > frameBudget;
+}
+
+PAGRenderQuality RenderCache::effectiveRenderQuality() const {
+  return overBudget() ? PAGRenderQuality::PowerSaving : renderQuality;
+}
+
 void RenderCache::beginFrame() {
+  frameGeneration++;
+  frameStartTime = tgfx::Clock::Now();
   usedAssets = {};
+  usedSnapshots = {};
   usedSequences = {};
+  snapshotHitCount = 0;
+  snapshotMissCount = 0;
   resetPerformance();
 }
 
 void RenderCache::attachToContext(tgfx::Context* current, bool forDrawing) {
+  TraceEvent traceEvent("RenderCache::attachToContext");
   if (contextID > 0 && contextID != current->uniqueID()) {
     // Context 改变需要清理内部所有缓存，这里用 uniqueID
     // 而不用指针比较，是因为指针析构后再创建可能会地址重合。
@@ -170,49 +368,177 @@ void RenderCache::attachToContext(tgfx::Context* current, bool forDrawing) {
   if (!isDrawingFrame) {
     return;
   }
+  applyMemoryPressure();
   auto removedAssets = stage->getRemovedAssets();
   for (auto assetID : removedAssets) {
     removeSnapshot(assetID);
     assetImages.erase(assetID);
     decodedAssetImages.erase(assetID);
+    mipmapPendingAssets.erase(assetID);
     clearSequenceCache(assetID);
     removeTextAtlas(assetID);
   }
 }
 
+void RenderCache::releaseScaledCaches() {
+  clearAllSnapshots();
+  clearAllTextAtlas();
+  clearAllSurfaces();
+  warmedFilterLayers = {};
+}
+
 void RenderCache::releaseAll() {
   clearAllSnapshots();
   clearAllTextAtlas();
+  clearAllSurfaces();
+  warmedFilterLayers = {};
   graphicsMemory = 0;
   clearAllSequenceCaches();
   contextID = 0;
 }
 
+std::unique_ptr<WarmStartContent> RenderCache::parkContent() {
+  if (assetImages.empty() && decodedAssetImages.empty() && sequenceCaches.empty()) {
+    return nullptr;
+  }
+  auto content = std::make_unique<WarmStartContent>();
+  content->assetImages = std::move(assetImages);
+  content->decodedAssetImages = std::move(decodedAssetImages);
+  content->sequenceCaches = std::move(sequenceCaches);
+  assetImages = {};
+  decodedAssetImages = {};
+  sequenceCaches = {};
+  usedSequences = {};
+  for (auto& item : content->decodedAssetImages) {
+    content->memoryUsage += static_cast<size_t>(item.second->width()) *
+                            static_cast<size_t>(item.second->height()) * 4;
+  }
+  for (auto& item : content->sequenceCaches) {
+    for (auto queue : item.second) {
+      // 队列里最多持有 readAheadCount + 1 帧已解码内容，按满载估算。
+      content->memoryUsage += static_cast<size_t>(queue->sequence->width()) *
+                              static_cast<size_t>(queue->sequence->height()) * 4 *
+                              static_cast<size_t>(queue->readAheadCount + 1);
+    }
+  }
+  return content;
+}
+
+void RenderCache::restoreContent(std::unique_ptr<WarmStartContent> content) {
+  if (content == nullptr) {
+    return;
+  }
+  assetImages.insert(content->assetImages.begin(), content->assetImages.end());
+  decodedAssetImages.insert(content->decodedAssetImages.begin(),
+                            content->decodedAssetImages.end());
+  for (auto& item : content->sequenceCaches) {
+    auto& queues = sequenceCaches[item.first];
+    queues.insert(queues.end(), item.second.begin(), item.second.end());
+  }
+  // 队列的所有权已经转移回来，避免 WarmStartContent 析构时再删除它们。
+  content->sequenceCaches.clear();
+}
+
 void RenderCache::detachFromContext() {
   if (!isDrawingFrame) {
     context = nullptr;
     return;
   }
   prepareNextFrame();
+  // 帧预算用尽时，帧尾的上传和逐出扫描整体顺延到下一帧的帧尾，先把当前帧交出去。
+  if (!overBudget()) {
+    uploadPreparedImages();
+    clearExpiredSequences();
+    clearExpiredDecodedImages();
+    clearExpiredSnapshots();
+    purgeSnapshotsOverBudget();
+    trimSurfacePool();
+    if (!timestamps.empty()) {
+      // Always purge recycled resources that haven't been used in 1 frame.
+      context->purgeResourcesNotUsedSince(timestamps.back(), true);
+    }
+    if (context->memoryUsage() + graphicsMemory > PURGEABLE_GRAPHICS_MEMORY &&
+        timestamps.size() == PURGEABLE_EXPIRED_FRAME) {
+      // Purge all types of resources that haven't been used in 10 frames when the total memory
+      // usage is over 20M.
+      context->purgeResourcesNotUsedSince(timestamps.front(), false);
+    }
+  }
   recordPerformance();
+  checkMemoryWarning();
+  timestamps.push(std::chrono::steady_clock::now());
+  while (timestamps.size() > PURGEABLE_EXPIRED_FRAME) {
+    timestamps.pop();
+  }
+  context = nullptr;
+}
+
+void RenderCache::performIdleMaintenance(tgfx::Context* current) {
+  if (current == nullptr || contextID != current->uniqueID()) {
+    // 缓存不属于这个上下文，没有可以清理的内容。
+    return;
+  }
+  context = current;
+  applyMemoryPressure();
+  // 逐出扫描沿用上一帧标记的 usedAssets / usedSnapshots，语义和帧尾的清理完全一致。
   clearExpiredSequences();
   clearExpiredDecodedImages();
   clearExpiredSnapshots();
-  if (!timestamps.empty()) {
-    // Always purge recycled resources that haven't been used in 1 frame.
-    context->purgeResourcesNotUsedSince(timestamps.back(), true);
+  purgeSnapshotsOverBudget();
+  // 停播期间不会有绘制，离屏表面池整池释放，恢复播放后按需重建。
+  clearAllSurfaces();
+  // 帧尾只清理超过 10 帧未使用的资源，这里把所有未被引用的 GPU 资源一并清掉。
+  context->purgeResourcesNotUsedSince(std::chrono::steady_clock::now(), false);
+  context = nullptr;
+}
+
+static uint64_t MakeSurfaceBucketKey(int width, int height, bool alphaOnly, int sampleCount) {
+  return (static_cast<uint64_t>(width) << 40) | (static_cast<uint64_t>(height) << 16) |
+         (static_cast<uint64_t>(sampleCount) << 8) | static_cast<uint64_t>(alphaOnly);
+}
+
+std::shared_ptr<tgfx::Surface> RenderCache::getOffscreenSurface(int width, int height,
+                                                                bool alphaOnly, int sampleCount) {
+  if (context == nullptr || width <= 0 || height <= 0) {
+    return nullptr;
   }
-  if (context->memoryUsage() + graphicsMemory > PURGEABLE_GRAPHICS_MEMORY &&
-      timestamps.size() == PURGEABLE_EXPIRED_FRAME) {
-    // Purge all types of resources that haven't been used in 10 frames when the total memory usage
-    // is over 20M.
-    context->purgeResourcesNotUsedSince(timestamps.front(), false);
+  width = (width + SURFACE_POOL_ALIGNMENT - 1) / SURFACE_POOL_ALIGNMENT * SURFACE_POOL_ALIGNMENT;
+  height = (height + SURFACE_POOL_ALIGNMENT - 1) / SURFACE_POOL_ALIGNMENT * SURFACE_POOL_ALIGNMENT;
+  auto key = MakeSurfaceBucketKey(width, height, alphaOnly, sampleCount);
+  auto& bucket = surfacePool[key];
+  if (bucket.usedCount < bucket.surfaces.size()) {
+    auto surface = bucket.surfaces[bucket.usedCount++];
+    auto canvas = surface->getCanvas();
+    canvas->setMatrix(tgfx::Matrix::I());
+    canvas->clear();
+    return surface;
+  }
+  auto surface = tgfx::Surface::Make(context, width, height, alphaOnly, sampleCount);
+  if (surface == nullptr) {
+    return nullptr;
   }
-  timestamps.push(std::chrono::steady_clock::now());
-  while (timestamps.size() > PURGEABLE_EXPIRED_FRAME) {
-    timestamps.pop();
+  bucket.surfaces.push_back(surface);
+  bucket.usedCount++;
+  return surface;
+}
+
+void RenderCache::trimSurfacePool() {
+  for (auto item = surfacePool.begin(); item != surfacePool.end();) {
+    auto& bucket = item->second;
+    // Shrink each bucket to the number of surfaces the current frame actually used, so the pool
+    // follows the high-water mark of the content instead of growing monotonically.
+    bucket.surfaces.resize(bucket.usedCount);
+    bucket.usedCount = 0;
+    if (bucket.surfaces.empty()) {
+      item = surfacePool.erase(item);
+    } else {
+      ++item;
+    }
   }
-  context = nullptr;
+}
+
+void RenderCache::clearAllSurfaces() {
+  surfacePool = {};
 }
 
 Snapshot* RenderCache::getSnapshot(ID assetID) const {
@@ -220,10 +546,16 @@ Snapshot* RenderCache::getSnapshot(ID assetID) const {
     return nullptr;
   }
   auto result = snapshotCaches.find(assetID);
-  if (result != snapshotCaches.end()) {
-    return result->second;
+  if (result == snapshotCaches.end()) {
+    return nullptr;
+  }
+  Snapshot* best = nullptr;
+  for (auto snapshot : result->second) {
+    if (best == nullptr || snapshot->scaleFactor() > best->scaleFactor()) {
+      best = snapshot;
+    }
   }
-  return nullptr;
+  return best;
 }
 
 Snapshot* RenderCache::getSnapshot(const Picture* picture) {
@@ -231,52 +563,186 @@ Snapshot* RenderCache::getSnapshot(const Picture* picture) {
     return nullptr;
   }
   usedAssets.insert(picture->assetID);
+  auto cachePolicy = stage->getAssetCachePolicy(picture->assetID);
+  if (cachePolicy == CachePolicy::Disable) {
+    // 设计侧标记为不缓存的资源永远直接绘制内容，不生成快照。
+    return nullptr;
+  }
   auto maxScaleFactor = stage->getAssetMaxScale(picture->assetID);
-  auto scaleFactor = picture->getScaleFactor(maxScaleFactor);
-  auto snapshot = getSnapshot(picture->assetID);
-  if (snapshot && (snapshot->makerKey != picture->uniqueKey ||
-                   fabsf(snapshot->scaleFactor() - scaleFactor) > SCALE_FACTOR_PRECISION)) {
+  auto contentScale = picture->getScaleFactor(maxScaleFactor);
+  auto staticScale = _staticSnapshotScale;
+  if (renderQuality == PAGRenderQuality::PowerSaving) {
+    // 省电模式下静态快照统一降到半分辨率，与用户配置的比例取较小值，不覆盖用户配置。
+    staticScale = std::min(staticScale, 0.5f);
+  }
+  if (staticScale < 1.0f && picture->isStaticContent()) {
+    // 静态内容的快照不会随播放进度失效，长期驻留的背景允许按较低分辨率栅格化，绘制时经快照
+    // 矩阵放大回原尺寸。0.5f 即可把这类快照的显存和采样带宽降为四分之一。
+    contentScale *= staticScale;
+  }
+  auto scaleFactor = GetSnapshotScaleBucket(contentScale);
+  auto result = snapshotCaches.find(picture->assetID);
+  if (result != snapshotCaches.end() && !result->second.empty() &&
+      result->second.front()->makerKey != picture->uniqueKey) {
+    // 内容本身发生了变化，该资源已有的所有缩放档位都失效了。
     removeSnapshot(picture->assetID);
-    snapshot = nullptr;
   }
-  if (snapshot) {
+  auto reuseSnapshot = [this](Snapshot* snapshot) {
+    snapshot->useCount++;
     moveSnapshotToHead(snapshot);
+    usedSnapshots.insert(snapshot);
     return snapshot;
+  };
+  // 没有命中请求的档位时，优先退回略高于它的档位（缩小绘制依然清晰），否则退回最高的低档位。
+  auto findFallback = [this, picture, scaleFactor]() -> Snapshot* {
+    auto item = snapshotCaches.find(picture->assetID);
+    if (item == snapshotCaches.end()) {
+      return nullptr;
+    }
+    Snapshot* fallback = nullptr;
+    for (auto snapshot : item->second) {
+      if (fallback == nullptr) {
+        fallback = snapshot;
+        continue;
+      }
+      auto above = snapshot->scaleFactor() > scaleFactor;
+      auto fallbackAbove = fallback->scaleFactor() > scaleFactor;
+      if (above != fallbackAbove ? above
+                                 : (above ? snapshot->scaleFactor() < fallback->scaleFactor()
+                                          : snapshot->scaleFactor() > fallback->scaleFactor())) {
+        fallback = snapshot;
+      }
+    }
+    return fallback;
+  };
+  result = snapshotCaches.find(picture->assetID);
+  if (result != snapshotCaches.end()) {
+    for (auto snapshot : result->second) {
+      if (fabsf(snapshot->scaleFactor() - scaleFactor) <= SCALE_FACTOR_PRECISION) {
+        pendingSnapshotScales.erase(picture->assetID);
+        snapshotHitCount++;
+        return reuseSnapshot(snapshot);
+      }
+    }
   }
+  auto fallback = findFallback();
+  if (fallback != nullptr) {
+    auto pending = pendingSnapshotScales.find(picture->assetID);
+    if (pending == pendingSnapshotScales.end() ||
+        fabsf(pending->second - scaleFactor) > SCALE_FACTOR_PRECISION) {
+      // 档位刚刚变化，通常正处于缩放动画中。本帧先用最近的档位缩放顶替，等请求的档位稳定一帧
+      // 之后再补渲染对应分辨率，避免动画期间每帧都重建缓存。
+      pendingSnapshotScales[picture->assetID] = scaleFactor;
+      snapshotHitCount++;
+      return reuseSnapshot(fallback);
+    }
+    pendingSnapshotScales.erase(pending);
+  }
+  snapshotMissCount++;
 
+  if (overBudget() && cachePolicy != CachePolicy::Enable) {
+    // 本帧已超出预算，新快照的生成顺延到下一帧，先用最近的缓存档位缩放顶替或直接绘制内容。
+    return fallback != nullptr ? reuseSnapshot(fallback) : nullptr;
+  }
   if (scaleFactor < SCALE_FACTOR_PRECISION || graphicsMemory >= MAX_GRAPHICS_MEMORY) {
-    return nullptr;
+    return fallback != nullptr ? reuseSnapshot(fallback) : nullptr;
+  }
+  if (_snapshotByteBudget > 0 && snapshotMemory >= _snapshotByteBudget) {
+    purgeSnapshotsOverBudget();
+    // The purge may have evicted the fallback bucket as well, look it up again.
+    fallback = findFallback();
+    if (snapshotMemory >= _snapshotByteBudget && cachePolicy != CachePolicy::Enable) {
+      // Every other snapshot saves more rendering work and nothing can be freed, reuse the
+      // nearest existing scale bucket if there is one, deny the cache otherwise. Assets authored
+      // with CachePolicy::Enable are cached regardless of the byte budget.
+      return fallback != nullptr ? reuseSnapshot(fallback) : nullptr;
+    }
   }
   auto minScaleFactor = stage->getAssetMinScale(picture->assetID);
   bool enableMipmap = minScaleFactor / scaleFactor < MIPMAP_ENABLED_THRESHOLD;
-  auto newSnapshot = picture->makeSnapshot(this, scaleFactor, enableMipmap);
+  std::string diskCacheKey = {};
+  if (_useDiskCache) {
+    diskCacheKey = stage->getDiskCacheKey(picture->assetID);
+  }
+  tgfx::Clock clock = {};
+  auto newSnapshot = picture->makeSnapshot(this, scaleFactor, enableMipmap, diskCacheKey);
   if (newSnapshot == nullptr) {
-    return nullptr;
+    return fallback != nullptr ? reuseSnapshot(fallback) : nullptr;
   }
-  snapshot = newSnapshot.release();
+  auto snapshot = newSnapshot.release();
   snapshot->assetID = picture->assetID;
   snapshot->makerKey = picture->uniqueKey;
+  snapshot->pinned = cachePolicy == CachePolicy::Enable;
+  snapshot->makeCost = clock.measure();
+  snapshot->lastUsedFrame = frameGeneration;
+  if (profiler != nullptr) {
+    profiler->addRecord("snapshot#" + std::to_string(picture->assetID), snapshot->makeCost);
+  }
   graphicsMemory += snapshot->memoryUsage();
+  snapshotMemory += snapshot->memoryUsage();
   snapshotLRU.push_front(snapshot);
   snapshotPositions[snapshot] = snapshotLRU.begin();
-  snapshotCaches[picture->assetID] = snapshot;
+  snapshotCaches[picture->assetID].push_back(snapshot);
+  usedSnapshots.insert(snapshot);
   return snapshot;
 }
 
 void RenderCache::removeSnapshot(ID assetID) {
-  auto snapshot = snapshotCaches.find(assetID);
-  if (snapshot == snapshotCaches.end()) {
+  tiledSnapshots.erase(assetID);
+  auto result = snapshotCaches.find(assetID);
+  if (result == snapshotCaches.end()) {
     return;
   }
-  removeSnapshotFromLRU(snapshot->second);
-  graphicsMemory -= snapshot->second->memoryUsage();
-  delete snapshot->second;
-  snapshotCaches.erase(assetID);
+  auto snapshots = result->second;
+  for (auto snapshot : snapshots) {
+    removeSnapshot(snapshot);
+  }
+  pendingSnapshotScales.erase(assetID);
+}
+
+RenderCache::TiledSnapshot* RenderCache::findTiledSnapshot(ID assetID) {
+  auto result = tiledSnapshots.find(assetID);
+  return result != tiledSnapshots.end() ? result->second.get() : nullptr;
+}
+
+RenderCache::TiledSnapshot* RenderCache::createTiledSnapshot(
+    ID assetID, std::shared_ptr<tgfx::Surface> surface) {
+  auto tiledSnapshot = std::make_unique<TiledSnapshot>();
+  tiledSnapshot->surface = std::move(surface);
+  auto result = tiledSnapshot.get();
+  tiledSnapshots[assetID] = std::move(tiledSnapshot);
+  return result;
+}
+
+void RenderCache::removeTiledSnapshot(ID assetID) {
+  tiledSnapshots.erase(assetID);
+}
+
+void RenderCache::removeSnapshot(Snapshot* snapshot) {
+  auto result = snapshotCaches.find(snapshot->assetID);
+  if (result == snapshotCaches.end()) {
+    return;
+  }
+  auto& snapshots = result->second;
+  auto position = std::find(snapshots.begin(), snapshots.end(), snapshot);
+  if (position == snapshots.end()) {
+    return;
+  }
+  snapshots.erase(position);
+  if (snapshots.empty()) {
+    snapshotCaches.erase(result);
+  }
+  removeSnapshotFromLRU(snapshot);
+  snapshotPositions.erase(snapshot);
+  graphicsMemory -= snapshot->memoryUsage();
+  snapshotMemory -= snapshot->memoryUsage();
+  usedSnapshots.erase(snapshot);
+  delete snapshot;
 }
 
 void RenderCache::moveSnapshotToHead(Snapshot* snapshot) {
   removeSnapshotFromLRU(snapshot);
-  snapshot->idleFrames = 0;
+  snapshot->lastUsedFrame = frameGeneration;
   snapshotLRU.push_front(snapshot);
   snapshotPositions[snapshot] = snapshotLRU.begin();
 }
@@ -297,33 +763,54 @@ TextAtlas* RenderCache::getTextAtlas(ID assetID) const {
 }
 
 TextAtlas* RenderCache::getTextAtlas(const TextBlock* textBlock) {
-  auto maxScaleFactor = stage->getAssetMaxScale(textBlock->assetID());
+  // 图集分辨率对齐到与快照相同的 sqrt(2) 缩放档位：缩放动画期间 getAssetMaxScale() 连续变化，
+  // 按精确值匹配会每帧重栅格化整个图集。档位内的差异由绘制端按 totalScale 缩放字形四边形
+  // 补偿，1.0→1.5 的文字缩放动画只会跨越一两个档位。
+  auto scaleFactor = GetSnapshotScaleBucket(stage->getAssetMaxScale(textBlock->assetID()));
   auto textAtlas = getTextAtlas(textBlock->assetID());
   if (textAtlas && (textAtlas->textGlyphsID() != textBlock->id() ||
-                    fabsf(textAtlas->scaleFactor() - maxScaleFactor) > SCALE_FACTOR_PRECISION)) {
+                    fabsf(textAtlas->scaleFactor() - scaleFactor) > SCALE_FACTOR_PRECISION)) {
     removeTextAtlas(textBlock->assetID());
     textAtlas = nullptr;
   }
   if (textAtlas) {
     return textAtlas;
   }
-  if (maxScaleFactor < SCALE_FACTOR_PRECISION) {
+  if (scaleFactor < SCALE_FACTOR_PRECISION) {
     return nullptr;
   }
-  textAtlas = TextAtlas::Make(textBlock, this, maxScaleFactor).release();
+  textAtlas = TextAtlas::Make(textBlock, this, scaleFactor).release();
   if (textAtlas) {
     graphicsMemory += textAtlas->memoryUsage();
+    atlasMemory += textAtlas->memoryUsage();
     textAtlases[textBlock->assetID()] = textAtlas;
   }
   return textAtlas;
 }
 
+void RenderCache::prepareTextAtlas(const TextBlock* textBlock) {
+  if (getTextAtlas(textBlock->assetID()) != nullptr) {
+    return;
+  }
+  if (!preparedGlyphPages.insert(textBlock->id()).second) {
+    // Already scheduled, the GlyphPageCache keeps the rasterized pages until the atlas is made.
+    return;
+  }
+  // 与 getTextAtlas() 使用同一套缩放档位，预渲染的字形页才能被之后的 Make() 命中。
+  auto scaleFactor = GetSnapshotScaleBucket(stage->getAssetMaxScale(textBlock->assetID()));
+  if (scaleFactor < SCALE_FACTOR_PRECISION) {
+    return;
+  }
+  TextAtlas::PrepareAsync(textBlock, this, scaleFactor);
+}
+
 void RenderCache::removeTextAtlas(ID assetID) {
   auto textAtlas = textAtlases.find(assetID);
   if (textAtlas == textAtlases.end()) {
     return;
   }
   graphicsMemory -= textAtlas->second->memoryUsage();
+  atlasMemory -= textAtlas->second->memoryUsage();
   delete textAtlas->second;
   textAtlases.erase(textAtlas);
 }
@@ -333,46 +820,97 @@ void RenderCache::clearAllTextAtlas() {
     graphicsMemory -= atlas.second->memoryUsage();
     delete atlas.second;
   }
+  atlasMemory = 0;
   textAtlases.clear();
+  preparedGlyphPages.clear();
 }
 
 void RenderCache::clearAllSnapshots() {
   for (auto& item : snapshotCaches) {
-    graphicsMemory -= item.second->memoryUsage();
-    delete item.second;
+    for (auto snapshot : item.second) {
+      graphicsMemory -= snapshot->memoryUsage();
+      delete snapshot;
+    }
   }
   snapshotCaches.clear();
   snapshotLRU.clear();
   snapshotPositions.clear();
+  usedSnapshots.clear();
+  pendingSnapshotScales.clear();
+  tiledSnapshots.clear();
+  snapshotMemory = 0;
 }
 
+// 未触及显存水位时每帧最多回收的过期快照数量，大批快照同时过期（例如切场景）时把析构
+// 开销摊到后续几帧里。
+static constexpr size_t MAX_SNAPSHOT_EVICTIONS_PER_FRAME = 16;
+
 void RenderCache::clearExpiredSnapshots() {
   std::vector<Snapshot*> expiredSnapshots;
   size_t releaseMemory = 0;
   for (auto snapshotIter = snapshotLRU.rbegin(); snapshotIter != snapshotLRU.rend();
        snapshotIter++) {
     auto* snapshot = *snapshotIter;
+    if (snapshot->pinned) {
+      // 设计侧标记为常驻缓存的快照不参与过期清理。
+      continue;
+    }
     // 只有 Snapshot 数量可能会比较多，使用 LRU
-    // 来避免遍历完整的列表，遇到第一个用过的就可以取消遍历。
-    if (usedAssets.count(snapshot->assetID) > 0) {
+    // 来避免遍历完整的列表，遇到第一个本帧用过的就可以取消遍历。同一资源可能缓存了多个缩放
+    // 档位，按 Snapshot 而不是资源判断是否使用过，闲置的档位才能正常过期。
+    if (usedSnapshots.count(snapshot) > 0) {
       break;
     }
-    snapshot->idleFrames++;
-    if (snapshot->idleFrames < PURGEABLE_EXPIRED_FRAME &&
-        graphicsMemory - releaseMemory < PURGEABLE_GRAPHICS_MEMORY) {
-      // 总显存占用未超过20M且所有缓存均未超过10帧未使用，跳过清理。
-      continue;
+    if (graphicsMemory - releaseMemory < PURGEABLE_GRAPHICS_MEMORY) {
+      if (frameGeneration - snapshot->lastUsedFrame <
+          static_cast<uint64_t>(PURGEABLE_EXPIRED_FRAME)) {
+        // 链表按最近访问排序，越靠近头部的快照代数越新，后面不会再有过期的，直接结束。
+        // 访问只盖一次代数戳，这里不再逐个累加空闲计数，清理开销与缓存总量无关。
+        break;
+      }
+      if (expiredSnapshots.size() >= MAX_SNAPSHOT_EVICTIONS_PER_FRAME) {
+        break;
+      }
     }
     releaseMemory += snapshot->memoryUsage();
     expiredSnapshots.push_back(snapshot);
   }
   for (const auto& snapshot : expiredSnapshots) {
-    removeSnapshot(snapshot->assetID);
+    removeSnapshot(snapshot);
+  }
+}
+
+void RenderCache::purgeSnapshotsOverBudget() {
+  if (_snapshotByteBudget == 0 || snapshotMemory <= _snapshotByteBudget) {
+    return;
+  }
+  // Rank the candidates by how much rendering work each snapshot saves: frequently reused caches
+  // of expensive content are kept, rarely hit caches of cheap content go first. Snapshots drawn
+  // in the current frame are never evicted.
+  std::vector<Snapshot*> candidates = {};
+  for (auto snapshot : snapshotLRU) {
+    if (usedSnapshots.count(snapshot) == 0 && !snapshot->pinned) {
+      candidates.push_back(snapshot);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), [](Snapshot* a, Snapshot* b) {
+    return static_cast<double>(a->useCount + 1) * static_cast<double>(a->makeCost + 1) <
+           static_cast<double>(b->useCount + 1) * static_cast<double>(b->makeCost + 1);
+  });
+  for (auto& snapshot : candidates) {
+    if (snapshotMemory <= _snapshotByteBudget) {
+      break;
+    }
+    removeSnapshot(snapshot);
   }
 }
 
 void RenderCache::prepareAssetImage(ID assetID, const ImageProxy* proxy) {
   usedAssets.insert(assetID);
+  auto deadline = assetDeadlines.find(assetID);
+  if (deadline == assetDeadlines.end() || prepareTimeDistance < deadline->second) {
+    assetDeadlines[assetID] = prepareTimeDistance;
+  }
   if (decodedAssetImages.count(assetID) != 0 || hasSnapshot(assetID)) {
     return;
   }
@@ -388,6 +926,8 @@ void RenderCache::prepareAssetImage(ID assetID, const ImageProxy* proxy) {
 
 std::shared_ptr<tgfx::Image> RenderCache::getAssetImage(ID assetID, const ImageProxy* proxy) {
   usedAssets.insert(assetID);
+  // 真正被绘制的资源视为立即可见。
+  assetDeadlines[assetID] = 0;
   auto result = decodedAssetImages.find(assetID);
   if (result != decodedAssetImages.end()) {
     auto decodedImage = result->second;
@@ -409,12 +949,95 @@ std::shared_ptr<tgfx::Image> RenderCache::getAssetImageInternal(ID assetID,
   }
   auto scaleFactor = stage->getAssetMinScale(assetID);
   if (scaleFactor < MIPMAP_ENABLED_THRESHOLD) {
-    image = image->makeMipmapped(true);
+    // 不在这里直接 makeMipmapped：大图（例如 replaceImage 换进来的 4K 照片）首帧会连
+    // 带整条 mip 链一起生成上传，轻易超出帧预算。先按无 mip 纹理显示，mip 链记到
+    // 待补名单里，由 uploadPreparedImages() 在之后几帧的上传额度内补齐替换。
+    mipmapPendingAssets.insert(assetID);
   }
   assetImages[assetID] = image;
   return image;
 }
 
+void RenderCache::uploadPreparedImages() {
+  // 把已经解码完、等待首次显示的图片提前转成纹理。上传发生在当前帧绘制结束之后，等真正显示
+  // 时直接绑定现成纹理，textureUploadingTime 不再在切场景那一帧集中飙升。
+  // 每帧的上传额度有限，按距离首次可见的时间从近到远排序，避免先显示的小图排在
+  // 还有几百毫秒才出现的大图后面。
+  std::vector<ID> pendingUploads = {};
+  for (auto& item : decodedAssetImages) {
+    if (!item.second->isTextureBacked()) {
+      pendingUploads.push_back(item.first);
+    }
+  }
+  auto getDeadline = [this](ID assetID) {
+    auto deadline = assetDeadlines.find(assetID);
+    return deadline != assetDeadlines.end() ? deadline->second : INT64_C(0);
+  };
+  std::sort(pendingUploads.begin(), pendingUploads.end(),
+            [&getDeadline](ID a, ID b) { return getDeadline(a) < getDeadline(b); });
+  int uploadedCount = 0;
+  for (auto assetID : pendingUploads) {
+    if (uploadedCount >= MAX_PREUPLOADS_PER_FRAME) {
+      break;
+    }
+    auto& image = decodedAssetImages[assetID];
+    tgfx::Clock clock = {};
+    auto uploadImage = image;
+    auto mipmapPending = mipmapPendingAssets.count(assetID) > 0;
+    if (mipmapPending) {
+      // 还没显示过的图片预上传时直接带上 mip 链，显示时就是完整版本。
+      uploadImage = uploadImage->makeMipmapped(true);
+      if (uploadImage == nullptr) {
+        uploadImage = image;
+        mipmapPending = false;
+      }
+    }
+    auto textureImage = uploadImage->makeTextureImage(context);
+    if (textureImage == nullptr) {
+      continue;
+    }
+    recordTextureUploadingTime(clock.measure());
+    image = textureImage;
+    if (mipmapPending) {
+      assetImages[assetID] = textureImage;
+      mipmapPendingAssets.erase(assetID);
+    }
+    uploadedCount++;
+  }
+  // 没赶上预上传、已经按无 mip 纹理显示过的图片在这里补齐 mip 链，占用同一份每帧额度，
+  // 替换进 assetImages 后下一帧起缩小采样就能用上完整的 mip。
+  std::vector<ID> upgradeList = {};
+  for (auto assetID : mipmapPendingAssets) {
+    if (decodedAssetImages.count(assetID) == 0) {
+      upgradeList.push_back(assetID);
+    }
+  }
+  for (auto assetID : upgradeList) {
+    if (uploadedCount >= MAX_PREUPLOADS_PER_FRAME) {
+      break;
+    }
+    auto result = assetImages.find(assetID);
+    if (result == assetImages.end()) {
+      mipmapPendingAssets.erase(assetID);
+      continue;
+    }
+    auto mipImage = result->second->makeMipmapped(true);
+    if (mipImage == nullptr) {
+      mipmapPendingAssets.erase(assetID);
+      continue;
+    }
+    tgfx::Clock clock = {};
+    auto textureImage = mipImage->makeTextureImage(context);
+    if (textureImage == nullptr) {
+      continue;
+    }
+    recordTextureUploadingTime(clock.measure());
+    result->second = textureImage;
+    mipmapPendingAssets.erase(assetID);
+    uploadedCount++;
+  }
+}
+
 void RenderCache::clearExpiredDecodedImages() {
   std::vector<ID> expiredList = {};
   for (auto& item : decodedAssetImages) {
@@ -426,6 +1049,14 @@ void RenderCache::clearExpiredDecodedImages() {
     decodedAssetImages.erase(assetID);
   }
   expiredList = {};
+  for (auto& item : assetDeadlines) {
+    if (usedAssets.count(item.first) == 0) {
+      expiredList.push_back(item.first);
+    }
+  }
+  for (auto& assetID : expiredList) {
+    assetDeadlines.erase(assetID);
+  }
 }
 
 //===================================== sequence caches =====================================
@@ -526,6 +1157,7 @@ SequenceImageQueue* RenderCache::makeSequenceImageQueue(std::shared_ptr<Sequence
   if (queue == nullptr) {
     return nullptr;
   }
+  queue->setReadAheadCount(_sequenceReadAheadCount);
   auto assetID = sequence->uniqueID();
   sequenceCaches[assetID].push_back(queue);
   return queue;
@@ -37,11 +37,51 @@
 #include "rendering/sequences/SequenceImageQueue.h"
 #include "rendering/sequences/SequenceInfo.h"
 #include "rendering/utils/PathHasher.h"
+#include "tgfx/core/Surface.h"
 #include "tgfx/gpu/Device.h"
 
 namespace pag {
+class WarmStartContent;
+
+/**
+ * A live breakdown of the bytes held by a RenderCache, split by subsystem.
+ */
+struct CacheMemoryUsage {
+  /**
+   * Decoded image frames cached ahead of their first draw.
+   */
+  size_t decodedImages = 0;
+  /**
+   * Decoded frames held by the sequence frame queues.
+   */
+  size_t sequenceFrames = 0;
+  /**
+   * Snapshot caches of layer contents.
+   */
+  size_t snapshots = 0;
+  /**
+   * Glyph atlas pages of text layers.
+   */
+  size_t textAtlases = 0;
+  /**
+   * In-memory staging buffers of the disk cache. This counter is shared by the whole process.
+   */
+  size_t diskCacheBuffers = 0;
+
+  size_t total() const {
+    return decodedImages + sequenceFrames + snapshots + textAtlases + diskCacheBuffers;
+  }
+};
+
 class RenderCache : public Performance {
  public:
+  /**
+   * Records a memory pressure event for every RenderCache in the process. The staged shedding is
+   * applied by each cache on its next attachToContext() call, where the GPU context needed to
+   * release the caches is available.
+   */
+  static void NotifyMemoryPressure(PAGMemoryPressureLevel level);
+
   explicit RenderCache(PAGStage* stage);
 
   ~RenderCache() override;
@@ -52,16 +92,43 @@ class RenderCache : public Performance {
 
   void beginFrame();
 
+  /**
+   * 当前帧内快照缓存的命中和未命中次数，beginFrame() 时清零。
+   */
+  int snapshotHitCount = 0;
+  int snapshotMissCount = 0;
+
   void attachToContext(tgfx::Context* current, bool forDrawing = true);
 
   void detachFromContext();
 
+  /**
+   * Runs the deferrable cache maintenance immediately: eviction sweeps, releasing the offscreen
+   * surface pool, and purging the unreferenced GPU resources. The per-frame sweeps only reclaim
+   * what the memory budgets require; this performs the deep cleanup that would otherwise compete
+   * with a visible frame, so it should be called while the playback is idle. The context must be
+   * locked by the caller and has no effect if it differs from the one the caches were built on.
+   */
+  void performIdleMaintenance(tgfx::Context* current);
+
   /**
    * Returns the total memory usage of this cache.
    */
-  size_t memoryUsage() const {
-    return graphicsMemory;
-  }
+  size_t memoryUsage() const;
+
+  /**
+   * Returns the live memory usage of this cache split by subsystem.
+   */
+  CacheMemoryUsage profileMemoryUsage() const;
+
+  /**
+   * Sets a listener that is invoked on the render thread at the end of a frame whenever the total
+   * memory usage rises above the specified threshold, so the app can shed caches before the OS
+   * intervenes. The listener fires once per crossing and re-arms after the usage drops back below
+   * the threshold. Pass a zero threshold or a null listener to disable the notification.
+   */
+  void setMemoryWarningListener(size_t threshold,
+                                std::function<void(const CacheMemoryUsage&)> listener);
 
   /**
    * Returns the GPU context associated with this cache.
@@ -72,9 +139,10 @@ class RenderCache : public Performance {
 
   /**
    * Prepares the nearly visible layers for the upcoming drawings, which collects all CPU tasks and
-   * runs them asynchronously in parallel.
+   * runs them asynchronously in parallel. If warmUpDecoders is true, every upcoming video sequence
+   * also gets its decoder initialized on a background thread.
    */
-  void prepareLayers();
+  void prepareLayers(bool warmUpDecoders = false);
 
   /**
    * If set to false, the getSnapshot() always returns nullptr. The default value is true.
@@ -86,11 +154,69 @@ class RenderCache : public Performance {
    */
   void setSnapshotEnabled(bool value);
 
+  /**
+   * Returns the maximum total byte size of all snapshot caches. When the budget is exceeded, the
+   * snapshots with the lowest reuse-frequency × render-cost score are evicted first, and creating
+   * new snapshots is denied until enough memory is freed. The default value is 0, which disables
+   * the budget and only applies the global graphics memory limit.
+   */
+  size_t snapshotByteBudget() const;
+
+  /**
+   * Set the value of snapshotByteBudget property.
+   */
+  void setSnapshotByteBudget(size_t budget);
+
+  /**
+   * Returns the resolution scale applied when rasterizing snapshots of static content. Static
+   * snapshots never get invalidated by playback progress, so long-lived backgrounds can be
+   * rasterized at a reduced resolution and scaled back up by the snapshot matrix when drawn. For
+   * example, a value of 0.5 quarters the texture memory and sampling bandwidth of every static
+   * snapshot. The default value is 1.0, which disables the reduction.
+   */
+  float staticSnapshotScale() const;
+
+  /**
+   * Set the value of staticSnapshotScale property. The value is clamped to the range [0.25, 1.0].
+   */
+  void setStaticSnapshotScale(float value);
+
+  /**
+   * The active frame profiler of the owning PAGPlayer, or nullptr when profiling is disabled.
+   */
+  FrameProfiler* profiler = nullptr;
+
+  /**
+   * The render quality of the owning PAGPlayer. Filters and snapshot generation read it to pick
+   * the cheaper paths in PAGRenderQuality::PowerSaving mode.
+   */
+  PAGRenderQuality renderQuality = PAGRenderQuality::Default;
+
+  /**
+   * The frame budget of the owning PAGPlayer in microseconds, 0 means unlimited. beginFrame()
+   * starts the timer; once the elapsed time of a frame exceeds the budget, new snapshot
+   * generation is deferred to the next frame, filters step down to their power-saving paths, and
+   * the end-of-frame uploads and eviction sweeps are postponed.
+   */
+  int64_t frameBudget = 0;
+
+  /**
+   * Returns true once the elapsed time of the current frame exceeds the frame budget.
+   */
+  bool overBudget() const;
+
+  /**
+   * Returns the render quality the rest of the current frame should use: the configured quality
+   * normally, PAGRenderQuality::PowerSaving once the frame runs over its budget.
+   */
+  PAGRenderQuality effectiveRenderQuality() const;
+
   /**
    * Returns true if there is snapshot cache available for specified asset ID.
    */
   bool hasSnapshot(ID assetID) const {
-    return snapshotCaches.count(assetID) > 0;
+    auto result = snapshotCaches.find(assetID);
+    return result != snapshotCaches.end() && !result->second.empty();
   }
 
   /**
@@ -110,8 +236,9 @@ class RenderCache : public Performance {
   }
 
   /**
-   * Returns a snapshot cache of specified asset id. Returns null if there is no associated cache
-   * available. This is a read-only query which is used usually during hit testing.
+   * Returns the highest-resolution snapshot cache of specified asset id. Returns null if there is
+   * no associated cache available. This is a read-only query which is used usually during hit
+   * testing.
    */
   Snapshot* getSnapshot(ID assetID) const;
 
@@ -123,12 +250,33 @@ class RenderCache : public Performance {
   Snapshot* getSnapshot(const Picture* picture);
 
   /**
-   * Frees the snapshot cache associated with specified asset ID immediately.
+   * Frees all snapshot caches associated with specified asset ID immediately.
    */
   void removeSnapshot(ID assetID);
 
+  /**
+   * 大型静态矢量内容分块栅格化快照的中间状态，见 SnapshotPicture::makeSnapshot()。表面在
+   * 多帧里逐块填充，完成前 getSnapshot() 返回空，调用方继续矢量直绘。
+   */
+  struct TiledSnapshot {
+    std::shared_ptr<tgfx::Surface> surface = nullptr;
+    int nextTile = 0;
+  };
+
+  TiledSnapshot* findTiledSnapshot(ID assetID);
+
+  TiledSnapshot* createTiledSnapshot(ID assetID, std::shared_ptr<tgfx::Surface> surface);
+
+  void removeTiledSnapshot(ID assetID);
+
   TextAtlas* getTextAtlas(const TextBlock* textBlock);
 
+  /**
+   * Rasterizes the atlas glyphs of the specified text block on a background thread, so the first
+   * draw of the text only pays for the texture uploads.
+   */
+  void prepareTextAtlas(const TextBlock* textBlock);
+
   /**
    * Prepares an image for the next getAssetImage() call, which may schedule an asynchronous
    * decoding task immediately.
@@ -141,12 +289,25 @@ class RenderCache : public Performance {
    */
   std::shared_ptr<tgfx::Image> getAssetImage(ID assetID, const ImageProxy* proxy);
 
+  /**
+   * Returns an offscreen surface for rendering intermediate filter or mask content. The surfaces
+   * are bucketed by size and recycled across frames to avoid allocation churn, so do not hold on
+   * to the returned surface after the current frame ends. The returned surface may be slightly
+   * larger than the requested size.
+   */
+  std::shared_ptr<tgfx::Surface> getOffscreenSurface(int width, int height, bool alphaOnly = false,
+                                                     int sampleCount = 1);
+
   uint32_t getContentVersion() const;
 
   bool videoEnabled() const;
 
   void setVideoEnabled(bool value);
 
+  int sequenceReadAheadCount() const;
+
+  void setSequenceReadAheadCount(int count);
+
   void prepareSequenceImage(std::shared_ptr<SequenceInfo> sequence, Frame targetFrame);
 
   std::shared_ptr<tgfx::Image> getSequenceImage(std::shared_ptr<SequenceInfo> sequence,
@@ -162,6 +323,26 @@ class RenderCache : public Performance {
 
   void releaseAll();
 
+  /**
+   * Releases only the caches whose content depends on the rendering scale (snapshots, text
+   * atlases, and the offscreen surface pool). Decoded asset images and sequence frame queues are
+   * resolution-independent and stay behind, so a surface resize only rebuilds the scaled parts.
+   */
+  void releaseScaledCaches();
+
+  /**
+   * Moves the context-independent content of this cache (asset images, decoded image buffers and
+   * sequence frame queues) out for parking in the WarmStartCache. Snapshots and text atlases are
+   * bound to the GPU context and stay behind. Returns null if there is nothing worth parking.
+   */
+  std::unique_ptr<WarmStartContent> parkContent();
+
+  /**
+   * Merges previously parked content back into this cache. Entries for assets that already have
+   * caches are dropped.
+   */
+  void restoreContent(std::unique_ptr<WarmStartContent> content);
+
  private:
   ID _uniqueID = 0;
   PAGStage* stage = nullptr;
@@ -171,24 +352,58 @@ class RenderCache : public Performance {
   bool isDrawingFrame = false;
   size_t graphicsMemory = 0;
   bool _videoEnabled = true;
+  int _sequenceReadAheadCount = 1;
   bool _snapshotEnabled = true;
+  size_t _snapshotByteBudget = 0;
+  float _staticSnapshotScale = 1.0f;
+  size_t snapshotMemory = 0;
+  size_t atlasMemory = 0;
   bool _useDiskCache = false;
+  size_t memoryWarningThreshold = 0;
+  std::function<void(const CacheMemoryUsage&)> memoryWarningListener = nullptr;
+  bool memoryWarningReported = false;
+  uint32_t pressureGeneration = 0;
   std::unordered_set<ID> usedAssets = {};
-  std::unordered_map<ID, Snapshot*> snapshotCaches = {};
+  // 同一个资源可以同时缓存多个缩放档位的 Snapshot，缩放动画往返时直接复用已有档位。
+  std::unordered_map<ID, std::vector<Snapshot*>> snapshotCaches = {};
+  std::unordered_set<Snapshot*> usedSnapshots = {};
+  // 当前绘制帧的代数，每帧自增一次，Snapshot 访问时记录它，过期判断只比较代数差。
+  uint64_t frameGeneration = 0;
+  // 当前帧的起始时间（微秒），beginFrame() 时记录，overBudget() 用它判断帧预算是否用尽。
+  int64_t frameStartTime = 0;
+  std::unordered_map<ID, float> pendingSnapshotScales = {};
   std::list<Snapshot*> snapshotLRU = {};
   std::unordered_map<Snapshot*, std::list<Snapshot*>::iterator> snapshotPositions = {};
+  // 尚未完成的分块快照，按资源 ID 存放，内容变化或资源移除时随 removeSnapshot() 一起释放。
+  std::unordered_map<ID, std::unique_ptr<TiledSnapshot>> tiledSnapshots = {};
   std::unordered_map<ID, TextAtlas*> textAtlases = {};
+  std::unordered_set<ID> preparedGlyphPages = {};
+  std::unordered_set<ID> warmedFilterLayers = {};
   std::unordered_map<ID, std::shared_ptr<tgfx::Image>> assetImages = {};
   std::unordered_map<ID, std::shared_ptr<tgfx::Image>> decodedAssetImages = {};
+  // 需要 mipmap 但首次显示时先按无 mip 纹理上传的资源，mip 链在之后几帧的预上传额度里补齐。
+  std::unordered_set<ID> mipmapPendingAssets = {};
+  // 每个资源距离首次可见还剩多少时间（微秒），0 表示当前帧就要显示，预上传按它从近到远排序。
+  std::unordered_map<ID, int64_t> assetDeadlines = {};
+  // prepareLayers() 遍历可见性距离表时的当前档位，循环外的 prepare 调用视为立即可见。
+  int64_t prepareTimeDistance = 0;
   std::unordered_map<ID, std::vector<SequenceImageQueue*>> sequenceCaches = {};
   std::unordered_map<ID, std::unordered_map<Frame, SequenceImageQueue*>> usedSequences = {};
+  struct SurfaceBucket {
+    std::vector<std::shared_ptr<tgfx::Surface>> surfaces = {};
+    size_t usedCount = 0;
+  };
+  std::unordered_map<uint64_t, SurfaceBucket> surfacePool = {};
 
   // decoded image caches:
+  void uploadPreparedImages();
   void clearExpiredDecodedImages();
 
   // snapshot caches:
   void clearAllSnapshots();
   void clearExpiredSnapshots();
+  void purgeSnapshotsOverBudget();
+  void removeSnapshot(Snapshot* snapshot);
   void moveSnapshotToHead(Snapshot* snapshot);
   void removeSnapshotFromLRU(Snapshot* snapshot);
 
@@ -202,16 +417,24 @@ class RenderCache : public Performance {
   void clearSequenceCache(ID uniqueID);
   void clearExpiredSequences();
 
+  // offscreen surface pool:
+  void trimSurfacePool();
+  void clearAllSurfaces();
+
   // text atlas caches:
   void clearAllTextAtlas();
   void removeTextAtlas(ID assetID);
   TextAtlas* getTextAtlas(ID assetID) const;
 
-  void preparePreComposeLayer(PreComposeLayer* layer);
+  void preparePreComposeLayer(PreComposeLayer* layer, bool warmUpDecoders);
   void prepareImageLayer(PAGImageLayer* layer);
+  void prepareTextLayer(PAGLayer* pagLayer);
+  void prepareLayerFilters(PAGLayer* pagLayer);
   void prepareNextFrame();
   std::shared_ptr<tgfx::Image> getAssetImageInternal(ID assetID, const ImageProxy* proxy);
   void recordPerformance();
+  void checkMemoryWarning();
+  void applyMemoryPressure();
 
   friend class PAGPlayer;
 };
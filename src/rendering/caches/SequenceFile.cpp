@@ -18,15 +18,22 @@
 
 #include "SequenceFile.h"
 #include <cstring>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 #include "DiskCache.h"
 #include "base/utils/Log.h"
+#include "base/utils/UniqueID.h"
 #include "pag/file.h"
 #include "rendering/utils/Directory.h"
+#include "rendering/utils/PixelKernels.h"
+#include "rendering/utils/Trace.h"
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/DataView.h"
 
 namespace pag {
-static constexpr uint8_t FILE_VERSION = 1;
+static constexpr uint8_t FILE_VERSION = 3;
 /**
  * [version: uint8_t]
  * [compression: uint8_t]
@@ -48,8 +55,53 @@ static constexpr uint32_t TIME_RANGE_SIZE = 8;
 /**
  * [frameIndex: uint32_t]
  * [frameSize: uint64_t]
+ * [crc32: uint32_t]
+ */
+static constexpr uint32_t FRAME_HEAD_SIZE = 16;
+/**
+ * [offset: uint64_t]
+ * [size: uint64_t]
+ * [crc32: uint32_t]
+ */
+static constexpr uint32_t INDEX_ENTRY_SIZE = 20;
+/**
+ * [indexOffset: uint64_t]
+ * [magic: uint32_t]
  */
-static constexpr uint32_t FRAME_HEAD_SIZE = 12;
+static constexpr uint32_t INDEX_TAIL_SIZE = 12;
+static constexpr uint32_t INDEX_MAGIC = 0x50414749;  // 'PAGI'
+/**
+ * [baseIndex: uint32_t]
+ * Prepended to the payload of a delta frame, naming the keyframe its XOR was taken against.
+ */
+static constexpr uint32_t DELTA_BASE_SIZE = 4;
+// Marks a delta frame in the size fields of frame heads and index entries.
+static constexpr uint64_t DELTA_FRAME_FLAG = 1ULL << 63;
+// A keyframe is forced after this many delta frames, so any seek decompresses at most two frames.
+static constexpr int KEYFRAME_INTERVAL = 8;
+
+static bool IsDeltaType(CompressionType type) {
+  return type == CompressionType::LZ4_DELTA || type == CompressionType::LZ4_APPLE_DELTA;
+}
+
+static CompressionType BaseTypeOf(CompressionType type) {
+  switch (type) {
+    case CompressionType::LZ4_DELTA:
+      return CompressionType::LZ4;
+    case CompressionType::LZ4_APPLE_DELTA:
+      return CompressionType::LZ4_APPLE;
+    default:
+      return type;
+  }
+}
+
+static CompressionType DefaultCompressionType() {
+#ifdef __APPLE__
+  return CompressionType::LZ4_APPLE_DELTA;
+#else
+  return CompressionType::LZ4_DELTA;
+#endif
+}
 
 std::shared_ptr<SequenceFile> SequenceFile::Open(const std::string& filePath,
                                                  const tgfx::ImageInfo& info, int frameCount,
@@ -63,16 +115,60 @@ std::shared_ptr<SequenceFile> SequenceFile::Open(const std::string& filePath,
   return sequenceFile->file ? sequenceFile : nullptr;
 }
 
+tgfx::ImageInfo SequenceFile::ReadInfo(const std::string& filePath, int frameCount,
+                                       float frameRate,
+                                       const std::vector<TimeRange>& staticTimeRanges) {
+  auto file = fopen(filePath.c_str(), "rb");
+  if (file == nullptr) {
+    return {};
+  }
+  tgfx::ImageInfo info = {};
+  tgfx::Buffer buffer(FILE_HEAD_SIZE);
+  auto data = tgfx::DataView(buffer.bytes(), buffer.size());
+  do {
+    if (fread(data.writableBytes(), 1, data.size(), file) != data.size()) {
+      break;
+    }
+    auto compression = data.getUint8(1);
+    if (data.getUint8(0) != FILE_VERSION ||
+        (compression != static_cast<uint8_t>(DefaultCompressionType()) &&
+         compression != static_cast<uint8_t>(BaseTypeOf(DefaultCompressionType()))) ||
+        data.getUint32(16) != static_cast<uint32_t>(frameCount) || data.getFloat(20) != frameRate ||
+        data.getUint32(24) != static_cast<uint32_t>(staticTimeRanges.size())) {
+      break;
+    }
+    auto colorType = data.getUint8(2);
+    auto alphaType = data.getUint8(3);
+    auto fileWidth = data.getUint32(4);
+    auto fileHeight = data.getUint32(8);
+    auto rowBytes = data.getUint32(12);
+    auto matched = true;
+    for (auto& timeRange : staticTimeRanges) {
+      if (fread(data.writableBytes(), 1, TIME_RANGE_SIZE, file) != TIME_RANGE_SIZE ||
+          timeRange.start != data.getUint32(0) || timeRange.end != data.getUint32(4)) {
+        matched = false;
+        break;
+      }
+    }
+    if (!matched) {
+      break;
+    }
+    info = tgfx::ImageInfo::Make(static_cast<int>(fileWidth), static_cast<int>(fileHeight),
+                                 static_cast<tgfx::ColorType>(colorType),
+                                 static_cast<tgfx::AlphaType>(alphaType), rowBytes);
+  } while (false);
+  fclose(file);
+  return info;
+}
+
 SequenceFile::SequenceFile(const std::string& filePath, const tgfx::ImageInfo& info, int frameCount,
                            float frameRate, std::vector<TimeRange> staticTimeRanges)
-    : _info(info), _numFrames(frameCount), _frameRate(frameRate),
-      _staticTimeRanges(std::move(staticTimeRanges)) {
+    : _uniqueID(UniqueID::Next()), _info(info), _numFrames(frameCount), _frameRate(frameRate),
+      _staticTimeRanges(std::move(staticTimeRanges)), filePath(filePath) {
   decoder = LZ4Decoder::Make();
   Directory::CreateRecursively(Directory::GetParentDirectory(filePath));
-#ifdef __APPLE__
-  compressionType = CompressionType::LZ4_APPLE;
-#endif
-  frames.resize(frameCount, {0, 0});
+  compressionType = DefaultCompressionType();
+  frames.resize(frameCount, {});
   file = fopen(filePath.c_str(), "ab+");
   if (file == nullptr) {
     return;
@@ -82,17 +178,41 @@ SequenceFile::SequenceFile(const std::string& filePath, const tgfx::ImageInfo& i
   if (_fileSize == 0) {
     return;
   }
-  if (!readFramesFromFile()) {
-    cachedFrames = 0;
-    memset(frames.data(), 0, sizeof(FrameLocation) * frames.size());
-    _fileSize = 0;
-    fclose(file);
-    file = fopen(filePath.c_str(), "wb+");
-    LOGE("The existing sequence file has been reset, which may be corrupted!");
+  // 校验已有缓存文件需要顺序扫描整个文件（没有帧索引时），放到后台任务执行，打开缓存不再阻塞
+  // 首帧渲染，所有读写入口会先等待扫描完成。帧数据本身由逐帧 CRC 校验兜底，无需提前验证。
+  scanTask = tgfx::Task::Run([this]() { scanFileFrames(); });
+}
+
+void SequenceFile::scanFileFrames() {
+  TraceEvent traceEvent("SequenceFile::scanFileFrames");
+  // 扫描期间不持有 locker，帧数据的读写入口都会先通过 waitForScan() 等待扫描结束，互不冲突，
+  // 只有 fileSize() 可能并发访问，重置 _fileSize 时短暂加锁保证其可见性。
+  if (readFramesFromFile()) {
+    return;
+  }
+  cachedFrames = 0;
+  memset(frames.data(), 0, sizeof(FrameLocation) * frames.size());
+  fclose(file);
+  file = fopen(filePath.c_str(), "wb+");
+  // readFramesFromFile() may have downgraded the compression type before failing.
+  compressionType = DefaultCompressionType();
+  std::lock_guard<std::mutex> autoLock(locker);
+  _fileSize = 0;
+  LOGE("The existing sequence file has been reset, which may be corrupted!");
+}
+
+void SequenceFile::waitForScan() {
+  if (scanTask != nullptr) {
+    scanTask->wait();
   }
 }
 
 SequenceFile::~SequenceFile() {
+  waitForScan();
+  if (writeTask != nullptr) {
+    writeTask->wait();
+  }
+  unmapFile();
   if (file != nullptr) {
     fclose(file);
   }
@@ -122,11 +242,19 @@ bool SequenceFile::readFramesFromFile() {
   auto info = tgfx::ImageInfo::Make(static_cast<int>(fileWidth), static_cast<int>(fileHeight),
                                     static_cast<tgfx::ColorType>(colorType),
                                     static_cast<tgfx::AlphaType>(alphaType), rowBytes);
-  if (version != FILE_VERSION || compression != static_cast<uint8_t>(compressionType) ||
-      info != _info || fileFrameCount != static_cast<uint32_t>(_numFrames) ||
-      fileFrameRate != _frameRate || staticTimeRangeCount != _staticTimeRanges.size()) {
+  if (version != FILE_VERSION || info != _info ||
+      fileFrameCount != static_cast<uint32_t>(_numFrames) || fileFrameRate != _frameRate ||
+      staticTimeRangeCount != _staticTimeRanges.size()) {
     return false;
   }
+  if (compression != static_cast<uint8_t>(compressionType)) {
+    // Caches written before delta frames existed are still valid, keep reading and extending them
+    // with standalone frames.
+    if (compression != static_cast<uint8_t>(BaseTypeOf(compressionType))) {
+      return false;
+    }
+    compressionType = BaseTypeOf(compressionType);
+  }
   for (uint32_t i = 0; i < staticTimeRangeCount; i++) {
     readLength = fread(data.writableBytes(), 1, TIME_RANGE_SIZE, file);
     if (readLength != TIME_RANGE_SIZE) {
@@ -137,6 +265,9 @@ bool SequenceFile::readFramesFromFile() {
       return false;
     }
   }
+  if (readFrameIndex()) {
+    return true;
+  }
   long position = 0;
   while (true) {
     readLength = fread(data.writableBytes(), 1, FRAME_HEAD_SIZE, file);
@@ -153,7 +284,10 @@ bool SequenceFile::readFramesFromFile() {
     }
     auto& frame = frames[frameIndex];
     frame.offset = static_cast<size_t>(ftell(file));
+    frame.isDelta = (frameSize & DELTA_FRAME_FLAG) != 0;
+    frameSize &= ~DELTA_FRAME_FLAG;
     frame.size = frameSize;
+    frame.crc = data.getUint32(12);
     cachedFrames++;
     if (fseek(file, static_cast<long>(frameSize), SEEK_CUR)) {
       return false;
@@ -175,6 +309,100 @@ bool SequenceFile::readFramesFromFile() {
   return true;
 }
 
+bool SequenceFile::readFrameIndex() {
+  auto scanPosition = ftell(file);
+  auto indexSize = static_cast<size_t>(_numFrames) * INDEX_ENTRY_SIZE + INDEX_TAIL_SIZE;
+  if (_fileSize < static_cast<size_t>(scanPosition) + indexSize) {
+    return false;
+  }
+  tgfx::Buffer buffer(indexSize);
+  auto data = tgfx::DataView(buffer.bytes(), buffer.size());
+  if (fseek(file, -static_cast<long>(INDEX_TAIL_SIZE), SEEK_END) ||
+      fread(data.writableBytes(), 1, INDEX_TAIL_SIZE, file) != INDEX_TAIL_SIZE ||
+      data.getUint32(8) != INDEX_MAGIC) {
+    fseek(file, scanPosition, SEEK_SET);
+    return false;
+  }
+  auto indexOffset = data.getUint64(0);
+  if (indexOffset + indexSize != _fileSize ||
+      fseek(file, static_cast<long>(indexOffset), SEEK_SET) ||
+      fread(data.writableBytes(), 1, indexSize, file) != indexSize) {
+    fseek(file, scanPosition, SEEK_SET);
+    return false;
+  }
+  for (int i = 0; i < _numFrames; i++) {
+    auto offset = data.getUint64(i * INDEX_ENTRY_SIZE);
+    auto size = data.getUint64(i * INDEX_ENTRY_SIZE + 8);
+    auto crc = data.getUint32(i * INDEX_ENTRY_SIZE + 16);
+    auto isDelta = (size & DELTA_FRAME_FLAG) != 0;
+    size &= ~DELTA_FRAME_FLAG;
+    if (size == 0 || offset < static_cast<uint64_t>(scanPosition) || offset + size > indexOffset) {
+      memset(frames.data(), 0, sizeof(FrameLocation) * frames.size());
+      fseek(file, scanPosition, SEEK_SET);
+      return false;
+    }
+    frames[i] = {static_cast<size_t>(offset), static_cast<size_t>(size), isDelta, crc};
+  }
+  // The index is only appended once every frame has been cached.
+  cachedFrames = _numFrames;
+  return true;
+}
+
+void SequenceFile::writeFrameIndex() {
+  auto indexOffset = _fileSize;
+  tgfx::Buffer buffer(static_cast<size_t>(_numFrames) * INDEX_ENTRY_SIZE + INDEX_TAIL_SIZE);
+  auto data = tgfx::DataView(buffer.bytes(), buffer.size());
+  for (int i = 0; i < _numFrames; i++) {
+    data.setUint64(i * INDEX_ENTRY_SIZE, frames[i].offset);
+    data.setUint64(i * INDEX_ENTRY_SIZE + 8,
+                   frames[i].size | (frames[i].isDelta ? DELTA_FRAME_FLAG : 0));
+    data.setUint32(i * INDEX_ENTRY_SIZE + 16, frames[i].crc);
+  }
+  auto tailOffset = static_cast<size_t>(_numFrames) * INDEX_ENTRY_SIZE;
+  data.setUint64(tailOffset, indexOffset);
+  data.setUint32(tailOffset + 8, INDEX_MAGIC);
+  if (fseek(file, 0, SEEK_END) || fwrite(data.bytes(), 1, data.size(), file) != data.size()) {
+    LOGE("SequenceFile::writeFrameIndex() failed to append the frame index!");
+    return;
+  }
+  _fileSize += data.size();
+}
+
+const uint8_t* SequenceFile::getMappedData(size_t offset, size_t size) {
+#ifdef _WIN32
+  // No mmap on this platform, fall back to the fread path.
+  (void)offset;
+  (void)size;
+  return nullptr;
+#else
+  if (offset + size > mappedSize) {
+    // The file has grown since the last mapping, remap it to the current size.
+    unmapFile();
+    if (offset + size > _fileSize) {
+      return nullptr;
+    }
+    fflush(file);
+    auto address = mmap(nullptr, _fileSize, PROT_READ, MAP_SHARED, fileno(file), 0);
+    if (address == MAP_FAILED) {
+      return nullptr;
+    }
+    mappedData = reinterpret_cast<uint8_t*>(address);
+    mappedSize = _fileSize;
+  }
+  return mappedData + offset;
+#endif
+}
+
+void SequenceFile::unmapFile() {
+#ifndef _WIN32
+  if (mappedData != nullptr) {
+    munmap(mappedData, mappedSize);
+    mappedData = nullptr;
+    mappedSize = 0;
+  }
+#endif
+}
+
 bool SequenceFile::writeFileHead() {
   tgfx::Buffer buffer(FILE_HEAD_SIZE + _staticTimeRanges.size() * 8);
   auto data = tgfx::DataView(buffer.bytes(), buffer.size());
@@ -203,18 +431,32 @@ bool SequenceFile::writeFileHead() {
 }
 
 size_t SequenceFile::fileSize() {
+  // 这里不等待后台扫描：构造时已经用文件长度初始化了 _fileSize，扫描只在文件损坏重置时才改动
+  // 它，后续写入会通过 notifyFileSizeChanged() 把绝对大小同步给 DiskCache 自行纠正。
   std::lock_guard<std::mutex> autoLock(locker);
   return _fileSize;
 }
 
+size_t SequenceFile::bufferMemoryUsage() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto usage = scratchBuffer.size() + keyframeBuffer.size() + deltaBuffer.size();
+  for (auto& pending : pendingFrames) {
+    usage += pending.second->size();
+  }
+  return usage;
+}
+
 bool SequenceFile::isComplete() {
+  waitForScan();
   std::lock_guard<std::mutex> autoLock(locker);
   return cachedFrames == _numFrames;
 }
 
 bool SequenceFile::readFrame(int index, std::shared_ptr<BitmapBuffer> bitmap) {
+  TraceEvent traceEvent("SequenceFile::readFrame");
+  waitForScan();
   std::lock_guard<std::mutex> autoLock(locker);
-  if (index < 0 || index >= _numFrames || bitmap == nullptr) {
+  if (file == nullptr || index < 0 || index >= _numFrames || bitmap == nullptr) {
     LOGE("SequenceFile::readFrame() invalid index or pixels!");
     return false;
   }
@@ -222,42 +464,114 @@ bool SequenceFile::readFrame(int index, std::shared_ptr<BitmapBuffer> bitmap) {
     LOGE("SequenceFile::readFrame() the info of the specified bitmap is different from ours!");
     return false;
   }
-  const auto& frame = frames[index];
-  if (frame.size == 0) {
+  auto timeRange = GetTimeRangeContains(_staticTimeRanges, index);
+  for (auto& pending : pendingFrames) {
+    if (pending.first == static_cast<int>(timeRange.start)) {
+      auto pixels = bitmap->lockPixels();
+      if (pixels == nullptr) {
+        return false;
+      }
+      memcpy(pixels, pending.second->data(), pending.second->size());
+      bitmap->unlockPixels();
+      return true;
+    }
+  }
+  if (frames[index].size == 0) {
     return false;
   }
-  if (!checkScratchBuffer()) {
+  auto pixels = bitmap->lockPixels();
+  if (pixels == nullptr) {
+    LOGE("SequenceFile::readFrame() failed to lock pixels from the specified bitmap!");
     return false;
   }
-  if (fseek(file, static_cast<long>(frame.offset), SEEK_SET)) {
-    LOGE("SequenceFile::readFrame() fseek failed! (offset: %zu)", frame.offset);
+  auto success = decodeFrame(index, reinterpret_cast<uint8_t*>(pixels));
+  bitmap->unlockPixels();
+  return success;
+}
+
+bool SequenceFile::decodeFrame(int index, uint8_t* dst) {
+  const auto& frame = frames[index];
+  if (frame.size == 0) {
     return false;
   }
-  auto encodedLength = fread(scratchBuffer.bytes(), 1, frame.size, file);
-  if (encodedLength != frame.size) {
-    LOGE("SequenceFile::readFrame() fread failed! (size: %zu)", frame.size);
+  auto offset = frame.offset;
+  auto length = frame.size;
+  if (frame.isDelta) {
+    if (length <= DELTA_BASE_SIZE) {
+      return false;
+    }
+    // Decode the base keyframe into dst first, its index sits in front of the delta payload. The
+    // mapped pointer is fetched afterwards because decoding the base may remap the file.
+    uint8_t baseBytes[DELTA_BASE_SIZE] = {};
+    auto mappedBase = getMappedData(offset, DELTA_BASE_SIZE);
+    if (mappedBase != nullptr) {
+      memcpy(baseBytes, mappedBase, DELTA_BASE_SIZE);
+    } else if (fseek(file, static_cast<long>(offset), SEEK_SET) ||
+               fread(baseBytes, 1, DELTA_BASE_SIZE, file) != DELTA_BASE_SIZE) {
+      LOGE("SequenceFile::decodeFrame() failed to read the base index of frame %d!", index);
+      return false;
+    }
+    auto baseIndex = tgfx::DataView(baseBytes, DELTA_BASE_SIZE).getUint32(0);
+    if (baseIndex >= static_cast<uint32_t>(_numFrames) ||
+        frames[baseIndex].isDelta || !decodeFrame(static_cast<int>(baseIndex), dst)) {
+      return false;
+    }
+    offset += DELTA_BASE_SIZE;
+    length -= DELTA_BASE_SIZE;
+  }
+  // Prefer decompressing directly from the memory-mapped file, which avoids copying the
+  // compressed frame into a scratch buffer on every cache hit.
+  auto encodedData = getMappedData(offset, length);
+  auto encodedLength = length;
+  if (encodedData == nullptr) {
+    if (!checkScratchBuffer()) {
+      return false;
+    }
+    if (fseek(file, static_cast<long>(offset), SEEK_SET)) {
+      LOGE("SequenceFile::decodeFrame() fseek failed! (offset: %zu)", offset);
+      return false;
+    }
+    encodedLength = fread(scratchBuffer.bytes(), 1, length, file);
+    if (encodedLength != length) {
+      LOGE("SequenceFile::decodeFrame() fread failed! (size: %zu)", length);
+      return false;
+    }
+    encodedData = scratchBuffer.bytes();
+  }
+  // 解压前用 CRC-32C 校验压缩数据，硬件 CRC 指令的吞吐远高于解压本身，损坏的缓存帧在污染
+  // 画面之前就会被拒绝。
+  if (Crc32(encodedData, encodedLength) != frame.crc) {
+    LOGE("SequenceFile::decodeFrame() checksum mismatch at frame %d!", index);
     return false;
   }
   auto byteSize = _info.byteSize();
-  auto pixels = bitmap->lockPixels();
-  if (pixels == nullptr) {
-    LOGE("SequenceFile::readFrame() failed to lock pixels from the specified bitmap!");
-    return false;
+  auto target = dst;
+  if (frame.isDelta) {
+    if (deltaBuffer.isEmpty()) {
+      deltaBuffer.alloc(byteSize);
+      if (deltaBuffer.isEmpty()) {
+        LOGE("SequenceFile::decodeFrame() failed to alloc the delta buffer!");
+        return false;
+      }
+    }
+    target = deltaBuffer.bytes();
   }
-  auto decodedLength = decoder->decode(reinterpret_cast<uint8_t*>(pixels), byteSize,
-                                       scratchBuffer.bytes(), encodedLength);
-  bitmap->unlockPixels();
+  auto decodedLength = decoder->decode(target, byteSize, encodedData, encodedLength);
   if (decodedLength != byteSize) {
-    LOGE("SequenceFile::readFrame() decode failed! (decoded: %zu, expected: %zu)", decodedLength,
+    LOGE("SequenceFile::decodeFrame() decode failed! (decoded: %zu, expected: %zu)", decodedLength,
          byteSize);
     return false;
   }
+  if (frame.isDelta) {
+    XorBytes(dst, deltaBuffer.bytes(), byteSize);
+  }
   return true;
 }
 
 bool SequenceFile::writeFrame(int index, std::shared_ptr<BitmapBuffer> bitmap) {
+  waitForScan();
   std::lock_guard<std::mutex> autoLock(locker);
-  if (index < 0 || index >= _numFrames || bitmap == nullptr) {
+  if (file == nullptr || index < 0 || index >= _numFrames || bitmap == nullptr) {
     LOGE("SequenceFile::writeFrame() invalid index or pixels!");
     return false;
   }
@@ -265,17 +579,100 @@ bool SequenceFile::writeFrame(int index, std::shared_ptr<BitmapBuffer> bitmap) {
     LOGE("SequenceFile::writeFrame() the specified bitmap info is different from ours!");
     return false;
   }
+  auto pixels = bitmap->lockPixels();
+  if (pixels == nullptr) {
+    LOGE("SequenceFile::writeFrame() failed to lock pixels from the specified bitmap!");
+    return false;
+  }
+  auto success = writeFrameInternal(index, pixels);
+  bitmap->unlockPixels();
+  return success;
+}
+
+bool SequenceFile::writeFrameAsync(int index, std::shared_ptr<BitmapBuffer> bitmap) {
+  waitForScan();
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (file == nullptr || index < 0 || index >= _numFrames || bitmap == nullptr) {
+    LOGE("SequenceFile::writeFrameAsync() invalid index or pixels!");
+    return false;
+  }
+  if (bitmap->info() != _info) {
+    LOGE("SequenceFile::writeFrameAsync() the specified bitmap info is different from ours!");
+    return false;
+  }
   auto timeRange = GetTimeRangeContains(_staticTimeRanges, index);
   if (frames[timeRange.start].size != 0) {
     return false;
   }
+  for (auto& pending : pendingFrames) {
+    if (pending.first == static_cast<int>(timeRange.start)) {
+      return false;
+    }
+  }
   auto pixels = bitmap->lockPixels();
   if (pixels == nullptr) {
-    LOGE("SequenceFile::writeFrame() failed to lock pixels from the specified bitmap!");
+    LOGE("SequenceFile::writeFrameAsync() failed to lock pixels from the specified bitmap!");
     return false;
   }
-  auto compressedSize = compressFrame(static_cast<int>(timeRange.start), pixels, _info.byteSize());
+  auto data = tgfx::Data::MakeWithCopy(pixels, _info.byteSize());
   bitmap->unlockPixels();
+  if (data == nullptr) {
+    return false;
+  }
+  pendingFrames.emplace_back(static_cast<int>(timeRange.start), std::move(data));
+  if (!writingPending) {
+    writingPending = true;
+    writeTask = tgfx::Task::Run([this]() { writePendingFrames(); });
+  }
+  return true;
+}
+
+void SequenceFile::writePendingFrames() {
+  TraceEvent traceEvent("SequenceFile::writePendingFrames");
+  std::lock_guard<std::mutex> autoLock(locker);
+  while (!pendingFrames.empty()) {
+    auto& pending = pendingFrames.front();
+    if (!writeFrameInternal(pending.first, pending.second->data())) {
+      LOGE("SequenceFile::writePendingFrames() failed to write frame %d!", pending.first);
+    }
+    pendingFrames.pop_front();
+  }
+  writingPending = false;
+}
+
+bool SequenceFile::writeFrameInternal(int index, const void* pixels) {
+  auto timeRange = GetTimeRangeContains(_staticTimeRanges, index);
+  if (frames[timeRange.start].size != 0) {
+    return false;
+  }
+  auto frameIndex = static_cast<int>(timeRange.start);
+  auto byteSize = _info.byteSize();
+  auto isDelta = false;
+  auto payload = reinterpret_cast<const uint8_t*>(pixels);
+  if (IsDeltaType(compressionType)) {
+    if (lastKeyframeIndex >= 0 && framesSinceKeyframe < KEYFRAME_INTERVAL - 1 &&
+        !keyframeBuffer.isEmpty() && !deltaBuffer.isEmpty()) {
+      // 连续帧大多只有局部变化，对关键帧做 XOR 后剩下大片零字节，LZ4 压得非常小。
+      memcpy(deltaBuffer.bytes(), pixels, byteSize);
+      XorBytes(deltaBuffer.bytes(), keyframeBuffer.bytes(), byteSize);
+      payload = deltaBuffer.bytes();
+      isDelta = true;
+    } else {
+      if (keyframeBuffer.isEmpty()) {
+        keyframeBuffer.alloc(byteSize);
+      }
+      if (deltaBuffer.isEmpty()) {
+        deltaBuffer.alloc(byteSize);
+      }
+      if (!keyframeBuffer.isEmpty()) {
+        memcpy(keyframeBuffer.bytes(), pixels, byteSize);
+        lastKeyframeIndex = frameIndex;
+        framesSinceKeyframe = 0;
+      }
+    }
+  }
+  auto compressedSize =
+      compressFrame(frameIndex, payload, byteSize, isDelta ? lastKeyframeIndex : -1);
   if (compressedSize == 0) {
     return false;
   }
@@ -290,16 +687,26 @@ bool SequenceFile::writeFrame(int index, std::shared_ptr<BitmapBuffer> bitmap) {
     LOGE("SequenceFile::writeFrame() failed to write the compressed frame to disk");
     return false;
   }
+  auto frameCrc = tgfx::DataView(scratchBuffer.bytes(), scratchBuffer.size()).getUint32(12);
   for (auto i = timeRange.start; i <= timeRange.end; i++) {
     auto& frame = frames[i];
     frame.offset = _fileSize + FRAME_HEAD_SIZE;
     frame.size = compressedSize - FRAME_HEAD_SIZE;
+    frame.isDelta = isDelta;
+    frame.crc = frameCrc;
     cachedFrames++;
   }
+  if (isDelta) {
+    framesSinceKeyframe++;
+  }
   _fileSize += compressedSize;
   if (cachedFrames == _numFrames) {
     scratchBuffer.reset();
+    keyframeBuffer.reset();
+    deltaBuffer.reset();
+    lastKeyframeIndex = -1;
     encoder = nullptr;
+    writeFrameIndex();
   }
   if (diskCache) {
     diskCache->notifyFileSizeChanged(fileID, _fileSize);
@@ -307,15 +714,16 @@ bool SequenceFile::writeFrame(int index, std::shared_ptr<BitmapBuffer> bitmap) {
   return true;
 }
 
-size_t SequenceFile::compressFrame(int index, const void* pixels, size_t byteSize) {
+size_t SequenceFile::compressFrame(int index, const void* pixels, size_t byteSize, int baseIndex) {
   if (!checkScratchBuffer()) {
     return 0;
   }
   if (encoder == nullptr) {
     encoder = LZ4Encoder::Make();
   }
-  auto bytes = scratchBuffer.bytes() + FRAME_HEAD_SIZE;
-  auto size = scratchBuffer.size() - FRAME_HEAD_SIZE;
+  auto headSize = FRAME_HEAD_SIZE + (baseIndex >= 0 ? DELTA_BASE_SIZE : 0);
+  auto bytes = scratchBuffer.bytes() + headSize;
+  auto size = scratchBuffer.size() - headSize;
   auto encodedLength =
       encoder->encode(bytes, size, reinterpret_cast<const uint8_t*>(pixels), byteSize);
   if (encodedLength == 0) {
@@ -324,6 +732,13 @@ size_t SequenceFile::compressFrame(int index, const void* pixels, size_t byteSiz
   }
   tgfx::DataView dataView(scratchBuffer.bytes(), scratchBuffer.size());
   dataView.setUint32(0, index);
+  dataView.setUint32(12, Crc32(bytes, encodedLength));
+  if (baseIndex >= 0) {
+    auto payloadSize = encodedLength + DELTA_BASE_SIZE;
+    dataView.setUint64(4, payloadSize | DELTA_FRAME_FLAG);
+    dataView.setUint32(FRAME_HEAD_SIZE, static_cast<uint32_t>(baseIndex));
+    return payloadSize + FRAME_HEAD_SIZE;
+  }
   dataView.setUint64(4, encodedLength);
   return encodedLength + FRAME_HEAD_SIZE;
 }
@@ -340,7 +755,8 @@ bool SequenceFile::checkScratchBuffer() {
       }
     }
   } else {
-    scratchBufferSize = LZ4Encoder::GetMaxOutputSize(_info.byteSize()) + FRAME_HEAD_SIZE;
+    scratchBufferSize =
+        LZ4Encoder::GetMaxOutputSize(_info.byteSize()) + FRAME_HEAD_SIZE + DELTA_BASE_SIZE;
   }
   scratchBuffer.alloc(scratchBufferSize);
   if (scratchBuffer.isEmpty()) {
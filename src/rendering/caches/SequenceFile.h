@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <list>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -26,7 +27,9 @@
 #include "rendering/utils/LZ4Decoder.h"
 #include "rendering/utils/LZ4Encoder.h"
 #include "tgfx/core/Buffer.h"
+#include "tgfx/core/Data.h"
 #include "tgfx/core/ImageInfo.h"
+#include "tgfx/core/Task.h"
 
 namespace pag {
 class DiskCache;
@@ -34,11 +37,18 @@ class DiskCache;
 struct FrameLocation {
   size_t offset = 0;
   size_t size = 0;
+  bool isDelta = false;
+  // CRC-32C of the compressed payload, verified before decompression on every cache hit.
+  uint32_t crc = 0;
 };
 
 enum class CompressionType {
   LZ4 = 1,
   LZ4_APPLE = 2,
+  // Same encodings as above, but non-keyframes store an LZ4-compressed XOR against the raw pixels
+  // of their base keyframe, which is written periodically so seeking stays O(1).
+  LZ4_DELTA = 3,
+  LZ4_APPLE_DELTA = 4,
 };
 
 /**
@@ -90,11 +100,25 @@ class SequenceFile {
     return _staticTimeRanges;
   }
 
+  /**
+   * Returns a unique ID for this sequence file, which is never reused by another instance in the
+   * process.
+   */
+  ID uniqueID() const {
+    return _uniqueID;
+  }
+
   /**
    * Returns the file size of the sequence.
    */
   size_t fileSize();
 
+  /**
+   * Returns the total byte size of the in-memory staging buffers held by this sequence file,
+   * including frames copied for asynchronous writing that have not reached the disk yet.
+   */
+  size_t bufferMemoryUsage();
+
   /**
    * Returns true if the sequence file already has all frames cached.
    */
@@ -112,9 +136,18 @@ class SequenceFile {
    */
   bool writeFrame(int index, std::shared_ptr<BitmapBuffer> bitmap);
 
+  /**
+   * Copies the given image frame and schedules its compression and disk write on a background
+   * task, so the calling thread never blocks on LZ4 encoding. Frames are written in the order
+   * they were scheduled. Returns false if the specified index is not empty or the bitmap info is
+   * different from ours.
+   */
+  bool writeFrameAsync(int index, std::shared_ptr<BitmapBuffer> bitmap);
+
  private:
   std::mutex locker = {};
   DiskCache* diskCache = nullptr;
+  ID _uniqueID = 0;
   uint32_t fileID = 0;
   FILE* file = nullptr;
   size_t _fileSize = 0;
@@ -126,20 +159,49 @@ class SequenceFile {
   int cachedFrames = 0;
   std::vector<FrameLocation> frames = {};
   tgfx::Buffer scratchBuffer = {};
+  tgfx::Buffer keyframeBuffer = {};
+  tgfx::Buffer deltaBuffer = {};
+  int lastKeyframeIndex = -1;
+  int framesSinceKeyframe = 0;
   std::unique_ptr<LZ4Decoder> decoder = nullptr;
   std::unique_ptr<LZ4Encoder> encoder = nullptr;
+  std::list<std::pair<int, std::shared_ptr<tgfx::Data>>> pendingFrames = {};
+  bool writingPending = false;
+  std::shared_ptr<tgfx::Task> writeTask = nullptr;
+  std::string filePath = {};
+  std::shared_ptr<tgfx::Task> scanTask = nullptr;
 
   static std::shared_ptr<SequenceFile> Open(const std::string& filePath,
                                             const tgfx::ImageInfo& info, int frameCount,
                                             float frameRate,
                                             const std::vector<TimeRange>& staticTimeRanges);
 
+  /**
+   * Reads the ImageInfo recorded in the head of the sequence file at filePath without modifying
+   * the file. Returns an empty ImageInfo if the file does not exist or its head does not match the
+   * given frame count, frame rate, and static time ranges.
+   */
+  static tgfx::ImageInfo ReadInfo(const std::string& filePath, int frameCount, float frameRate,
+                                  const std::vector<TimeRange>& staticTimeRanges);
+
   SequenceFile(const std::string& filePath, const tgfx::ImageInfo& info, int frameCount,
                float frameRate, std::vector<TimeRange> staticTimeRanges);
 
+  uint8_t* mappedData = nullptr;
+  size_t mappedSize = 0;
+
+  void scanFileFrames();
+  void waitForScan();
   bool readFramesFromFile();
+  bool readFrameIndex();
+  void writeFrameIndex();
+  const uint8_t* getMappedData(size_t offset, size_t size);
+  void unmapFile();
   bool writeFileHead();
-  size_t compressFrame(int index, const void* pixels, size_t byteSize);
+  size_t compressFrame(int index, const void* pixels, size_t byteSize, int baseIndex);
+  bool decodeFrame(int index, uint8_t* dst);
+  bool writeFrameInternal(int index, const void* pixels);
+  void writePendingFrames();
   bool checkScratchBuffer();
   bool compatible(const tgfx::ImageInfo& info, int frameCount, float frameRate,
                   const std::vector<TimeRange>& staticTimeRanges);
@@ -17,10 +17,15 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ShapeContentCache.h"
-#include "rendering/renderers/ShapeRenderer.h"
 
 namespace pag {
 ShapeContentCache::ShapeContentCache(ShapeLayer* layer) : ContentCache(layer) {
+  if (ShapeGeometryCacheable(layer->contents)) {
+    std::vector<TimeRange> timeRanges = {layer->visibleRange()};
+    ExcludeGeometryVaryingRanges(layer->contents, &timeRanges);
+    timeRanges = OffsetTimeRanges(timeRanges, -layer->startTime);
+    geometryStatic = !HasVaryingTimeRange(&timeRanges, 0, layer->duration);
+  }
 }
 
 void ShapeContentCache::excludeVaryingRanges(std::vector<TimeRange>* timeRanges) const {
@@ -30,8 +35,16 @@ void ShapeContentCache::excludeVaryingRanges(std::vector<TimeRange>* timeRanges)
 }
 
 GraphicContent* ShapeContentCache::createContent(Frame layerFrame) const {
-  auto graphic =
-      RenderShapes(layer->uniqueID, static_cast<ShapeLayer*>(layer)->contents, layerFrame);
+  auto shapeLayer = static_cast<ShapeLayer*>(layer);
+  if (!geometryStatic) {
+    auto graphic = RenderShapes(layer->uniqueID, shapeLayer->contents, layerFrame);
+    return new GraphicContent(graphic);
+  }
+  // Only the paints animate, so bake the path geometry once and reuse it for every frame.
+  if (shapeGeometry == nullptr) {
+    shapeGeometry = MakeShapeGeometry(shapeLayer->contents, layerFrame);
+  }
+  auto graphic = RenderShapes(layer->uniqueID, shapeGeometry.get(), layerFrame);
   return new GraphicContent(graphic);
 }
 }  // namespace pag
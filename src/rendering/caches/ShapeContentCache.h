@@ -19,6 +19,7 @@
 #pragma once
 
 #include "ContentCache.h"
+#include "rendering/renderers/ShapeRenderer.h"
 
 namespace pag {
 class ShapeContentCache : public ContentCache {
@@ -28,5 +29,11 @@ class ShapeContentCache : public ContentCache {
  protected:
   void excludeVaryingRanges(std::vector<TimeRange>* timeRanges) const override;
   GraphicContent* createContent(Frame layerFrame) const override;
+
+ private:
+  // True when the path geometry never varies across frames, so only the paints animate and one
+  // baked geometry can be shared by all frames.
+  bool geometryStatic = false;
+  mutable std::shared_ptr<ShapeGeometry> shapeGeometry = nullptr;
 };
 }  // namespace pag
@@ -17,8 +17,10 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "TextAtlas.h"
+#include "GlyphPageCache.h"
 #include "RenderCache.h"
 #include "tgfx/core/Canvas.h"
+#include "rendering/utils/RenderTaskScheduler.h"
 #include "tgfx/core/Mask.h"
 #include "tgfx/core/Surface.h"
 
@@ -222,7 +224,31 @@ static std::vector<Page> CreatePages(const std::vector<GlyphHandle>& glyphs, int
   return pages;
 }
 
-std::shared_ptr<tgfx::Image> DrawMask(tgfx::Context* context, const Page& page) {
+static tgfx::BytesKey MakePageKey(const Page& page) {
+  tgfx::BytesKey pageKey = {};
+  pageKey.write(static_cast<uint32_t>(page.width));
+  pageKey.write(static_cast<uint32_t>(page.height));
+  for (auto& textRun : page.textRuns) {
+    auto typeface = textRun.textFont.getTypeface();
+    pageKey.write(typeface ? typeface->uniqueID() : 0);
+    pageKey.write(textRun.textFont.getSize());
+    pageKey.write(static_cast<uint32_t>(textRun.paint.getStyle()));
+    pageKey.write(textRun.paint.getStrokeWidth());
+    for (size_t i = 0; i < textRun.glyphIDs.size(); i++) {
+      pageKey.write(static_cast<uint32_t>(textRun.glyphIDs[i]));
+      pageKey.write(textRun.positions[i].x);
+      pageKey.write(textRun.positions[i].y);
+    }
+  }
+  return pageKey;
+}
+
+static std::shared_ptr<tgfx::ImageBuffer> RasterizePage(const Page& page) {
+  auto pageKey = MakePageKey(page);
+  auto buffer = GlyphPageCache::GetInstance()->find(pageKey);
+  if (buffer != nullptr) {
+    return buffer;
+  }
   auto mask = tgfx::Mask::Make(page.width, page.height);
   if (mask == nullptr) {
     LOGE("Atlas: create mask failed.");
@@ -237,7 +263,17 @@ std::shared_ptr<tgfx::Image> DrawMask(tgfx::Context* context, const Page& page)
       mask->fillText(blob.get(), textRun.paint.getStroke());
     }
   }
-  auto maskImage = tgfx::Image::MakeFrom(mask->makeBuffer());
+  buffer = mask->makeBuffer();
+  GlyphPageCache::GetInstance()->add(pageKey, buffer);
+  return buffer;
+}
+
+std::shared_ptr<tgfx::Image> DrawMask(tgfx::Context* context, const Page& page) {
+  auto buffer = RasterizePage(page);
+  auto maskImage = tgfx::Image::MakeFrom(std::move(buffer));
+  if (maskImage == nullptr) {
+    return nullptr;
+  }
   return maskImage->makeTextureImage(context);
 }
 
@@ -323,6 +359,29 @@ std::unique_ptr<TextAtlas> TextAtlas::Make(const TextBlock* textBlock, RenderCac
       new TextAtlas(textBlock->id(), maskAtlas, colorAtlas, scale, maxScale));
 }
 
+void TextAtlas::PrepareAsync(const TextBlock* textBlock, RenderCache* renderCache, float scale) {
+  auto context = renderCache->getContext();
+  if (context == nullptr) {
+    return;
+  }
+  auto maxPageSize = context->caps()->maxTextureSize;
+  auto maxScale = scale * textBlock->maxScale();
+  auto maskGlyphs = textBlock->maskAtlasGlyphs(maxScale);
+  if (maskGlyphs.empty() || maskGlyphs[0]->getFont().getSize() > MaxAtlasFontSize) {
+    return;
+  }
+  // Color glyphs are drawn through a GPU surface, only the mask pages can be rasterized off the
+  // rendering thread.
+  auto pages = std::make_shared<std::vector<Page>>(CreatePages(maskGlyphs, maxPageSize));
+  RenderTaskScheduler::GetInstance()->submit(
+      [pages] {
+        for (auto& page : *pages) {
+          RasterizePage(page);
+        }
+      },
+      TaskPriority::Prefetch);
+}
+
 TextAtlas::~TextAtlas() {
   delete maskAtlas;
   delete colorAtlas;
@@ -38,6 +38,12 @@ class TextAtlas {
   static std::unique_ptr<TextAtlas> Make(const TextBlock* textBlock, RenderCache* renderCache,
                                          float scale);
 
+  /**
+   * Rasterizes the mask atlas pages of the specified text block into the GlyphPageCache on a
+   * background thread, so a later Make() call only pays for the texture uploads.
+   */
+  static void PrepareAsync(const TextBlock* textBlock, RenderCache* renderCache, float scale);
+
   ~TextAtlas();
 
   ID textGlyphsID() const {
@@ -242,7 +242,7 @@ GraphicContent* TextContentCache::createContent(Frame layerFrame) const {
   auto colorText = Text::MakeFrom(colorGlyphs, block);
   auto content = new TextContent(std::move(graphic), std::move(colorText));
   if (_cacheEnabled) {
-    content->colorGlyphs = Picture::MakeFrom(getCacheID(), content->colorGlyphs);
+    content->colorGlyphs = Picture::MakeFrom(getCacheID(), content->colorGlyphs, contentStatic());
   }
   return content;
 }
@@ -0,0 +1,89 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "WarmStartCache.h"
+
+namespace pag {
+// 整个进程所有播放器共享的停车位上限，超出后按 LRU 淘汰整条记录。
+static constexpr size_t MAX_WARM_CACHE_SIZE = 67108864;  // 64MB
+// 进度按十分之一分桶，列表回滚到相近进度时仍能命中同一条记录。
+static constexpr int PROGRESS_BUCKET_COUNT = 10;
+
+WarmStartContent::~WarmStartContent() {
+  for (auto& item : sequenceCaches) {
+    for (auto queue : item.second) {
+      delete queue;
+    }
+  }
+}
+
+WarmStartCache* WarmStartCache::GetInstance() {
+  static auto& instance = *new WarmStartCache();
+  return &instance;
+}
+
+std::string WarmStartCache::MakeKey(const std::string& filePath, double progress) {
+  auto bucket = static_cast<int>(progress * PROGRESS_BUCKET_COUNT);
+  if (bucket < 0) {
+    bucket = 0;
+  }
+  if (bucket >= PROGRESS_BUCKET_COUNT) {
+    bucket = PROGRESS_BUCKET_COUNT - 1;
+  }
+  return filePath + ":" + std::to_string(bucket);
+}
+
+void WarmStartCache::park(const std::string& key, std::unique_ptr<WarmStartContent> content) {
+  if (content == nullptr || content->memoryUsage > MAX_WARM_CACHE_SIZE) {
+    return;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  for (auto item = entries.begin(); item != entries.end(); item++) {
+    if (item->first == key) {
+      totalMemory -= item->second->memoryUsage;
+      entries.erase(item);
+      break;
+    }
+  }
+  totalMemory += content->memoryUsage;
+  entries.emplace_front(key, std::move(content));
+  while (totalMemory > MAX_WARM_CACHE_SIZE && !entries.empty()) {
+    totalMemory -= entries.back().second->memoryUsage;
+    entries.pop_back();
+  }
+}
+
+std::unique_ptr<WarmStartContent> WarmStartCache::restore(const std::string& key) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  for (auto item = entries.begin(); item != entries.end(); item++) {
+    if (item->first == key) {
+      auto content = std::move(item->second);
+      totalMemory -= content->memoryUsage;
+      entries.erase(item);
+      return content;
+    }
+  }
+  return nullptr;
+}
+
+void WarmStartCache::purgeAll() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  entries.clear();
+  totalMemory = 0;
+}
+}  // namespace pag
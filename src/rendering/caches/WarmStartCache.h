@@ -0,0 +1,89 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "pag/types.h"
+#include "rendering/sequences/SequenceImageQueue.h"
+#include "tgfx/core/Image.h"
+
+namespace pag {
+/**
+ * WarmStartContent holds the context-independent parts of a RenderCache: the asset images, the
+ * decoded image buffers, and the sequence frame queues with their decoders. Snapshots and text
+ * atlases are GPU resources bound to a specific context and can never be parked.
+ */
+class WarmStartContent {
+ public:
+  ~WarmStartContent();
+
+  std::unordered_map<ID, std::shared_ptr<tgfx::Image>> assetImages = {};
+  std::unordered_map<ID, std::shared_ptr<tgfx::Image>> decodedAssetImages = {};
+  std::unordered_map<ID, std::vector<SequenceImageQueue*>> sequenceCaches = {};
+  size_t memoryUsage = 0;
+};
+
+/**
+ * WarmStartCache is a process-level, size-capped pool of parked render cache content, keyed by
+ * file path and progress bucket. It lets a recycled view park its decoded content on detach and
+ * have a later player showing the same file restore it on the next flush, instead of re-decoding
+ * everything from scratch.
+ */
+class WarmStartCache {
+ public:
+  static WarmStartCache* GetInstance();
+
+  /**
+   * Returns the pool key for the specified file path and progress. Entries parked and restored
+   * within the same progress bucket share the key, so a cell scrolled away and back at a nearby
+   * progress still hits the pool.
+   */
+  static std::string MakeKey(const std::string& filePath, double progress);
+
+  /**
+   * Parks the content under the specified key, replacing any previous entry with the same key.
+   * The least recently parked entries are evicted when the pool exceeds its byte limit.
+   */
+  void park(const std::string& key, std::unique_ptr<WarmStartContent> content);
+
+  /**
+   * Removes and returns the content parked under the specified key. Returns null if there is no
+   * entry for the key.
+   */
+  std::unique_ptr<WarmStartContent> restore(const std::string& key);
+
+  /**
+   * Removes all parked entries, e.g. on memory pressure.
+   */
+  void purgeAll();
+
+ private:
+  std::mutex locker = {};
+  size_t totalMemory = 0;
+  // 最近 park 的内容放在队首，超出容量上限时从队尾淘汰。
+  std::list<std::pair<std::string, std::unique_ptr<WarmStartContent>>> entries = {};
+
+  WarmStartCache() = default;
+};
+}  // namespace pag
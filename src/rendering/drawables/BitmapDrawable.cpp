@@ -41,6 +41,20 @@ void BitmapDrawable::setBitmap(std::shared_ptr<BitmapBuffer> buffer) {
   freeSurface();
 }
 
+void BitmapDrawable::setAsyncReadback(bool value) {
+  if (asyncReadback == value) {
+    return;
+  }
+  asyncReadback = value;
+  pendingSurface = nullptr;
+  pendingBitmap = nullptr;
+  asyncSurfaces[0] = nullptr;
+  asyncSurfaces[1] = nullptr;
+  backIndex = 0;
+  lastReadbackResult = true;
+  freeSurface();
+}
+
 void BitmapDrawable::present(tgfx::Context* context) {
   if (bitmap == nullptr) {
     return;
@@ -51,6 +65,18 @@ void BitmapDrawable::present(tgfx::Context* context) {
     pixelCopied = true;
     return;
   }
+  if (asyncReadback) {
+    // Read back the previous frame first, whose rendering has had a whole frame to finish, then
+    // queue this one. The deferred copy is what lets rendering frame N+1 overlap with reading
+    // frame N.
+    lastReadbackResult = finishPendingReadback();
+    pendingSurface = asyncSurfaces[backIndex];
+    pendingBitmap = bitmap;
+    backIndex = 1 - backIndex;
+    // Force the next getSurface() onto the other offscreen surface.
+    surface = nullptr;
+    return;
+  }
   if (offscreenSurface != nullptr) {
     auto pixels = bitmap->lockPixels();
     if (pixels == nullptr) {
@@ -61,6 +87,34 @@ void BitmapDrawable::present(tgfx::Context* context) {
   }
 }
 
+bool BitmapDrawable::finishPendingReadback() {
+  if (pendingSurface == nullptr || pendingBitmap == nullptr) {
+    return true;
+  }
+  auto result = false;
+  auto pixels = pendingBitmap->lockPixels();
+  if (pixels != nullptr) {
+    result = pendingSurface->readPixels(pendingBitmap->info(), pixels);
+    pendingBitmap->unlockPixels();
+  }
+  pendingSurface = nullptr;
+  pendingBitmap = nullptr;
+  return result;
+}
+
+std::shared_ptr<tgfx::Surface> BitmapDrawable::makeOffscreenSurface(tgfx::Context* context) {
+  auto hardwareBuffer = tgfx::HardwareBufferAllocate(_width, _height);
+  auto newSurface = tgfx::Surface::MakeFrom(context, hardwareBuffer);
+  tgfx::HardwareBufferRelease(hardwareBuffer);
+  if (newSurface == nullptr) {
+    auto colorType = bitmap->info().colorType() == tgfx::ColorType::BGRA_8888
+                         ? tgfx::ColorType::BGRA_8888
+                         : tgfx::ColorType::RGBA_8888;
+    newSurface = tgfx::Surface::Make(context, _width, _height, colorType);
+  }
+  return newSurface;
+}
+
 std::shared_ptr<tgfx::Surface> BitmapDrawable::onCreateSurface(tgfx::Context* context) {
   if (bitmap == nullptr) {
     return nullptr;
@@ -69,16 +123,14 @@ std::shared_ptr<tgfx::Surface> BitmapDrawable::onCreateSurface(tgfx::Context* co
   if (hardwareBuffer != nullptr) {
     return tgfx::Surface::MakeFrom(context, hardwareBuffer);
   }
-  if (offscreenSurface == nullptr) {
-    hardwareBuffer = tgfx::HardwareBufferAllocate(_width, _height);
-    offscreenSurface = tgfx::Surface::MakeFrom(context, hardwareBuffer);
-    tgfx::HardwareBufferRelease(hardwareBuffer);
-    if (offscreenSurface == nullptr) {
-      auto colorType = bitmap->info().colorType() == tgfx::ColorType::BGRA_8888
-                           ? tgfx::ColorType::BGRA_8888
-                           : tgfx::ColorType::RGBA_8888;
-      offscreenSurface = tgfx::Surface::Make(context, _width, _height, colorType);
+  if (asyncReadback) {
+    if (asyncSurfaces[backIndex] == nullptr) {
+      asyncSurfaces[backIndex] = makeOffscreenSurface(context);
     }
+    return asyncSurfaces[backIndex];
+  }
+  if (offscreenSurface == nullptr) {
+    offscreenSurface = makeOffscreenSurface(context);
   }
   return offscreenSurface;
 }
@@ -46,6 +46,34 @@ class BitmapDrawable : public Drawable {
     return pixelCopied;
   }
 
+  /**
+   * If set to true, present() only queues the rendered frame for readback instead of copying its
+   * pixels immediately, and two offscreen surfaces are used alternately so the next frame can
+   * render while the previous one is still in flight. The pixels are copied when the next frame is
+   * presented or by finishPendingReadback(). Only applies to bitmaps without a hardware buffer.
+   */
+  void setAsyncReadback(bool value);
+
+  /**
+   * Returns true if a presented frame is still waiting for its pixels to be read back.
+   */
+  bool hasPendingReadback() const {
+    return pendingBitmap != nullptr;
+  }
+
+  /**
+   * Returns false if the readback completed by the last present() failed.
+   */
+  bool lastReadbackSucceeded() const {
+    return lastReadbackResult;
+  }
+
+  /**
+   * Copies the pixels of the pending frame into its bitmap. Must be called with the context of
+   * the associated device current. Returns true if there was nothing pending.
+   */
+  bool finishPendingReadback();
+
  protected:
   std::shared_ptr<tgfx::Surface> onCreateSurface(tgfx::Context* context) override;
 
@@ -56,7 +84,15 @@ class BitmapDrawable : public Drawable {
   std::shared_ptr<tgfx::Surface> offscreenSurface = nullptr;
   std::shared_ptr<BitmapBuffer> bitmap = nullptr;
   bool pixelCopied = false;
+  bool asyncReadback = false;
+  bool lastReadbackResult = true;
+  int backIndex = 0;
+  std::shared_ptr<tgfx::Surface> asyncSurfaces[2] = {nullptr, nullptr};
+  std::shared_ptr<tgfx::Surface> pendingSurface = nullptr;
+  std::shared_ptr<BitmapBuffer> pendingBitmap = nullptr;
 
   BitmapDrawable(int width, int height, std::shared_ptr<tgfx::Device> device);
+
+  std::shared_ptr<tgfx::Surface> makeOffscreenSurface(tgfx::Context* context);
 };
 }  // namespace pag
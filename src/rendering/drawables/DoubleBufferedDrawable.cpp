@@ -17,27 +17,34 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "DoubleBufferedDrawable.h"
+#include <algorithm>
 #include "base/utils/TGFXCast.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 #include "tgfx/platform/HardwareBuffer.h"
 
 namespace pag {
 std::shared_ptr<DoubleBufferedDrawable> DoubleBufferedDrawable::Make(
-    int width, int height, bool tryHardware, std::shared_ptr<tgfx::Device> device) {
+    int width, int height, bool tryHardware, std::shared_ptr<tgfx::Device> device,
+    int bufferCount) {
   if (device == nullptr || width <= 0 || height <= 0) {
     return nullptr;
   }
+  bufferCount = std::max(2, std::min(bufferCount, 4));
   return std::shared_ptr<DoubleBufferedDrawable>(
-      new DoubleBufferedDrawable(width, height, tryHardware, std::move(device)));
+      new DoubleBufferedDrawable(width, height, tryHardware, bufferCount, std::move(device)));
 }
 
 DoubleBufferedDrawable::DoubleBufferedDrawable(int width, int height, bool tryHardware,
+                                               int bufferCount,
                                                std::shared_ptr<tgfx::Device> device)
-    : _width(width), _height(height), tryHardware(tryHardware), device(std::move(device)) {
+    : _width(width), _height(height), tryHardware(tryHardware), bufferCount(bufferCount),
+      device(std::move(device)) {
 }
 
 void DoubleBufferedDrawable::onFreeSurface() {
   frontSurface = nullptr;
+  surfaces.clear();
+  backIndex = 0;
 }
 
 std::shared_ptr<tgfx::Surface> DoubleBufferedDrawable::getFrontSurface(tgfx::Context* context,
@@ -52,23 +59,30 @@ std::shared_ptr<tgfx::Surface> DoubleBufferedDrawable::getFrontSurface(tgfx::Con
 }
 
 std::shared_ptr<tgfx::Surface> DoubleBufferedDrawable::onCreateSurface(tgfx::Context* context) {
-  frontSurface = makeSurface(context);
-  if (frontSurface == nullptr) {
-    return nullptr;
-  }
-  auto backSurface = makeSurface(context);
-  if (backSurface == nullptr) {
-    frontSurface = nullptr;
-    return nullptr;
+  surfaces.clear();
+  for (int i = 0; i < bufferCount; i++) {
+    auto newSurface = makeSurface(context);
+    if (newSurface == nullptr) {
+      surfaces.clear();
+      frontSurface = nullptr;
+      return nullptr;
+    }
+    surfaces.push_back(std::move(newSurface));
   }
-  return backSurface;
+  frontSurface = surfaces.front();
+  backIndex = 1;
+  return surfaces[backIndex];
 }
 
 void DoubleBufferedDrawable::present(tgfx::Context*) {
   if (frontSurface == nullptr) {
     return;
   }
-  std::swap(frontSurface, surface);
+  // The just rendered back surface becomes the new front, and the rendering moves on to the
+  // oldest buffer in the ring, which the consumer is least likely to still be reading.
+  frontSurface = surface;
+  backIndex = (backIndex + 1) % surfaces.size();
+  surface = surfaces[backIndex];
 }
 
 std::shared_ptr<tgfx::Surface> DoubleBufferedDrawable::makeSurface(tgfx::Context* context) const {
@@ -23,8 +23,13 @@
 namespace pag {
 class DoubleBufferedDrawable : public Drawable {
  public:
+  /**
+   * The bufferCount is clamped to the range of [2, 4]. A deeper ring lets a consumer hold a
+   * presented buffer for an extra frame or two without stalling the rendering into the next one.
+   */
   static std::shared_ptr<DoubleBufferedDrawable> Make(int width, int height, bool tryHardware,
-                                                      std::shared_ptr<tgfx::Device> device);
+                                                      std::shared_ptr<tgfx::Device> device,
+                                                      int bufferCount = 2);
 
   int width() const override {
     return _width;
@@ -51,10 +56,13 @@ class DoubleBufferedDrawable : public Drawable {
   int _width;
   int _height;
   bool tryHardware;
+  int bufferCount;
   std::shared_ptr<tgfx::Device> device = nullptr;
   std::shared_ptr<tgfx::Surface> frontSurface;
+  std::vector<std::shared_ptr<tgfx::Surface>> surfaces = {};
+  size_t backIndex = 0;
 
-  DoubleBufferedDrawable(int width, int height, bool tryHardware,
+  DoubleBufferedDrawable(int width, int height, bool tryHardware, int bufferCount,
                          std::shared_ptr<tgfx::Device> device);
 
   std::shared_ptr<tgfx::Surface> makeSurface(tgfx::Context* context) const;
@@ -17,11 +17,26 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "OffscreenDrawable.h"
+#include <atomic>
+#include <mutex>
 #include "tgfx/gpu/opengl/GLDevice.h"
 
 namespace pag {
-std::shared_ptr<OffscreenDrawable> OffscreenDrawable::Make(int width, int height) {
-  auto device = tgfx::GLDevice::MakeWithFallback();
+static std::shared_ptr<tgfx::Device> GetSharedDevice() {
+  static auto& locker = *new std::mutex();
+  static auto& weakDevice = *new std::weak_ptr<tgfx::Device>();
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto device = weakDevice.lock();
+  if (device == nullptr) {
+    device = tgfx::GLDevice::MakeWithFallback();
+    weakDevice = device;
+  }
+  return device;
+}
+
+std::shared_ptr<OffscreenDrawable> OffscreenDrawable::Make(int width, int height,
+                                                           bool useSharedDevice) {
+  auto device = useSharedDevice ? GetSharedDevice() : tgfx::GLDevice::MakeWithFallback();
   if (device == nullptr || width <= 0 || height <= 0) {
     return nullptr;
   }
@@ -34,11 +49,20 @@ OffscreenDrawable::OffscreenDrawable(int width, int height, std::shared_ptr<tgfx
 }
 
 std::shared_ptr<tgfx::Surface> OffscreenDrawable::onCreateSurface(tgfx::Context* context) {
-  auto hardwareBuffer = tgfx::HardwareBufferAllocate(_width, _height);
-  auto surface = tgfx::Surface::MakeFrom(context, hardwareBuffer);
-  tgfx::HardwareBufferRelease(hardwareBuffer);
-  if (surface != nullptr) {
-    return surface;
+  // 无 GPU 的容器环境没有硬件缓冲支持，第一次分配失败后记住结果，后续的离屏表面直接走
+  // 纹理路径，不再为每个表面重复一次注定失败的分配尝试。
+  static std::atomic<bool> hardwareBufferUnsupported = {false};
+  if (!hardwareBufferUnsupported.load(std::memory_order_relaxed)) {
+    auto hardwareBuffer = tgfx::HardwareBufferAllocate(_width, _height);
+    if (hardwareBuffer != nullptr) {
+      auto surface = tgfx::Surface::MakeFrom(context, hardwareBuffer);
+      tgfx::HardwareBufferRelease(hardwareBuffer);
+      if (surface != nullptr) {
+        return surface;
+      }
+    } else {
+      hardwareBufferUnsupported.store(true, std::memory_order_relaxed);
+    }
   }
 #ifdef __APPLE__
   return tgfx::Surface::Make(context, _width, _height, tgfx::ColorType::BGRA_8888);
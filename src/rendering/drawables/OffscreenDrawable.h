@@ -24,7 +24,14 @@ namespace pag {
 
 class OffscreenDrawable : public Drawable {
  public:
-  static std::shared_ptr<OffscreenDrawable> Make(int width, int height);
+  /**
+   * Creates an offscreen drawable of the specified size. If useSharedDevice is true, the drawable
+   * attaches to a process-wide device shared by all offscreen drawables created with the same
+   * flag, instead of creating its own device. The shared device is released automatically when the
+   * last drawable using it goes away.
+   */
+  static std::shared_ptr<OffscreenDrawable> Make(int width, int height,
+                                                 bool useSharedDevice = false);
 
   int width() const override {
     return _width;
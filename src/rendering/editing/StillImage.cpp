@@ -17,26 +17,88 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "StillImage.h"
+#include <algorithm>
+#include <cmath>
 #include "base/utils/TGFXCast.h"
 #include "base/utils/UniqueID.h"
 #include "pag/pag.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/graphics/Graphic.h"
 #include "rendering/graphics/Picture.h"
+#include "rendering/utils/RenderTaskScheduler.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 
 namespace pag {
+// 计算把图片限制在 maxWidth x maxHeight 以内所需的缩放比例，0 或负数表示对应方向不限制。
+static float GetTargetScale(int width, int height, int maxWidth, int maxHeight) {
+  auto scale = 1.0f;
+  if (maxWidth > 0 && width > maxWidth) {
+    scale = static_cast<float>(maxWidth) / static_cast<float>(width);
+  }
+  if (maxHeight > 0 && height > maxHeight) {
+    scale = std::min(scale, static_cast<float>(maxHeight) / static_cast<float>(height));
+  }
+  return scale;
+}
+
 std::shared_ptr<PAGImage> PAGImage::FromPath(const std::string& filePath) {
   auto image = tgfx::Image::MakeFromFile(filePath);
   return StillImage::MakeFrom(std::move(image));
 }
 
+std::shared_ptr<PAGImage> PAGImage::FromPath(const std::string& filePath, int maxWidth,
+                                             int maxHeight) {
+  auto image = tgfx::Image::MakeFromFile(filePath);
+  return StillImage::MakeFrom(std::move(image), maxWidth, maxHeight);
+}
+
+std::shared_ptr<PAGLoadRequest> PAGImage::FromPathAsync(
+    const std::string& filePath, std::function<void(std::shared_ptr<PAGImage>)> callback,
+    int maxWidth, int maxHeight) {
+  if (callback == nullptr) {
+    return nullptr;
+  }
+  auto request = std::shared_ptr<PAGLoadRequest>(new PAGLoadRequest());
+  RenderTaskScheduler::GetInstance()->submit(
+      [request, filePath, maxWidth, maxHeight, callback = std::move(callback)]() {
+        {
+          std::lock_guard<std::mutex> autoLock(request->locker);
+          if (request->cancelled) {
+            // 已经取消的请求直接跳过磁盘读取和解码。
+            return;
+          }
+        }
+        auto image = tgfx::Image::MakeFromFile(filePath);
+        if (image != nullptr) {
+          // 在工作线程上提前完成解码，避免首帧绘制时再去解码大图。
+          auto decoded = image->makeDecoded();
+          if (decoded != nullptr) {
+            image = decoded;
+          }
+        }
+        auto pagImage = StillImage::MakeFrom(std::move(image), maxWidth, maxHeight);
+        std::lock_guard<std::mutex> autoLock(request->locker);
+        if (!request->cancelled) {
+          callback(std::move(pagImage));
+        }
+      },
+      TaskPriority::VisibleNow);
+  return request;
+}
+
 std::shared_ptr<PAGImage> PAGImage::FromBytes(const void* bytes, size_t length) {
   auto fileBytes = tgfx::Data::MakeWithCopy(bytes, length);
   auto image = tgfx::Image::MakeFromEncoded(std::move(fileBytes));
   return StillImage::MakeFrom(std::move(image));
 }
 
+std::shared_ptr<PAGImage> PAGImage::FromBytes(const void* bytes, size_t length, int maxWidth,
+                                              int maxHeight) {
+  auto fileBytes = tgfx::Data::MakeWithCopy(bytes, length);
+  auto image = tgfx::Image::MakeFromEncoded(std::move(fileBytes));
+  return StillImage::MakeFrom(std::move(image), maxWidth, maxHeight);
+}
+
 std::shared_ptr<PAGImage> PAGImage::FromPixels(const void* pixels, int width, int height,
                                                size_t rowBytes, ColorType colorType,
                                                AlphaType alphaType) {
@@ -47,15 +109,23 @@ std::shared_ptr<PAGImage> PAGImage::FromPixels(const void* pixels, int width, in
   return StillImage::MakeFrom(image);
 }
 
-std::shared_ptr<StillImage> StillImage::MakeFrom(std::shared_ptr<tgfx::Image> image) {
+std::shared_ptr<StillImage> StillImage::MakeFrom(std::shared_ptr<tgfx::Image> image, int maxWidth,
+                                                 int maxHeight) {
   if (image == nullptr) {
     return nullptr;
   }
-  auto pagImage = std::shared_ptr<StillImage>(new StillImage(image->width(), image->height()));
-  auto picture = Picture::MakeFrom(pagImage->uniqueID(), image);
+  auto scale = GetTargetScale(image->width(), image->height(), maxWidth, maxHeight);
+  auto width = std::max(1, static_cast<int>(roundf(static_cast<float>(image->width()) * scale)));
+  auto height = std::max(1, static_cast<int>(roundf(static_cast<float>(image->height()) * scale)));
+  auto pagImage = std::shared_ptr<StillImage>(new StillImage(width, height));
+  std::shared_ptr<Graphic> picture = Picture::MakeFrom(pagImage->uniqueID(), image);
   if (!picture) {
     return nullptr;
   }
+  if (scale < 1.0f) {
+    // 以缩放后的尺寸作为内容大小，光栅化和快照缓存都按显示尺寸而不是原图分辨率来分配。
+    picture = Graphic::MakeCompose(picture, tgfx::Matrix::MakeScale(scale));
+  }
   pagImage->graphic = picture;
   return pagImage;
 }
@@ -26,7 +26,8 @@ namespace pag {
 
 class StillImage : public PAGImage {
  public:
-  static std::shared_ptr<StillImage> MakeFrom(std::shared_ptr<tgfx::Image> image);
+  static std::shared_ptr<StillImage> MakeFrom(std::shared_ptr<tgfx::Image> image, int maxWidth = 0,
+                                              int maxHeight = 0);
 
  protected:
   std::shared_ptr<Graphic> getGraphic(int64_t) const override {
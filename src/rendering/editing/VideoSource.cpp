@@ -0,0 +1,69 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "VideoSource.h"
+#include "rendering/graphics/Picture.h"
+
+namespace pag {
+std::shared_ptr<tgfx::Image> VideoSourceProxy::getImage(RenderCache*) const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return image;
+}
+
+void VideoSourceProxy::setCurrentFrame(HardwareBufferRef hardwareBuffer) {
+  // 先在锁外完成包装，推帧线程和渲染线程只在指针交换上短暂互斥。
+  auto frame = hardwareBuffer != nullptr ? tgfx::Image::MakeFrom(hardwareBuffer) : nullptr;
+  std::lock_guard<std::mutex> autoLock(locker);
+  image = frame;
+  version++;
+}
+
+Frame VideoSourceProxy::contentVersion() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return version;
+}
+
+std::shared_ptr<PAGVideoSource> PAGVideoSource::Make(int width, int height) {
+  if (width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  return std::shared_ptr<PAGVideoSource>(new PAGVideoSource(width, height));
+}
+
+PAGVideoSource::PAGVideoSource(int width, int height) : PAGImage(width, height) {
+  proxy = std::make_shared<VideoSourceProxy>(width, height);
+  // 内容图始终是同一个 Picture，推帧只替换 proxy 里的纹理，不会触发图层缓存的重建。
+  graphic = Picture::MakeFrom(uniqueID(), proxy);
+}
+
+void PAGVideoSource::setCurrentFrame(HardwareBufferRef hardwareBuffer) {
+  proxy->setCurrentFrame(hardwareBuffer);
+}
+
+std::shared_ptr<Graphic> PAGVideoSource::getGraphic(Frame) const {
+  return graphic;
+}
+
+bool PAGVideoSource::isStill() const {
+  return false;
+}
+
+Frame PAGVideoSource::getContentFrame(int64_t) const {
+  return proxy->contentVersion();
+}
+}  // namespace pag
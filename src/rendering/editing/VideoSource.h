@@ -0,0 +1,77 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include "pag/pag.h"
+#include "rendering/graphics/ImageProxy.h"
+
+namespace pag {
+/**
+ * VideoSourceProxy holds the most recently pushed frame of a PAGVideoSource. It reports itself as
+ * temporary, so the frame is always drawn directly instead of being rasterized into a snapshot
+ * that the next frame would invalidate anyway.
+ */
+class VideoSourceProxy : public ImageProxy {
+ public:
+  VideoSourceProxy(int width, int height) : _width(width), _height(height) {
+  }
+
+  int width() const override {
+    return _width;
+  }
+
+  int height() const override {
+    return _height;
+  }
+
+  bool isTemporary() const override {
+    return true;
+  }
+
+  void prepareImage(RenderCache*) const override {
+  }
+
+  std::shared_ptr<tgfx::Image> getImage(RenderCache*) const override;
+
+  /**
+   * Wraps the hardware buffer as the current frame without copying pixels and bumps the content
+   * version. Passing null clears the current frame.
+   */
+  void setCurrentFrame(HardwareBufferRef hardwareBuffer);
+
+  /**
+   * Returns the number of frames pushed so far, used as the content frame of the owning
+   * PAGVideoSource so that a newly pushed frame marks the layer content as changed.
+   */
+  Frame contentVersion() const;
+
+ protected:
+  std::shared_ptr<tgfx::Image> makeImage(RenderCache* cache) const override {
+    return getImage(cache);
+  }
+
+ private:
+  mutable std::mutex locker = {};
+  int _width = 0;
+  int _height = 0;
+  std::shared_ptr<tgfx::Image> image = nullptr;
+  Frame version = 0;
+};
+}  // namespace pag
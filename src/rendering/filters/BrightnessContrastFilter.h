@@ -49,6 +49,10 @@ class BrightnessContrastFilter : public RuntimeFilter {
   void onUpdateParams(tgfx::Context* context, const RuntimeProgram* program,
                       const std::vector<tgfx::BackendTexture>& sources) const override;
 
+  bool coversTarget() const override {
+    return true;
+  }
+
  private:
   float brightness = 0.f;
   float contrast = 0.f;
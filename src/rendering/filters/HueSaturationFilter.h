@@ -53,6 +53,10 @@ class HueSaturationFilter : public RuntimeFilter {
   void onUpdateParams(tgfx::Context* context, const RuntimeProgram* program,
                       const std::vector<tgfx::BackendTexture>& sources) const override;
 
+  bool coversTarget() const override {
+    return true;
+  }
+
  private:
   float hue = 0.f;
   float saturation = 0.f;
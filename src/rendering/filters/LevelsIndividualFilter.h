@@ -81,6 +81,10 @@ class LevelsIndividualFilter : public RuntimeFilter {
   void onUpdateParams(tgfx::Context* context, const RuntimeProgram* program,
                       const std::vector<tgfx::BackendTexture>&) const override;
 
+  bool coversTarget() const override {
+    return true;
+  }
+
  private:
   LevelsIndividualFilterParam param;
 };
@@ -57,6 +57,10 @@ class MosaicFilter : public RuntimeFilter {
   void onUpdateParams(tgfx::Context* context, const RuntimeProgram* program,
                       const std::vector<tgfx::BackendTexture>&) const override;
 
+  bool coversTarget() const override {
+    return true;
+  }
+
  private:
   float horizontalBlocks = 1;
   float verticalBlocks = 1;
@@ -18,11 +18,16 @@
 
 #include "MotionBlurFilter.h"
 #include "rendering/caches/LayerCache.h"
+#include "rendering/caches/RenderCache.h"
 #include "rendering/filters/utils/FilterHelper.h"
 
 namespace pag {
 #define MOTION_BLUR_SCALE_FACTOR 1.2f
 
+// Below this size (in either dimension) the accumulation runs at full resolution: the saving is
+// negligible and the bilinear upsample would soften small layers visibly.
+static constexpr int MOTION_BLUR_MIN_DOWNSAMPLE_SIZE = 64;
+
 static const char MOTIONBLUR_VERTEX_SHADER[] = R"(
         #version 100
         attribute vec2 aPosition;
@@ -99,10 +104,44 @@ bool MotionBlurFilter::ShouldSkipFilter(Layer* layer, Frame layerFrame) {
   return previousMatrix == currentMatrix;
 }
 
+// The shader samples the source 37 times per pixel, which roughly doubles the GPU cost of a layer
+// whenever motion blur is enabled. The accumulated result is low-frequency by nature, so run it at
+// half resolution and upsample with the default bilinear sampling; the velocity matrices are
+// normalized by the content size and therefore apply to the half-resolution image unchanged.
+static std::shared_ptr<tgfx::Image> ApplyDownsampled(std::shared_ptr<tgfx::Image> input,
+                                                     tgfx::Context* context,
+                                                     const std::array<float, 9>& previousGLMatrix,
+                                                     const std::array<float, 9>& currentGLMatrix,
+                                                     tgfx::Point* offset) {
+  auto scaledWidth = (input->width() + 1) / 2;
+  auto scaledHeight = (input->height() + 1) / 2;
+  auto scaled = ScaleImage(context, input, scaledWidth, scaledHeight, 0.5f, 0.5f);
+  if (scaled == nullptr) {
+    return nullptr;
+  }
+  auto filter = std::make_shared<MotionBlurFilter>(previousGLMatrix, currentGLMatrix);
+  auto scaledOffset = tgfx::Point::Zero();
+  auto blurred = scaled->makeWithFilter(tgfx::ImageFilter::Runtime(filter), &scaledOffset);
+  if (blurred == nullptr) {
+    return nullptr;
+  }
+  auto scaleX = static_cast<float>(scaled->width()) / static_cast<float>(input->width());
+  auto scaleY = static_cast<float>(scaled->height()) / static_cast<float>(input->height());
+  auto width = static_cast<int>(roundf(static_cast<float>(blurred->width()) / scaleX));
+  auto height = static_cast<int>(roundf(static_cast<float>(blurred->height()) / scaleY));
+  auto result =
+      ScaleImage(context, std::move(blurred), width, height, 1.0f / scaleX, 1.0f / scaleY);
+  if (result == nullptr) {
+    return nullptr;
+  }
+  offset->set(scaledOffset.x / scaleX, scaledOffset.y / scaleY);
+  return result;
+}
+
 std::shared_ptr<tgfx::Image> MotionBlurFilter::Apply(std::shared_ptr<tgfx::Image> input,
                                                      Layer* layer, Frame layerFrame,
                                                      const tgfx::Rect& contentBounds,
-                                                     tgfx::Point* offset) {
+                                                     RenderCache* cache, tgfx::Point* offset) {
   auto contentFrame = layerFrame - layer->startTime;
   auto layerCache = LayerCache::Get(layer);
   auto previousMatrix = layerCache->getTransform(contentFrame > 0 ? contentFrame - 1 : 0)->matrix;
@@ -115,6 +154,14 @@ std::shared_ptr<tgfx::Image> MotionBlurFilter::Apply(std::shared_ptr<tgfx::Image
       ToGLTextureMatrix(previousMatrix, width, height, tgfx::ImageOrigin::TopLeft);
   auto currentGLMatrix =
       ToGLTextureMatrix(currentMatrix, width, height, tgfx::ImageOrigin::TopLeft);
+  auto context = cache != nullptr ? cache->getContext() : nullptr;
+  if (context != nullptr && input->width() >= MOTION_BLUR_MIN_DOWNSAMPLE_SIZE &&
+      input->height() >= MOTION_BLUR_MIN_DOWNSAMPLE_SIZE) {
+    auto result = ApplyDownsampled(input, context, previousGLMatrix, currentGLMatrix, offset);
+    if (result != nullptr) {
+      return result;
+    }
+  }
   auto filter = std::make_shared<MotionBlurFilter>(previousGLMatrix, currentGLMatrix);
   return input->makeWithFilter(tgfx::ImageFilter::Runtime(filter), offset);
 }
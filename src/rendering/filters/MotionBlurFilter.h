@@ -23,6 +23,7 @@
 #include "pag/file.h"
 
 namespace pag {
+class RenderCache;
 
 class MotionBlurUniforms : public Uniforms {
  public:
@@ -48,7 +49,7 @@ class MotionBlurFilter : public RuntimeFilter {
 
   static std::shared_ptr<tgfx::Image> Apply(std::shared_ptr<tgfx::Image> input, Layer* layer,
                                             Frame layerFrame, const tgfx::Rect& contentBounds,
-                                            tgfx::Point* offset);
+                                            RenderCache* cache, tgfx::Point* offset);
   DEFINE_RUNTIME_EFFECT_TYPE
 
   MotionBlurFilter(const std::array<float, 9>& preMatrix, const std::array<float, 9>& curMatrix)
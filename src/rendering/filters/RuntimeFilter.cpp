@@ -19,6 +19,7 @@
 #include "RuntimeFilter.h"
 #include "base/utils/Log.h"
 #include "rendering/filters/utils/FilterHelper.h"
+#include "rendering/filters/utils/FilterProgramCache.h"
 
 namespace pag {
 static constexpr char VERTEX_SHADER[] = R"(
@@ -68,7 +69,7 @@ std::unique_ptr<RuntimeProgram> RuntimeProgram::Make(tgfx::Context* context,
                                                      const std::string& vertex,
                                                      const std::string& fragment) {
   auto gl = tgfx::GLFunctions::Get(context);
-  auto program = CreateGLProgram(context, vertex, fragment);
+  auto program = FilterProgramCache::GetProgram(context, vertex, fragment);
   if (program == 0) {
     return nullptr;
   }
@@ -84,7 +85,7 @@ std::unique_ptr<RuntimeProgram> RuntimeProgram::Make(tgfx::Context* context,
 void RuntimeProgram::onReleaseGPU() {
   auto gl = tgfx::GLFunctions::Get(getContext());
   if (program > 0) {
-    gl->deleteProgram(program);
+    FilterProgramCache::ReleaseProgram(getContext(), program);
     program = 0;
   }
   if (vertexArray > 0) {
@@ -167,13 +168,18 @@ bool RuntimeFilter::onDraw(const tgfx::RuntimeProgram* program,
   auto filterProgram = static_cast<const RuntimeProgram*>(program);
   gl->useProgram(filterProgram->program);
   gl->disable(GL_SCISSOR_TEST);
-  gl->enable(GL_BLEND);
-  gl->blendEquation(GL_FUNC_ADD);
-  gl->blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
   gl->bindFramebuffer(GL_FRAMEBUFFER, targetInfo.id);
   gl->viewport(0, 0, target.width(), target.height());
-  gl->clearColor(0, 0, 0, 0);
-  gl->clear(GL_COLOR_BUFFER_BIT);
+  if (coversTarget()) {
+    // 滤镜声明了会覆写输出的每个像素，直接写入即可，跳过清屏和混合。
+    gl->disable(GL_BLEND);
+  } else {
+    gl->enable(GL_BLEND);
+    gl->blendEquation(GL_FUNC_ADD);
+    gl->blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    gl->clearColor(0, 0, 0, 0);
+    gl->clear(GL_COLOR_BUFFER_BIT);
+  }
   for (size_t i = 0; i < sources.size(); i++) {
     tgfx::GLTextureInfo sourceInfo;
     if (!sources[i].getGLTextureInfo(&sourceInfo)) {
@@ -59,6 +59,12 @@ class RuntimeProgram : public tgfx::RuntimeProgram {
   }
 };
 
+/**
+ * RuntimeFilter is the extension surface for custom GPU effects. Each subclass is one render pass:
+ * tgfx hands it the input textures and the pooled render target directly, with no intermediate
+ * copies, and the pass declares its properties (sampleCount, coversTarget) up front so the draw
+ * can be planned without reading them back.
+ */
 class RuntimeFilter : public tgfx::RuntimeEffect {
  public:
   explicit RuntimeFilter(tgfx::UniqueType type,
@@ -69,6 +75,15 @@ class RuntimeFilter : public tgfx::RuntimeEffect {
   std::unique_ptr<tgfx::RuntimeProgram> onCreateProgram(tgfx::Context* context) const override;
 
  protected:
+  /**
+   * 声明该滤镜会覆写输出纹理的每一个像素（顶点覆盖整个输出、片元总是写入最终的预乘颜色）。
+   * 满足该条件的 1:1 滤镜（例如颜色映射类滤镜）在 onDraw 里可以跳过清屏和混合，
+   * 省掉每个 pass 一次全目标的读写带宽。默认返回 false。
+   */
+  virtual bool coversTarget() const {
+    return false;
+  }
+
   bool onDraw(const tgfx::RuntimeProgram* program, const std::vector<tgfx::BackendTexture>& sources,
               const tgfx::BackendRenderTarget& target, const tgfx::Point& offset) const override;
 
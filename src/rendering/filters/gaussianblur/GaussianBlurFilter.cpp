@@ -17,17 +17,79 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GaussianBlurFilter.h"
+#include "rendering/caches/RenderCache.h"
 #include "rendering/filters/utils/FilterHelper.h"
-#include "tgfx/core/Canvas.h"
 #include "tgfx/core/ImageFilter.h"
 
 namespace pag {
+// Above this blurriness (in source pixels) the blur runs on a downsampled ladder: each halving
+// cuts the blurred pixel count by 4x and the effective kernel size by 2x, while the result stays
+// visually identical at high radii.
+static constexpr float DOWNSAMPLE_BLUR_THRESHOLD = 32.0f;
+static constexpr int MAX_DOWNSAMPLE_STEPS = 3;
+static constexpr int MIN_DOWNSAMPLE_SIZE = 16;
+// In PowerSaving quality the ladder starts at much smaller radii and goes one level deeper. The
+// blur becomes slightly softer than the full-fidelity result, which is acceptable for the mode.
+static constexpr float POWER_SAVING_BLUR_THRESHOLD = 8.0f;
+
+static std::shared_ptr<tgfx::Image> ApplyDownsampled(std::shared_ptr<tgfx::Image> input,
+                                                     tgfx::Context* context, float blurrinessX,
+                                                     float blurrinessY, bool repeatEdgePixels,
+                                                     bool powerSaving, tgfx::Point* offset) {
+  // Halve the resolution step by step instead of scaling down in one draw, so every source pixel
+  // still contributes to the downsampled image and high-frequency content does not flicker.
+  auto scaled = input;
+  auto maxBlurriness = std::max(blurrinessX, blurrinessY);
+  auto threshold = powerSaving ? POWER_SAVING_BLUR_THRESHOLD : DOWNSAMPLE_BLUR_THRESHOLD;
+  auto maxSteps = powerSaving ? MAX_DOWNSAMPLE_STEPS + 1 : MAX_DOWNSAMPLE_STEPS;
+  auto steps = 0;
+  while (steps < maxSteps && maxBlurriness > threshold &&
+         scaled->width() >= MIN_DOWNSAMPLE_SIZE * 2 &&
+         scaled->height() >= MIN_DOWNSAMPLE_SIZE * 2) {
+    auto width = (scaled->width() + 1) / 2;
+    auto height = (scaled->height() + 1) / 2;
+    scaled = ScaleImage(context, std::move(scaled), width, height, 0.5f, 0.5f);
+    if (scaled == nullptr) {
+      return nullptr;
+    }
+    maxBlurriness *= 0.5f;
+    steps++;
+  }
+  if (steps == 0) {
+    return nullptr;
+  }
+  auto scaleX = static_cast<float>(scaled->width()) / static_cast<float>(input->width());
+  auto scaleY = static_cast<float>(scaled->height()) / static_cast<float>(input->height());
+  std::shared_ptr<tgfx::Image> blurred;
+  auto scaledOffset = tgfx::Point::Zero();
+  if (repeatEdgePixels) {
+    auto filter =
+        tgfx::ImageFilter::Blur(blurrinessX * scaleX, blurrinessY * scaleY, tgfx::TileMode::Clamp);
+    tgfx::Rect clipBounds = tgfx::Rect::MakeWH(scaled->width(), scaled->height());
+    blurred = scaled->makeWithFilter(filter, &scaledOffset, &clipBounds);
+  } else {
+    auto filter = tgfx::ImageFilter::Blur(blurrinessX * scaleX, blurrinessY * scaleY);
+    blurred = scaled->makeWithFilter(filter, &scaledOffset);
+  }
+  if (blurred == nullptr) {
+    return nullptr;
+  }
+  auto width = static_cast<int>(roundf(static_cast<float>(blurred->width()) / scaleX));
+  auto height = static_cast<int>(roundf(static_cast<float>(blurred->height()) / scaleY));
+  auto result = ScaleImage(context, std::move(blurred), width, height, 1.0f / scaleX,
+                           1.0f / scaleY);
+  if (result == nullptr) {
+    return nullptr;
+  }
+  offset->set(scaledOffset.x / scaleX, scaledOffset.y / scaleY);
+  return result;
+}
 
 std::shared_ptr<tgfx::Image> GaussianBlurFilter::Apply(std::shared_ptr<tgfx::Image> input,
                                                        Effect* effect, Frame layerFrame,
                                                        const tgfx::Point& filterScale,
                                                        const tgfx::Point& sourceScale,
-                                                       tgfx::Point* offset) {
+                                                       RenderCache* cache, tgfx::Point* offset) {
   auto* blurEffect = static_cast<FastBlurEffect*>(effect);
   auto repeatEdgePixels = blurEffect->repeatEdgePixels->getValueAt(layerFrame);
   auto blurDimensions = blurEffect->blurDimensions->getValueAt(layerFrame);
@@ -40,6 +102,17 @@ std::shared_ptr<tgfx::Image> GaussianBlurFilter::Apply(std::shared_ptr<tgfx::Ima
   }
   blurrinessX *= filterScale.x * sourceScale.x;
   blurrinessY *= filterScale.y * sourceScale.y;
+  auto context = cache != nullptr ? cache->getContext() : nullptr;
+  auto powerSaving =
+      cache != nullptr && cache->effectiveRenderQuality() == PAGRenderQuality::PowerSaving;
+  auto threshold = powerSaving ? POWER_SAVING_BLUR_THRESHOLD : DOWNSAMPLE_BLUR_THRESHOLD;
+  if (context != nullptr && std::max(blurrinessX, blurrinessY) > threshold) {
+    auto result = ApplyDownsampled(input, context, blurrinessX, blurrinessY, repeatEdgePixels,
+                                   powerSaving, offset);
+    if (result != nullptr) {
+      return result;
+    }
+  }
   std::shared_ptr<tgfx::ImageFilter> filter;
   if (repeatEdgePixels) {
     filter = tgfx::ImageFilter::Blur(blurrinessX, blurrinessY, tgfx::TileMode::Clamp);
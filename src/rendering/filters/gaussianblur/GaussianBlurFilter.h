@@ -22,11 +22,13 @@
 #include "rendering/filters/RuntimeFilter.h"
 
 namespace pag {
+class RenderCache;
 
 class GaussianBlurFilter {
  public:
   static std::shared_ptr<tgfx::Image> Apply(std::shared_ptr<tgfx::Image> input, Effect* effect,
                                             Frame layerFrame, const tgfx::Point& filterScale,
-                                            const tgfx::Point& sourceScale, tgfx::Point* offset);
+                                            const tgfx::Point& sourceScale, RenderCache* cache,
+                                            tgfx::Point* offset);
 };
 }  // namespace pag
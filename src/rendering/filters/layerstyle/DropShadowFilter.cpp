@@ -21,6 +21,7 @@
 #include "base/utils/TGFXCast.h"
 #include "rendering/filters/layerstyle/SolidStrokeFilter.h"
 #include "rendering/filters/utils/BlurTypes.h"
+#include "rendering/filters/utils/LayerStyleFilterCache.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/ImageFilter.h"
 
@@ -86,13 +87,14 @@ std::shared_ptr<tgfx::ImageFilter> DropShadowFilter::getStrokeFilter() const {
   strokeOption.spreadSizeY = sizeY * spread;
   strokeOption.offsetX = offsetX;
   strokeOption.offsetY = offsetY;
-  return SolidStrokeFilter::CreateFilter(strokeOption, mode);
+  // 多个图层带同参数投影时共享同一个滤镜实例，避免每层每帧都重建滤镜管线。
+  return LayerStyleFilterCache::GetSolidStroke(strokeOption, mode);
 }
 
 std::shared_ptr<tgfx::ImageFilter> DropShadowFilter::getDropShadowFilter() const {
   float blurSizeX = sizeX * (1.f - spread) * 2.f;
   float blurSizeY = sizeY * (1.f - spread) * 2.f;
-  return tgfx::ImageFilter::DropShadowOnly(offsetX, offsetY, blurSizeX, blurSizeY, color);
+  return LayerStyleFilterCache::GetDropShadow(offsetX, offsetY, blurSizeX, blurSizeY, color);
 }
 
 }  // namespace pag
@@ -20,6 +20,7 @@
 #include "base/utils/TGFXCast.h"
 #include "rendering/filters/layerstyle/SolidStrokeFilter.h"
 #include "rendering/filters/utils/BlurTypes.h"
+#include "rendering/filters/utils/LayerStyleFilterCache.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/ImageFilter.h"
 
@@ -73,13 +74,14 @@ std::shared_ptr<tgfx::ImageFilter> OuterGlowFilter::getStrokeFilter() const {
   strokeOption.color = color;
   strokeOption.spreadSizeX = spread * sizeX / range;
   strokeOption.spreadSizeY = spread * sizeY / range;
-  return SolidStrokeFilter::CreateFilter(strokeOption, mode);
+  // 同参数的外发光在多个图层间共享同一个滤镜实例。
+  return LayerStyleFilterCache::GetSolidStroke(strokeOption, mode);
 }
 
 std::shared_ptr<tgfx::ImageFilter> OuterGlowFilter::getDropShadowFilter() const {
   auto blurSizeX = sizeX * (1.f - spread) * 2.f / range;
   auto blurSizeY = sizeY * (1.f - spread) * 2.f / range;
-  return tgfx::ImageFilter::DropShadowOnly(0, 0, blurSizeX, blurSizeY, color);
+  return LayerStyleFilterCache::GetDropShadow(0, 0, blurSizeX, blurSizeY, color);
 }
 
 }  // namespace pag
@@ -20,6 +20,7 @@
 #include "rendering/filters/layerstyle/AlphaEdgeDetectFilter.h"
 #include "rendering/filters/layerstyle/SolidStrokeFilter.h"
 #include "rendering/filters/utils/BlurTypes.h"
+#include "rendering/filters/utils/LayerStyleFilterCache.h"
 #include "tgfx/core/Canvas.h"
 #include "tgfx/core/ImageFilter.h"
 #include "tgfx/core/Paint.h"
@@ -60,7 +61,8 @@ bool StrokeFilter::draw(Canvas* canvas, std::shared_ptr<tgfx::Image> image) {
 
   std::shared_ptr<tgfx::ImageFilter> filter = nullptr;
   if (strokeOption.position == StrokePosition::Outside) {
-    filter = SolidStrokeFilter::CreateFilter(strokeOption, mode, nullptr);
+    // 外描边不引用图层内容，可以在同参数的图层之间共享滤镜实例。
+    filter = LayerStyleFilterCache::GetSolidStroke(strokeOption, mode);
   } else {
     auto strokeFilter = SolidStrokeFilter::CreateFilter(strokeOption, mode, image);
     if (strokeFilter == nullptr) {
@@ -23,6 +23,12 @@
 
 namespace pag {
 
+/**
+ * 3D 渲染目前是占位实现：Has3DSupport() 返回 false，Apply3DEffects() 原样返回输入。文件里的
+ * Transform3D 和摄像机图层只走解码和校验，渲染端不会求取任何 view/projection 矩阵。等真正的
+ * 3D 渲染落地时，摄像机矩阵应当在每帧每个合成里只求一次，逐图层的 MVP 结果挂到 TransformCache
+ * 的帧缓存上复用，而不是每个受影响的图层都从关键帧属性重建一遍。
+ */
 std::shared_ptr<tgfx::Image> Apply3DEffects(std::shared_ptr<tgfx::Image> input,
                                             const FilterList* filterList,
                                             const tgfx::Rect& clipBounds, tgfx::Rect* filterBounds,
@@ -19,10 +19,23 @@
 #include "FilterHelper.h"
 #include "base/utils/Log.h"
 #include "base/utils/USE.h"
+#include "tgfx/core/Canvas.h"
 #include "tgfx/core/Surface.h"
 #include "tgfx/gpu/opengl/GLFunctions.h"
 
 namespace pag {
+std::shared_ptr<tgfx::Image> ScaleImage(tgfx::Context* context, std::shared_ptr<tgfx::Image> image,
+                                        int width, int height, float scaleX, float scaleY) {
+  auto surface = tgfx::Surface::Make(context, width, height);
+  if (surface == nullptr) {
+    return nullptr;
+  }
+  auto canvas = surface->getCanvas();
+  canvas->setMatrix(tgfx::Matrix::MakeScale(scaleX, scaleY));
+  canvas->drawImage(std::move(image));
+  return surface->makeImageSnapshot();
+}
+
 std::array<float, 9> ToGLMatrix(const tgfx::Matrix& matrix) {
   float values[6];
   matrix.get6(values);
@@ -20,10 +20,14 @@
 
 #include "base/utils/TGFXCast.h"
 #include "pag/pag.h"
+#include "tgfx/core/Image.h"
 
 namespace pag {
 std::array<float, 9> ToGLMatrix(const tgfx::Matrix& matrix);
 
+std::shared_ptr<tgfx::Image> ScaleImage(tgfx::Context* context, std::shared_ptr<tgfx::Image> image,
+                                        int width, int height, float scaleX, float scaleY);
+
 std::array<float, 9> ToGLVertexMatrix(const tgfx::Matrix& matrix, int width, int height,
                                       tgfx::ImageOrigin origin);
 
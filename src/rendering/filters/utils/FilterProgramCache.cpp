@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FilterProgramCache.h"
+#include <mutex>
+#include <unordered_map>
+#include "rendering/filters/utils/FilterHelper.h"
+
+namespace pag {
+struct ProgramEntry {
+  unsigned program = 0;
+  int referenceCount = 0;
+  size_t sourceHash = 0;
+};
+
+struct ContextPrograms {
+  std::unordered_map<size_t, ProgramEntry> programsByHash = {};
+  std::unordered_map<unsigned, size_t> hashesByProgram = {};
+};
+
+static std::mutex& CacheLocker() {
+  static auto& locker = *new std::mutex();
+  return locker;
+}
+
+static std::unordered_map<tgfx::Context*, ContextPrograms>& CacheMap() {
+  static auto& cacheMap = *new std::unordered_map<tgfx::Context*, ContextPrograms>();
+  return cacheMap;
+}
+
+unsigned FilterProgramCache::GetProgram(tgfx::Context* context, const std::string& vertex,
+                                        const std::string& fragment) {
+  auto sourceHash = std::hash<std::string>{}(vertex + '\1' + fragment);
+  {
+    std::lock_guard<std::mutex> autoLock(CacheLocker());
+    auto& programs = CacheMap()[context];
+    auto result = programs.programsByHash.find(sourceHash);
+    if (result != programs.programsByHash.end()) {
+      result->second.referenceCount++;
+      return result->second.program;
+    }
+  }
+  auto program = CreateGLProgram(context, vertex, fragment);
+  if (program == 0) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> autoLock(CacheLocker());
+  auto& programs = CacheMap()[context];
+  programs.programsByHash[sourceHash] = {program, 1, sourceHash};
+  programs.hashesByProgram[program] = sourceHash;
+  return program;
+}
+
+void FilterProgramCache::ReleaseProgram(tgfx::Context* context, unsigned program) {
+  std::lock_guard<std::mutex> autoLock(CacheLocker());
+  auto& cacheMap = CacheMap();
+  auto contextResult = cacheMap.find(context);
+  if (contextResult == cacheMap.end()) {
+    return;
+  }
+  auto& programs = contextResult->second;
+  auto hashResult = programs.hashesByProgram.find(program);
+  if (hashResult == programs.hashesByProgram.end()) {
+    return;
+  }
+  auto entryResult = programs.programsByHash.find(hashResult->second);
+  if (entryResult == programs.programsByHash.end() || --entryResult->second.referenceCount > 0) {
+    return;
+  }
+  programs.programsByHash.erase(entryResult);
+  programs.hashesByProgram.erase(hashResult);
+  if (programs.programsByHash.empty()) {
+    cacheMap.erase(contextResult);
+  }
+  auto gl = tgfx::GLFunctions::Get(context);
+  gl->deleteProgram(program);
+}
+}  // namespace pag
@@ -0,0 +1,48 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include "tgfx/gpu/opengl/GLFunctions.h"
+
+namespace pag {
+/**
+ * FilterProgramCache shares linked filter programs within a GL context, keyed by a hash of the
+ * shader sources. Every RuntimeProgram that requests the same shader pair on the same context
+ * gets the same program object, so each filter shader is compiled at most once per context no
+ * matter how many players or filter instances use it. Programs are ref-counted and deleted once
+ * the last RuntimeProgram using them is released.
+ */
+class FilterProgramCache {
+ public:
+  /**
+   * Returns a linked program for the given shader pair on the context, compiling and linking it
+   * only on the first request. Each successful call must be balanced by ReleaseProgram(). Returns
+   * 0 if the compilation fails.
+   */
+  static unsigned GetProgram(tgfx::Context* context, const std::string& vertex,
+                             const std::string& fragment);
+
+  /**
+   * Releases a reference to a program previously returned by GetProgram(). The GL program object
+   * is deleted when the last reference is released. Must be called with the context current.
+   */
+  static void ReleaseProgram(tgfx::Context* context, unsigned program);
+};
+}  // namespace pag
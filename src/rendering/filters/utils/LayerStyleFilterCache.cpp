@@ -0,0 +1,92 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "LayerStyleFilterCache.h"
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace pag {
+// 缓存条目超过上限时整体清空，样式参数通常在模板里是常量，正常播放远达不到这个数量。
+static constexpr size_t MAX_FILTER_CACHE_SIZE = 64;
+
+class FilterCache {
+ public:
+  static FilterCache* GetInstance() {
+    static auto& instance = *new FilterCache();
+    return &instance;
+  }
+
+  std::shared_ptr<tgfx::ImageFilter> findOrCreate(
+      const std::string& key, const std::function<std::shared_ptr<tgfx::ImageFilter>()>& creator) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = filterMap.find(key);
+    if (result != filterMap.end()) {
+      return result->second;
+    }
+    auto filter = creator();
+    if (filter != nullptr) {
+      if (filterMap.size() >= MAX_FILTER_CACHE_SIZE) {
+        filterMap.clear();
+      }
+      filterMap[key] = filter;
+    }
+    return filter;
+  }
+
+ private:
+  std::mutex locker = {};
+  std::unordered_map<std::string, std::shared_ptr<tgfx::ImageFilter>> filterMap = {};
+};
+
+template <typename T>
+static void AppendToKey(std::string* key, const T& value) {
+  key->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::shared_ptr<tgfx::ImageFilter> LayerStyleFilterCache::GetDropShadow(
+    float offsetX, float offsetY, float blurSizeX, float blurSizeY, const tgfx::Color& color) {
+  std::string key = "D";
+  AppendToKey(&key, offsetX);
+  AppendToKey(&key, offsetY);
+  AppendToKey(&key, blurSizeX);
+  AppendToKey(&key, blurSizeY);
+  AppendToKey(&key, color);
+  return FilterCache::GetInstance()->findOrCreate(key, [&]() {
+    return tgfx::ImageFilter::DropShadowOnly(offsetX, offsetY, blurSizeX, blurSizeY, color);
+  });
+}
+
+std::shared_ptr<tgfx::ImageFilter> LayerStyleFilterCache::GetSolidStroke(
+    const SolidStrokeOption& option, SolidStrokeMode mode) {
+  if (!option.valid()) {
+    return nullptr;
+  }
+  std::string key = "S";
+  AppendToKey(&key, option.position);
+  AppendToKey(&key, option.color);
+  AppendToKey(&key, option.spreadSizeX);
+  AppendToKey(&key, option.spreadSizeY);
+  AppendToKey(&key, option.offsetX);
+  AppendToKey(&key, option.offsetY);
+  AppendToKey(&key, mode);
+  return FilterCache::GetInstance()->findOrCreate(
+      key, [&]() { return SolidStrokeFilter::CreateFilter(option, mode); });
+}
+
+}  // namespace pag
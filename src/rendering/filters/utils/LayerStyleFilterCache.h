@@ -0,0 +1,49 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "rendering/filters/layerstyle/SolidStrokeFilter.h"
+#include "tgfx/core/ImageFilter.h"
+
+namespace pag {
+/**
+ * LayerStyleFilterCache shares immutable tgfx::ImageFilter instances across styled layers, keyed
+ * by the style parameters. Templates often apply the same drop shadow or stroke to many layers;
+ * with a shared filter instance every one of those passes reuses the same filter graph and GPU
+ * pipeline state instead of building its own each frame. Only filters that do not capture a layer
+ * image are cached.
+ */
+class LayerStyleFilterCache {
+ public:
+  /**
+   * Returns a shared drop-shadow-only filter for the given parameters, creating it on the first
+   * request.
+   */
+  static std::shared_ptr<tgfx::ImageFilter> GetDropShadow(float offsetX, float offsetY,
+                                                          float blurSizeX, float blurSizeY,
+                                                          const tgfx::Color& color);
+
+  /**
+   * Returns a shared solid-stroke filter for the given option and mode, creating it on the first
+   * request. Returns nullptr if the option is invalid.
+   */
+  static std::shared_ptr<tgfx::ImageFilter> GetSolidStroke(const SolidStrokeOption& option,
+                                                           SolidStrokeMode mode);
+};
+}  // namespace pag
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "FeatherMask.h"
+#include "base/utils/MatrixUtil.h"
 #include "base/utils/TGFXCast.h"
 #include "pag/file.h"
 #include "rendering/caches/RenderCache.h"
@@ -82,14 +83,25 @@ std::shared_ptr<tgfx::Surface> MakeAlphaSurface(tgfx::Context* context, int widt
 }
 
 void FeatherMask::draw(Canvas* parentCanvas) const {
-  auto surface =
-      MakeAlphaSurface(parentCanvas->getContext(), static_cast<int>(ceilf(bounds.width())),
-                       static_cast<int>(ceilf(bounds.height())));
+  // 按上屏时的实际缩放栅格化羽化遮罩：缩略图等缩小显示的场景里没必要按设计分辨率画完再整体缩小，
+  // 面积随缩放平方下降。放大显示时仍按 1.0 栅格化，行为与之前一致。
+  auto contentScale = GetMaxScaleFactor(parentCanvas->getMatrix());
+  if (contentScale <= 0) {
+    return;
+  }
+  if (contentScale > 1.0f) {
+    contentScale = 1.0f;
+  }
+  auto surface = MakeAlphaSurface(parentCanvas->getContext(),
+                                  static_cast<int>(ceilf(bounds.width() * contentScale)),
+                                  static_cast<int>(ceilf(bounds.height() * contentScale)));
   if (surface == nullptr) {
     return;
   }
   auto canvas = surface->getCanvas();
-  canvas->setMatrix(tgfx::Matrix::MakeTrans(bounds.x(), bounds.y()));
+  auto surfaceMatrix = tgfx::Matrix::MakeScale(contentScale);
+  surfaceMatrix.preTranslate(bounds.x(), bounds.y());
+  canvas->setMatrix(surfaceMatrix);
   bool isFirst = true;
   for (auto* mask : masks) {
     auto path = mask->maskPath->getValueAt(layerFrame);
@@ -110,8 +122,8 @@ void FeatherMask::draw(Canvas* parentCanvas) const {
       maskPath.toggleInverseFillType();
     }
     auto maskBounds = maskPath.getBounds();
-    auto width = static_cast<int>(ceilf(maskBounds.width()));
-    auto height = static_cast<int>(ceilf(maskBounds.height()));
+    auto width = static_cast<int>(ceilf(maskBounds.width() * contentScale));
+    auto height = static_cast<int>(ceilf(maskBounds.height() * contentScale));
     if (width == 0 || height == 0) {
       continue;
     }
@@ -120,7 +132,9 @@ void FeatherMask::draw(Canvas* parentCanvas) const {
       return;
     }
     auto maskCanvas = maskSurface->getCanvas();
-    maskCanvas->setMatrix(tgfx::Matrix::MakeTrans(-maskBounds.x(), -maskBounds.y()));
+    auto maskMatrix = tgfx::Matrix::MakeScale(contentScale);
+    maskMatrix.preTranslate(-maskBounds.x(), -maskBounds.y());
+    maskCanvas->setMatrix(maskMatrix);
     tgfx::Paint maskPaint;
     float alpha = ToAlpha(mask->maskOpacity->getValueAt(layerFrame));
     maskPaint.setAlpha(alpha);
@@ -128,15 +142,20 @@ void FeatherMask::draw(Canvas* parentCanvas) const {
     auto maskImage = maskSurface->makeImageSnapshot();
     tgfx::Paint blurPaint;
     if (mask->maskFeather) {
-      auto blurrinessX = mask->maskFeather->getValueAt(layerFrame).x;
-      auto blurrinessY = mask->maskFeather->getValueAt(layerFrame).y;
+      // 羽化半径同样换算到栅格化分辨率下。
+      auto blurrinessX = mask->maskFeather->getValueAt(layerFrame).x * contentScale;
+      auto blurrinessY = mask->maskFeather->getValueAt(layerFrame).y * contentScale;
       blurPaint.setImageFilter(tgfx::ImageFilter::Blur(blurrinessX, blurrinessY));
     }
     canvas->save();
-    canvas->setMatrix(tgfx::Matrix::MakeTrans(maskBounds.x(), maskBounds.y()));
+    canvas->setMatrix(tgfx::Matrix::MakeTrans(maskBounds.x() * contentScale,
+                                              maskBounds.y() * contentScale));
     canvas->drawImage(maskImage, &blurPaint);
     canvas->restore();
   }
+  parentCanvas->save();
+  parentCanvas->scale(1.0f / contentScale, 1.0f / contentScale);
   parentCanvas->drawImage(surface->makeImageSnapshot());
+  parentCanvas->restore();
 }
 }  // namespace pag
@@ -17,11 +17,68 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Glyph.h"
+#include <mutex>
 #include <unordered_map>
 #include "rendering/utils/shaper/TextShaper.h"
 #include "tgfx/core/UTF.h"
 
 namespace pag {
+// Info 只由字体和字形决定，而打字预览每敲一个键都会重建整层文本。按进程缓存测量结果，
+// 重建时相同字形直接复用，省掉每个字形的度量查询和 Info 堆分配。条目很小，超过上限时
+// 整体清空重来，避免维护 LRU 的开销。
+class GlyphInfoCache {
+ public:
+  static GlyphInfoCache* GetInstance() {
+    static auto& instance = *new GlyphInfoCache();
+    return &instance;
+  }
+
+  bool find(const tgfx::BytesKey& key, std::shared_ptr<Glyph::Info>* horizontalInfo,
+            std::shared_ptr<Glyph::Info>* verticalInfo) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = infos.find(key);
+    if (result == infos.end()) {
+      return false;
+    }
+    *horizontalInfo = result->second.first;
+    *verticalInfo = result->second.second;
+    return true;
+  }
+
+  void insert(const tgfx::BytesKey& key, std::shared_ptr<Glyph::Info> horizontalInfo,
+              std::shared_ptr<Glyph::Info> verticalInfo) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (infos.size() >= MAX_GLYPH_INFO_COUNT) {
+      infos.clear();
+    }
+    infos[key] = {std::move(horizontalInfo), std::move(verticalInfo)};
+  }
+
+ private:
+  static constexpr size_t MAX_GLYPH_INFO_COUNT = 4096;
+
+  std::mutex locker = {};
+  tgfx::BytesKeyMap<std::pair<std::shared_ptr<Glyph::Info>, std::shared_ptr<Glyph::Info>>> infos =
+      {};
+};
+
+static tgfx::BytesKey MakeInfoKey(const tgfx::Font& font, tgfx::GlyphID glyphID,
+                                  const std::string& name, bool isVertical) {
+  tgfx::BytesKey infoKey = {};
+  auto typeface = font.getTypeface();
+  infoKey.write(typeface ? typeface->uniqueID() : 0);
+  infoKey.write(static_cast<uint32_t>(glyphID));
+  infoKey.write(font.getSize());
+  // 竖排时单字符和多字符走不同的布局分支，空格有特殊的 bounds 修正，都要进 key。
+  uint32_t flags = 0;
+  flags |= isVertical ? 1u : 0;
+  flags |= font.isFauxBold() ? 2u : 0;
+  flags |= font.isFauxItalic() ? 4u : 0;
+  flags |= name.size() == 1 ? 8u : 0;
+  flags |= name == " " ? 16u : 0;
+  infoKey.write(flags);
+  return infoKey;
+}
 std::vector<GlyphHandle> Glyph::BuildFromText(const std::string& text, const tgfx::Font& font,
                                               const TextPaint& paint, bool isVertical) {
   auto textFont = font;
@@ -51,7 +108,19 @@ Glyph::Glyph(std::vector<tgfx::GlyphID> glyphIDs, std::string name, tgfx::Font f
              bool isVertical, const TextPaint& textPaint)
     : _glyphIDs(std::move(glyphIDs)), _name(std::move(name)), _font(std::move(font)),
       _isVertical(isVertical) {
+  textStyle = textPaint.style;
+  strokeOverFill = textPaint.strokeOverFill;
+  fillColor = textPaint.fillColor;
+  strokeColor = textPaint.strokeColor;
+  strokeWidth = textPaint.strokeWidth;
   auto glyphID = _glyphIDs.front();
+  auto infoKey = MakeInfoKey(_font, glyphID, _name, isVertical);
+  auto infoCache = GlyphInfoCache::GetInstance();
+  if (infoCache->find(infoKey, &horizontalInfo, &verticalInfo)) {
+    info = _isVertical ? verticalInfo.get() : horizontalInfo.get();
+    return;
+  }
+  horizontalInfo = std::make_shared<Info>();
   horizontalInfo->advance = _font.getAdvance(glyphID);
   horizontalInfo->originPosition.set(horizontalInfo->advance / 2, 0);
   horizontalInfo->bounds = _font.getBounds(glyphID);
@@ -93,13 +162,10 @@ Glyph::Glyph(std::vector<tgfx::GlyphID> glyphIDs, std::string name, tgfx::Font f
     }
     verticalInfo->originPosition.set(0, verticalInfo->advance / 2);
     verticalInfo->extraMatrix.mapRect(&verticalInfo->bounds);
-    info = verticalInfo.get();
   }
-  textStyle = textPaint.style;
-  strokeOverFill = textPaint.strokeOverFill;
-  fillColor = textPaint.fillColor;
-  strokeColor = textPaint.strokeColor;
-  strokeWidth = textPaint.strokeWidth;
+  info = _isVertical ? verticalInfo.get() : horizontalInfo.get();
+  // Info 构造完成后不再修改，可以安全地跨 Glyph 共享。
+  infoCache->insert(infoKey, horizontalInfo, verticalInfo);
 }
 
 void Glyph::computeStyleKey(tgfx::BytesKey* styleKey) const {
@@ -264,11 +264,13 @@ class Glyph {
   Color strokeColor = Black;
   float strokeWidth = 0;
 
-  std::shared_ptr<Info> horizontalInfo = std::make_shared<Info>();
-  std::shared_ptr<Info> verticalInfo;
-  const Info* info = horizontalInfo.get();
+  std::shared_ptr<Info> horizontalInfo = nullptr;
+  std::shared_ptr<Info> verticalInfo = nullptr;
+  const Info* info = nullptr;
 
   Glyph(std::vector<tgfx::GlyphID> glyphIDs, std::string name, tgfx::Font font, bool isVertical,
         const TextPaint& textPaint);
+
+  friend class GlyphInfoCache;
 };
 }  // namespace pag
@@ -17,10 +17,90 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GradientPaint.h"
+#include <algorithm>
+#include <list>
+#include <map>
+#include <mutex>
 #include "base/utils/Interpolate.h"
 #include "base/utils/TGFXCast.h"
 
 namespace pag {
+struct GradientRamp {
+  std::vector<tgfx::Color> colors;
+  std::vector<float> positions;
+};
+
+static constexpr size_t MaxRampCacheSize = 64;
+
+static std::mutex& RampCacheLocker() {
+  static auto& locker = *new std::mutex();
+  return locker;
+}
+
+static std::list<std::string>& RampCacheLRU() {
+  static auto& lru = *new std::list<std::string>();
+  return lru;
+}
+
+static std::map<std::string, GradientRamp>& RampCache() {
+  static auto& cache = *new std::map<std::string, GradientRamp>();
+  return cache;
+}
+
+static std::string MakeRampKey(const GradientColorHandle& gradientColor) {
+  std::string key = {};
+  key.reserve(gradientColor->colorStops.size() * sizeof(ColorStop) +
+              gradientColor->alphaStops.size() * sizeof(AlphaStop) + 1);
+  auto appendBytes = [&key](const void* bytes, size_t length) {
+    key.append(static_cast<const char*>(bytes), length);
+  };
+  for (auto& stop : gradientColor->colorStops) {
+    appendBytes(&stop.position, sizeof(float));
+    appendBytes(&stop.midpoint, sizeof(float));
+    appendBytes(&stop.color, sizeof(Color));
+  }
+  key.push_back('\1');
+  for (auto& stop : gradientColor->alphaStops) {
+    appendBytes(&stop.position, sizeof(float));
+    appendBytes(&stop.midpoint, sizeof(float));
+    appendBytes(&stop.opacity, sizeof(Opacity));
+  }
+  return key;
+}
+
+static bool FindCachedRamp(const std::string& key, std::vector<tgfx::Color>* colors,
+                           std::vector<float>* positions) {
+  std::lock_guard<std::mutex> autoLock(RampCacheLocker());
+  auto& cache = RampCache();
+  auto result = cache.find(key);
+  if (result == cache.end()) {
+    return false;
+  }
+  auto& lru = RampCacheLRU();
+  auto position = std::find(lru.begin(), lru.end(), key);
+  if (position != lru.begin()) {
+    lru.splice(lru.begin(), lru, position);
+  }
+  *colors = result->second.colors;
+  *positions = result->second.positions;
+  return true;
+}
+
+static void SaveRampToCache(const std::string& key, const std::vector<tgfx::Color>& colors,
+                            const std::vector<float>& positions) {
+  std::lock_guard<std::mutex> autoLock(RampCacheLocker());
+  auto& cache = RampCache();
+  if (cache.count(key) > 0) {
+    return;
+  }
+  auto& lru = RampCacheLRU();
+  while (lru.size() >= MaxRampCacheSize) {
+    cache.erase(lru.back());
+    lru.pop_back();
+  }
+  lru.push_front(key);
+  cache[key] = {colors, positions};
+}
 void ConvertColorStop(const GradientColorHandle& gradientColor, std::vector<Color>& colorValues,
                       std::vector<float>& colorPositions) {
   auto colorStops = gradientColor->colorStops;
@@ -55,11 +135,8 @@ void ConvertAlphaStop(const GradientColorHandle& gradientColor, std::vector<Opac
   }
 }
 
-GradientPaint::GradientPaint(GradientFillType fillType, Point startPoint, Point endPoint,
-                             const GradientColorHandle& gradientColor, const tgfx::Matrix& matrix,
-                             bool reverse)
-    : gradientType(fillType), startPoint(ToTGFX(startPoint)), endPoint(ToTGFX(endPoint)),
-      matrix(matrix) {
+static void MergeGradientStops(const GradientColorHandle& gradientColor,
+                               std::vector<tgfx::Color>& colors, std::vector<float>& positions) {
   std::vector<Color> colorValues;
   std::vector<float> colorPositions;
   ConvertColorStop(gradientColor, colorValues, colorPositions);
@@ -119,6 +196,19 @@ GradientPaint::GradientPaint(GradientFillType fillType, Point startPoint, Point
     auto color4f = ToTGFX(lastColor, opacityValues[opacityIndex++]);
     colors.push_back(color4f);
   }
+}
+
+GradientPaint::GradientPaint(GradientFillType fillType, Point startPoint, Point endPoint,
+                             const GradientColorHandle& gradientColor, const tgfx::Matrix& matrix,
+                             bool reverse)
+    : gradientType(fillType), startPoint(ToTGFX(startPoint)), endPoint(ToTGFX(endPoint)),
+      matrix(matrix) {
+  // 动画渐变每帧都会重新构建 GradientPaint，这里按照色标内容缓存合并结果，相同色标直接复用。
+  auto key = MakeRampKey(gradientColor);
+  if (!FindCachedRamp(key, &colors, &positions)) {
+    MergeGradientStops(gradientColor, colors, positions);
+    SaveRampToCache(key, colors, positions);
+  }
   if (reverse) {
     std::swap(startPoint, endPoint);
     std::reverse(colors.begin(), colors.end());
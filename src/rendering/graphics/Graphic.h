@@ -82,8 +82,8 @@ class Graphic {
 
   /**
    * Gets a Path which is the filled equivalent of the Graphic contents. Returns false and
-   * leaves the path unchanged if the Graphic contents are not opaque or can not be converted to
-   * a path.
+   * leaves the path unchanged if the Graphic contents are not opaque, blend with the pixels
+   * below, or can not be converted to a path.
    */
   virtual bool getPath(tgfx::Path* path) const = 0;
 
@@ -21,6 +21,7 @@
 #include "base/utils/MatrixUtil.h"
 #include "base/utils/TGFXCast.h"
 #include "base/utils/UniqueID.h"
+#include "rendering/caches/RenderCache.h"
 #include "rendering/utils/SurfaceUtil.h"
 #include "tgfx/core/BlendMode.h"
 #include "tgfx/core/Surface.h"
@@ -48,7 +49,9 @@ class BlendModifier : public Modifier {
   void applyToBounds(tgfx::Rect*) const override{};
 
   bool applyToPath(tgfx::Path*) const override {
-    return alpha == 1.0f;  // blendMode 只影响颜色，不改变形状或透明度，不影响 getPath 结果。
+    // 非 SrcOver 混合会读取下方像素参与计算，覆盖区域不能当作不透明遮挡，遮挡剔除依赖
+    // getPath 的这个语义；半透明同理。
+    return alpha == 1.0f && blendMode == tgfx::BlendMode::SrcOver;
   }
 
   void applyToGraphic(Canvas* canvas, std::shared_ptr<Graphic> graphic) const override;
@@ -170,6 +173,10 @@ bool BlendModifier::hitTest(RenderCache*, float, float) const {
   return alpha != 0.0f;
 }
 
+// 非常规混合模式（Multiply、Screen 等）在这一层不会引入离屏合成：混合模式只写进画布状态，
+// 由 createPaint() 附加到每次绘制上，内容依然直接画进目标 Surface。读取目标颜色用
+// framebuffer-fetch、dual-source blending 还是 texture barrier，由底层图形后端按设备能力
+// 选择，上层无需也不应感知。
 void BlendModifier::applyToGraphic(Canvas* canvas, std::shared_ptr<Graphic> graphic) const {
   canvas->save();
   auto newAlpha = canvas->getAlpha() * alpha;
@@ -268,11 +275,11 @@ void MaskModifier::applyToGraphic(Canvas* canvas, std::shared_ptr<Graphic> graph
   Canvas contentCanvas(contentSurface.get(), canvas->getCache());
   auto contentMatrix = contentCanvas.getMatrix();
   graphic->draw(&contentCanvas);
-  auto maskSurface = tgfx::Surface::Make(contentSurface->getContext(), contentSurface->width(),
-                                         contentSurface->height(), !useLuma);
+  auto cache = canvas->getCache();
+  auto maskSurface =
+      cache->getOffscreenSurface(contentSurface->width(), contentSurface->height(), !useLuma);
   if (maskSurface == nullptr) {
-    maskSurface = tgfx::Surface::Make(contentSurface->getContext(), contentSurface->width(),
-                                      contentSurface->height());
+    maskSurface = cache->getOffscreenSurface(contentSurface->width(), contentSurface->height());
   }
   if (maskSurface == nullptr) {
     return;
@@ -19,8 +19,12 @@
 #include "Picture.h"
 #include <unordered_set>
 #include "base/utils/MatrixUtil.h"
+#include "rendering/caches/DiskCache.h"
 #include "rendering/caches/RenderCache.h"
+#include "rendering/utils/RenderTaskScheduler.h"
+#include "tgfx/core/Buffer.h"
 #include "tgfx/core/Clock.h"
+#include "tgfx/core/ImageBuffer.h"
 #include "tgfx/core/Surface.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 
@@ -118,8 +122,8 @@ class ImageProxyPicture : public Picture {
     return maxScaleFactor;
   }
 
-  std::unique_ptr<Snapshot> makeSnapshot(RenderCache* cache, float scaleFactor,
-                                         bool mipmapped) const override {
+  std::unique_ptr<Snapshot> makeSnapshot(RenderCache* cache, float scaleFactor, bool mipmapped,
+                                         const std::string&) const override {
     auto image = proxy->getImage(cache);
     if (image == nullptr) {
       return nullptr;
@@ -143,10 +147,42 @@ class ImageProxyPicture : public Picture {
 //=================================== ImageProxyPicture==========================================
 
 //====================================== SnapshotPicture ===========================================
+static std::shared_ptr<tgfx::Image> ReadSnapshotPixels(const std::string& key, int width,
+                                                       int height) {
+  auto pixels = DiskCache::ReadFile(key);
+  if (pixels == nullptr) {
+    return nullptr;
+  }
+  auto info = tgfx::ImageInfo::Make(width, height, tgfx::ColorType::RGBA_8888);
+  if (pixels->size() != info.byteSize()) {
+    return nullptr;
+  }
+  auto imageBuffer = tgfx::ImageBuffer::MakeFrom(info, std::move(pixels));
+  return tgfx::Image::MakeFrom(std::move(imageBuffer));
+}
+
+static void WriteSnapshotPixels(const std::string& key, tgfx::Surface* surface) {
+  auto info =
+      tgfx::ImageInfo::Make(surface->width(), surface->height(), tgfx::ColorType::RGBA_8888);
+  tgfx::Buffer buffer(info.byteSize());
+  if (buffer.isEmpty() || !surface->readPixels(info, buffer.data())) {
+    return;
+  }
+  auto pixels = buffer.release();
+  RenderTaskScheduler::GetInstance()->submit([key, pixels] { DiskCache::WriteFile(key, pixels); },
+                                             TaskPriority::Speculative);
+}
+
+// 静态矢量内容的面积达到该阈值后改为分块栅格化，避免单帧渲染耗时过长。
+static constexpr int64_t TILED_SNAPSHOT_AREA = 2048 * 2048;
+// 单个 tile 的边长以及每帧最多补画的 tile 数量。
+static constexpr int SNAPSHOT_TILE_SIZE = 512;
+static constexpr int MAX_SNAPSHOT_TILES_PER_FRAME = 4;
+
 class SnapshotPicture : public Picture {
  public:
-  SnapshotPicture(ID assetID, std::shared_ptr<Graphic> graphic)
-      : Picture(assetID), graphic(std::move(graphic)) {
+  SnapshotPicture(ID assetID, std::shared_ptr<Graphic> graphic, bool staticContent)
+      : Picture(assetID), graphic(std::move(graphic)), staticContent(staticContent) {
   }
 
   void measureBounds(tgfx::Rect* bounds) const override {
@@ -188,29 +224,55 @@ class SnapshotPicture : public Picture {
   }
 
  protected:
+  bool isStaticContent() const override {
+    return staticContent;
+  }
+
   float getScaleFactor(float maxScaleFactor) const override {
     return maxScaleFactor;
   }
 
-  std::unique_ptr<Snapshot> makeSnapshot(RenderCache* cache, float scaleFactor,
-                                         bool mipmapped) const override {
+  std::unique_ptr<Snapshot> makeSnapshot(RenderCache* cache, float scaleFactor, bool mipmapped,
+                                         const std::string& diskCacheKey) const override {
     tgfx::Rect bounds = tgfx::Rect::MakeEmpty();
     graphic->measureBounds(&bounds);
     auto width = static_cast<int>(ceilf(bounds.width() * scaleFactor));
     auto height = static_cast<int>(ceilf(bounds.height() * scaleFactor));
+    auto matrix = tgfx::Matrix::MakeScale(scaleFactor);
+    matrix.preTranslate(-bounds.x(), -bounds.y());
+    auto drawingMatrix = tgfx::Matrix::I();
+    matrix.invert(&drawingMatrix);
+    std::string pixelsKey = {};
+    if (!diskCacheKey.empty()) {
+      // The rasterized size is part of the key, a mismatched scale falls back to rendering.
+      pixelsKey = diskCacheKey + "." + std::to_string(width) + "x" + std::to_string(height);
+      auto image = ReadSnapshotPixels(pixelsKey, width, height);
+      if (image != nullptr) {
+        if (mipmapped) {
+          image = image->makeMipmapped(true);
+        }
+        return std::unique_ptr<Snapshot>(new Snapshot(std::move(image), drawingMatrix));
+      }
+    }
     auto renderFlags = tgfx::RenderFlags::DisableCache;
+    if (staticContent && static_cast<int64_t>(width) * height >= TILED_SNAPSHOT_AREA) {
+      // 超大静态矢量内容一次性栅格化会在单帧里挤爆集成显卡的时间预算，改为分块推进：
+      // 每帧最多补画几个 tile，完成前返回空继续矢量直绘，完成后整块表面转成快照。
+      // 内容变化或资源移除时中间状态随 removeSnapshot() 一起丢弃。
+      return makeSnapshotTiled(cache, width, height, matrix, drawingMatrix, mipmapped, pixelsKey,
+                               renderFlags);
+    }
     auto surface =
         tgfx::Surface::Make(cache->getContext(), width, height, false, 1, mipmapped, renderFlags);
     if (surface == nullptr) {
       return nullptr;
     }
     Canvas canvas(surface.get(), cache);
-    auto matrix = tgfx::Matrix::MakeScale(scaleFactor);
-    matrix.preTranslate(-bounds.x(), -bounds.y());
     canvas.setMatrix(matrix);
     graphic->draw(&canvas);
-    auto drawingMatrix = tgfx::Matrix::I();
-    matrix.invert(&drawingMatrix);
+    if (!pixelsKey.empty()) {
+      WriteSnapshotPixels(pixelsKey, surface.get());
+    }
     auto image = surface->makeImageSnapshot();
     auto snapshot = new Snapshot(std::move(image), drawingMatrix);
     return std::unique_ptr<Snapshot>(snapshot);
@@ -218,6 +280,61 @@ class SnapshotPicture : public Picture {
 
  private:
   std::shared_ptr<Graphic> graphic = nullptr;
+  bool staticContent = false;
+
+  std::unique_ptr<Snapshot> makeSnapshotTiled(RenderCache* cache, int width, int height,
+                                              const tgfx::Matrix& matrix,
+                                              const tgfx::Matrix& drawingMatrix, bool mipmapped,
+                                              const std::string& pixelsKey,
+                                              uint32_t renderFlags) const {
+    auto tiled = cache->findTiledSnapshot(assetID);
+    if (tiled != nullptr &&
+        (tiled->surface->width() != width || tiled->surface->height() != height)) {
+      // 缩放档位变了，重新开始。
+      cache->removeTiledSnapshot(assetID);
+      tiled = nullptr;
+    }
+    if (tiled == nullptr) {
+      auto surface =
+          tgfx::Surface::Make(cache->getContext(), width, height, false, 1, mipmapped, renderFlags);
+      if (surface == nullptr) {
+        return nullptr;
+      }
+      tiled = cache->createTiledSnapshot(assetID, std::move(surface));
+    }
+    auto tileColumns = (width + SNAPSHOT_TILE_SIZE - 1) / SNAPSHOT_TILE_SIZE;
+    auto tileRows = (height + SNAPSHOT_TILE_SIZE - 1) / SNAPSHOT_TILE_SIZE;
+    auto tileCount = tileColumns * tileRows;
+    auto endTile = tiled->nextTile + MAX_SNAPSHOT_TILES_PER_FRAME;
+    if (endTile > tileCount) {
+      endTile = tileCount;
+    }
+    Canvas canvas(tiled->surface.get(), cache);
+    while (tiled->nextTile < endTile) {
+      auto tileX = (tiled->nextTile % tileColumns) * SNAPSHOT_TILE_SIZE;
+      auto tileY = (tiled->nextTile / tileColumns) * SNAPSHOT_TILE_SIZE;
+      auto tileRect = tgfx::Rect::MakeXYWH(static_cast<float>(tileX), static_cast<float>(tileY),
+                                           SNAPSHOT_TILE_SIZE, SNAPSHOT_TILE_SIZE);
+      canvas.save();
+      // 先裁剪再设置矩阵，裁剪区域落在设备坐标上。
+      canvas.clipRect(tileRect);
+      canvas.setMatrix(matrix);
+      graphic->draw(&canvas);
+      canvas.restore();
+      tiled->nextTile++;
+    }
+    if (tiled->nextTile < tileCount) {
+      // 还没画完，调用方继续矢量直绘，下一帧接着补。
+      return nullptr;
+    }
+    if (!pixelsKey.empty()) {
+      WriteSnapshotPixels(pixelsKey, tiled->surface.get());
+    }
+    auto image = tiled->surface->makeImageSnapshot();
+    cache->removeTiledSnapshot(assetID);
+    auto snapshot = new Snapshot(std::move(image), drawingMatrix);
+    return std::unique_ptr<Snapshot>(snapshot);
+  }
 };
 //===================================== SnapshotPicture ============================================
 
@@ -343,10 +460,11 @@ std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, const tgfx::BackendTextur
   return std::make_shared<ImageProxyPicture>(assetID, proxy);
 }
 
-std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic) {
+std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic,
+                                           bool staticContent) {
   if (assetID == 0 || graphic == nullptr || graphic->type() == GraphicType::Picture) {
     return graphic;
   }
-  return std::make_shared<SnapshotPicture>(assetID, graphic);
+  return std::make_shared<SnapshotPicture>(assetID, graphic, staticContent);
 }
 }  // namespace pag
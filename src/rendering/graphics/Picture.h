@@ -55,9 +55,12 @@ class Picture : public Graphic {
   /**
    * Creates a new Picture with specified graphic. If the assetID is valid (not 0), the returned
    * Picture may be cached as an internal texture representation during rendering, which increases
-   * performance for drawing complex content.
+   * performance for drawing complex content. Set staticContent to true if the graphic stays the
+   * same across the whole playback, which allows the render cache to apply memory-reducing
+   * policies to its snapshot.
    */
-  static std::shared_ptr<Graphic> MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic);
+  static std::shared_ptr<Graphic> MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic,
+                                           bool staticContent = false);
 
   explicit Picture(ID assetID);
 
@@ -68,9 +71,17 @@ class Picture : public Graphic {
  protected:
   ID assetID = 0;
 
+  /**
+   * Returns true if the content of this Picture never changes across the whole playback.
+   */
+  virtual bool isStaticContent() const {
+    return false;
+  }
+
   virtual float getScaleFactor(float maxScaleFactor) const = 0;
   virtual std::unique_ptr<Snapshot> makeSnapshot(RenderCache* cache, float scaleFactor,
-                                                 bool mipmapped) const = 0;
+                                                 bool mipmapped,
+                                                 const std::string& diskCacheKey) const = 0;
 
  private:
   uint64_t uniqueKey = 0;
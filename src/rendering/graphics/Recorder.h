@@ -121,9 +121,27 @@ class Recorder {
    */
   std::shared_ptr<Graphic> makeGraphic();
 
+  /**
+   * Returns the culling rectangle in the coordinate space the recorder started in. Renderers may
+   * skip generating content that lies entirely outside of it. Returns an empty rectangle if no
+   * culling was requested.
+   */
+  const tgfx::Rect& getCullRect() const {
+    return cullRect;
+  }
+
+  /**
+   * Sets the culling rectangle. Culling is a pure optimization hint, the caller is responsible for
+   * clipping the drawing to the rectangle as well.
+   */
+  void setCullRect(const tgfx::Rect& rect) {
+    cullRect = rect;
+  }
+
  private:
   std::vector<std::shared_ptr<Graphic>> rootContents = {};
   int layerIndex = 0;
+  tgfx::Rect cullRect = tgfx::Rect::MakeEmpty();
   tgfx::Matrix matrix = tgfx::Matrix::I();
   std::vector<std::shared_ptr<Graphic>> layerContents = {};
   std::vector<std::shared_ptr<Record>> records = {};
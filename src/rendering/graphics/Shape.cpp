@@ -30,7 +30,10 @@ std::shared_ptr<Graphic> Shape::MakeFrom(ID assetID, const tgfx::Path& path, tgf
     return nullptr;
   }
   auto shader = tgfx::Shader::MakeColorShader(color);
-  return std::shared_ptr<Graphic>(new Shape(assetID, path, std::move(shader)));
+  auto shape = new Shape(assetID, path, std::move(shader));
+  shape->isSolid = true;
+  shape->solidColor = color;
+  return std::shared_ptr<Graphic>(shape);
 }
 
 std::shared_ptr<Graphic> Shape::MakeFrom(ID assetID, const tgfx::Path& path,
@@ -41,6 +44,35 @@ std::shared_ptr<Graphic> Shape::MakeFrom(ID assetID, const tgfx::Path& path,
   return std::shared_ptr<Graphic>(new Shape(assetID, path, gradient.getShader()));
 }
 
+std::shared_ptr<Graphic> Shape::TryMerge(const std::shared_ptr<Graphic>& first,
+                                         const std::shared_ptr<Graphic>& second) {
+  if (first == nullptr || second == nullptr || first->type() != GraphicType::Shape ||
+      second->type() != GraphicType::Shape) {
+    return nullptr;
+  }
+  auto shapeA = static_cast<Shape*>(first.get());
+  auto shapeB = static_cast<Shape*>(second.get());
+  auto& colorA = shapeA->solidColor;
+  auto& colorB = shapeB->solidColor;
+  if (!shapeA->isSolid || !shapeB->isSolid || shapeA->assetID != shapeB->assetID ||
+      colorA.red != colorB.red || colorA.green != colorB.green || colorA.blue != colorB.blue ||
+      colorA.alpha != colorB.alpha ||
+      shapeA->path.getFillType() != shapeB->path.getFillType()) {
+    return nullptr;
+  }
+  // 路径重叠时合并可能改变填充结果（EvenOdd 或反向 Winding 的轮廓会相互抵消），保守起见只
+  // 合并包围盒不相交的路径。
+  if (shapeA->path.getBounds().intersects(shapeB->path.getBounds())) {
+    return nullptr;
+  }
+  auto path = shapeA->path;
+  path.addPath(shapeB->path);
+  auto merged = new Shape(shapeA->assetID, std::move(path), shapeA->shader);
+  merged->isSolid = true;
+  merged->solidColor = shapeA->solidColor;
+  return std::shared_ptr<Graphic>(merged);
+}
+
 Shape::Shape(ID assetID, tgfx::Path path, std::shared_ptr<tgfx::Shader> shader)
     : assetID(assetID), path(std::move(path)), shader(std::move(shader)) {
 }
@@ -36,6 +36,13 @@ class Shape : public Graphic {
   static std::shared_ptr<Graphic> MakeFrom(ID assetID, const tgfx::Path& path,
                                            const GradientPaint& gradient);
 
+  /**
+   * Merges two shape Graphics drawn back to back into a single one when they use the same solid
+   * color and their paths do not overlap. Returns nullptr if they cannot be merged.
+   */
+  static std::shared_ptr<Graphic> TryMerge(const std::shared_ptr<Graphic>& first,
+                                           const std::shared_ptr<Graphic>& second);
+
   GraphicType type() const override {
     return GraphicType::Shape;
   }
@@ -52,6 +59,8 @@ class Shape : public Graphic {
   ID assetID = 0;
   tgfx::Path path = {};
   std::shared_ptr<tgfx::Shader> shader;
+  bool isSolid = false;
+  tgfx::Color solidColor = tgfx::Color::Transparent();
 
   friend class RenderCache;
 };
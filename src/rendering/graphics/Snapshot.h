@@ -70,7 +70,16 @@ class Snapshot {
   tgfx::Matrix matrix = tgfx::Matrix::I();
   ID assetID = 0;
   uint64_t makerKey = 0;
-  Frame idleFrames = 0;
+  // The frame generation this snapshot was last drawn in, stamped by RenderCache on access so
+  // expiry checks never have to touch idle snapshots.
+  uint64_t lastUsedFrame = 0;
+  // How many times this snapshot has been reused and how long it took to make, used by RenderCache
+  // to rank eviction candidates when the snapshot byte budget is exceeded.
+  size_t useCount = 0;
+  int64_t makeCost = 0;
+  // True when the asset is authored with CachePolicy::Enable. Pinned snapshots are exempt from
+  // expiry and byte-budget eviction; only a full release removes them.
+  bool pinned = false;
 
   friend class RenderCache;
 };
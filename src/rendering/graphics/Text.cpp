@@ -18,6 +18,7 @@
 
 #include "Text.h"
 #include <unordered_map>
+#include "base/utils/MatrixUtil.h"
 #include "base/utils/TGFXCast.h"
 #include "pag/file.h"
 #include "rendering/caches/RenderCache.h"
@@ -235,7 +236,8 @@ bool Text::getPath(tgfx::Path* path) const {
   return true;
 }
 
-void Text::prepare(RenderCache*) const {
+void Text::prepare(RenderCache* cache) const {
+  cache->prepareTextAtlas(textBlock.get());
 }
 
 static std::vector<TextStyle> GetGlyphStyles(const GlyphHandle& glyph) {
@@ -256,18 +258,29 @@ static std::vector<TextStyle> GetGlyphStyles(const GlyphHandle& glyph) {
   return styles;
 }
 
+// 图集允许被轻微放大绘制，超过这个比例贴图的发虚就肉眼可见了。
+static constexpr float MAX_ATLAS_MAGNIFICATION = 1.05f;
+
 void Text::draw(Canvas* canvas) const {
   auto textAtlas = canvas->getCache()->getTextAtlas(textBlock.get());
   if (textAtlas != nullptr) {
-    draw(canvas, textAtlas);
-  } else {
-    drawTextRuns(canvas, 0);
-    drawTextRuns(canvas, 1);
+    // 画布缩放超过图集栅格化比例时贴图会被放大而发虚，常见于编辑器连续放大时图集档位尚未
+    // 跟上，或 cacheScale 压低了图集分辨率。字形轮廓本身是矢量数据，超出图集覆盖范围的帧
+    // 直接按路径绘制，任意缩放都保持清晰，也不用为瞬时的缩放峰值重建整个图集。
+    auto drawScale = GetMaxScaleFactor(canvas->getMatrix()) * textBlock->maxScale();
+    if (drawScale <= textAtlas->totalScale() * MAX_ATLAS_MAGNIFICATION) {
+      draw(canvas, textAtlas);
+      return;
+    }
   }
+  drawTextRuns(canvas, 0);
+  drawTextRuns(canvas, 1);
 }
 
 struct Parameters {
   size_t imageIndex = 0;
+  // The shared alpha of the batched color glyphs, which have no entries in the colors list.
+  float colorGlyphAlpha = 1.0f;
   std::vector<tgfx::Matrix> matrices;
   std::vector<tgfx::Rect> rects;
   std::vector<tgfx::Color> colors;
@@ -277,10 +290,15 @@ static void Draw(Canvas* canvas, const TextAtlas* atlas, const Parameters& param
   if (parameters.matrices.empty()) {
     return;
   }
+  auto alpha = canvas->getAlpha();
+  if (parameters.colors.empty()) {
+    canvas->setAlpha(alpha * parameters.colorGlyphAlpha);
+  }
   canvas->drawAtlas(atlas->getAtlasImage(parameters.imageIndex), parameters.matrices.data(),
                     parameters.rects.data(),
                     parameters.colors.empty() ? nullptr : parameters.colors.data(),
                     parameters.matrices.size());
+  canvas->setAlpha(alpha);
 }
 
 static bool RectStaysRectAndNoScale(const tgfx::Matrix& matrix) {
@@ -296,6 +314,15 @@ static bool RectStaysRectAndNoScale(const tgfx::Matrix& matrix) {
 }
 
 void Text::draw(Canvas* canvas, const TextAtlas* textAtlas) const {
+  // Draw the first style of every glyph before any second style, the same order drawTextRuns()
+  // uses. Iterating style-by-style instead of glyph-by-glyph keeps consecutive glyphs on the same
+  // atlas page, so a run of glyphs sharing a page and paint merges into one drawAtlas() call
+  // rather than flushing on every fill/stroke page switch.
+  drawAtlasGlyphs(canvas, textAtlas, 0);
+  drawAtlasGlyphs(canvas, textAtlas, 1);
+}
+
+void Text::drawAtlasGlyphs(Canvas* canvas, const TextAtlas* textAtlas, size_t styleIndex) const {
   Parameters parameters = {};
   auto viewMatrix = canvas->getMatrix();
   canvas->setMatrix(tgfx::Matrix::I());
@@ -305,42 +332,43 @@ void Text::draw(Canvas* canvas, const TextAtlas* textAtlas) const {
       continue;
     }
     auto styles = GetGlyphStyles(glyph);
+    if (styleIndex >= styles.size()) {
+      continue;
+    }
+    auto style = styles[styleIndex];
     AtlasLocator locator;
-    for (auto style : styles) {
-      tgfx::BytesKey bytesKey;
-      glyph->computeAtlasKey(&bytesKey, style);
-      if (!textAtlas->getLocator(bytesKey, &locator)) {
-        continue;
-      }
-      if (parameters.imageIndex != locator.imageIndex) {
-        Draw(canvas, textAtlas, parameters);
-        parameters = {};
-        parameters.imageIndex = locator.imageIndex;
-      }
-      auto matrix = tgfx::Matrix::I();
-      matrix.postTranslate(locator.glyphBounds.x(), locator.glyphBounds.y());
-      matrix.postScale(atlasScaleInverted, atlasScaleInverted);
-      matrix.postConcat(glyph->getTotalMatrix());
-      matrix.postConcat(viewMatrix);
-      if (RectStaysRectAndNoScale(matrix)) {
-        auto rect = tgfx::Rect::MakeWH(locator.location.width(), locator.location.height());
-        matrix.mapRect(&rect);
-        matrix.postTranslate(std::round(rect.left) - rect.left, std::round(rect.top) - rect.top);
-      }
-      parameters.matrices.emplace_back(matrix);
-      parameters.rects.emplace_back(locator.location);
-      if (glyph->getFont().hasColor()) {
-        auto alpha = canvas->getAlpha();
-        canvas->setAlpha(alpha * glyph->getAlpha());
-        Draw(canvas, textAtlas, parameters);
-        parameters = {};
-        canvas->setAlpha(alpha);
-      } else {
-        auto color =
-            ToTGFX(style == TextStyle::Stroke ? glyph->getStrokeColor() : glyph->getFillColor());
-        color.alpha *= glyph->getAlpha();
-        parameters.colors.emplace_back(color);
-      }
+    tgfx::BytesKey bytesKey;
+    glyph->computeAtlasKey(&bytesKey, style);
+    if (!textAtlas->getLocator(bytesKey, &locator)) {
+      continue;
+    }
+    auto hasColor = glyph->getFont().hasColor();
+    if (parameters.imageIndex != locator.imageIndex ||
+        (hasColor && parameters.colorGlyphAlpha != glyph->getAlpha())) {
+      Draw(canvas, textAtlas, parameters);
+      parameters = {};
+      parameters.imageIndex = locator.imageIndex;
+    }
+    if (hasColor) {
+      parameters.colorGlyphAlpha = glyph->getAlpha();
+    }
+    auto matrix = tgfx::Matrix::I();
+    matrix.postTranslate(locator.glyphBounds.x(), locator.glyphBounds.y());
+    matrix.postScale(atlasScaleInverted, atlasScaleInverted);
+    matrix.postConcat(glyph->getTotalMatrix());
+    matrix.postConcat(viewMatrix);
+    if (RectStaysRectAndNoScale(matrix)) {
+      auto rect = tgfx::Rect::MakeWH(locator.location.width(), locator.location.height());
+      matrix.mapRect(&rect);
+      matrix.postTranslate(std::round(rect.left) - rect.left, std::round(rect.top) - rect.top);
+    }
+    parameters.matrices.emplace_back(matrix);
+    parameters.rects.emplace_back(locator.location);
+    if (!hasColor) {
+      auto color =
+          ToTGFX(style == TextStyle::Stroke ? glyph->getStrokeColor() : glyph->getFillColor());
+      color.alpha *= glyph->getAlpha();
+      parameters.colors.emplace_back(color);
     }
   }
   Draw(canvas, textAtlas, parameters);
@@ -66,6 +66,8 @@ class Text : public Graphic {
 
   void draw(Canvas* canvas, const TextAtlas* textAtlas) const;
 
+  void drawAtlasGlyphs(Canvas* canvas, const TextAtlas* textAtlas, size_t styleIndex) const;
+
   void drawTextRuns(Canvas* canvas, int paintIndex) const;
 
   std::vector<GlyphHandle> glyphs;
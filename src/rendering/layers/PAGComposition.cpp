@@ -16,6 +16,7 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <unordered_set>
 #include "base/utils/MatrixUtil.h"
 #include "base/utils/TimeUtil.h"
 #include "pag/file.h"
@@ -26,7 +27,10 @@
 #include "rendering/graphics/Recorder.h"
 #include "rendering/layers/PAGStage.h"
 #include "rendering/renderers/LayerRenderer.h"
+#include "rendering/utils/FrameProfiler.h"
+#include "rendering/utils/HitTestGrid.h"
 #include "rendering/utils/LockGuard.h"
+#include "rendering/utils/RenderTaskScheduler.h"
 #include "rendering/utils/ScopedLock.h"
 
 namespace pag {
@@ -213,6 +217,7 @@ bool PAGComposition::doAddLayer(std::shared_ptr<PAGLayer> pagLayer, int index) {
   this->layers.insert(this->layers.begin() + index, pagLayer);
   pagLayer->_parent = this;
   notifyModified(true);
+  notifyStructureModified();
   if (emptyComposition) {
     updateDurationAndFrameRate();
   }
@@ -265,6 +270,7 @@ std::shared_ptr<PAGLayer> PAGComposition::doRemoveLayer(int index) {
   layer->_parent = nullptr;
   layers.erase(layers.begin() + index);
   notifyModified(true);
+  notifyStructureModified();
   if (emptyComposition) {
     updateDurationAndFrameRate();
   }
@@ -428,8 +434,27 @@ void PAGComposition::draw(Recorder* recorder) {
   if (hasClip()) {
     recorder->saveClip(0, 0, static_cast<float>(_width), static_cast<float>(_height));
   }
+  // Generate the contents of independent sibling layers in parallel before composing them in draw
+  // order below.
+  generateChildContents();
   auto count = static_cast<int>(layers.size());
-  for (int i = 0; i < count; i++) {
+  int firstIndex = 0;
+  if (hasClip() && count > 1) {
+    // 模板里常见不透明的全屏图层（例如片头卡片）盖住下方所有内容，这里从最上层往下找第一个完全
+    // 覆盖视口的不透明图层，它下方的图层全部被遮挡，直接跳过绘制。
+    auto viewport = tgfx::Rect::MakeWH(static_cast<float>(_width), static_cast<float>(_height));
+    for (int i = count - 1; i > 0; i--) {
+      auto& childLayer = layers[i];
+      if (!childLayer->layerVisible) {
+        continue;
+      }
+      if (LayerCoversViewport(childLayer.get(), viewport)) {
+        firstIndex = i;
+        break;
+      }
+    }
+  }
+  for (int i = firstIndex; i < count; i++) {
     auto& childLayer = layers[i];
     if (!childLayer->layerVisible) {
       continue;
@@ -441,13 +466,135 @@ void PAGComposition::draw(Recorder* recorder) {
   }
 }
 
+void PAGComposition::generateChildContents() {
+  std::vector<PAGLayer*> pendingLayers = {};
+  for (auto& childLayer : layers) {
+    if (!childLayer->layerVisible) {
+      continue;
+    }
+    auto layerType = childLayer->layerType();
+    if (layerType != LayerType::Shape && layerType != LayerType::Text) {
+      // Other layer types either share caches across sibling layers or create GPU resources, so
+      // their contents cannot be generated off the drawing thread.
+      continue;
+    }
+    pendingLayers.push_back(childLayer.get());
+  }
+  if (pendingLayers.size() < 2) {
+    // Nothing to gain from forking, the drawing pass generates the content in place.
+    return;
+  }
+  std::vector<std::shared_ptr<RenderTask>> tasks = {};
+  for (auto pagLayer : pendingLayers) {
+    auto layer = pagLayer->layer;
+    auto contentFrame = pagLayer->contentFrame;
+    auto task = RenderTaskScheduler::GetInstance()->submit(
+        [layer, contentFrame] {
+          auto layerCache = LayerCache::Get(layer);
+          if (layerCache->contentVisible(contentFrame)) {
+            layerCache->getContent(contentFrame);
+          }
+        },
+        TaskPriority::VisibleNow);
+    if (task != nullptr) {
+      tasks.push_back(std::move(task));
+    }
+  }
+  for (auto& task : tasks) {
+    task->wait();
+  }
+}
+
+bool PAGComposition::RetainedGraphicValid(PAGLayer* childLayer) {
+  if (childLayer->retainedGraphicFrame < 0 ||
+      childLayer->retainedGraphicVersion != childLayer->contentVersion) {
+    return false;
+  }
+  if (!(childLayer->retainedGraphicMatrix == childLayer->layerMatrix) ||
+      childLayer->retainedGraphicAlpha != childLayer->layerAlpha) {
+    return false;
+  }
+  auto layerCache = LayerCache::Get(childLayer->layer);
+  return !layerCache->checkFrameChanged(childLayer->contentFrame,
+                                        childLayer->retainedGraphicFrame);
+}
+
+bool PAGComposition::LayerCoversViewport(PAGLayer* childLayer, const tgfx::Rect& viewport) {
+  // 非 Normal 混合模式会读取下方像素参与计算，即使图层完全不透明也不能遮挡下方内容。
+  if (childLayer->layerAlpha < 1.0f || childLayer->layer->blendMode != BlendMode::Normal) {
+    return false;
+  }
+  // 只利用已经缓存好的 retainedGraphic 做覆盖判断，避免为了剔除反而提前生成图层内容。
+  if (childLayer->layerType() == LayerType::PreCompose || childLayer->_trackMatteLayer != nullptr ||
+      !RetainedGraphicValid(childLayer)) {
+    return false;
+  }
+  tgfx::Path coverPath = {};
+  if (childLayer->retainedGraphic == nullptr || !childLayer->retainedGraphic->getPath(&coverPath)) {
+    return false;
+  }
+  tgfx::Path uncovered = {};
+  uncovered.addRect(viewport);
+  uncovered.addPath(coverPath, tgfx::PathOp::Difference);
+  return uncovered.isEmpty();
+}
+
 void PAGComposition::DrawChildLayer(Recorder* recorder, PAGLayer* childLayer) {
+  if (childLayer->layerAlpha <= 0) {
+    // 整层透明，滤镜、遮罩和内容生成全部跳过。
+    return;
+  }
+  auto& cullRect = recorder->getCullRect();
+  if (!cullRect.isEmpty()) {
+    // 设置了视口时，完全落在视口外的图层在内容生成之前就剔除掉，而不是等到光栅化再被裁剪。
+    tgfx::Rect layerBounds = {};
+    childLayer->measureBounds(&layerBounds);
+    // measureBounds() 只覆盖内容本身，阴影、发光、运动模糊等滤镜会超出内容区域，内容在视口
+    // 外不代表滤镜结果也在视口外，剔除前先按滤镜链扩展边界。
+    auto boundsModifier = FilterModifier::Make(childLayer);
+    if (boundsModifier != nullptr) {
+      boundsModifier->applyToBounds(&layerBounds);
+    }
+    auto matrix = recorder->getMatrix();
+    matrix.preConcat(ToTGFX(childLayer->getTotalMatrixInternal()));
+    matrix.mapRect(&layerBounds);
+    if (!layerBounds.intersect(cullRect)) {
+      return;
+    }
+  }
+  auto profiler = childLayer->stage != nullptr ? childLayer->stage->profiler : nullptr;
+  std::string profileName = {};
+  if (profiler != nullptr) {
+    auto& layerName = childLayer->layer->name;
+    profileName = layerName.empty() ? "layer#" + std::to_string(childLayer->layer->id) : layerName;
+  }
+  ProfileScope profileScope(profiler, std::move(profileName));
+  // Pre-compose layers animate through their children and track mattes are driven by a second
+  // layer, so only the other layer types can retain their display list between frames.
+  bool retainable = childLayer->layerType() != LayerType::PreCompose &&
+                    childLayer->_trackMatteLayer == nullptr;
+  if (retainable && RetainedGraphicValid(childLayer)) {
+    recorder->drawGraphic(childLayer->retainedGraphic);
+    return;
+  }
   auto filterModifier = childLayer->cacheFilters() ? nullptr : FilterModifier::Make(childLayer);
   auto trackMatte = TrackMatteRenderer::Make(childLayer);
   Transform extraTransform = {ToTGFX(childLayer->layerMatrix), childLayer->layerAlpha};
-  LayerRenderer::DrawLayer(recorder, childLayer->layer,
-                           childLayer->contentFrame + childLayer->layer->startTime, filterModifier,
+  auto layerFrame = childLayer->contentFrame + childLayer->layer->startTime;
+  if (!retainable) {
+    LayerRenderer::DrawLayer(recorder, childLayer->layer, layerFrame, filterModifier,
+                             trackMatte.get(), childLayer, &extraTransform);
+    return;
+  }
+  Recorder childRecorder = {};
+  LayerRenderer::DrawLayer(&childRecorder, childLayer->layer, layerFrame, filterModifier,
                            trackMatte.get(), childLayer, &extraTransform);
+  childLayer->retainedGraphic = childRecorder.makeGraphic();
+  childLayer->retainedGraphicFrame = childLayer->contentFrame;
+  childLayer->retainedGraphicVersion = childLayer->contentVersion;
+  childLayer->retainedGraphicMatrix = childLayer->layerMatrix;
+  childLayer->retainedGraphicAlpha = childLayer->layerAlpha;
+  recorder->drawGraphic(childLayer->retainedGraphic);
 }
 
 void PAGComposition::measureBounds(tgfx::Rect* bounds) {
@@ -461,6 +608,7 @@ void PAGComposition::measureBounds(tgfx::Rect* bounds) {
       composition->type() == CompositionType::Video) {
     getContent()->measureBounds(bounds);
   }
+  generateChildContents();
   for (auto& childLayer : layers) {
     if (!childLayer->layerVisible) {
       continue;
@@ -516,6 +664,38 @@ std::vector<std::shared_ptr<PAGLayer>> PAGComposition::getLayersUnderPoint(float
   return results;
 }
 
+void PAGComposition::applyTransforms(const std::vector<PAGTransformUpdate>& updates) {
+  LockGuard autoLock(rootLocker);
+  std::unordered_set<PAGLayer*> visited = {};
+  for (auto& update : updates) {
+    auto& pagLayer = update.layer;
+    // 不同树的图层由别的 rootLocker 保护，跳过以免在未持锁的情况下修改它们。
+    if (pagLayer == nullptr || pagLayer->rootLocker != rootLocker) {
+      continue;
+    }
+    auto matrixChanged = !(update.matrix == pagLayer->layerMatrix);
+    auto alphaChanged = update.alpha != pagLayer->layerAlpha;
+    if (!matrixChanged && !alphaChanged) {
+      continue;
+    }
+    if (matrixChanged) {
+      pagLayer->layerMatrix = update.matrix;
+      pagLayer->invalidateCacheScale();
+    }
+    if (alphaChanged) {
+      pagLayer->layerAlpha = update.alpha;
+    }
+    // 父链的版本号统一在这里补齐，公共祖先只走一次，整批更新等价于一次失效遍历。
+    for (auto parent = pagLayer->getParentOrOwner(); parent != nullptr;
+         parent = parent->getParentOrOwner()) {
+      if (!visited.insert(parent).second) {
+        break;
+      }
+      parent->contentVersion++;
+    }
+  }
+}
+
 bool PAGComposition::GetTrackMatteLayerAtPoint(PAGLayer* childLayer, float x, float y,
                                                std::vector<std::shared_ptr<PAGLayer>>* results) {
   // trackMatteLayer 处于时间轴不可见的情况下也要当做空区域处理，永远不取消遮罩作用。当 trackMatte
@@ -575,9 +755,10 @@ bool PAGComposition::getLayersUnderPointInternal(float x, float y,
   if (hasClip() && !bounds.contains(x, y)) {
     return false;
   }
+  updateHitTestGrid();
   bool found = false;
-  for (int i = static_cast<int>(layers.size()) - 1; i >= 0; i--) {
-    auto childLayer = layers[i];
+  for (auto i : hitTestGrid->find(x, y)) {
+    auto childLayer = layers[static_cast<size_t>(i)];
     if (!childLayer->layerVisible) {
       continue;
     }
@@ -594,6 +775,36 @@ bool PAGComposition::getLayersUnderPointInternal(float x, float y,
   return found;
 }
 
+void PAGComposition::updateHitTestGrid() {
+  if (hitTestGrid != nullptr && hitTestGridFrame == contentFrame &&
+      hitTestGridVersion == contentVersion) {
+    return;
+  }
+  hitTestGrid =
+      std::make_unique<HitTestGrid>(static_cast<float>(_width), static_cast<float>(_height));
+  hitTestGridFrame = contentFrame;
+  hitTestGridVersion = contentVersion;
+  for (size_t i = 0; i < layers.size(); i++) {
+    auto childLayer = layers[i].get();
+    if (!childLayer->layerVisible) {
+      continue;
+    }
+    if (childLayer->_trackMatteLayer != nullptr) {
+      // 轨道遮罩可能反向保留目标图层，遮罩图层自身也可能被命中，保守地参与每个点的检测。
+      hitTestGrid->addToAllCells(static_cast<int>(i));
+      continue;
+    }
+    Transform layerTransform = {};
+    if (!childLayer->getTransform(&layerTransform)) {
+      continue;
+    }
+    tgfx::Rect childBounds = {};
+    childLayer->measureBounds(&childBounds);
+    layerTransform.matrix.mapRect(&childBounds);
+    hitTestGrid->addEntry(static_cast<int>(i), childBounds);
+  }
+}
+
 bool PAGComposition::cacheFilters() const {
   return layerCache->cacheFilters() && !contentModified() && layerCache->contentStatic();
 }
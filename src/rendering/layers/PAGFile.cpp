@@ -19,8 +19,14 @@
 #include "base/utils/TimeUtil.h"
 #include "pag/file.h"
 #include "pag/pag.h"
+#include "rendering/FontManager.h"
+#include "rendering/layers/PAGStage.h"
 #include "rendering/utils/LockGuard.h"
+#include "rendering/utils/ReplayCapture.h"
+#include "rendering/utils/RenderTaskScheduler.h"
 #include "rendering/utils/ScopedLock.h"
+#include "rendering/utils/shaper/TextShaper.h"
+#include "tgfx/core/Task.h"
 
 namespace pag {
 uint16_t PAGFile::MaxSupportedTagLevel() {
@@ -73,6 +79,38 @@ std::shared_ptr<PAGFile> PAGFile::Load(const std::string& filePath, const std::s
   return MakeFrom(file);
 }
 
+void PAGLoadRequest::cancel() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  cancelled = true;
+}
+
+std::shared_ptr<PAGLoadRequest> PAGFile::LoadAsync(
+    const std::string& filePath, std::function<void(std::shared_ptr<PAGFile>)> callback,
+    bool prefetch, const std::string& password) {
+  if (callback == nullptr) {
+    return nullptr;
+  }
+  auto request = std::shared_ptr<PAGLoadRequest>(new PAGLoadRequest());
+  auto priority = prefetch ? TaskPriority::Prefetch : TaskPriority::VisibleNow;
+  RenderTaskScheduler::GetInstance()->submit(
+      [request, filePath, password, callback = std::move(callback)]() {
+        {
+          std::lock_guard<std::mutex> autoLock(request->locker);
+          if (request->cancelled) {
+            // 已经取消的请求直接跳过磁盘读取和解码。
+            return;
+          }
+        }
+        auto pagFile = Load(filePath, password);
+        std::lock_guard<std::mutex> autoLock(request->locker);
+        if (!request->cancelled) {
+          callback(std::move(pagFile));
+        }
+      },
+      priority);
+  return request;
+}
+
 std::shared_ptr<PAGFile> PAGFile::MakeFrom(std::shared_ptr<File> file) {
   if (file == nullptr) {
     return nullptr;
@@ -172,12 +210,51 @@ void PAGFile::replaceText(int editableTextIndex, std::shared_ptr<TextDocument> t
   LockGuard autoLock(rootLocker);
   auto textLayers = getLayersByEditableIndexInternal(editableTextIndex, LayerType::Text);
   replaceTextInternal(textLayers, textData);
+  if (stage != nullptr && stage->replayCapture != nullptr) {
+    stage->replayCapture->recordTextReplacement(editableTextIndex,
+                                                textData ? textData->text : "");
+  }
+}
+
+void PAGFile::replaceTexts(
+    const std::vector<std::pair<int, std::shared_ptr<TextDocument>>>& batch) {
+  std::vector<std::shared_ptr<TextDocument>> shapingList = {};
+  {
+    LockGuard autoLock(rootLocker);
+    for (auto& item : batch) {
+      auto textLayers = getLayersByEditableIndexInternal(item.first, LayerType::Text);
+      replaceTextInternal(textLayers, item.second);
+      if (item.second != nullptr && !textLayers.empty()) {
+        shapingList.push_back(item.second);
+      }
+      if (stage != nullptr && stage->replayCapture != nullptr) {
+        stage->replayCapture->recordTextReplacement(item.first,
+                                                    item.second ? item.second->text : "");
+      }
+    }
+  }
+  // 排版只读取文本内容，不访问图层状态，放到锁外并行执行，避免首帧渲染时串行排版所有文本。
+  std::vector<std::shared_ptr<tgfx::Task>> shapingTasks = {};
+  for (auto& textData : shapingList) {
+    shapingTasks.push_back(tgfx::Task::Run([textData]() {
+      auto typeface =
+          FontManager::GetTypefaceWithoutFallback(textData->fontFamily, textData->fontStyle);
+      TextShaper::Shape(textData->text, std::move(typeface));
+    }));
+  }
+  for (auto& task : shapingTasks) {
+    task->wait();
+  }
 }
 
 void PAGFile::replaceImage(int editableImageIndex, std::shared_ptr<PAGImage> image) {
   LockGuard autoLock(rootLocker);
   auto imageLayers = getLayersByEditableIndexInternal(editableImageIndex, LayerType::Image);
   replaceImageInternal(imageLayers, image);
+  if (stage != nullptr && stage->replayCapture != nullptr) {
+    stage->replayCapture->recordImageReplacement(editableImageIndex, image ? image->width() : 0,
+                                                 image ? image->height() : 0);
+  }
 }
 
 void PAGFile::replaceImageByName(const std::string& layerName, std::shared_ptr<PAGImage> image) {
@@ -190,6 +267,11 @@ void PAGFile::replaceImageByName(const std::string& layerName, std::shared_ptr<P
   }
   LockGuard autoLock(rootLocker);
   replaceImageInternal(imageLayers, image);
+  if (stage != nullptr && stage->replayCapture != nullptr) {
+    stage->replayCapture->recordImageReplacement(imageLayers.front()->editableIndex(),
+                                                 image ? image->width() : 0,
+                                                 image ? image->height() : 0);
+  }
 }
 
 std::vector<std::shared_ptr<PAGLayer>> PAGFile::getLayersByEditableIndex(int editableIndex,
@@ -200,11 +282,36 @@ std::vector<std::shared_ptr<PAGLayer>> PAGFile::getLayersByEditableIndex(int edi
 
 std::vector<std::shared_ptr<PAGLayer>> PAGFile::getLayersByEditableIndexInternal(
     int editableIndex, LayerType layerType) {
-  std::vector<std::shared_ptr<PAGLayer>> result = getLayersBy([=](PAGLayer* pagLayer) -> bool {
-    return pagLayer->layerType() == layerType && pagLayer->_editableIndex == editableIndex &&
+  if (layerType != LayerType::Text && layerType != LayerType::Image) {
+    return getLayersBy([=](PAGLayer* pagLayer) -> bool {
+      return pagLayer->layerType() == layerType && pagLayer->_editableIndex == editableIndex &&
+             pagLayer->file == file;
+    });
+  }
+  // 槽位表一次性把 editableIndex → 图层列表编译出来，结构版本不变时每次替换都直接查表，
+  // 批量生成场景下不再为每个索引做整树遍历。
+  if (!editableSlotsValid || editableSlotsVersion != structureVersion) {
+    updateEditableSlots();
+  }
+  auto& slots = layerType == LayerType::Text ? editableTextSlots : editableImageSlots;
+  auto result = slots.find(editableIndex);
+  return result != slots.end() ? result->second : std::vector<std::shared_ptr<PAGLayer>>{};
+}
+
+void PAGFile::updateEditableSlots() {
+  editableTextSlots.clear();
+  editableImageSlots.clear();
+  auto editableLayers = getLayersBy([=](PAGLayer* pagLayer) -> bool {
+    return (pagLayer->layerType() == LayerType::Text ||
+            pagLayer->layerType() == LayerType::Image) &&
            pagLayer->file == file;
   });
-  return result;
+  for (auto& pagLayer : editableLayers) {
+    auto& slots = pagLayer->layerType() == LayerType::Text ? editableTextSlots : editableImageSlots;
+    slots[pagLayer->_editableIndex].push_back(pagLayer);
+  }
+  editableSlotsVersion = structureVersion;
+  editableSlotsValid = true;
 }
 
 PAGTimeStretchMode PAGFile::timeStretchMode() const {
@@ -236,6 +343,7 @@ void PAGFile::setDurationInternal(int64_t duration) {
   }
   onTimelineChanged();
   notifyModified(true);
+  notifyStructureModified();
 }
 
 std::shared_ptr<PAGFile> PAGFile::copyOriginal() {
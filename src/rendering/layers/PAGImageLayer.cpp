@@ -27,6 +27,9 @@
 #include "rendering/utils/ScopedLock.h"
 
 namespace pag {
+// 时间重映射查找表最多展开这么多帧（一帧 4 字节，上限 256KB），再长就退回关键帧插值。
+static constexpr size_t MAX_TIME_REMAP_LUT_SIZE = 65536;
+
 std::shared_ptr<PAGImageLayer> PAGImageLayer::Make(int width, int height, int64_t duration) {
   if (width <= 0 || height <= 0 || duration <= 0) {
     return nullptr;
@@ -230,10 +233,14 @@ bool PAGImageLayer::cacheFilters() const {
 void PAGImageLayer::onRemoveFromRootFile() {
   PAGLayer::onRemoveFromRootFile();
   contentTimeRemap = nullptr;
+  contentTimeRemapLUT.clear();
+  visibleRangeCached = false;
 }
 
 void PAGImageLayer::onTimelineChanged() {
   contentTimeRemap = nullptr;
+  contentTimeRemapLUT.clear();
+  visibleRangeCached = false;
 }
 
 bool PAGImageLayer::contentVisible() {
@@ -252,7 +259,13 @@ int64_t PAGImageLayer::getCurrentContentTime(int64_t layerTime) {
   if (rootFile) {
     if (contentVisible()) {
       auto timeRemap = getContentTimeRemap();
-      auto replacementFrame = timeRemap->getValueAt(rootFile->stretchedContentFrame());
+      auto contentFrame = rootFile->stretchedContentFrame();
+      float replacementFrame;
+      if (contentFrame >= 0 && static_cast<size_t>(contentFrame) < contentTimeRemapLUT.size()) {
+        replacementFrame = contentTimeRemapLUT[static_cast<size_t>(contentFrame)];
+      } else {
+        replacementFrame = timeRemap->getValueAt(contentFrame);
+      }
       replacementTime =
           static_cast<Frame>(ceil(replacementFrame * 1000000.0 / rootFile->frameRateInternal()));
     } else {
@@ -370,6 +383,15 @@ Property<float>* PAGImageLayer::getContentTimeRemap() {
           static_cast<double>(visibleRange.end - visibleRange.start + 1) / frameDuration();
       BuildContentTimeRemap(property.get(), rootFile, visibleRange, frameScale);
       contentTimeRemap = std::move(property);
+      // 时间重映射实际都是分段线性或贝塞尔的短曲线，摊平成帧号查找表后，每帧取内容时间就是一次
+      // 下标访问，不再走关键帧插值。超长的 File 不展开，避免表本身占太多内存。
+      auto lutSize = static_cast<size_t>(rootFile->stretchedFrameDuration());
+      if (contentTimeRemap->animatable() && lutSize <= MAX_TIME_REMAP_LUT_SIZE) {
+        contentTimeRemapLUT.reserve(lutSize);
+        for (size_t frame = 0; frame < lutSize; frame++) {
+          contentTimeRemapLUT.push_back(contentTimeRemap->getValueAt(static_cast<Frame>(frame)));
+        }
+      }
     }
   }
   return contentTimeRemap.get();
@@ -466,6 +488,11 @@ void PAGImageLayer::BuildContentTimeRemap(AnimatableProperty<float>* property, P
 }
 
 TimeRange PAGImageLayer::getVisibleRangeInFile() {
+  // 连续拖动进度条时每帧都会查询可见区间，父链上的时间伸缩和填充规则换算只做一次，
+  // 失效时机与 contentTimeRemap 一致。
+  if (visibleRangeCached) {
+    return cachedVisibleRange;
+  }
   TimeRange timeRange = {};
   timeRange.start = startFrame;
   timeRange.end = startFrame + frameDuration() - 1;
@@ -485,6 +512,8 @@ TimeRange PAGImageLayer::getVisibleRangeInFile() {
   if (timeRange.start > timeRange.end) {
     std::swap(timeRange.start, timeRange.end);
   }
+  cachedVisibleRange = timeRange;
+  visibleRangeCached = true;
   return timeRange;
 }
 
@@ -101,6 +101,19 @@ void PAGLayer::setAlpha(float alpha) {
   notifyModified();
 }
 
+void PAGLayer::setTransformOverride(const Matrix& matrix, float alpha) {
+  LockGuard autoLock(rootLocker);
+  LayerCache::Get(layer)->setTransformOverride(ToTGFX(matrix), alpha);
+  // 覆盖值不触碰任何缓存，只递增父链的内容版本号，让下一次 flush 重绘这一帧。
+  notifyModified();
+}
+
+void PAGLayer::clearTransformOverride() {
+  LockGuard autoLock(rootLocker);
+  LayerCache::Get(layer)->clearTransformOverride();
+  notifyModified();
+}
+
 bool PAGLayer::visible() const {
   LockGuard autoLock(rootLocker);
   return layerVisible;
@@ -117,6 +130,7 @@ void PAGLayer::setVisibleInternal(bool value) {
   }
   layerVisible = value;
   notifyModified();
+  notifyStructureModified();
 }
 
 Rect PAGLayer::getBounds() {
@@ -246,6 +260,7 @@ void PAGLayer::setStartTimeInternal(int64_t time) {
     _parent->updateDurationAndFrameRate();
   }
   gotoTimeAndNotifyChanged(FrameToTime(layerFrame, frameRateInternal()));
+  notifyStructureModified();
   onTimelineChanged();
 }
 
@@ -399,6 +414,7 @@ bool PAGLayer::setTrackMatte(std::shared_ptr<PAGLayer> matteLayer, TrackMatteTyp
     }
     detachTrackMatteInternal();
     notifyModified(true);
+    notifyStructureModified();
     invalidateCacheScale();
     return true;
   }
@@ -425,6 +441,7 @@ bool PAGLayer::setTrackMatte(std::shared_ptr<PAGLayer> matteLayer, TrackMatteTyp
   layer->trackMatteLayer = matteLayer->layer;
   layer->trackMatteType = type;
   notifyModified(true);
+  notifyStructureModified();
   invalidateCacheScale();
   return true;
 }
@@ -453,7 +470,11 @@ bool PAGLayer::excludedFromTimeline() const {
 
 void PAGLayer::setExcludedFromTimeline(bool value) {
   LockGuard autoLock(rootLocker);
+  if (_excludedFromTimeline == value) {
+    return;
+  }
   _excludedFromTimeline = value;
+  notifyStructureModified();
 }
 
 void PAGLayer::notifyModified(bool contentChanged) {
@@ -467,6 +488,17 @@ void PAGLayer::notifyModified(bool contentChanged) {
   }
 }
 
+void PAGLayer::notifyStructureModified() {
+  // 结构版本只在图层树形态或时间线排布发生变化时递增，PAGStage 以它为依据决定是否重建
+  // layerStartTimeMap，纯内容或变换修改就不再触发整树遍历。
+  structureVersion++;
+  auto parentLayer = getParentOrOwner();
+  while (parentLayer) {
+    parentLayer->structureVersion++;
+    parentLayer = parentLayer->getParentOrOwner();
+  }
+}
+
 void PAGLayer::notifyAudioModified() {
   audioVersion++;
   auto parentLayer = getParentOrOwner();
@@ -521,6 +553,13 @@ void PAGLayer::draw(Recorder* recorder) {
 }
 
 void PAGLayer::measureBounds(tgfx::Rect* bounds) {
+  if (!contentModified()) {
+    Rect cachedBounds = {};
+    if (layer->getCachedBounds(contentFrame, &cachedBounds)) {
+      *bounds = *ToTGFX(&cachedBounds);
+      return;
+    }
+  }
   getContent()->measureBounds(bounds);
 }
 
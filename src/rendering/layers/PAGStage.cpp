@@ -20,6 +20,7 @@
 #include <algorithm>
 #include "base/utils/MatrixUtil.h"
 #include "base/utils/TimeUtil.h"
+#include "platform/Platform.h"
 #include "rendering/caches/LayerCache.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/editing/ImageReplacement.h"
@@ -215,10 +216,12 @@ std::map<int64_t, std::vector<PAGLayer*>> PAGStage::findNearlyVisibleLayersIn(
   auto globalFrameRate = frameRateInternal();
   auto globalFrame = root->localFrameToGlobal(root->currentFrameInternal());
   auto globalCurrent = FrameToTime(globalFrame, globalFrameRate);
-  if (rootVersion != root->contentVersion) {
+  // 起始时间索引只依赖图层树的结构和时间线排布，以 structureVersion 为准重建，内容和变换
+  // 修改（例如编辑器里的逐键文本输入）不再触发整树遍历。
+  if (rootVersion != root->structureVersion) {
     layerStartTimeMap = {};
     updateLayerStartTime(root.get());
-    rootVersion = root->contentVersion;
+    rootVersion = root->structureVersion;
   }
   for (auto& item : layerStartTimeMap) {
     auto visibleStart = item.second;
@@ -332,6 +335,55 @@ std::optional<std::pair<float, float>> PAGStage::calcScaleFactor(ID referenceID)
   return result;
 }
 
+std::string PAGStage::getDiskCacheKey(ID assetID) {
+  auto reference = layerReferenceMap.find(assetID);
+  if (reference == layerReferenceMap.end() || reference->second.empty()) {
+    return "";
+  }
+  auto pagLayer = reference->second.front();
+  if (pagLayer->layer == nullptr || pagLayer->layer->uniqueID != assetID) {
+    // Only layer contents are cached to the disk, compositions are skipped.
+    return "";
+  }
+  for (auto& item : reference->second) {
+    if (item->contentModified()) {
+      // The cached pixels would no longer match the edited content in the next launch.
+      return "";
+    }
+  }
+  auto file = pagLayer->getFile();
+  if (file == nullptr) {
+    return "";
+  }
+  auto cachePath = Platform::Current()->getSandboxPath(file->path);
+  if (cachePath.empty()) {
+    return "";
+  }
+  return cachePath + ".snapshot." + std::to_string(pagLayer->layer->id);
+}
+
+CachePolicy PAGStage::getAssetCachePolicy(ID assetID) {
+  auto reference = layerReferenceMap.find(assetID);
+  if (reference == layerReferenceMap.end()) {
+    return CachePolicy::Auto;
+  }
+  auto policy = CachePolicy::Auto;
+  for (auto& pagLayer : reference->second) {
+    if (pagLayer->layer == nullptr) {
+      continue;
+    }
+    auto layerPolicy = pagLayer->layer->cachePolicy;
+    if (layerPolicy == CachePolicy::Enable) {
+      // 任何一处引用标记了常驻缓存，就按常驻处理。
+      return CachePolicy::Enable;
+    }
+    if (layerPolicy == CachePolicy::Disable) {
+      policy = CachePolicy::Disable;
+    }
+  }
+  return policy;
+}
+
 tgfx::Point PAGStage::GetLayerContentScaleFactor(PAGLayer* pagLayer, bool isPAGImage) {
   tgfx::Point scale = {1, 1};
   if (pagLayer->layerType() == LayerType::Image) {
@@ -98,6 +98,30 @@ class PAGStage : public PAGComposition {
 
   float getAssetMinScale(ID assetID);
 
+  /**
+   * Returns a disk cache key for the specified asset which stays stable across processes, or an
+   * empty string if the asset is not an unmodified layer loaded from a pag file on disk.
+   */
+  std::string getDiskCacheKey(ID assetID);
+
+  /**
+   * Returns the authored cache policy for the specified asset, folded over all layers that
+   * reference it: Enable wins over Disable, and both win over Auto.
+   */
+  CachePolicy getAssetCachePolicy(ID assetID);
+
+  /**
+   * The active frame profiler of the owning PAGPlayer, or nullptr when profiling is disabled.
+   * Layers reach it through the stage while recording their contents.
+   */
+  FrameProfiler* profiler = nullptr;
+
+  /**
+   * The active replay capture of the owning PAGPlayer, or nullptr when capturing is disabled.
+   * PAGFile reaches it through the stage to record replacements.
+   */
+  ReplayCapture* replayCapture = nullptr;
+
  protected:
   void invalidateCacheScale() override {
     PAGComposition::invalidateCacheScale();
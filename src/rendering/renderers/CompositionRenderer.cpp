@@ -39,17 +39,27 @@ std::shared_ptr<Graphic> RenderVectorComposition(VectorComposition* composition,
       continue;
     }
     auto layerCache = LayerCache::Get(childLayer);
-    auto filterModifier =
-        layerCache->cacheFilters() ? nullptr : FilterModifier::Make(childLayer, compositionFrame);
-    auto trackMatte = TrackMatteRenderer::Make(childLayer, compositionFrame);
-    LayerRenderer::DrawLayer(&recorder, childLayer, compositionFrame, filterModifier,
-                             trackMatte.get());
+    auto contentFrame = compositionFrame - childLayer->startTime;
+    // 整层的合成结果（内容、变换、遮罩、轨道蒙版、滤镜）在图层的静态区间内逐帧相同，相邻的
+    // 缓存帧直接引用共享同一棵子树，长合成的缓存内存只随动态部分增长。
+    auto graphic = layerCache->getComposedGraphic(contentFrame);
+    if (graphic == nullptr) {
+      auto filterModifier =
+          layerCache->cacheFilters() ? nullptr : FilterModifier::Make(childLayer, compositionFrame);
+      auto trackMatte = TrackMatteRenderer::Make(childLayer, compositionFrame);
+      Recorder layerRecorder = {};
+      LayerRenderer::DrawLayer(&layerRecorder, childLayer, compositionFrame, filterModifier,
+                               trackMatte.get());
+      graphic = layerRecorder.makeGraphic();
+      layerCache->cacheComposedGraphic(contentFrame, graphic);
+    }
+    recorder.drawGraphic(graphic);
   }
   recorder.restore();
   auto graphic = recorder.makeGraphic();
   if (layers.size() > 1 && composition->staticContent() && !composition->hasImageContent()) {
     // 仅当子项列表只存在矢量内容并图层数量大于 1 时才包装一个 Image，避免重复的 Image 包装。
-    graphic = Picture::MakeFrom(composition->uniqueID, graphic);
+    graphic = Picture::MakeFrom(composition->uniqueID, graphic, true);
   }
   return graphic;
 }
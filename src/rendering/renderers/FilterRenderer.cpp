@@ -35,6 +35,8 @@
 #include "rendering/filters/gaussianblur/GaussianBlurFilter.h"
 #include "rendering/filters/glow/GlowFilter.h"
 #include "rendering/filters/utils/Filter3DFactory.h"
+#include "rendering/utils/FrameProfiler.h"
+#include "rendering/utils/GpuPassTimer.h"
 #include "tgfx/core/Recorder.h"
 
 namespace pag {
@@ -172,6 +174,7 @@ tgfx::Rect GetClipBounds(Canvas* canvas, const FilterList* filterList,
 
 static std::shared_ptr<tgfx::Image> ApplyMotionBlur(std::shared_ptr<tgfx::Image> input,
                                                     const FilterList* filterList,
+                                                    RenderCache* cache,
                                                     const tgfx::Rect& clipBounds,
                                                     tgfx::Rect* filterBounds, tgfx::Point* offset) {
   offset->set(0, 0);
@@ -186,7 +189,7 @@ static std::shared_ptr<tgfx::Image> ApplyMotionBlur(std::shared_ptr<tgfx::Image>
       return nullptr;
     }
     return MotionBlurFilter::Apply(input, filterList->layer, filterList->layerFrame, oldBounds,
-                                   offset);
+                                   cache, offset);
   }
   return input;
 }
@@ -210,7 +213,7 @@ std::shared_ptr<tgfx::Image> ApplyFilter(std::shared_ptr<tgfx::Image> input, Eff
       return LevelsIndividualFilter::Apply(std::move(input), effect, layerFrame, offset);
     case EffectType::FastBlur:
       return GaussianBlurFilter::Apply(std::move(input), effect, layerFrame, effectScale,
-                                       sourceScale, offset);
+                                       sourceScale, cache, offset);
     case EffectType::DisplacementMap:
       return DisplacementMapFilter::Apply(std::move(input), effect, layer, cache, layerMatrix,
                                           layerFrame, filterBounds, offset);
@@ -308,7 +311,7 @@ std::shared_ptr<tgfx::Image> FilterRenderer::ApplyFilters(
   }
   *outputOffset += offset;
 
-  output = ApplyMotionBlur(output, filterList, clipBounds, &filterBounds, &offset);
+  output = ApplyMotionBlur(output, filterList, cache, clipBounds, &filterBounds, &offset);
   if (!output) {
     return input;
   }
@@ -361,12 +364,25 @@ void FilterRenderer::DrawWithFilter(Canvas* parentCanvas, const FilterModifier*
                                     std::shared_ptr<Graphic> content) {
   auto cache = parentCanvas->getCache();
   auto filterList = MakeFilterList(modifier);
+  std::string profileName = {};
+  if (cache->profiler != nullptr) {
+    auto& layerName = filterList->layer->name;
+    profileName = "filters: " + (layerName.empty() ? "layer#" + std::to_string(filterList->layer->id)
+                                                   : layerName);
+  }
+  ProfileScope profileScope(cache->profiler, std::move(profileName));
+  GpuPassTimer gpuPassTimer(cache->profiler, cache->getContext());
   auto contentBounds = GetContentBounds(filterList.get(), content);
   // 相对于content Bounds的clip Bounds
   auto clipBounds = GetClipBounds(parentCanvas, filterList.get(), contentBounds);
 
   auto contentScale = GetContentScale(parentCanvas, filterList->scaleFactorLimit,
                                       GetScaleFactor(filterList.get(), contentBounds));
+  if (cache->effectiveRenderQuality() == PAGRenderQuality::PowerSaving) {
+    // 省电模式或帧预算用尽时滤镜通路按半分辨率生成，离屏表面的像素量和滤镜着色器的执行次数都
+    // 降为四分之一，结果经现有的缩放矩阵放大回原尺寸。
+    contentScale *= 0.5f;
+  }
 
   int clipStartIndex = GetClipStartIndex(filterList->effects);
   bool skipClipBounds = NeedToSkipClipBounds(filterList.get());
@@ -422,4 +438,51 @@ void FilterRenderer::DrawWithFilter(Canvas* parentCanvas, const FilterModifier*
   }
   parentCanvas->restore();
 }
+
+#define WARM_UP_SOURCE_SIZE 16
+
+static std::shared_ptr<tgfx::Image> MakeWarmUpImage() {
+  tgfx::Recorder recorder;
+  auto canvas = recorder.beginRecording();
+  tgfx::Paint paint;
+  paint.setColor(tgfx::Color::White());
+  canvas->drawRect(tgfx::Rect::MakeWH(WARM_UP_SOURCE_SIZE, WARM_UP_SOURCE_SIZE), paint);
+  auto picture = recorder.finishRecordingAsPicture();
+  return tgfx::Image::MakeFrom(std::move(picture), WARM_UP_SOURCE_SIZE, WARM_UP_SOURCE_SIZE);
+}
+
+void FilterRenderer::PrepareFilters(RenderCache* cache, Layer* layer, Frame layerFrame) {
+  auto surface = cache->getOffscreenSurface(WARM_UP_SOURCE_SIZE, WARM_UP_SOURCE_SIZE);
+  if (surface == nullptr) {
+    return;
+  }
+  Canvas canvas(surface.get(), cache);
+  auto warmUpBounds = tgfx::Rect::MakeWH(WARM_UP_SOURCE_SIZE, WARM_UP_SOURCE_SIZE);
+  tgfx::Point unitScale = {1.0f, 1.0f};
+  // 用真实的滤镜参数对一张小的占位图完整跑一遍滤镜链，效果参数不影响着色器的编译结果，
+  // 图层正式上屏时直接命中已经编译好的程序。
+  for (auto& effect : layer->effects) {
+    auto input = MakeWarmUpImage();
+    tgfx::Point offset = {};
+    auto output = ApplyFilter(input, effect, layer, cache, tgfx::Matrix::I(), layerFrame,
+                              warmUpBounds, unitScale, unitScale, &offset);
+    if (output != nullptr && output != input) {
+      canvas.drawImage(std::move(output));
+    }
+  }
+  if (layer->motionBlur && !layer->transform3D) {
+    auto input = MakeWarmUpImage();
+    tgfx::Point offset = {};
+    auto output = MotionBlurFilter::Apply(input, layer, layerFrame, warmUpBounds, cache, &offset);
+    if (output != nullptr && output != input) {
+      canvas.drawImage(std::move(output));
+    }
+  }
+  if (!layer->layerStyles.empty()) {
+    auto filter = LayerStylesFilter::Make(layer->layerStyles, layerFrame, 1.0f, unitScale);
+    if (filter != nullptr) {
+      filter->applyFilter(&canvas, MakeWarmUpImage());
+    }
+  }
+}
 }  // namespace pag
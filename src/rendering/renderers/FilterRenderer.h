@@ -42,6 +42,12 @@ class FilterRenderer {
  public:
   static void MeasureFilterBounds(tgfx::Rect* bounds, const FilterModifier* modifier);
 
+  /**
+   * Runs the layer's filter passes on a small placeholder image while the GPU context is current,
+   * so that shader programs and pipeline state are created before the layer first draws on screen.
+   */
+  static void PrepareFilters(RenderCache* cache, Layer* layer, Frame layerFrame);
+
   static void DrawWithFilter(Canvas* parentCanvas, const FilterModifier* modifier,
                              std::shared_ptr<Graphic> content);
 
@@ -116,9 +116,14 @@ void LayerRenderer::MeasureLayerBounds(tgfx::Rect* bounds, Layer* layer, Frame l
   if (!layerCache->contentVisible(contentFrame)) {
     return;
   }
-  auto content = layerContent ? layerContent : layerCache->getContent(contentFrame);
   auto masks = layerCache->getMasks(contentFrame);
-  content->measureBounds(bounds);
+  Rect cachedBounds = {};
+  if (layerContent == nullptr && layer->getCachedBounds(contentFrame, &cachedBounds)) {
+    *bounds = *ToTGFX(&cachedBounds);
+  } else {
+    auto content = layerContent ? layerContent : layerCache->getContent(contentFrame);
+    content->measureBounds(bounds);
+  }
   if (masks) {
     ApplyClipToBounds(*masks, bounds);
   }
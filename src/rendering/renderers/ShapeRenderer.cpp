@@ -23,13 +23,14 @@
 #include "base/utils/EnumClassHash.h"
 #include "base/utils/Interpolate.h"
 #include "base/utils/MathUtil.h"
+#include "base/utils/PropertyBatch.h"
 #include "base/utils/TGFXCast.h"
 #include "rendering/graphics/GradientPaint.h"
 #include "rendering/graphics/Graphic.h"
 #include "rendering/graphics/Shape.h"
+#include "rendering/utils/PathMeasureCache.h"
 #include "rendering/utils/PathUtil.h"
 #include "tgfx/core/PathEffect.h"
-#include "tgfx/core/PathMeasure.h"
 
 namespace pag {
 
@@ -80,6 +81,8 @@ class PaintElement : public ElementData {
     newPaint->stroke = stroke;
     newPaint->pathFillType = pathFillType;
     newPaint->compositeOrder = compositeOrder;
+    newPaint->source = source;
+    newPaint->sourceMatrix = sourceMatrix;
     return std::unique_ptr<ElementData>(newPaint);
   }
 
@@ -98,6 +101,10 @@ class PaintElement : public ElementData {
   tgfx::Color color = tgfx::Color::White();
   GradientPaint gradient;
   StrokePaint stroke;
+  // The model element this paint was baked from, set only when the tree belongs to a
+  // ShapeGeometry so the paint values can be refreshed per frame.
+  ShapeElement* source = nullptr;
+  tgfx::Matrix sourceMatrix = tgfx::Matrix::I();
 };
 
 class PathElement : public ElementData {
@@ -135,6 +142,7 @@ class GroupElement : public ElementData {
     auto newGroup = new GroupElement();
     newGroup->blendMode = blendMode;
     newGroup->alpha = alpha;
+    newGroup->source = source;
     for (auto& data : elements) {
       auto element = data->clone().release();
       newGroup->elements.push_back(element);
@@ -177,6 +185,9 @@ class GroupElement : public ElementData {
 
   tgfx::BlendMode blendMode = tgfx::BlendMode::SrcOver;
   float alpha = 1.0f;
+  // The model element this group was baked from, set only when the tree belongs to a
+  // ShapeGeometry so the group alpha can be refreshed per frame.
+  ShapeGroupElement* source = nullptr;
   std::vector<ElementData*> elements;
 };
 
@@ -316,13 +327,18 @@ static void ConvertPolygonToPath(tgfx::Path* path, float centerX, float centerY,
 }
 
 void PolyStarToPath(PolyStarElement* polyStar, tgfx::Path* path, Frame frame) {
-  auto points = polyStar->points->getValueAt(frame);
+  Property<float>* scalarProperties[] = {polyStar->points,         polyStar->rotation,
+                                         polyStar->innerRadius,    polyStar->outerRadius,
+                                         polyStar->innerRoundness, polyStar->outerRoundness};
+  float scalarValues[6] = {};
+  EvaluateProperties(scalarProperties, 6, frame, scalarValues);
+  auto points = scalarValues[0];
+  auto rotation = scalarValues[1];
+  auto innerRadius = scalarValues[2];
+  auto outerRadius = scalarValues[3];
+  auto innerRoundness = scalarValues[4];
+  auto outerRoundness = scalarValues[5];
   auto position = polyStar->position->getValueAt(frame);
-  auto rotation = polyStar->rotation->getValueAt(frame);
-  auto innerRadius = polyStar->innerRadius->getValueAt(frame);
-  auto outerRadius = polyStar->outerRadius->getValueAt(frame);
-  auto innerRoundness = polyStar->innerRoundness->getValueAt(frame);
-  auto outerRoundness = polyStar->outerRoundness->getValueAt(frame);
   if (polyStar->polyType == PolyStarType::Star) {
     ConvertPolyStarToPath(path, position.x, position.y, points, rotation, innerRadius, outerRadius,
                           innerRoundness, outerRoundness, polyStar->reversed);
@@ -431,9 +447,10 @@ struct TrimSegment {
 void ApplyTrimPathIndividually(const std::vector<tgfx::Path*>& pathList,
                                std::vector<TrimSegment> segments) {
   float totalLength = 0;
-  std::vector<std::unique_ptr<tgfx::PathMeasure>> measureList;
+  // 仅有 Trim 动画时路径几何逐帧不变，长度参数化结构从缓存复用，不再每帧重建。
+  std::vector<std::shared_ptr<MeasuredPath>> measureList;
   for (auto& path : pathList) {
-    auto pathMeasure = tgfx::PathMeasure::MakeFrom(*path);
+    auto pathMeasure = PathMeasureCache::Get(*path);
     totalLength += pathMeasure->getLength();
     measureList.push_back(std::move(pathMeasure));
   }
@@ -489,7 +506,7 @@ void ApplyTrimPaths(TrimPathsElement* trimPaths, std::vector<tgfx::Path*>& pathL
   if (trimPaths->trimType == TrimPathsType::Simultaneously) {
     tgfx::Path tempPath = {};
     for (auto& path : pathList) {
-      auto pathMeasure = tgfx::PathMeasure::MakeFrom(*path);
+      auto pathMeasure = PathMeasureCache::Get(*path);
       auto length = pathMeasure->getLength();
       if (length == 0) {
         continue;
@@ -850,9 +867,17 @@ void ApplyStrokeToPath(tgfx::Path* path, const StrokePaint& stroke) {
 }
 
 std::shared_ptr<Graphic> RenderShape(ID assetID, PaintElement* paint, tgfx::Path* path) {
+  if (paint->alpha <= 0) {
+    // Only possible for a baked paint that is invisible at the current frame; the direct path
+    // never creates a paint with zero opacity.
+    return nullptr;
+  }
   tgfx::Path shapePath = *path;
   auto paintType = paint->paintType;
   if (paintType == PaintType::Stroke || paintType == PaintType::GradientStroke) {
+    if (paint->stroke.strokeWidth <= 0) {
+      return nullptr;
+    }
     ApplyStrokeToPath(&shapePath, paint->stroke);
   } else if (shapePath.isLine()) {
     return nullptr;
@@ -870,6 +895,25 @@ std::shared_ptr<Graphic> RenderShape(ID assetID, PaintElement* paint, tgfx::Path
   return Graphic::MakeCompose(shape, modifier);
 }
 
+// 按绘制顺序把相邻且画法完全相同的实色形状合并成一条路径，一次 drawPath 就能画完。大量
+// 零散的小图形（例如几百个实色碎片的模板）原来逐个绘制的开销主要在这里省掉。
+static void AddShapeContent(std::vector<std::shared_ptr<Graphic>>* contents,
+                            std::shared_ptr<Graphic> shape, bool above) {
+  if (!contents->empty()) {
+    auto& neighbor = above ? contents->back() : contents->front();
+    auto merged = above ? Shape::TryMerge(neighbor, shape) : Shape::TryMerge(shape, neighbor);
+    if (merged) {
+      neighbor = merged;
+      return;
+    }
+  }
+  if (above) {
+    contents->push_back(shape);
+  } else {
+    contents->insert(contents->begin(), shape);
+  }
+}
+
 std::shared_ptr<Graphic> RenderShape(ID assetID, GroupElement* group, tgfx::Path* path) {
   std::vector<std::shared_ptr<Graphic>> contents = {};
   for (auto& element : group->elements) {
@@ -882,11 +926,8 @@ std::shared_ptr<Graphic> RenderShape(ID assetID, GroupElement* group, tgfx::Path
         auto paint = reinterpret_cast<PaintElement*>(element);
         auto shape = RenderShape(assetID, paint, path);
         if (shape) {
-          if (paint->compositeOrder == CompositeOrder::AbovePreviousInSameGroup) {
-            contents.push_back(shape);
-          } else {
-            contents.insert(contents.begin(), shape);
-          }
+          AddShapeContent(&contents, shape,
+                          paint->compositeOrder == CompositeOrder::AbovePreviousInSameGroup);
         }
       } break;
       case ElementDataType::Group: {
@@ -894,7 +935,7 @@ std::shared_ptr<Graphic> RenderShape(ID assetID, GroupElement* group, tgfx::Path
         auto shape = RenderShape(assetID, static_cast<GroupElement*>(element), &tempPath);
         path->addPath(tempPath);
         if (shape) {
-          contents.insert(contents.begin(), shape);
+          AddShapeContent(&contents, shape, false);
         }
       } break;
     }
@@ -912,4 +953,169 @@ std::shared_ptr<Graphic> RenderShapes(ID assetID, const std::vector<ShapeElement
   tgfx::Path tempPath = {};
   return RenderShape(assetID, &rootGroup, &tempPath);
 }
+
+class ShapeGeometry {
+ public:
+  GroupElement rootGroup;
+};
+
+static PaintElement* MakePaintElement(ShapeElement* element, const tgfx::Matrix& parentMatrix,
+                                      Frame frame) {
+  switch (element->type()) {
+    case ShapeType::Fill:
+      return FillToPaint(static_cast<FillElement*>(element), frame);
+    case ShapeType::Stroke:
+      return StrokeToPaint(static_cast<StrokeElement*>(element), parentMatrix, frame);
+    case ShapeType::GradientFill:
+      return GradientFillToPaint(static_cast<GradientFillElement*>(element), parentMatrix, frame);
+    case ShapeType::GradientStroke:
+      return GradientStrokeToPaint(static_cast<GradientStrokeElement*>(element), parentMatrix,
+                                   frame);
+    default:
+      return nullptr;
+  }
+}
+
+static PaintType ToPaintType(ShapeType shapeType) {
+  switch (shapeType) {
+    case ShapeType::Stroke:
+      return PaintType::Stroke;
+    case ShapeType::GradientFill:
+      return PaintType::GradientFill;
+    case ShapeType::GradientStroke:
+      return PaintType::GradientStroke;
+    default:
+      return PaintType::Fill;
+  }
+}
+
+static void BakeElements(const std::vector<ShapeElement*>& list, const tgfx::Matrix& parentMatrix,
+                         GroupElement* parentGroup, Frame frame) {
+  for (auto& element : list) {
+    switch (element->type()) {
+      case ShapeType::ShapeGroup: {
+        auto shape = reinterpret_cast<ShapeGroupElement*>(element);
+        auto transform = ShapeTransformToTransform(shape->transform, frame);
+        transform.matrix.postConcat(parentMatrix);
+        auto group = new GroupElement();
+        group->source = shape;
+        group->alpha = transform.alpha;
+        group->blendMode = ToTGFX(shape->blendMode);
+        BakeElements(shape->elements, transform.matrix, group, frame);
+        parentGroup->elements.push_back(group);
+        break;
+      }
+      case ShapeType::Fill:
+      case ShapeType::Stroke:
+      case ShapeType::GradientFill:
+      case ShapeType::GradientStroke: {
+        auto paint = MakePaintElement(element, parentMatrix, frame);
+        if (paint == nullptr) {
+          // The paint is invisible at this frame. Keep a zero-alpha placeholder so
+          // UpdateBakedPaints() can bring it back when its opacity animates in.
+          paint = new PaintElement(ToPaintType(element->type()));
+          paint->alpha = 0.0f;
+        }
+        paint->source = element;
+        paint->sourceMatrix = parentMatrix;
+        parentGroup->elements.push_back(paint);
+        break;
+      }
+      default: {
+        auto iter = elementHandlers.find(element->type());
+        if (iter != elementHandlers.end()) {
+          iter->second(element, parentMatrix, parentGroup, frame);
+        }
+        break;
+      }
+    }
+  }
+}
+
+static void UpdateBakedPaints(GroupElement* group, Frame frame) {
+  if (group->source != nullptr) {
+    group->alpha = ToAlpha(group->source->transform->opacity->getValueAt(frame));
+  }
+  for (auto& element : group->elements) {
+    if (element->type() == ElementDataType::Group) {
+      UpdateBakedPaints(reinterpret_cast<GroupElement*>(element), frame);
+      continue;
+    }
+    if (element->type() != ElementDataType::Paint) {
+      continue;
+    }
+    auto paint = reinterpret_cast<PaintElement*>(element);
+    if (paint->source == nullptr) {
+      continue;
+    }
+    auto newPaint = MakePaintElement(paint->source, paint->sourceMatrix, frame);
+    if (newPaint == nullptr) {
+      paint->alpha = 0.0f;
+      continue;
+    }
+    newPaint->source = paint->source;
+    newPaint->sourceMatrix = paint->sourceMatrix;
+    *paint = *newPaint;
+    delete newPaint;
+  }
+}
+
+std::shared_ptr<Graphic> RenderShapes(ID assetID, ShapeGeometry* geometry, Frame layerFrame) {
+  UpdateBakedPaints(&geometry->rootGroup, layerFrame);
+  tgfx::Path tempPath = {};
+  return RenderShape(assetID, &geometry->rootGroup, &tempPath);
+}
+
+std::shared_ptr<ShapeGeometry> MakeShapeGeometry(const std::vector<ShapeElement*>& contents,
+                                                 Frame layerFrame) {
+  auto geometry = std::make_shared<ShapeGeometry>();
+  auto matrix = tgfx::Matrix::I();
+  BakeElements(contents, matrix, &geometry->rootGroup, layerFrame);
+  return geometry;
+}
+
+bool ShapeGeometryCacheable(const std::vector<ShapeElement*>& contents) {
+  for (auto& element : contents) {
+    if (element->type() == ShapeType::Repeater) {
+      // A repeater clones the baked paints with per-copy matrices and alpha, which cannot be
+      // refreshed from the model afterwards.
+      return false;
+    }
+    if (element->type() == ShapeType::ShapeGroup &&
+        !ShapeGeometryCacheable(reinterpret_cast<ShapeGroupElement*>(element)->elements)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ExcludeGeometryVaryingRanges(const std::vector<ShapeElement*>& contents,
+                                  std::vector<TimeRange>* timeRanges) {
+  for (auto& element : contents) {
+    switch (element->type()) {
+      case ShapeType::Fill:
+      case ShapeType::Stroke:
+      case ShapeType::GradientFill:
+      case ShapeType::GradientStroke:
+        // Paint animation does not invalidate the baked geometry, the paints are refreshed on
+        // every frame.
+        break;
+      case ShapeType::ShapeGroup: {
+        auto shape = reinterpret_cast<ShapeGroupElement*>(element);
+        auto transform = shape->transform;
+        transform->anchorPoint->excludeVaryingRanges(timeRanges);
+        transform->position->excludeVaryingRanges(timeRanges);
+        transform->scale->excludeVaryingRanges(timeRanges);
+        transform->skew->excludeVaryingRanges(timeRanges);
+        transform->skewAxis->excludeVaryingRanges(timeRanges);
+        transform->rotation->excludeVaryingRanges(timeRanges);
+        ExcludeGeometryVaryingRanges(shape->elements, timeRanges);
+        break;
+      }
+      default:
+        element->excludeVaryingRanges(timeRanges);
+        break;
+    }
+  }
+}
 }  // namespace pag
@@ -23,6 +23,40 @@
 #include "rendering/utils/Transform.h"
 
 namespace pag {
+/**
+ * A shape element tree with its path geometry baked into tgfx paths, created by
+ * MakeShapeGeometry(). When the geometry of a shape layer is frame-invariant the baked tree can be
+ * rendered repeatedly with only the paints refreshed per frame.
+ */
+class ShapeGeometry;
+
 std::shared_ptr<Graphic> RenderShapes(ID assetID, const std::vector<ShapeElement*>& contents,
                                       Frame layerFrame);
+
+/**
+ * Renders a baked shape geometry at the specified frame, refreshing only the paint values from
+ * the model.
+ */
+std::shared_ptr<Graphic> RenderShapes(ID assetID, ShapeGeometry* geometry, Frame layerFrame);
+
+/**
+ * Creates a baked shape geometry from the specified shape elements. The path data is baked at
+ * layerFrame, so only call this when the geometry is frame-invariant.
+ */
+std::shared_ptr<ShapeGeometry> MakeShapeGeometry(const std::vector<ShapeElement*>& contents,
+                                                 Frame layerFrame);
+
+/**
+ * Returns false if the specified shape elements contain a repeater, whose baked copies cannot be
+ * refreshed from the model afterwards.
+ */
+bool ShapeGeometryCacheable(const std::vector<ShapeElement*>& contents);
+
+/**
+ * Removes the time ranges from timeRanges where the path geometry of the specified shape elements
+ * is varying. Paint animation is not excluded, since paints are refreshed on every frame when
+ * rendering a baked geometry.
+ */
+void ExcludeGeometryVaryingRanges(const std::vector<ShapeElement*>& contents,
+                                  std::vector<TimeRange>* timeRanges);
 }
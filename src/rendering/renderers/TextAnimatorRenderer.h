@@ -42,8 +42,10 @@ class TextAnimatorRenderer {
  private:
   // 应用文本动画
   void apply(std::vector<std::vector<GlyphHandle>>& glyphList);
+  // 一次性计算所有字符的范围因子
+  const std::vector<float>& calculateFactors(size_t count);
   // 计算一行的字间距总长度
-  float calculateTrackingLen(size_t textStart, size_t textEnd);
+  float calculateTrackingLen(const std::vector<float>& factors, size_t textStart, size_t textEnd);
   // 根据字符序号计算该字符的范围因子
   float calculateFactorByIndex(size_t index, bool* pBiasFlag);
   // 读取字间距信息
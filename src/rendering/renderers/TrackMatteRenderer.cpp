@@ -65,6 +65,20 @@ static std::shared_ptr<Modifier> MakeMaskModifier(std::shared_ptr<Graphic> conte
   return Modifier::MakeMask(std::move(content), inverted, useLuma);
 }
 
+bool TrackMatteRenderer::MatteContentValid(PAGLayer* trackMatteLayer) {
+  if (trackMatteLayer->trackMatteContentFrame < 0 ||
+      trackMatteLayer->trackMatteContentVersion != trackMatteLayer->contentVersion) {
+    return false;
+  }
+  if (!(trackMatteLayer->trackMatteContentMatrix == trackMatteLayer->layerMatrix) ||
+      trackMatteLayer->trackMatteContentAlpha != trackMatteLayer->layerAlpha) {
+    return false;
+  }
+  auto layerCache = LayerCache::Get(trackMatteLayer->layer);
+  return !layerCache->checkFrameChanged(trackMatteLayer->contentFrame,
+                                        trackMatteLayer->trackMatteContentFrame);
+}
+
 std::unique_ptr<TrackMatte> TrackMatteRenderer::Make(PAGLayer* trackMatteOwner) {
   if (trackMatteOwner == nullptr || trackMatteOwner->_trackMatteLayer == nullptr) {
     return nullptr;
@@ -72,25 +86,45 @@ std::unique_ptr<TrackMatte> TrackMatteRenderer::Make(PAGLayer* trackMatteOwner)
   auto trackMatteLayer = trackMatteOwner->_trackMatteLayer.get();
   auto trackMatteType = trackMatteOwner->layer->trackMatteType;
   auto layerFrame = trackMatteLayer->contentFrame + trackMatteLayer->layer->startTime;
-  std::shared_ptr<FilterModifier> filterModifier = nullptr;
-  if (!trackMatteLayer->cacheFilters()) {
-    filterModifier = FilterModifier::Make(trackMatteLayer);
+  // Many mattes are static shapes applied to animated content; keep the composed matte and
+  // re-render it only when the matte itself changes. Pre-compose mattes are excluded because
+  // their static time ranges cover the whole duration while the children animate.
+  auto cacheable = trackMatteLayer->layerType() != LayerType::PreCompose;
+  std::shared_ptr<Graphic> content = nullptr;
+  std::shared_ptr<Graphic> colorGlyphs = nullptr;
+  if (cacheable && MatteContentValid(trackMatteLayer)) {
+    content = trackMatteLayer->trackMatteContent;
+    colorGlyphs = trackMatteLayer->trackMatteColorGlyphs;
+  } else {
+    std::shared_ptr<FilterModifier> filterModifier = nullptr;
+    if (!trackMatteLayer->cacheFilters()) {
+      filterModifier = FilterModifier::Make(trackMatteLayer);
+    }
+    Recorder recorder = {};
+    Transform extraTransform = {ToTGFX(trackMatteLayer->layerMatrix), trackMatteLayer->layerAlpha};
+    LayerRenderer::DrawLayer(&recorder, trackMatteLayer->layer, layerFrame, filterModifier, nullptr,
+                             trackMatteLayer, &extraTransform);
+    content = recorder.makeGraphic();
+    if (trackMatteLayer->layerType() == LayerType::Text) {
+      auto textContent = static_cast<TextContent*>(trackMatteLayer->getContent());
+      colorGlyphs = RenderColorGlyphs(static_cast<TextLayer*>(trackMatteLayer->layer), layerFrame,
+                                      textContent, &extraTransform);
+    }
+    if (cacheable) {
+      trackMatteLayer->trackMatteContent = content;
+      trackMatteLayer->trackMatteColorGlyphs = colorGlyphs;
+      trackMatteLayer->trackMatteContentFrame = trackMatteLayer->contentFrame;
+      trackMatteLayer->trackMatteContentVersion = trackMatteLayer->contentVersion;
+      trackMatteLayer->trackMatteContentMatrix = trackMatteLayer->layerMatrix;
+      trackMatteLayer->trackMatteContentAlpha = trackMatteLayer->layerAlpha;
+    }
   }
-  Recorder recorder = {};
-  Transform extraTransform = {ToTGFX(trackMatteLayer->layerMatrix), trackMatteLayer->layerAlpha};
-  LayerRenderer::DrawLayer(&recorder, trackMatteLayer->layer, layerFrame, filterModifier, nullptr,
-                           trackMatteLayer, &extraTransform);
-  auto content = recorder.makeGraphic();
   auto trackMatte = std::make_unique<TrackMatte>();
   trackMatte->modifier = MakeMaskModifier(content, trackMatteType);
   if (trackMatte->modifier == nullptr) {
     return nullptr;
   }
-  if (trackMatteLayer->layerType() == LayerType::Text) {
-    auto textContent = static_cast<TextContent*>(trackMatteLayer->getContent());
-    trackMatte->colorGlyphs = RenderColorGlyphs(static_cast<TextLayer*>(trackMatteLayer->layer),
-                                                layerFrame, textContent, &extraTransform);
-  }
+  trackMatte->colorGlyphs = colorGlyphs;
   return trackMatte;
 }
 
@@ -39,5 +39,8 @@ class TrackMatteRenderer {
    * Returns nullptr if trackMatteLayer is nullptr.
    */
   static std::unique_ptr<TrackMatte> Make(Layer* trackMatteOwner, Frame layerFrame);
+
+ private:
+  static bool MatteContentValid(PAGLayer* trackMatteLayer);
 };
 }  // namespace pag
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "TransformRenderer.h"
+#include "base/utils/PropertyBatch.h"
 #include "base/utils/TGFXCast.h"
 
 namespace pag {
@@ -25,13 +26,19 @@ void RenderTransform(Transform* transform, Transform2D* transform2D, Frame layer
   auto anchorPoint = transform2D->anchorPoint->getValueAt(layerFrame);
   auto scale = transform2D->scale->getValueAt(layerFrame);
   Point position = {};
+  auto rotation = 0.0f;
   if (transform2D->position != nullptr) {
     position = transform2D->position->getValueAt(layerFrame);
+    rotation = transform2D->rotation->getValueAt(layerFrame);
   } else {
-    position.x = transform2D->xPosition->getValueAt(layerFrame);
-    position.y = transform2D->yPosition->getValueAt(layerFrame);
+    Property<float>* scalarProperties[] = {transform2D->rotation, transform2D->xPosition,
+                                           transform2D->yPosition};
+    float scalarValues[3] = {};
+    EvaluateProperties(scalarProperties, 3, layerFrame, scalarValues);
+    rotation = scalarValues[0];
+    position.x = scalarValues[1];
+    position.y = scalarValues[2];
   }
-  auto rotation = transform2D->rotation->getValueAt(layerFrame);
   transform->alpha = ToAlpha(transform2D->opacity->getValueAt(layerFrame));
   matrix.postTranslate(-anchorPoint.x, -anchorPoint.y);
   matrix.postScale(scale.x, scale.y);
@@ -17,9 +17,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "BitmapSequenceReader.h"
+#include <atomic>
 #include "tgfx/core/Buffer.h"
 #include "tgfx/core/ImageCodec.h"
 #include "tgfx/core/Pixmap.h"
+#include "tgfx/core/Task.h"
 
 namespace pag {
 BitmapSequenceReader::BitmapSequenceReader(std::shared_ptr<File> file, BitmapSequence* sequence)
@@ -53,8 +55,10 @@ std::shared_ptr<tgfx::ImageBuffer> BitmapSequenceReader::onMakeBuffer(Frame targ
   if (hardWareBuffer == nullptr && pixels == nullptr) {
     return nullptr;
   }
+  auto previousBuffer = imageBuffer;
   imageBuffer = nullptr;
   lastDecodeFrame = -1;
+  bool pixelsChanged = false;
   tgfx::Pixmap pixmap = {};
   if (hardWareBuffer) {
     auto hardwarePixels = tgfx::HardwareBufferLock(hardWareBuffer);
@@ -69,31 +73,65 @@ std::shared_ptr<tgfx::ImageBuffer> BitmapSequenceReader::onMakeBuffer(Frame targ
   auto& bitmapFrames = static_cast<BitmapSequence*>(sequence)->frames;
   for (Frame frame = startFrame; frame <= targetFrame; frame++) {
     auto bitmapFrame = bitmapFrames[frame];
-    auto firstRead = true;
+    std::vector<std::pair<BitmapRect*, std::shared_ptr<tgfx::ImageCodec>>> codecs = {};
     for (auto bitmapRect : bitmapFrame->bitmaps) {
       auto imageBytes = tgfx::Data::MakeWithoutCopy(bitmapRect->fileBytes->data(),
                                                     bitmapRect->fileBytes->length());
       auto codec = tgfx::ImageCodec::MakeFrom(imageBytes);
       // The returned image could be nullptr if the frame is an empty frame.
       if (codec != nullptr) {
-        if (firstRead && bitmapFrame->isKeyframe &&
-            !(codec->width() == pixmap.width() && codec->height() == pixmap.height())) {
-          // clear the whole screen if the size of the key frame is smaller than the screen.
-          pixmap.clear();
-        }
-        auto offset = pixmap.rowBytes() * bitmapRect->y + bitmapRect->x * 4;
-        auto result = codec->readPixels(
-            pixmap.info(), reinterpret_cast<uint8_t*>(pixmap.writablePixels()) + offset);
-        if (!result) {
-          tgfx::HardwareBufferUnlock(hardWareBuffer);
-          return nullptr;
-        }
-        firstRead = false;
+        codecs.emplace_back(bitmapRect, std::move(codec));
       }
     }
+    if (!codecs.empty() && bitmapFrame->isKeyframe &&
+        !(codecs.front().second->width() == pixmap.width() &&
+          codecs.front().second->height() == pixmap.height())) {
+      // clear the whole screen if the size of the key frame is smaller than the screen.
+      pixmap.clear();
+      pixelsChanged = true;
+    }
+    if (!codecs.empty()) {
+      pixelsChanged = true;
+    }
+    // 每个 BitmapRect 是一张独立的 webp，且覆盖互不重叠的脏区域，帧内可以并行解码，
+    // 第一张留在当前线程解码，避免只有一张时白等任务调度。
+    std::atomic_bool decodeFailed = {false};
+    auto decodeRect = [&pixmap, &decodeFailed](BitmapRect* bitmapRect,
+                                               std::shared_ptr<tgfx::ImageCodec> codec) {
+      auto offset = pixmap.rowBytes() * bitmapRect->y + bitmapRect->x * 4;
+      auto result = codec->readPixels(
+          pixmap.info(), reinterpret_cast<uint8_t*>(pixmap.writablePixels()) + offset);
+      if (!result) {
+        decodeFailed = true;
+      }
+    };
+    std::vector<std::shared_ptr<tgfx::Task>> decodeTasks = {};
+    for (size_t i = 1; i < codecs.size(); i++) {
+      auto& item = codecs[i];
+      decodeTasks.push_back(tgfx::Task::Run(
+          [&decodeRect, bitmapRect = item.first, codec = item.second]() mutable {
+            decodeRect(bitmapRect, std::move(codec));
+          }));
+    }
+    if (!codecs.empty()) {
+      decodeRect(codecs.front().first, codecs.front().second);
+    }
+    for (auto& task : decodeTasks) {
+      task->wait();
+    }
+    if (decodeFailed) {
+      tgfx::HardwareBufferUnlock(hardWareBuffer);
+      return nullptr;
+    }
   }
   if (hardWareBuffer) {
     tgfx::HardwareBufferUnlock(hardWareBuffer);
+  }
+  if (!pixelsChanged && previousBuffer != nullptr) {
+    // 跨度内的帧没有携带任何 BitmapRect，像素和上一次完全一致。复用之前的 ImageBuffer，
+    // 纹理缓存按同一个对象命中，静态区间的帧就不会触发任何重新上传。
+    imageBuffer = previousBuffer;
+  } else if (hardWareBuffer) {
     imageBuffer = tgfx::ImageBuffer::MakeFrom(hardWareBuffer);
   } else {
     imageBuffer = tgfx::ImageBuffer::MakeFrom(info, pixels);
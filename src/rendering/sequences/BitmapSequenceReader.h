@@ -38,6 +38,12 @@ class BitmapSequenceReader : public SequenceReader {
 
   ~BitmapSequenceReader() override;
 
+  bool asyncDecodingSupported() const override {
+    // onMakeBuffer() is mutex-guarded, but decoding ahead into a shared hardware buffer would
+    // overwrite pixels the rendering path may still be sampling, so only the raster path is safe.
+    return hardWareBuffer == nullptr;
+  }
+
  protected:
   std::shared_ptr<tgfx::ImageBuffer> onMakeBuffer(Frame targetFrame) override;
 
@@ -0,0 +1,68 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SequenceDecodeScheduler.h"
+#include <algorithm>
+#include "rendering/utils/RenderTaskScheduler.h"
+
+namespace pag {
+SequenceDecodeScheduler* SequenceDecodeScheduler::GetInstance() {
+  static auto& instance = *new SequenceDecodeScheduler();
+  return &instance;
+}
+
+void SequenceDecodeScheduler::schedule(std::shared_ptr<SequenceReader> reader, Frame targetFrame,
+                                       int64_t deadline) {
+  if (reader == nullptr || targetFrame < 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    for (auto& job : jobs) {
+      if (job.reader == reader && job.targetFrame == targetFrame) {
+        job.deadline = std::min(job.deadline, deadline);
+        return;
+      }
+    }
+    jobs.push_back({std::move(reader), targetFrame, deadline});
+  }
+  // A frame due within the next display refresh is decoding for visible content, anything
+  // further out is prefetching.
+  auto priority = deadline <= 1 ? TaskPriority::VisibleNow : TaskPriority::Prefetch;
+  RenderTaskScheduler::GetInstance()->submit([this] { decodeNextJob(); }, priority);
+}
+
+void SequenceDecodeScheduler::decodeNextJob() {
+  DecodeJob job = {};
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (jobs.empty()) {
+      return;
+    }
+    auto nearest = jobs.begin();
+    for (auto item = jobs.begin(); item != jobs.end(); ++item) {
+      if (item->deadline < nearest->deadline) {
+        nearest = item;
+      }
+    }
+    job = std::move(*nearest);
+    jobs.erase(nearest);
+  }
+  job.reader->readBuffer(job.targetFrame);
+}
+}  // namespace pag
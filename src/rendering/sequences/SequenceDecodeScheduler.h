@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include "SequenceReader.h"
+
+namespace pag {
+/**
+ * A process-wide scheduler which pre-decodes upcoming sequence frames on the shared
+ * RenderTaskScheduler pool, so multiple software video readers decode concurrently instead of
+ * serially on the rendering path. Jobs are ordered by their display deadline, giving the sequence
+ * nearest its deadline the next free worker.
+ */
+class SequenceDecodeScheduler {
+ public:
+  static SequenceDecodeScheduler* GetInstance();
+
+  /**
+   * Schedules decoding of the specified frame on a worker thread. The deadline is the distance in
+   * frames until the frame is displayed; jobs with smaller deadlines are decoded first. Does
+   * nothing if the same frame of the reader is already scheduled.
+   */
+  void schedule(std::shared_ptr<SequenceReader> reader, Frame targetFrame, int64_t deadline);
+
+ private:
+  struct DecodeJob {
+    std::shared_ptr<SequenceReader> reader = nullptr;
+    Frame targetFrame = -1;
+    int64_t deadline = 0;
+  };
+
+  SequenceDecodeScheduler() = default;
+
+  void decodeNextJob();
+
+  std::mutex locker = {};
+  std::vector<DecodeJob> jobs = {};
+};
+}  // namespace pag
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "SequenceImageQueue.h"
+#include "SequenceDecodeScheduler.h"
 
 namespace pag {
 std::unique_ptr<SequenceImageQueue> SequenceImageQueue::MakeFrom(
@@ -40,44 +41,132 @@ SequenceImageQueue::SequenceImageQueue(std::shared_ptr<SequenceInfo> sequence,
       totalFrames(sequence->duration()), useDiskCache(useDiskCache) {
 }
 
+void SequenceImageQueue::warmUpDecoder() {
+  reader->prepareAsync();
+}
+
+void SequenceImageQueue::setReadAheadCount(int count) {
+  readAheadCount = count < 1 ? 1 : count;
+}
+
 void SequenceImageQueue::prepareNextImage() {
-  auto nextFrame = currentFrame + 1;
-  if (nextFrame >= totalFrames) {
+  auto nextFrame = currentFrame + direction;
+  if (nextFrame >= totalFrames || nextFrame < 0) {
     nextFrame = firstFrame;
   }
   prepare(nextFrame);
 }
 
 void SequenceImageQueue::prepare(Frame targetFrame) {
-  if (preparedImage != nullptr || targetFrame < 0 || targetFrame >= totalFrames) {
+  if (targetFrame < 0 || targetFrame >= totalFrames) {
     return;
   }
-  auto image = sequence->makeFrameImage(reader, targetFrame, useDiskCache);
-  preparedImage = image->makeDecoded();
-  preparedFrame = targetFrame;
+  // Drop prepared frames that fell out of the read-ahead window. The distance is computed
+  // modulo the sequence length, so frames prepared across the loop boundary stay in the window.
+  for (auto item = preparedImages.begin(); item != preparedImages.end();) {
+    auto distance = (item->first - targetFrame) * direction;
+    if (distance < 0) {
+      distance += totalFrames;
+    }
+    if (distance < 0 || distance >= readAheadCount) {
+      item = preparedImages.erase(item);
+    } else {
+      ++item;
+    }
+  }
+  auto frame = targetFrame;
+  for (int i = 0; i < readAheadCount; i++) {
+    if (frame < 0 || frame >= totalFrames) {
+      // 预读窗口跨过结尾时回绕到循环起点，提前把下一轮开头的帧解出来，消除每次循环回绕
+      // 瞬间整组 GOP 重新解码造成的卡顿。
+      frame = direction > 0 ? firstFrame : totalFrames - 1;
+      if (frame < 0 || frame >= totalFrames) {
+        break;
+      }
+    }
+    if (frame != currentFrame && !hasPreparedImage(frame)) {
+      auto image = sequence->makeFrameImage(reader, frame, useDiskCache);
+      if (image == nullptr) {
+        break;
+      }
+      preparedImages.emplace_back(frame, image->makeDecoded());
+      preparedFrame = frame;
+    }
+    frame += direction;
+  }
+  if (targetFrame != currentFrame && reader->asyncDecodingSupported()) {
+    // Only the nearest frame is scheduled, keeping the decoding order of each reader sequential.
+    auto deadline =
+        targetFrame > currentFrame ? targetFrame - currentFrame : currentFrame - targetFrame;
+    SequenceDecodeScheduler::GetInstance()->schedule(reader, targetFrame, deadline);
+  }
+}
+
+bool SequenceImageQueue::hasPreparedImage(Frame targetFrame) const {
+  for (auto& item : preparedImages) {
+    if (item.first == targetFrame) {
+      return true;
+    }
+  }
+  return false;
 }
 
 std::shared_ptr<tgfx::Image> SequenceImageQueue::getImage(Frame targetFrame) {
   if (targetFrame == currentFrame) {
     return currentImage;
   }
-  if (targetFrame == preparedFrame) {
-    currentImage = preparedImage;
-    preparedImage = nullptr;
-    currentFrame = preparedFrame;
-    return currentImage;
+  if (currentFrame >= 0) {
+    // 按环形最短路径判断播放方向：从结尾回绕到开头是正向循环，不能误判成倒放，否则刚为下一轮
+    // 预读好的帧会在回绕瞬间被整批丢弃。
+    auto forwardDistance = targetFrame - currentFrame;
+    if (forwardDistance < 0) {
+      forwardDistance += totalFrames;
+    }
+    direction = forwardDistance <= totalFrames - forwardDistance ? 1 : -1;
+  }
+  if (reader->reusesUnchangedBuffers() && currentImage != nullptr) {
+    // 解码输出和当前帧一致时读取器会返回同一个 ImageBuffer 实例，直接复用当前的 Image，
+    // 它的纹理已经在显存里，静止区段就省掉了整帧的重复上传。
+    auto buffer = reader->readBuffer(targetFrame);
+    if (buffer != nullptr && buffer == currentBuffer) {
+      currentFrame = targetFrame;
+      for (auto item = preparedImages.begin(); item != preparedImages.end();) {
+        if ((item->first - targetFrame) * direction <= 0) {
+          item = preparedImages.erase(item);
+        } else {
+          ++item;
+        }
+      }
+      return currentImage;
+    }
+    currentBuffer = buffer;
+  }
+  for (auto item = preparedImages.begin(); item != preparedImages.end(); ++item) {
+    if (item->first == targetFrame) {
+      currentImage = item->second;
+      currentFrame = targetFrame;
+      // Everything up to the consumed frame is behind the playback position now.
+      preparedImages.erase(preparedImages.begin(), ++item);
+      return currentImage;
+    }
   }
   auto image = sequence->makeFrameImage(reader, targetFrame, useDiskCache);
   if (image == nullptr) {
     return nullptr;
   }
   currentImage = image->makeDecoded();
-  preparedImage = nullptr;
   currentFrame = targetFrame;
   preparedFrame = targetFrame;
+  // The playback position jumped outside the prepared window, so the entries are all stale.
+  preparedImages.clear();
   return currentImage;
 }
 
+void SequenceImageQueue::releaseReadAheadBuffers() {
+  preparedImages.clear();
+  preparedFrame = currentFrame;
+}
+
 void SequenceImageQueue::reportPerformance(Performance* performance) {
   reader->reportPerformance(performance);
 }
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <list>
 #include "SequenceInfo.h"
 #include "SequenceReader.h"
 #include "pag/file.h"
@@ -29,13 +30,25 @@ class SequenceImageQueue {
   static std::unique_ptr<SequenceImageQueue> MakeFrom(std::shared_ptr<SequenceInfo> sequence,
                                                       PAGLayer* pagLayer, bool useDiskCache);
 
+  /**
+   * Schedules decoder initialization of the reader on a background thread.
+   */
+  void warmUpDecoder();
+
+  /**
+   * Sets how many frames the queue decodes ahead of the displayed frame along the predicted
+   * playback direction. The default value is 1.
+   */
+  void setReadAheadCount(int count);
+
   /**
    * Prepares the image of the next frame.
    */
   void prepareNextImage();
 
   /**
-   * Prepares the image of the specified frame.
+   * Prepares the images of the specified frame and up to readAheadCount frames beyond it along
+   * the predicted playback direction, dropping prepared frames that fell out of the window.
    */
   void prepare(Frame targetFrame);
 
@@ -44,6 +57,12 @@ class SequenceImageQueue {
    */
   std::shared_ptr<tgfx::Image> getImage(Frame targetFrame);
 
+  /**
+   * Frees the prepared frames beyond the displayed one, keeping the reader and its decoder alive,
+   * so playback continues without the read-ahead memory.
+   */
+  void releaseReadAheadBuffers();
+
   /**
    * Reports the decoding performance data.
    */
@@ -57,12 +76,19 @@ class SequenceImageQueue {
   Frame currentFrame = -1;
   Frame preparedFrame = -1;
   std::shared_ptr<tgfx::Image> currentImage = nullptr;
-  std::shared_ptr<tgfx::Image> preparedImage = nullptr;
+  // 当前帧对应的解码缓冲，用于和读取器返回的实例比对来识别未变化的帧。
+  std::shared_ptr<tgfx::ImageBuffer> currentBuffer = nullptr;
+  // Prepared frames ordered along the playback direction.
+  std::list<std::pair<Frame, std::shared_ptr<tgfx::Image>>> preparedImages = {};
+  int readAheadCount = 1;
+  int direction = 1;
   bool useDiskCache = false;
 
   SequenceImageQueue(std::shared_ptr<SequenceInfo> sequence, std::shared_ptr<SequenceReader> reader,
                      Frame firstFrame, bool useDiskCache);
 
+  bool hasPreparedImage(Frame targetFrame) const;
+
   friend class RenderCache;
 };
 }  // namespace pag
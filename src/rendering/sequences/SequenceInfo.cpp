@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "SequenceInfo.h"
+#include <mutex>
+#include <unordered_map>
 #include "DiskSequenceReader.h"
 #include "rendering/sequences/BitmapSequenceReader.h"
 #include "rendering/sequences/VideoReader.h"
@@ -27,6 +29,52 @@
 #endif
 
 namespace pag {
+// 进程级的读取器注册表。同一个 File 被多个播放器展示时（File::Load 按路径共享 File），
+// 相同序列直接复用同一个 SequenceReader，解码只跑一份。读取器内部有互斥锁并缓存最近
+// 一帧，跨线程并发读取是安全的；weak_ptr 让读取器的生命周期仍由各使用方共同持有。
+class SequenceReaderRegistry {
+ public:
+  static SequenceReaderRegistry* GetInstance() {
+    static auto& instance = *new SequenceReaderRegistry();
+    return &instance;
+  }
+
+  std::shared_ptr<SequenceReader> find(const Sequence* sequence) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = readers.find(sequence);
+    if (result == readers.end()) {
+      return nullptr;
+    }
+    auto reader = result->second.lock();
+    if (reader == nullptr) {
+      readers.erase(result);
+    }
+    return reader;
+  }
+
+  void insert(const Sequence* sequence, std::shared_ptr<SequenceReader> reader) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    readers[sequence] = std::move(reader);
+    if (readers.size() <= MAX_REGISTRY_SIZE) {
+      return;
+    }
+    // 已销毁的 File 会留下失效的条目，超过上限时统一清理一轮。
+    for (auto item = readers.begin(); item != readers.end();) {
+      if (item->second.expired()) {
+        item = readers.erase(item);
+      } else {
+        ++item;
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t MAX_REGISTRY_SIZE = 64;
+
+  std::mutex locker = {};
+  std::unordered_map<const Sequence*, std::weak_ptr<SequenceReader>> readers = {};
+};
+
 static std::shared_ptr<tgfx::Image> MakeSequenceImage(
     std::shared_ptr<tgfx::ImageGenerator> generator, Sequence* sequence, bool useDiskCache) {
   auto image = tgfx::Image::MakeFrom(std::move(generator));
@@ -58,11 +106,17 @@ std::shared_ptr<SequenceReader> SequenceInfo::makeReader(std::shared_ptr<File> f
   std::shared_ptr<SequenceReader> reader = nullptr;
   auto composition = sequence->composition;
   if (useDiskCache) {
+    // 磁盘缓存读取器本身就按 (文件, 序列) 去重了解码工作，不进注册表。
     reader = DiskSequenceReader::Make(std::move(file), sequence);
     if (reader) {
       return reader;
     }
   }
+  auto registry = SequenceReaderRegistry::GetInstance();
+  reader = registry->find(sequence);
+  if (reader != nullptr) {
+    return reader;
+  }
   if (composition->type() == CompositionType::Bitmap) {
     reader = std::make_shared<BitmapSequenceReader>(std::move(file),
                                                     static_cast<BitmapSequence*>(sequence));
@@ -76,6 +130,7 @@ std::shared_ptr<SequenceReader> SequenceInfo::makeReader(std::shared_ptr<File> f
 #endif
     reader = std::make_shared<VideoReader>(std::move(demuxer));
   }
+  registry->insert(sequence, reader);
   return reader;
 }
 
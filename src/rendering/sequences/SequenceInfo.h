@@ -69,7 +69,7 @@ class StaticSequenceGenerator : public tgfx::ImageGenerator {
     return false;
   }
 
-#ifdef PAG_BUILD_FOR_WEB
+#if defined(PAG_BUILD_FOR_WEB) && !defined(PAG_USE_WASM_THREADS)
   bool asyncSupport() const override {
     return false;
   }
@@ -98,7 +98,7 @@ class SequenceFrameGenerator : public tgfx::ImageGenerator {
     return false;
   }
 
-#ifdef PAG_BUILD_FOR_WEB
+#if defined(PAG_BUILD_FOR_WEB) && !defined(PAG_USE_WASM_THREADS)
   bool asyncSupport() const override {
     return false;
   }
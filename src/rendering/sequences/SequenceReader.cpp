@@ -23,6 +23,24 @@
 #include "rendering/sequences/VideoSequenceDemuxer.h"
 
 namespace pag {
+SequenceReader::~SequenceReader() {
+  waitForPrepared();
+}
+
+void SequenceReader::prepareAsync() {
+  if (prepareTask != nullptr) {
+    return;
+  }
+  prepareTask =
+      RenderTaskScheduler::GetInstance()->submit([this]() { onPrepare(); }, TaskPriority::Prefetch);
+}
+
+void SequenceReader::waitForPrepared() {
+  if (prepareTask != nullptr) {
+    prepareTask->wait();
+  }
+}
+
 std::shared_ptr<tgfx::ImageBuffer> SequenceReader::readBuffer(Frame targetFrame) {
   tgfx::Clock clock = {};
   auto buffer = onMakeBuffer(targetFrame);
@@ -22,12 +22,36 @@
 #include "pag/file.h"
 #include "pag/pag.h"
 #include "rendering/Performance.h"
+#include "rendering/utils/RenderTaskScheduler.h"
 #include "tgfx/core/ImageBuffer.h"
 
 namespace pag {
 class SequenceReader {
  public:
-  virtual ~SequenceReader() = default;
+  virtual ~SequenceReader();
+
+  /**
+   * Schedules decoder initialization on a background thread, so the first readBuffer() call does
+   * not pay the setup cost of the underlying decoder.
+   */
+  void prepareAsync();
+
+  /**
+   * Returns true if readBuffer() can be called from a decoding worker thread concurrently with
+   * the rendering path.
+   */
+  virtual bool asyncDecodingSupported() const {
+    return false;
+  }
+
+  /**
+   * Returns true if readBuffer() may return the ImageBuffer instance of the previous frame when
+   * the decoded content has not changed, so callers can reuse the Image created from it and skip
+   * re-uploading an identical texture.
+   */
+  virtual bool reusesUnchangedBuffers() const {
+    return false;
+  }
 
   /**
    * Returns the width of the sequence buffers created from the reader.
@@ -47,6 +71,18 @@ class SequenceReader {
   void reportPerformance(Performance* performance);
 
  protected:
+  /**
+   * Blocks until any pending onPrepare() task has finished. Subclasses must call this before
+   * destroying their decoding resources.
+   */
+  void waitForPrepared();
+
+  /**
+   * Initializes the decoding resources of the reader. Called on a background thread.
+   */
+  virtual void onPrepare() {
+  }
+
   /**
    * Return the decoded ImageBuffer of the specified frame.
    */
@@ -59,5 +95,6 @@ class SequenceReader {
 
  private:
   std::atomic_int64_t decodingTime = 0;
+  std::shared_ptr<RenderTask> prepareTask = nullptr;
 };
 }  // namespace pag
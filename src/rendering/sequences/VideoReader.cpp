@@ -19,6 +19,7 @@
 #include "VideoReader.h"
 #include "base/utils/TimeUtil.h"
 #include "platform/Platform.h"
+#include "rendering/utils/Trace.h"
 #include "tgfx/core/Clock.h"
 
 namespace pag {
@@ -39,11 +40,18 @@ VideoReader::VideoReader(std::unique_ptr<VideoDemuxer> videoDemuxer)
 }
 
 VideoReader::~VideoReader() {
+  waitForPrepared();
   destroyVideoDecoder();
   delete demuxer;
 }
 
+void VideoReader::onPrepare() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  checkVideoDecoder();
+}
+
 std::shared_ptr<tgfx::ImageBuffer> VideoReader::onMakeBuffer(Frame targetFrame) {
+  TraceEvent traceEvent("VideoReader::onMakeBuffer");
   // Need a locker here in case there are other threads are decoding at the same time.
   std::lock_guard<std::mutex> autoLock(locker);
   auto targetTime = FrameToTime(targetFrame, frameRate);
@@ -56,6 +64,8 @@ std::shared_ptr<tgfx::ImageBuffer> VideoReader::onMakeBuffer(Frame targetFrame)
   if (!checkVideoDecoder()) {
     return nullptr;
   }
+  auto seeking = demuxer->needSeeking(currentDecodedTime, sampleTime);
+  tgfx::Clock seekClock = {};
   auto success = decodeFrame(sampleTime);
   if (!success) {
     // retry once.
@@ -70,6 +80,9 @@ std::shared_ptr<tgfx::ImageBuffer> VideoReader::onMakeBuffer(Frame targetFrame)
       }
     }
   }
+  if (seeking) {
+    seekingTime += seekClock.elapsedTime();
+  }
   if (!success) {
     LOGE("VideoDecoder: Error on decoding frame.\n");
     return nullptr;
@@ -87,6 +100,8 @@ void VideoReader::onReportPerformance(Performance* performance, int64_t decoding
   if (videoDecoder == nullptr) {
     return;
   }
+  performance->videoSeekingTime += seekingTime;
+  seekingTime = 0;
   if (videoDecoder->isHardwareBacked()) {
     performance->hardwareDecodingTime += decodingTime;
     performance->hardwareDecodingInitialTime += hardDecodingInitialTime;
@@ -131,6 +146,14 @@ bool VideoReader::decodeFrame(int64_t sampleTime) {
     videoDecoder->onFlush();
     demuxer->seekTo(sampleTime);
   }
+  // Every sample before the target is decoded only as a reference and never rendered. So when
+  // playback falls behind by more than one frame interval, or we just jumped to a sync sample,
+  // drop the non-reference samples in between and decode only what is needed to resume at the
+  // current time, instead of compounding the stall by decoding every sample.
+  if (currentDecodedTime == INT64_MIN ||
+      sampleTime - currentDecodedTime > FrameToTime(1, frameRate)) {
+    demuxer->skipDroppableSamples(sampleTime);
+  }
   int tryDecodeCount = 0;
   while (currentDecodedTime < sampleTime) {
     if (!sendSampleData()) {
@@ -38,7 +38,20 @@ class VideoReader : public SequenceReader {
     return demuxer->getFormat().height;
   }
 
+  bool asyncDecodingSupported() const override {
+    // onMakeBuffer() is guarded by a mutex and caches the last decoded buffer, so a worker thread
+    // can safely decode ahead of the rendering path.
+    return true;
+  }
+
+  bool reusesUnchangedBuffers() const override {
+    // Software decoders detect fully-skipped frames and hand back the previous ImageBuffer.
+    return true;
+  }
+
  protected:
+  void onPrepare() override;
+
   std::shared_ptr<tgfx::ImageBuffer> onMakeBuffer(Frame targetFrame) override;
 
   void onReportPerformance(Performance* performance, int64_t decodingTime) override;
@@ -58,6 +71,7 @@ class VideoReader : public SequenceReader {
   int64_t currentRenderedTime = INT64_MIN;
   std::atomic_int64_t hardDecodingInitialTime = 0;
   std::atomic_int64_t softDecodingInitialTime = 0;
+  std::atomic_int64_t seekingTime = 0;
 
   void destroyVideoDecoder();
 
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "VideoSequenceDemuxer.h"
+#include <algorithm>
 #include "base/utils/TimeUtil.h"
 
 namespace pag {
@@ -71,30 +72,51 @@ bool VideoSequenceDemuxer::needSeeking(int64_t currentTime, int64_t targetTime)
   if (target <= maxPTSFrame) {
     return false;
   }
+  // The GOP index is sorted, so finding the prior keyframe is a binary search instead of walking
+  // the frame list backwards.
+  return findPriorKeyframe(target) > current + 1;
+}
+
+Frame VideoSequenceDemuxer::findPriorKeyframe(Frame targetFrame) const {
+  auto index = std::upper_bound(keyframes.begin(), keyframes.end(), targetFrame);
+  if (index == keyframes.begin()) {
+    return -1;
+  }
+  return *(index - 1);
+}
+
+static bool IsDroppableSample(const VideoFrame* videoFrame) {
+  if (videoFrame->isKeyframe || videoFrame->fileBytes == nullptr ||
+      videoFrame->fileBytes->length() < 5) {
+    return false;
+  }
+  // The first 4 bytes are either an AVCC length or an Annex-B start code, so the NAL unit header
+  // is always at a fixed offset. A non-IDR slice with nal_ref_idc == 0 is never referenced by any
+  // other frame and can be dropped without being decoded.
+  auto nalHeader = videoFrame->fileBytes->data()[4];
+  return (nalHeader & 0x60) == 0 && (nalHeader & 0x1F) == 1;
+}
+
+void VideoSequenceDemuxer::skipDroppableSamples(int64_t targetTime) {
+  auto targetFrame = TimeToFrame(targetTime, sequence->frameRate);
   const auto& frames = sequence->frames;
-  for (Frame frame = target; frame > current + 1; frame--) {
-    // DTS == PTS when the frame is key frame.
-    if (frames[frame]->isKeyframe) {
-      return true;
+  while (sampleIndex < static_cast<int>(frames.size())) {
+    auto videoFrame = frames[sampleIndex];
+    if (videoFrame->frame >= targetFrame || !IsDroppableSample(videoFrame)) {
+      break;
     }
+    sampleIndex++;
   }
-  return false;
 }
 
 void VideoSequenceDemuxer::seekTo(int64_t targetTime) {
   auto targetFrame = TimeToFrame(targetTime, sequence->frameRate);
-  int start = 0;
-  int end = static_cast<int>(keyframes.size()) - 1;
-  while (start < end - 1) {
-    int middle = (start + end) / 2;
-    if (keyframes[middle] <= targetFrame) {
-      start = middle;
-    } else {
-      end = middle;
-    }
+  auto keyframe = findPriorKeyframe(targetFrame);
+  if (keyframe < 0) {
+    keyframe = keyframes.empty() ? 0 : keyframes.front();
   }
   // DTS == PTS when the frame is key frame.
-  maxPTSFrame = sampleIndex = keyframes[start];
+  maxPTSFrame = sampleIndex = keyframe;
 }
 
 void VideoSequenceDemuxer::reset() {
@@ -39,6 +39,8 @@ class VideoSequenceDemuxer : public VideoDemuxer {
 
   bool needSeeking(int64_t currentTime, int64_t targetTime) override;
 
+  void skipDroppableSamples(int64_t targetTime) override;
+
   void seekTo(int64_t targetTime) override;
 
   void reset() override;
@@ -54,8 +56,12 @@ class VideoSequenceDemuxer : public VideoDemuxer {
   // used by the video decoder on the web platform.
   PAGFile* pagFile = nullptr;
   VideoFormat format = {};
+  // The GOP index: frame indices of all keyframes in ascending order, built once at creation so
+  // random seeks only cost a binary search.
   std::vector<Frame> keyframes = {};
 
+  Frame findPriorKeyframe(Frame targetFrame) const;
+
   bool staticContent() const override {
     return sequence->composition->staticContent();
   }
@@ -0,0 +1,34 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace pag {
+#ifdef PAG_ALLOCATION_AUDIT
+/**
+ * Returns the number of heap allocations the current thread has made since it started. Only
+ * available in builds with PAG_ALLOCATION_AUDIT defined, which override the global allocation
+ * operators to keep the count. The counter is for auditing allocation activity on the flush path
+ * and costs one thread-local increment per allocation, so the flag should stay off in release
+ * builds.
+ */
+int64_t AllocationCount();
+#endif
+}  // namespace pag
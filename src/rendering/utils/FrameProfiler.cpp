@@ -0,0 +1,96 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FrameProfiler.h"
+#include "rendering/utils/AllocationAudit.h"
+
+namespace pag {
+static int64_t CurrentAllocationCount() {
+#ifdef PAG_ALLOCATION_AUDIT
+  return AllocationCount();
+#else
+  return 0;
+#endif
+}
+
+void FrameProfiler::begin() {
+  root = {};
+  root.name = "flush";
+  stack = {&root};
+  startTimes = {clock.measure()};
+  startAllocations = {CurrentAllocationCount()};
+}
+
+void FrameProfiler::end() {
+  while (stack.size() > 1) {
+    exit();
+  }
+  if (!stack.empty()) {
+    root.totalTime = clock.measure() - startTimes.front();
+    root.allocationCount = CurrentAllocationCount() - startAllocations.front();
+  }
+  stack.clear();
+  startTimes.clear();
+  startAllocations.clear();
+}
+
+void FrameProfiler::enter(std::string name) {
+  if (stack.empty()) {
+    return;
+  }
+  // Children are only ever appended to the top of the stack, so the pointers to the open ancestor
+  // nodes stay valid even when a children vector reallocates.
+  auto parent = stack.back();
+  parent->children.emplace_back();
+  auto node = &parent->children.back();
+  node->name = std::move(name);
+  stack.push_back(node);
+  startTimes.push_back(clock.measure());
+  startAllocations.push_back(CurrentAllocationCount());
+}
+
+void FrameProfiler::exit() {
+  if (stack.size() < 2) {
+    return;
+  }
+  stack.back()->totalTime = clock.measure() - startTimes.back();
+  // 计数里也包含 profiler 自身追加节点的少量分配，审计关心的是量级和趋势，不扣除这部分。
+  stack.back()->allocationCount = CurrentAllocationCount() - startAllocations.back();
+  stack.pop_back();
+  startTimes.pop_back();
+  startAllocations.pop_back();
+}
+
+void FrameProfiler::addGpuTime(int64_t duration) {
+  if (stack.empty()) {
+    return;
+  }
+  stack.back()->gpuTime += duration;
+}
+
+void FrameProfiler::addRecord(std::string name, int64_t duration) {
+  if (stack.empty()) {
+    return;
+  }
+  auto parent = stack.back();
+  parent->children.emplace_back();
+  auto& node = parent->children.back();
+  node.name = std::move(name);
+  node.totalTime = duration;
+}
+}  // namespace pag
@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "pag/pag.h"
+#include "tgfx/core/Clock.h"
+
+namespace pag {
+/**
+ * FrameProfiler records a tree of named costs while a frame is being flushed. All methods must be
+ * called from the flushing thread; scopes opened with enter() follow strict stack discipline, so
+ * nested layers and compositions naturally form the tree. Calls outside of a begin()/end() pair
+ * are ignored.
+ */
+class FrameProfiler {
+ public:
+  /**
+   * Clears the previous profile and opens the root node covering the whole flush.
+   */
+  void begin();
+
+  /**
+   * Closes any scopes left open and finishes the root node.
+   */
+  void end();
+
+  /**
+   * Opens a named scope as a child of the current one.
+   */
+  void enter(std::string name);
+
+  /**
+   * Closes the current scope, recording the time since the matching enter().
+   */
+  void exit();
+
+  /**
+   * Adds a leaf node with an externally measured duration to the current scope.
+   */
+  void addRecord(std::string name, int64_t duration);
+
+  /**
+   * Adds measured GPU time to the current scope. Called by GpuPassTimer when a pass finishes.
+   */
+  void addGpuTime(int64_t duration);
+
+  /**
+   * When true, GpuPassTimer scopes drain the GPU pipeline around major passes and record the
+   * measured GPU time into the profile. Draining serializes the CPU and the GPU, so this stays
+   * false unless explicitly enabled for diagnostics.
+   */
+  bool recordGpuCost = false;
+
+  /**
+   * Returns a copy of the profile recorded by the last begin()/end() pair.
+   */
+  FrameProfileNode makeProfile() const {
+    return root;
+  }
+
+ private:
+  tgfx::Clock clock = {};
+  FrameProfileNode root = {};
+  std::vector<FrameProfileNode*> stack = {};
+  std::vector<int64_t> startTimes = {};
+  std::vector<int64_t> startAllocations = {};
+};
+
+/**
+ * Opens a profiler scope for the lifetime of the object. The profiler may be nullptr, in which
+ * case the scope costs nothing but a null check.
+ */
+class ProfileScope {
+ public:
+  ProfileScope(FrameProfiler* profiler, std::string name) : profiler(profiler) {
+    if (profiler != nullptr) {
+      profiler->enter(std::move(name));
+    }
+  }
+
+  ~ProfileScope() {
+    if (profiler != nullptr) {
+      profiler->exit();
+    }
+  }
+
+ private:
+  FrameProfiler* profiler = nullptr;
+};
+}  // namespace pag
@@ -0,0 +1,50 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GpuPassTimer.h"
+#include "tgfx/gpu/opengl/GLFunctions.h"
+
+namespace pag {
+// 没有跨后端、跨驱动都可信的 GPU 计时查询（GLES 上 timer query 只是扩展，移动端驱动的返回值
+// 经常不可用），因此采用排空管线的方式计时：提交当前累积的命令并等待它们全部执行完。量到的
+// 就是真实的 GPU 毫秒数，代价是 CPU 和 GPU 被串行化，所以只在开启 recordGpuCost 时才生效。
+static void DrainGpu(tgfx::Context* context) {
+  context->flush();
+  auto gl = tgfx::GLFunctions::Get(context);
+  gl->finish();
+}
+
+GpuPassTimer::GpuPassTimer(FrameProfiler* profiler, tgfx::Context* context)
+    : profiler(profiler), context(context) {
+  if (profiler == nullptr || !profiler->recordGpuCost || context == nullptr) {
+    this->profiler = nullptr;
+    return;
+  }
+  // 先排掉作用域之前累积的命令，计时只覆盖本作用域内发出的 GPU 工作。
+  DrainGpu(context);
+  startTime = clock.measure();
+}
+
+GpuPassTimer::~GpuPassTimer() {
+  if (profiler == nullptr) {
+    return;
+  }
+  DrainGpu(context);
+  profiler->addGpuTime(clock.measure() - startTime);
+}
+}  // namespace pag
@@ -0,0 +1,43 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "rendering/utils/FrameProfiler.h"
+#include "tgfx/gpu/Device.h"
+
+namespace pag {
+/**
+ * GpuPassTimer measures the GPU cost of one rendering pass for the lifetime of the object and adds
+ * it to the current FrameProfiler scope. It stays inactive (a null check per scope) unless the
+ * profiler has recordGpuCost enabled, because measuring requires draining the command pipeline at
+ * both ends of the pass, which serializes the CPU and the GPU. Use it only for diagnostics.
+ */
+class GpuPassTimer {
+ public:
+  GpuPassTimer(FrameProfiler* profiler, tgfx::Context* context);
+
+  ~GpuPassTimer();
+
+ private:
+  FrameProfiler* profiler = nullptr;
+  tgfx::Context* context = nullptr;
+  tgfx::Clock clock = {};
+  int64_t startTime = 0;
+};
+}  // namespace pag
@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HitTestGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace pag {
+HitTestGrid::HitTestGrid(float width, float height) {
+  cellWidth = std::max(width / GRID_SIZE, 1.0f);
+  cellHeight = std::max(height / GRID_SIZE, 1.0f);
+  cells.resize(GRID_SIZE * GRID_SIZE);
+}
+
+static int ClampIndex(float value, float cellSize) {
+  auto index = static_cast<int>(floorf(value / cellSize));
+  return std::max(0, std::min(index, HitTestGrid::GRID_SIZE - 1));
+}
+
+void HitTestGrid::addEntry(int index, const tgfx::Rect& bounds) {
+  if (bounds.isEmpty()) {
+    return;
+  }
+  auto startColumn = ClampIndex(bounds.left, cellWidth);
+  auto endColumn = ClampIndex(bounds.right, cellWidth);
+  auto startRow = ClampIndex(bounds.top, cellHeight);
+  auto endRow = ClampIndex(bounds.bottom, cellHeight);
+  for (auto row = startRow; row <= endRow; row++) {
+    for (auto column = startColumn; column <= endColumn; column++) {
+      cells[static_cast<size_t>(row * GRID_SIZE + column)].push_back(index);
+    }
+  }
+}
+
+void HitTestGrid::addToAllCells(int index) {
+  fullEntries.push_back(index);
+}
+
+std::vector<int> HitTestGrid::find(float x, float y) const {
+  auto column = ClampIndex(x, cellWidth);
+  auto row = ClampIndex(y, cellHeight);
+  auto& cell = cells[static_cast<size_t>(row * GRID_SIZE + column)];
+  std::vector<int> candidates = {};
+  candidates.reserve(cell.size() + fullEntries.size());
+  // Both lists are in ascending index order, merge them back to front so callers can test layers
+  // from top to bottom.
+  auto cellIndex = static_cast<int>(cell.size()) - 1;
+  auto fullIndex = static_cast<int>(fullEntries.size()) - 1;
+  while (cellIndex >= 0 || fullIndex >= 0) {
+    if (fullIndex < 0 || (cellIndex >= 0 && cell[cellIndex] > fullEntries[fullIndex])) {
+      candidates.push_back(cell[cellIndex--]);
+    } else {
+      candidates.push_back(fullEntries[fullIndex--]);
+    }
+  }
+  return candidates;
+}
+}  // namespace pag
@@ -0,0 +1,60 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "tgfx/core/Rect.h"
+
+namespace pag {
+/**
+ * A uniform grid over a composition that buckets child layer indices by their measured bounds, so
+ * hit testing only has to run the precise per-layer checks on the layers whose bounds cover the
+ * queried point. The grid is a conservative superset: entries whose bounds cannot be determined
+ * are kept in every cell.
+ */
+class HitTestGrid {
+ public:
+  HitTestGrid(float width, float height);
+
+  /**
+   * Adds an entry covering the specified bounds. Entries must be added in ascending index order.
+   */
+  void addEntry(int index, const tgfx::Rect& bounds);
+
+  /**
+   * Adds an entry which is a candidate for every point, used when the bounds of a layer cannot be
+   * determined safely.
+   */
+  void addToAllCells(int index);
+
+  /**
+   * Returns the candidate indices whose bounds may contain the specified point, sorted in
+   * descending order so callers can test layers from top to bottom.
+   */
+  std::vector<int> find(float x, float y) const;
+
+  static constexpr int GRID_SIZE = 8;
+
+ private:
+  float cellWidth = 1.0f;
+  float cellHeight = 1.0f;
+  std::vector<std::vector<int>> cells = {};
+  std::vector<int> fullEntries = {};
+};
+}  // namespace pag
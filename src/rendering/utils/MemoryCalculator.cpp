@@ -331,4 +331,98 @@ int64_t CalculateGraphicsMemory(std::shared_ptr<File> file) {
   }
   return maxGraphicsMemory;
 }
+
+// Classification thresholds for FileCostClass. A file is Low only when every metric stays below
+// the low bounds, and High as soon as any metric crosses a high bound.
+static constexpr int64_t LOW_COST_GRAPHICS_MEMORY = 64 * 1024 * 1024;
+static constexpr int64_t HIGH_COST_GRAPHICS_MEMORY = 256 * 1024 * 1024;
+static constexpr int LOW_COST_VIDEO_COUNT = 1;
+static constexpr int HIGH_COST_VIDEO_COUNT = 3;
+static constexpr int LOW_COST_FILTER_DEPTH = 2;
+static constexpr int HIGH_COST_FILTER_DEPTH = 5;
+static constexpr int LOW_COST_GLYPH_COUNT = 300;
+static constexpr int HIGH_COST_GLYPH_COUNT = 2000;
+
+struct PreflightContext {
+  FilePreflightData* data = nullptr;
+  // Caches the internal filter depth of every visited composition, so compositions referenced by
+  // several layers are scanned and counted only once.
+  std::unordered_map<Composition*, int> compositionDepths = {};
+};
+
+static int PreflightLayer(Layer* layer, PreflightContext* context);
+
+static int PreflightComposition(Composition* composition, PreflightContext* context) {
+  auto cached = context->compositionDepths.find(composition);
+  if (cached != context->compositionDepths.end()) {
+    return cached->second;
+  }
+  context->compositionDepths[composition] = 0;
+  int maxDepth = 0;
+  if (composition->type() == CompositionType::Vector) {
+    auto vectorComposition = static_cast<VectorComposition*>(composition);
+    for (auto layer : vectorComposition->layers) {
+      maxDepth = std::max(maxDepth, PreflightLayer(layer, context));
+    }
+  }
+  context->compositionDepths[composition] = maxDepth;
+  return maxDepth;
+}
+
+static int CountCharacters(const std::string& text) {
+  int count = 0;
+  for (auto character : text) {
+    if ((character & 0xC0) != 0x80) {
+      count++;
+    }
+  }
+  return count;
+}
+
+static int PreflightLayer(Layer* layer, PreflightContext* context) {
+  auto data = context->data;
+  data->layerCount++;
+  auto filters = static_cast<int>(layer->effects.size() + layer->layerStyles.size());
+  if (layer->motionBlur) {
+    filters++;
+  }
+  data->filterCount += filters;
+  if (layer->type() == LayerType::Text) {
+    auto textLayer = static_cast<TextLayer*>(layer);
+    if (textLayer->sourceText != nullptr && textLayer->sourceText->value != nullptr) {
+      data->glyphCount += CountCharacters(textLayer->sourceText->value->text);
+    }
+  }
+  auto depth = filters;
+  if (layer->type() == LayerType::PreCompose) {
+    depth += PreflightComposition(static_cast<PreComposeLayer*>(layer)->composition, context);
+  }
+  return depth;
+}
+
+static FileCostClass ClassifyCost(const FilePreflightData& data) {
+  if (data.graphicsMemory > HIGH_COST_GRAPHICS_MEMORY || data.videoCount >= HIGH_COST_VIDEO_COUNT ||
+      data.maxFilterDepth >= HIGH_COST_FILTER_DEPTH || data.glyphCount > HIGH_COST_GLYPH_COUNT) {
+    return FileCostClass::High;
+  }
+  if (data.graphicsMemory <= LOW_COST_GRAPHICS_MEMORY && data.videoCount <= LOW_COST_VIDEO_COUNT &&
+      data.maxFilterDepth <= LOW_COST_FILTER_DEPTH && data.glyphCount <= LOW_COST_GLYPH_COUNT) {
+    return FileCostClass::Low;
+  }
+  return FileCostClass::Moderate;
+}
+
+FilePreflightData PreflightFile(std::shared_ptr<File> file) {
+  FilePreflightData data = {};
+  if (file == nullptr) {
+    return data;
+  }
+  data.graphicsMemory = CalculateGraphicsMemory(file);
+  data.videoCount = file->numVideos();
+  PreflightContext context = {};
+  context.data = &data;
+  data.maxFilterDepth = PreflightLayer(file->getRootLayer(), &context);
+  data.costClass = ClassifyCost(data);
+  return data;
+}
 }  // namespace pag
@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PathMeasureCache.h"
+#include <list>
+#include <unordered_map>
+#include "rendering/utils/PathHasher.h"
+
+namespace pag {
+// 缓存的参数化结构份数上限，超出后从队尾淘汰最久未命中的条目。
+static constexpr size_t MAX_CACHED_MEASURES = 64;
+
+using MeasureList = std::list<std::pair<tgfx::Path, std::shared_ptr<MeasuredPath>>>;
+
+static auto& cacheLocker = *new std::mutex();
+static auto& measureLRU = *new MeasureList();
+static auto& measurePositions =
+    *new std::unordered_map<tgfx::Path, MeasureList::iterator, PathHasher>();
+
+MeasuredPath::MeasuredPath(const tgfx::Path& path)
+    : pathMeasure(tgfx::PathMeasure::MakeFrom(path)) {
+}
+
+float MeasuredPath::getLength() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return pathMeasure->getLength();
+}
+
+bool MeasuredPath::getSegment(float startD, float stopD, tgfx::Path* result) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return pathMeasure->getSegment(startD, stopD, result);
+}
+
+std::shared_ptr<MeasuredPath> PathMeasureCache::Get(const tgfx::Path& path) {
+  std::lock_guard<std::mutex> autoLock(cacheLocker);
+  auto result = measurePositions.find(path);
+  if (result != measurePositions.end()) {
+    measureLRU.splice(measureLRU.begin(), measureLRU, result->second);
+    return result->second->second;
+  }
+  // PathMeasure 的长度表是惰性构建的，这里只记录路径，真正的测量开销发生在首次取值时。
+  auto measure = std::make_shared<MeasuredPath>(path);
+  measureLRU.emplace_front(path, measure);
+  measurePositions[path] = measureLRU.begin();
+  while (measureLRU.size() > MAX_CACHED_MEASURES) {
+    measurePositions.erase(measureLRU.back().first);
+    measureLRU.pop_back();
+  }
+  return measure;
+}
+}  // namespace pag
@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2021 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include "tgfx/core/PathMeasure.h"
+
+namespace pag {
+/**
+ * MeasuredPath holds the length parameterization of one path so it can be reused across frames.
+ * The accessors lock internally, a measure shared by players on different threads stays safe.
+ */
+class MeasuredPath {
+ public:
+  explicit MeasuredPath(const tgfx::Path& path);
+
+  /**
+   * Returns the total length of the path.
+   */
+  float getLength();
+
+  /**
+   * Extracts the segment between the two distances and appends it to the result path. Returns
+   * false if the segment is zero-length.
+   */
+  bool getSegment(float startD, float stopD, tgfx::Path* result);
+
+ private:
+  std::mutex locker = {};
+  std::unique_ptr<tgfx::PathMeasure> pathMeasure = nullptr;
+};
+
+/**
+ * PathMeasureCache is a process-level LRU pool of length parameterizations keyed by the path
+ * geometry. An animated Trim Paths only changes the start and end fractions from frame to frame
+ * while the geometry stays the same, so reusing the parameterization turns the per-frame trim
+ * cost into a few table lookups instead of rebuilding the length table of the whole path.
+ */
+class PathMeasureCache {
+ public:
+  /**
+   * Returns the length parameterization of the specified path, building and caching it on the
+   * first request.
+   */
+  static std::shared_ptr<MeasuredPath> Get(const tgfx::Path& path);
+};
+}  // namespace pag
@@ -0,0 +1,267 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PixelKernels.h"
+#include <cstring>
+
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define PIXEL_KERNELS_NEON
+#include <arm_neon.h>
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#include <arm_acle.h>
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/auxv.h>
+#endif
+#endif
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PIXEL_KERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace pag {
+using XorKernel = void (*)(uint8_t* dst, const uint8_t* src, size_t byteSize);
+
+static void XorBytesScalar(uint8_t* dst, const uint8_t* src, size_t byteSize) {
+  auto wordCount = byteSize / sizeof(uint64_t);
+  auto dstWords = reinterpret_cast<uint64_t*>(dst);
+  auto srcWords = reinterpret_cast<const uint64_t*>(src);
+  for (size_t i = 0; i < wordCount; i++) {
+    dstWords[i] ^= srcWords[i];
+  }
+  for (size_t i = wordCount * sizeof(uint64_t); i < byteSize; i++) {
+    dst[i] ^= src[i];
+  }
+}
+
+#if defined(PIXEL_KERNELS_NEON)
+
+static void XorBytesNEON(uint8_t* dst, const uint8_t* src, size_t byteSize) {
+  size_t i = 0;
+  for (; i + 64 <= byteSize; i += 64) {
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+    vst1q_u8(dst + i + 16, veorq_u8(vld1q_u8(dst + i + 16), vld1q_u8(src + i + 16)));
+    vst1q_u8(dst + i + 32, veorq_u8(vld1q_u8(dst + i + 32), vld1q_u8(src + i + 32)));
+    vst1q_u8(dst + i + 48, veorq_u8(vld1q_u8(dst + i + 48), vld1q_u8(src + i + 48)));
+  }
+  for (; i + 16 <= byteSize; i += 16) {
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+  }
+  XorBytesScalar(dst + i, src + i, byteSize - i);
+}
+
+static XorKernel ChooseXorKernel() {
+  // NEON is baseline on every arm platform we ship to, no runtime check is needed.
+  return XorBytesNEON;
+}
+
+#elif defined(PIXEL_KERNELS_X86)
+
+static void XorBytesSSE2(uint8_t* dst, const uint8_t* src, size_t byteSize) {
+  size_t i = 0;
+  for (; i + 16 <= byteSize; i += 16) {
+    auto value = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), value);
+  }
+  XorBytesScalar(dst + i, src + i, byteSize - i);
+}
+
+#if defined(__AVX2__) || defined(_MSC_VER)
+#define PIXEL_KERNELS_TARGET_AVX2
+#elif defined(__GNUC__) || defined(__clang__)
+#define PIXEL_KERNELS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#ifdef PIXEL_KERNELS_TARGET_AVX2
+PIXEL_KERNELS_TARGET_AVX2 static void XorBytesAVX2(uint8_t* dst, const uint8_t* src,
+                                                   size_t byteSize) {
+  size_t i = 0;
+  for (; i + 32 <= byteSize; i += 32) {
+    auto value = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i)),
+                                  _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), value);
+  }
+  XorBytesSSE2(dst + i, src + i, byteSize - i);
+}
+
+static bool HasAVX2() {
+#ifdef _MSC_VER
+  int info[4] = {};
+  __cpuid(info, 1);
+  // The OS must support saving the YMM registers (OSXSAVE + XGETBV) before AVX2 can be used.
+  if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6) {
+    return false;
+  }
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+static XorKernel ChooseXorKernel() {
+#ifdef PIXEL_KERNELS_TARGET_AVX2
+  if (HasAVX2()) {
+    return XorBytesAVX2;
+  }
+#endif
+  return XorBytesSSE2;
+}
+
+#else
+
+static XorKernel ChooseXorKernel() {
+  return XorBytesScalar;
+}
+
+#endif
+
+void XorBytes(uint8_t* dst, const uint8_t* src, size_t byteSize) {
+  static const XorKernel kernel = ChooseXorKernel();
+  kernel(dst, src, byteSize);
+}
+
+using CrcKernel = uint32_t (*)(uint32_t crc, const uint8_t* data, size_t byteSize);
+
+static uint32_t Crc32Scalar(uint32_t crc, const uint8_t* data, size_t byteSize) {
+  static const uint32_t* table = [] {
+    auto table = new uint32_t[256];
+    for (uint32_t i = 0; i < 256; i++) {
+      auto value = i;
+      for (int j = 0; j < 8; j++) {
+        value = (value >> 1) ^ ((value & 1) ? 0x82F63B78u : 0u);
+      }
+      table[i] = value;
+    }
+    return table;
+  }();
+  for (size_t i = 0; i < byteSize; i++) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+
+#ifdef __ARM_FEATURE_CRC32
+#define PIXEL_KERNELS_TARGET_CRC
+#else
+#define PIXEL_KERNELS_TARGET_CRC __attribute__((target("crc")))
+#endif
+
+#ifdef PIXEL_KERNELS_TARGET_CRC
+PIXEL_KERNELS_TARGET_CRC static uint32_t Crc32ARM(uint32_t crc, const uint8_t* data,
+                                                  size_t byteSize) {
+  size_t i = 0;
+  for (; i + 8 <= byteSize; i += 8) {
+    uint64_t word;
+    memcpy(&word, data + i, 8);
+    crc = __crc32cd(crc, word);
+  }
+  for (; i < byteSize; i++) {
+    crc = __crc32cb(crc, data[i]);
+  }
+  return crc;
+}
+
+static bool HasARMCrc() {
+#if defined(__ARM_FEATURE_CRC32) || defined(__APPLE__)
+  // 编译目标已经保证 CRC 扩展可用（apple silicon 全系支持）。
+  return true;
+#elif defined(__linux__) || defined(__ANDROID__)
+  // HWCAP_CRC32 on aarch64.
+  return (getauxval(AT_HWCAP) & (1 << 7)) != 0;
+#else
+  return false;
+#endif
+}
+#endif
+
+static CrcKernel ChooseCrcKernel() {
+#ifdef PIXEL_KERNELS_TARGET_CRC
+  if (HasARMCrc()) {
+    return Crc32ARM;
+  }
+#endif
+  return Crc32Scalar;
+}
+
+#elif defined(PIXEL_KERNELS_X86)
+
+#if defined(__SSE4_2__) || defined(_MSC_VER)
+#define PIXEL_KERNELS_TARGET_SSE42
+#elif defined(__GNUC__) || defined(__clang__)
+#define PIXEL_KERNELS_TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+
+#ifdef PIXEL_KERNELS_TARGET_SSE42
+PIXEL_KERNELS_TARGET_SSE42 static uint32_t Crc32SSE42(uint32_t crc, const uint8_t* data,
+                                                      size_t byteSize) {
+  size_t i = 0;
+#if defined(__x86_64__) || defined(_M_X64)
+  auto crc64 = static_cast<uint64_t>(crc);
+  for (; i + 8 <= byteSize; i += 8) {
+    uint64_t word;
+    memcpy(&word, data + i, 8);
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+  crc = static_cast<uint32_t>(crc64);
+#endif
+  for (; i < byteSize; i++) {
+    crc = _mm_crc32_u8(crc, data[i]);
+  }
+  return crc;
+}
+
+static bool HasSSE42() {
+#ifdef _MSC_VER
+  int info[4] = {};
+  __cpuid(info, 1);
+  return (info[2] & (1 << 20)) != 0;
+#else
+  return __builtin_cpu_supports("sse4.2");
+#endif
+}
+#endif
+
+static CrcKernel ChooseCrcKernel() {
+#ifdef PIXEL_KERNELS_TARGET_SSE42
+  if (HasSSE42()) {
+    return Crc32SSE42;
+  }
+#endif
+  return Crc32Scalar;
+}
+
+#else
+
+static CrcKernel ChooseCrcKernel() {
+  return Crc32Scalar;
+}
+
+#endif
+
+uint32_t Crc32(const uint8_t* data, size_t byteSize) {
+  static const CrcKernel kernel = ChooseCrcKernel();
+  return kernel(0xFFFFFFFFu, data, byteSize) ^ 0xFFFFFFFFu;
+}
+}  // namespace pag
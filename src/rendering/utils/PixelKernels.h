@@ -0,0 +1,38 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pag {
+/**
+ * XORs byteSize bytes of src into dst. The implementation is selected once at runtime based on the
+ * available CPU features (NEON on arm, AVX2 or SSE2 on x86), falling back to a scalar loop
+ * elsewhere. The buffers must not overlap.
+ */
+void XorBytes(uint8_t* dst, const uint8_t* src, size_t byteSize);
+
+/**
+ * Returns the CRC-32C (Castagnoli) checksum of the given bytes. Uses the dedicated CRC
+ * instructions where available (armv8 CRC extension, SSE4.2 on x86), selected once at runtime,
+ * falling back to a table-driven loop elsewhere.
+ */
+uint32_t Crc32(const uint8_t* data, size_t byteSize);
+}  // namespace pag
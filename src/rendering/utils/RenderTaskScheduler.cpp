@@ -0,0 +1,157 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RenderTaskScheduler.h"
+#include <algorithm>
+
+namespace pag {
+static constexpr int PRIORITY_COUNT = 3;
+static constexpr int MAX_RENDER_WORKERS = 16;
+
+static size_t WorkerCount() {
+  auto count = static_cast<int>(std::thread::hardware_concurrency());
+  return static_cast<size_t>(std::max(1, std::min(count, MAX_RENDER_WORKERS)));
+}
+
+void RenderTask::wait() {
+  if (finished.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::unique_lock<std::mutex> autoLock(locker);
+  waiting.store(true, std::memory_order_relaxed);
+  condition.wait(autoLock, [this] { return finished.load(std::memory_order_acquire); });
+}
+
+void RenderTask::run() {
+  execute();
+  finished.store(true, std::memory_order_release);
+  // 绝大多数任务（预取、预解码）没有线程在等结果，完成路径只多一次加锁检查。waiting 必须在
+  // 锁内读取：锁外读会和上面的 finished 写发生 StoreLoad 重排，两边可能同时读到对方的旧值，
+  // 等待者就永远收不到唤醒。有了锁的互斥，要么这里看到 waiting 为 true 发出通知，要么等待者
+  // 之后在锁内的谓词里看到 finished 为 true 直接返回。
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (waiting.load(std::memory_order_relaxed)) {
+    condition.notify_all();
+  }
+}
+
+RenderTaskScheduler* RenderTaskScheduler::GetInstance() {
+  static auto& instance = *new RenderTaskScheduler();
+  return &instance;
+}
+
+RenderTaskScheduler::RenderTaskScheduler() {
+#if defined(PAG_BUILD_FOR_WEB) && !defined(PAG_USE_WASM_THREADS)
+  // 单线程的 wasm 构建没有可用的工作线程，submit() 会在提交线程上同步执行任务。
+  return;
+#endif
+  auto count = WorkerCount();
+  for (size_t index = 0; index < count; index++) {
+    workers.push_back(std::make_unique<Worker>());
+  }
+  for (size_t index = 0; index < count; index++) {
+    workers[index]->thread = std::thread(&RenderTaskScheduler::workLoop, this, index);
+    workers[index]->thread.detach();
+  }
+}
+
+std::shared_ptr<RenderTask> RenderTaskScheduler::submit(std::function<void()> task,
+                                                        TaskPriority priority) {
+  if (task == nullptr) {
+    return nullptr;
+  }
+  auto renderTask = std::shared_ptr<RenderTask>(new RenderTask());
+  renderTask->execute = std::move(task);
+  if (workers.empty()) {
+    renderTask->run();
+    return renderTask;
+  }
+  size_t index;
+  bool notify;
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    index = nextWorker++ % workers.size();
+    pendingTasks++;
+    // 所有工作线程都在忙时没有可唤醒的对象，它们取完当前任务自然会看到新计数，稳定满载的
+    // 流水线上提交路径就省掉了每个任务一次的系统调用。
+    notify = idleWorkers > 0;
+  }
+  auto worker = workers[index].get();
+  {
+    std::lock_guard<std::mutex> autoLock(worker->locker);
+    worker->queues[static_cast<int>(priority)].push_back(renderTask);
+  }
+  if (notify) {
+    condition.notify_one();
+  }
+  return renderTask;
+}
+
+std::shared_ptr<RenderTask> RenderTaskScheduler::PopTask(Worker* worker, bool stealing) {
+  std::lock_guard<std::mutex> autoLock(worker->locker);
+  for (int priority = 0; priority < PRIORITY_COUNT; priority++) {
+    auto& queue = worker->queues[priority];
+    if (queue.empty()) {
+      continue;
+    }
+    // The owner drains its queue in submission order while thieves take from the opposite end,
+    // which keeps them off the same task most of the time.
+    auto task = stealing ? queue.back() : queue.front();
+    if (stealing) {
+      queue.pop_back();
+    } else {
+      queue.pop_front();
+    }
+    return task;
+  }
+  return nullptr;
+}
+
+std::shared_ptr<RenderTask> RenderTaskScheduler::takeTask(size_t index) {
+  auto task = PopTask(workers[index].get(), false);
+  if (task != nullptr) {
+    return task;
+  }
+  for (size_t i = 1; i < workers.size(); i++) {
+    task = PopTask(workers[(index + i) % workers.size()].get(), true);
+    if (task != nullptr) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+void RenderTaskScheduler::workLoop(size_t index) {
+  while (true) {
+    std::shared_ptr<RenderTask> task = nullptr;
+    {
+      std::unique_lock<std::mutex> autoLock(locker);
+      idleWorkers++;
+      condition.wait(autoLock, [this] { return pendingTasks > 0; });
+      idleWorkers--;
+      pendingTasks--;
+    }
+    while ((task = takeTask(index)) == nullptr) {
+      // The task this worker was woken for may be claimed by a sibling between the counter
+      // decrement and the take, but the counts always balance out, so another one is on its way.
+      std::this_thread::yield();
+    }
+    task->run();
+  }
+}
+}  // namespace pag
@@ -0,0 +1,98 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pag {
+/**
+ * Describes how urgently a render task has to finish. Tasks for content on screen in the current
+ * frame always run before prefetching, and prefetching runs before purely speculative work.
+ */
+enum class TaskPriority : int { VisibleNow = 0, Prefetch = 1, Speculative = 2 };
+
+/**
+ * A handle to a task submitted to the RenderTaskScheduler, used to block until the task finishes.
+ */
+class RenderTask {
+ public:
+  /**
+   * Blocks the calling thread until the task has finished executing.
+   */
+  void wait();
+
+ private:
+  std::mutex locker = {};
+  std::condition_variable condition = {};
+  std::function<void()> execute = nullptr;
+  // wait() 先无锁检查 finished，已完成的任务不加锁直接返回；waiting 只在锁内读写，
+  // 完成方和等待方靠锁的互斥保证不会漏掉唤醒。
+  std::atomic<bool> finished = {false};
+  std::atomic<bool> waiting = {false};
+
+  void run();
+
+  friend class RenderTaskScheduler;
+};
+
+/**
+ * A process-wide work-stealing task pool shared by the asynchronous work of every RenderCache:
+ * sequence pre-decoding, glyph page rasterization, and disk cache writes. Each worker owns a set
+ * of priority queues and steals from its siblings when it runs out of work, so a single heavy task
+ * cannot starve the rest of the pipeline. The pool is sized to the core count of the device.
+ */
+class RenderTaskScheduler {
+ public:
+  static RenderTaskScheduler* GetInstance();
+
+  /**
+   * Submits a task for execution with the specified priority and returns a handle which can be
+   * used to wait for its completion. Returns nullptr if the task is nullptr.
+   */
+  std::shared_ptr<RenderTask> submit(std::function<void()> task,
+                                     TaskPriority priority = TaskPriority::Prefetch);
+
+ private:
+  struct Worker {
+    std::mutex locker = {};
+    std::deque<std::shared_ptr<RenderTask>> queues[3] = {};
+    std::thread thread;
+  };
+
+  RenderTaskScheduler();
+
+  void workLoop(size_t index);
+  std::shared_ptr<RenderTask> takeTask(size_t index);
+  static std::shared_ptr<RenderTask> PopTask(Worker* worker, bool stealing);
+
+  std::mutex locker = {};
+  std::condition_variable condition = {};
+  std::vector<std::unique_ptr<Worker>> workers = {};
+  size_t nextWorker = 0;
+  int pendingTasks = 0;
+  int idleWorkers = 0;
+};
+}  // namespace pag
@@ -0,0 +1,169 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ReplayCapture.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include "pag/pag.h"
+#include "rendering/caches/RenderCache.h"
+
+namespace pag {
+// 日志是一行一条事件的文本格式，第一行是版本头。文本内容转义换行和反斜杠后原样落在行尾，
+// 这样日志既紧凑又能直接用肉眼检查。
+static constexpr auto REPLAY_LOG_HEADER = "pagreplay 1";
+
+static std::string EscapeText(const std::string& text) {
+  std::string result = {};
+  result.reserve(text.size());
+  for (auto character : text) {
+    switch (character) {
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\r':
+        result += "\\r";
+        break;
+      default:
+        result += character;
+        break;
+    }
+  }
+  return result;
+}
+
+static std::string UnescapeText(const std::string& text) {
+  std::string result = {};
+  result.reserve(text.size());
+  for (size_t i = 0; i < text.size(); i++) {
+    if (text[i] != '\\' || i + 1 == text.size()) {
+      result += text[i];
+      continue;
+    }
+    i++;
+    switch (text[i]) {
+      case 'n':
+        result += '\n';
+        break;
+      case 'r':
+        result += '\r';
+        break;
+      default:
+        result += text[i];
+        break;
+    }
+  }
+  return result;
+}
+
+void ReplayCapture::recordTextReplacement(int editableIndex, const std::string& text) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  lines += "t " + std::to_string(editableIndex) + " " + EscapeText(text) + "\n";
+}
+
+void ReplayCapture::recordImageReplacement(int editableIndex, int width, int height) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  lines += "i " + std::to_string(editableIndex) + " " + std::to_string(width) + " " +
+           std::to_string(height) + "\n";
+}
+
+void ReplayCapture::recordFlush(double progress, int surfaceWidth, int surfaceHeight,
+                                RenderCache* cache) {
+  char buffer[120];
+  snprintf(buffer, sizeof(buffer), "f %.9f %d %d %d %d\n", progress, surfaceWidth, surfaceHeight,
+           cache->snapshotHitCount, cache->snapshotMissCount);
+  std::lock_guard<std::mutex> autoLock(locker);
+  lines += buffer;
+}
+
+std::string ReplayCapture::makeLog() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return std::string(REPLAY_LOG_HEADER) + "\n" + lines;
+}
+
+std::shared_ptr<PAGReplay> PAGReplay::Load(const std::string& log) {
+  std::istringstream stream(log);
+  std::string line = {};
+  if (!std::getline(stream, line) || line != REPLAY_LOG_HEADER) {
+    return nullptr;
+  }
+  auto replay = std::shared_ptr<PAGReplay>(new PAGReplay());
+  PAGReplayFrame frame = {};
+  while (std::getline(stream, line)) {
+    if (line.size() < 2 || line[1] != ' ') {
+      continue;
+    }
+    auto body = line.substr(2);
+    switch (line[0]) {
+      case 't': {
+        auto separator = body.find(' ');
+        if (separator == std::string::npos) {
+          return nullptr;
+        }
+        frame.texts.emplace_back(atoi(body.c_str()), UnescapeText(body.substr(separator + 1)));
+        break;
+      }
+      case 'i':
+        frame.images.push_back(atoi(body.c_str()));
+        break;
+      case 'f': {
+        std::istringstream values(body);
+        values >> frame.progress >> frame.surfaceWidth >> frame.surfaceHeight >>
+            frame.snapshotHits >> frame.snapshotMisses;
+        if (values.fail()) {
+          return nullptr;
+        }
+        replay->frames.push_back(std::move(frame));
+        frame = {};
+        break;
+      }
+      default:
+        // 未知的事件类型直接跳过，旧版本的查看器也能读新日志。
+        break;
+    }
+  }
+  return replay;
+}
+
+bool PAGReplay::applyFrame(size_t index, std::shared_ptr<PAGFile> pagFile,
+                           std::shared_ptr<PAGPlayer> player,
+                           const std::function<std::shared_ptr<PAGImage>(int)>& imageProvider) {
+  if (index >= frames.size() || pagFile == nullptr || player == nullptr) {
+    return false;
+  }
+  auto& frame = frames[index];
+  for (auto& text : frame.texts) {
+    auto textData = pagFile->getTextData(text.first);
+    if (textData == nullptr) {
+      continue;
+    }
+    textData->text = text.second;
+    pagFile->replaceText(text.first, textData);
+  }
+  if (imageProvider != nullptr) {
+    for (auto editableIndex : frame.images) {
+      pagFile->replaceImage(editableIndex, imageProvider(editableIndex));
+    }
+  }
+  player->setProgress(frame.progress);
+  return true;
+}
+}  // namespace pag
@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include "pag/file.h"
+
+namespace pag {
+class RenderCache;
+
+/**
+ * ReplayCapture records the frame-by-frame input sequence of a PAGPlayer into a compact
+ * line-based log: replacements, surface sizes, progress values, and per-flush cache statistics.
+ * The log can be loaded with PAGReplay::Load() to reproduce the exact production scenario against
+ * the same pag file. Replacement and flush events may come from different threads, so every
+ * record call takes the internal lock.
+ */
+class ReplayCapture {
+ public:
+  /**
+   * Records a text replacement at the given editable index.
+   */
+  void recordTextReplacement(int editableIndex, const std::string& text);
+
+  /**
+   * Records an image replacement at the given editable index. Only the dimensions are captured;
+   * the pixels have to be supplied again when replaying.
+   */
+  void recordImageReplacement(int editableIndex, int width, int height);
+
+  /**
+   * Records a finished flush with the progress value, the surface size, and the snapshot cache
+   * statistics of the frame.
+   */
+  void recordFlush(double progress, int surfaceWidth, int surfaceHeight, RenderCache* cache);
+
+  /**
+   * Returns the captured log.
+   */
+  std::string makeLog();
+
+ private:
+  std::mutex locker = {};
+  std::string lines = {};
+};
+}  // namespace pag
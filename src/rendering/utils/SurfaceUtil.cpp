@@ -18,6 +18,7 @@
 
 #include "SurfaceUtil.h"
 #include "base/utils/MatrixUtil.h"
+#include "rendering/caches/RenderCache.h"
 
 namespace pag {
 // 1/20 is the minimum precision for rendering pixels on most platforms.
@@ -39,8 +40,8 @@ std::shared_ptr<tgfx::Surface> SurfaceUtil::MakeContentSurface(Canvas* parentCan
   auto height = static_cast<int>(ceil(bounds.height() * maxScale));
   // LOGE("makeContentSurface: (width = %d, height = %d)", width, height);
   auto sampleCount = usesMSAA ? 4 : 1;
-  auto newSurface =
-      tgfx::Surface::Make(parentCanvas->getContext(), width, height, false, sampleCount);
+  auto newSurface = parentCanvas->getCache()->getOffscreenSurface(width, height, false,
+                                                                  sampleCount);
   if (newSurface == nullptr) {
     return nullptr;
   }
@@ -17,6 +17,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Trace.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include "pag/pag.h"
 #include "platform/Platform.h"
 #include "tgfx/core/Bitmap.h"
 #include "tgfx/core/Surface.h"
@@ -47,4 +52,82 @@ void Trace(const tgfx::Pixmap& pixmap, const std::string& tag) {
   }
   Platform::Current()->traceImage(pixmap.info(), pixmap.pixels(), tag);
 }
+
+struct TraceEventRecord {
+  const char* name = nullptr;
+  uint32_t threadID = 0;
+  int64_t startTime = 0;
+  int64_t duration = 0;
+};
+
+static std::atomic_bool traceEnabled = {false};
+static std::mutex traceLocker = {};
+static std::vector<TraceEventRecord>& TraceEvents() {
+  static auto& events = *new std::vector<TraceEventRecord>();
+  return events;
+}
+
+static int64_t TraceTimestamp() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  auto elapsed = std::chrono::steady_clock::now() - epoch;
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+static uint32_t CurrentThreadID() {
+  static std::atomic_uint32_t nextThreadID = {1};
+  static thread_local uint32_t threadID = nextThreadID.fetch_add(1);
+  return threadID;
+}
+
+TraceEvent::TraceEvent(const char* eventName) {
+  if (!traceEnabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  name = eventName;
+  startTime = TraceTimestamp();
+  Platform::Current()->traceEventBegin(eventName);
+}
+
+TraceEvent::~TraceEvent() {
+  if (name == nullptr) {
+    return;
+  }
+  Platform::Current()->traceEventEnd();
+  TraceEventRecord record = {};
+  record.name = name;
+  record.threadID = CurrentThreadID();
+  record.startTime = startTime;
+  record.duration = TraceTimestamp() - startTime;
+  std::lock_guard<std::mutex> autoLock(traceLocker);
+  TraceEvents().push_back(record);
+}
+
+bool PAGTrace::Enabled() {
+  return traceEnabled.load(std::memory_order_relaxed);
+}
+
+void PAGTrace::SetEnabled(bool value) {
+  std::lock_guard<std::mutex> autoLock(traceLocker);
+  if (value && !traceEnabled.load(std::memory_order_relaxed)) {
+    TraceEvents().clear();
+  }
+  traceEnabled.store(value, std::memory_order_relaxed);
+}
+
+std::string PAGTrace::ExportJSON() {
+  std::lock_guard<std::mutex> autoLock(traceLocker);
+  std::string json = "{\"traceEvents\":[";
+  auto& events = TraceEvents();
+  for (size_t i = 0; i < events.size(); i++) {
+    auto& event = events[i];
+    if (i > 0) {
+      json += ",";
+    }
+    json += "{\"name\":\"" + std::string(event.name) + "\",\"ph\":\"X\",\"pid\":1,\"tid\":" +
+            std::to_string(event.threadID) + ",\"ts\":" + std::to_string(event.startTime) +
+            ",\"dur\":" + std::to_string(event.duration) + "}";
+  }
+  json += "]}";
+  return json;
+}
 }  // namespace pag
@@ -36,4 +36,21 @@ void Trace(const tgfx::Bitmap& bitmap, const std::string& tag = "");
  * Trace() provides a utility to view the Bitmap.
  */
 void Trace(const tgfx::Pixmap& pixmap, const std::string& tag = "");
+
+/**
+ * TraceEvent records a timeline event covering the lifetime of the scope. Events are only recorded
+ * while tracing has been enabled by PAGTrace::SetEnabled(), otherwise constructing a TraceEvent
+ * costs a single atomic load. The name must be a string literal or otherwise outlive the recording
+ * session, since only the pointer is stored.
+ */
+class TraceEvent {
+ public:
+  explicit TraceEvent(const char* name);
+
+  ~TraceEvent();
+
+ private:
+  const char* name = nullptr;
+  int64_t startTime = 0;
+};
 }  // namespace pag
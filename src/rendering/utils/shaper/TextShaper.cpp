@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "TextShaper.h"
+#include <mutex>
+#include <unordered_map>
 #ifdef PAG_USE_HARFBUZZ
 #include "TextShaperHarfbuzz.h"
 #else
@@ -25,11 +27,8 @@
 #endif
 
 namespace pag {
-std::vector<ShapedGlyph> TextShaper::Shape(const std::string& text,
-                                           std::shared_ptr<tgfx::Typeface> typeface) {
-  if (text.empty()) {
-    return {};
-  }
+static std::vector<ShapedGlyph> ShapeDirect(const std::string& text,
+                                            std::shared_ptr<tgfx::Typeface> typeface) {
 #ifdef PAG_USE_HARFBUZZ
   return TextShaperHarfbuzz::Shape(text, std::move(typeface));
 #else
@@ -43,7 +42,147 @@ std::vector<ShapedGlyph> TextShaper::Shape(const std::string& text,
 #endif
 }
 
+// 按字体缓存最近一次整形的文本和结果。打字场景下相邻两次整形的文本只差一个编辑点，
+// 对比后只重新整形编辑过的片段，其余的整形结果平移复用，单次按键的开销随编辑量走。
+class ShapingCache {
+ public:
+  static ShapingCache* GetInstance() {
+    static auto& instance = *new ShapingCache();
+    return &instance;
+  }
+
+  bool find(uint32_t typefaceID, std::string* text, std::vector<ShapedGlyph>* glyphs) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = entries.find(typefaceID);
+    if (result == entries.end()) {
+      return false;
+    }
+    *text = result->second.text;
+    *glyphs = result->second.glyphs;
+    return true;
+  }
+
+  void insert(uint32_t typefaceID, const std::string& text,
+              const std::vector<ShapedGlyph>& glyphs) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (entries.size() >= MAX_CACHE_SIZE && entries.find(typefaceID) == entries.end()) {
+      entries.clear();
+    }
+    entries[typefaceID] = {text, glyphs};
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> autoLock(locker);
+    entries.clear();
+  }
+
+ private:
+  struct Entry {
+    std::string text;
+    std::vector<ShapedGlyph> glyphs;
+  };
+
+  static constexpr size_t MAX_CACHE_SIZE = 16;
+
+  std::mutex locker = {};
+  std::unordered_map<uint32_t, Entry> entries = {};
+};
+
+static bool IsShapingBoundary(char character) {
+  return character == ' ' || character == '\n' || character == '\r' || character == '\t';
+}
+
+// 返回 stringIndex 恰好等于 index 的字形下标。找不到说明该位置落在某个连写簇内部，拼接不安全。
+static bool FindClusterStart(const std::vector<ShapedGlyph>& glyphs, size_t index,
+                             size_t* glyphIndex) {
+  for (size_t i = 0; i < glyphs.size(); i++) {
+    if (glyphs[i].stringIndex == index) {
+      *glyphIndex = i;
+      return true;
+    }
+    if (glyphs[i].stringIndex > index) {
+      return false;
+    }
+  }
+  return false;
+}
+
+static bool ShapeIncremental(const std::string& oldText, const std::vector<ShapedGlyph>& oldGlyphs,
+                             const std::string& newText, std::shared_ptr<tgfx::Typeface> typeface,
+                             std::vector<ShapedGlyph>* result) {
+  auto maxCommon = std::min(oldText.size(), newText.size());
+  size_t prefix = 0;
+  while (prefix < maxCommon && oldText[prefix] == newText[prefix]) {
+    prefix++;
+  }
+  size_t suffix = 0;
+  while (suffix < maxCommon - prefix &&
+         oldText[oldText.size() - 1 - suffix] == newText[newText.size() - 1 - suffix]) {
+    suffix++;
+  }
+  // 整形会跨字符产生连写和字距，编辑点前后退到空白边界再拼接，空白两侧的整形互不影响。
+  while (prefix > 0 && !IsShapingBoundary(newText[prefix - 1])) {
+    prefix--;
+  }
+  while (suffix > 0 && !IsShapingBoundary(newText[newText.size() - suffix])) {
+    suffix--;
+  }
+  if (prefix == 0 && suffix == 0) {
+    return false;
+  }
+  auto oldSuffixStart = oldText.size() - suffix;
+  size_t prefixGlyphEnd = oldGlyphs.size();
+  if (prefix < oldText.size() && !FindClusterStart(oldGlyphs, prefix, &prefixGlyphEnd)) {
+    return false;
+  }
+  size_t suffixGlyphStart = oldGlyphs.size();
+  if (suffix > 0 && !FindClusterStart(oldGlyphs, oldSuffixStart, &suffixGlyphStart)) {
+    return false;
+  }
+  auto middle = newText.substr(prefix, newText.size() - suffix - prefix);
+  auto middleGlyphs = ShapeDirect(middle, std::move(typeface));
+  result->clear();
+  result->reserve(prefixGlyphEnd + middleGlyphs.size() + (oldGlyphs.size() - suffixGlyphStart));
+  result->insert(result->end(), oldGlyphs.begin(),
+                 oldGlyphs.begin() + static_cast<ptrdiff_t>(prefixGlyphEnd));
+  for (auto& glyph : middleGlyphs) {
+    glyph.stringIndex += static_cast<uint32_t>(prefix);
+    result->push_back(std::move(glyph));
+  }
+  auto indexShift = static_cast<int64_t>(newText.size()) - static_cast<int64_t>(oldText.size());
+  for (auto i = suffixGlyphStart; i < oldGlyphs.size(); i++) {
+    auto glyph = oldGlyphs[i];
+    glyph.stringIndex = static_cast<uint32_t>(static_cast<int64_t>(glyph.stringIndex) + indexShift);
+    result->push_back(std::move(glyph));
+  }
+  return true;
+}
+
+std::vector<ShapedGlyph> TextShaper::Shape(const std::string& text,
+                                           std::shared_ptr<tgfx::Typeface> typeface) {
+  if (text.empty()) {
+    return {};
+  }
+  auto typefaceID = typeface != nullptr ? typeface->uniqueID() : 0;
+  auto cache = ShapingCache::GetInstance();
+  std::string lastText = {};
+  std::vector<ShapedGlyph> lastGlyphs = {};
+  std::vector<ShapedGlyph> glyphs = {};
+  if (cache->find(typefaceID, &lastText, &lastGlyphs) && lastText != text) {
+    if (!ShapeIncremental(lastText, lastGlyphs, text, typeface, &glyphs)) {
+      glyphs = ShapeDirect(text, typeface);
+    }
+  } else if (lastText == text && !lastGlyphs.empty()) {
+    return lastGlyphs;
+  } else {
+    glyphs = ShapeDirect(text, typeface);
+  }
+  cache->insert(typefaceID, text, glyphs);
+  return glyphs;
+}
+
 void TextShaper::PurgeCaches() {
+  ShapingCache::GetInstance()->clear();
 #ifdef PAG_USE_HARFBUZZ
   TextShaperHarfbuzz::PurgeCaches();
 #endif
@@ -145,6 +145,58 @@ static HBLockedFontCache GetHBFontCache() {
   return {HBFontLRU, HBFontCache, HBFontCacheMutex};
 }
 
+class HBLockedShapeCache {
+ public:
+  HBLockedShapeCache(std::list<std::string>* lru,
+                     std::map<std::string, std::vector<ShapedGlyph>>* cache, std::mutex* mutex)
+      : lru(lru), cache(cache), mutex(mutex) {
+    mutex->lock();
+  }
+  HBLockedShapeCache(const HBLockedShapeCache&) = delete;
+  HBLockedShapeCache& operator=(const HBLockedShapeCache&) = delete;
+  HBLockedShapeCache& operator=(HBLockedShapeCache&&) = delete;
+
+  ~HBLockedShapeCache() {
+    mutex->unlock();
+  }
+
+  const std::vector<ShapedGlyph>* find(const std::string& key) {
+    auto iter = std::find(lru->begin(), lru->end(), key);
+    if (iter == lru->end()) {
+      return nullptr;
+    }
+    lru->erase(iter);
+    lru->push_front(key);
+    return &(*cache)[key];
+  }
+  void insert(const std::string& key, std::vector<ShapedGlyph> glyphs) {
+    static const size_t MaxCacheSize = 500;
+    cache->insert(std::make_pair(key, std::move(glyphs)));
+    lru->push_front(key);
+    while (lru->size() > MaxCacheSize) {
+      auto backKey = lru->back();
+      lru->pop_back();
+      cache->erase(backKey);
+    }
+  }
+  void reset() {
+    lru->clear();
+    cache->clear();
+  }
+
+ private:
+  std::list<std::string>* lru;
+  std::map<std::string, std::vector<ShapedGlyph>>* cache;
+  std::mutex* mutex;
+};
+
+static HBLockedShapeCache GetHBShapeCache() {
+  static auto* HBShapeCacheMutex = new std::mutex();
+  static auto* HBShapeLRU = new std::list<std::string>();
+  static auto* HBShapeCache = new std::map<std::string, std::vector<ShapedGlyph>>();
+  return {HBShapeLRU, HBShapeCache, HBShapeCacheMutex};
+}
+
 static std::shared_ptr<hb_font_t> CreateHBFont(std::shared_ptr<tgfx::Typeface> typeface) {
   if (typeface == nullptr) {
     return nullptr;
@@ -234,6 +286,16 @@ static bool Shape(std::list<HBGlyph>& glyphs, std::shared_ptr<tgfx::Typeface> ty
 
 std::vector<ShapedGlyph> TextShaperHarfbuzz::Shape(const std::string& text,
                                                    std::shared_ptr<tgfx::Typeface> face) {
+  // 模板里相同的字符串会在多个合成中反复整形，整形输出与字号和排版方向无关，
+  // 因此按 (字体, 文本) 缓存整形结果即可直接复用。
+  auto cacheKey = std::to_string(face ? face->uniqueID() : 0) + '\1' + text;
+  {
+    auto cache = GetHBShapeCache();
+    auto cachedGlyphs = cache.find(cacheKey);
+    if (cachedGlyphs != nullptr) {
+      return *cachedGlyphs;
+    }
+  }
   std::list<HBGlyph> hbGlyphs = {};
   hbGlyphs.emplace_back(HBGlyph{text, {}, 0, nullptr});
   bool allShaped = false;
@@ -250,13 +312,28 @@ std::vector<ShapedGlyph> TextShaperHarfbuzz::Shape(const std::string& text,
     }
   }
   std::vector<ShapedGlyph> glyphs = {};
+  bool fullyShaped = true;
   for (const auto& hbGlyph : hbGlyphs) {
+    if (hbGlyph.typeface == nullptr) {
+      fullyShaped = false;
+    }
     glyphs.emplace_back(hbGlyph.typeface, hbGlyph.glyphID, hbGlyph.stringIndex);
   }
+  if (fullyShaped) {
+    // 有缺字的结果不缓存，后续注册的回退字体还有机会补齐。
+    auto cache = GetHBShapeCache();
+    if (cache.find(cacheKey) == nullptr) {
+      cache.insert(cacheKey, glyphs);
+    }
+  }
   return glyphs;
 }
 
 void TextShaperHarfbuzz::PurgeCaches() {
+  {
+    auto cache = GetHBShapeCache();
+    cache.reset();
+  }
   auto cache = GetHBFontCache();
   cache.reset();
 }
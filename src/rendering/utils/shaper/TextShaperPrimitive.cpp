@@ -26,24 +26,17 @@ std::vector<ShapedGlyph> TextShaperPrimitive::Shape(const std::string& text,
   const char* textStart = text.data();
   const char* textStop = textStart + text.size();
   std::vector<ShapedGlyph> glyphs = {};
-  auto fallbackTypefaces = FontManager::GetFallbackTypefaces();
   while (textStart < textStop) {
     auto oldPosition = textStart;
-    tgfx::UTF::NextUTF8(&textStart, textStop);
+    auto codepoint = tgfx::UTF::NextUTF8(&textStart, textStop);
     auto length = textStart - oldPosition;
     auto str = std::string(oldPosition, length);
     auto glyphID = typeface ? typeface->getGlyphID(str) : 0;
     if (glyphID == 0) {
-      for (const auto& faceHolder : fallbackTypefaces) {
-        auto face = faceHolder->getTypeface();
-        if (face == nullptr) {
-          continue;
-        }
-        glyphID = face->getGlyphID(str);
-        if (glyphID != 0) {
-          glyphs.emplace_back(std::move(face), glyphID, oldPosition - text.data());
-          break;
-        }
+      tgfx::GlyphID fallbackGlyphID = 0;
+      auto face = FontManager::GetFallbackTypeface(str, codepoint, &fallbackGlyphID);
+      if (face != nullptr) {
+        glyphs.emplace_back(std::move(face), fallbackGlyphID, oldPosition - text.data());
       }
     } else {
       glyphs.emplace_back(typeface, glyphID, oldPosition - text.data());
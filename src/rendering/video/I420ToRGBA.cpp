@@ -0,0 +1,154 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "I420ToRGBA.h"
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/ImageInfo.h"
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define I420_CONVERT_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define I420_CONVERT_SSE 1
+#endif
+
+namespace pag {
+/**
+ * Fixed-point conversion coefficients at a scale of 64, which keeps every term of the matrix
+ * within the int16 range so the SIMD paths can stay in 16-bit lanes. Output values above the
+ * representable range saturate, which matches the final clamp to 255 anyway.
+ */
+struct YUVCoefficients {
+  int16_t yOffset = 16;
+  int16_t yScale = 74;   // (255 / 219) * 64
+  int16_t rV = 102;      // 1.596 * 64
+  int16_t gU = 25;       // 0.391 * 64
+  int16_t gV = 52;       // 0.813 * 64
+  int16_t bU = 129;      // 2.018 * 64
+};
+
+static YUVCoefficients GetCoefficients(tgfx::YUVColorSpace colorSpace) {
+  switch (colorSpace) {
+    case tgfx::YUVColorSpace::BT601_FULL:
+      return {0, 64, 90, 22, 46, 113};
+    case tgfx::YUVColorSpace::BT709_LIMITED:
+      return {16, 74, 115, 14, 34, 135};
+    case tgfx::YUVColorSpace::BT709_FULL:
+      return {0, 64, 101, 12, 30, 119};
+    default:
+      return {};
+  }
+}
+
+static uint8_t ClampToByte(int value) {
+  return static_cast<uint8_t>(value < 0 ? 0 : value > 255 ? 255 : value);
+}
+
+static void ConvertRow(const uint8_t* yRow, const uint8_t* uRow, const uint8_t* vRow, uint8_t* dst,
+                       int width, const YUVCoefficients& c) {
+  int x = 0;
+#if defined(I420_CONVERT_NEON)
+  // Stop 16 pixels before the end so the 8-byte chroma loads never read past the plane.
+  for (; x + 16 <= width; x += 8) {
+    auto yValue = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(yRow + x)));
+    yValue = vmulq_n_s16(vsubq_s16(yValue, vdupq_n_s16(c.yOffset)), c.yScale);
+    auto u8x8 = vld1_u8(uRow + x / 2);
+    auto v8x8 = vld1_u8(vRow + x / 2);
+    auto uPairs = vzip_u8(u8x8, u8x8).val[0];
+    auto vPairs = vzip_u8(v8x8, v8x8).val[0];
+    auto uValue = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uPairs)), vdupq_n_s16(128));
+    auto vValue = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vPairs)), vdupq_n_s16(128));
+    auto red = vqaddq_s16(yValue, vmulq_n_s16(vValue, c.rV));
+    auto green = vqsubq_s16(vqsubq_s16(yValue, vmulq_n_s16(uValue, c.gU)),
+                            vmulq_n_s16(vValue, c.gV));
+    auto blue = vqaddq_s16(yValue, vmulq_n_s16(uValue, c.bU));
+    uint8x8x4_t rgba = {};
+    rgba.val[0] = vqmovun_s16(vrshrq_n_s16(red, 6));
+    rgba.val[1] = vqmovun_s16(vrshrq_n_s16(green, 6));
+    rgba.val[2] = vqmovun_s16(vrshrq_n_s16(blue, 6));
+    rgba.val[3] = vdup_n_u8(255);
+    vst4_u8(dst + x * 4, rgba);
+  }
+#elif defined(I420_CONVERT_SSE)
+  auto zero = _mm_setzero_si128();
+  auto rounding = _mm_set1_epi16(32);
+  // Stop 16 pixels before the end so the 8-byte chroma loads never read past the plane.
+  for (; x + 16 <= width; x += 8) {
+    auto yValue = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(yRow + x)),
+                                    zero);
+    yValue = _mm_mullo_epi16(_mm_sub_epi16(yValue, _mm_set1_epi16(c.yOffset)),
+                             _mm_set1_epi16(c.yScale));
+    auto u16 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(uRow + x / 2)),
+                                 zero);
+    auto v16 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(vRow + x / 2)),
+                                 zero);
+    auto uValue = _mm_sub_epi16(_mm_unpacklo_epi16(u16, u16), _mm_set1_epi16(128));
+    auto vValue = _mm_sub_epi16(_mm_unpacklo_epi16(v16, v16), _mm_set1_epi16(128));
+    auto red = _mm_adds_epi16(yValue, _mm_mullo_epi16(vValue, _mm_set1_epi16(c.rV)));
+    auto green = _mm_subs_epi16(_mm_subs_epi16(yValue,
+                                               _mm_mullo_epi16(uValue, _mm_set1_epi16(c.gU))),
+                                _mm_mullo_epi16(vValue, _mm_set1_epi16(c.gV)));
+    auto blue = _mm_adds_epi16(yValue, _mm_mullo_epi16(uValue, _mm_set1_epi16(c.bU)));
+    red = _mm_srai_epi16(_mm_adds_epi16(red, rounding), 6);
+    green = _mm_srai_epi16(_mm_adds_epi16(green, rounding), 6);
+    blue = _mm_srai_epi16(_mm_adds_epi16(blue, rounding), 6);
+    auto r8 = _mm_packus_epi16(red, red);
+    auto g8 = _mm_packus_epi16(green, green);
+    auto b8 = _mm_packus_epi16(blue, blue);
+    auto rg = _mm_unpacklo_epi8(r8, g8);
+    auto ba = _mm_unpacklo_epi8(b8, _mm_set1_epi8(static_cast<char>(255)));
+    auto pixels = reinterpret_cast<__m128i*>(dst + x * 4);
+    _mm_storeu_si128(pixels, _mm_unpacklo_epi16(rg, ba));
+    _mm_storeu_si128(pixels + 1, _mm_unpackhi_epi16(rg, ba));
+  }
+#endif
+  for (; x < width; x++) {
+    auto yValue = (yRow[x] - c.yOffset) * c.yScale;
+    auto uValue = uRow[x / 2] - 128;
+    auto vValue = vRow[x / 2] - 128;
+    auto pixel = dst + x * 4;
+    pixel[0] = ClampToByte((yValue + c.rV * vValue + 32) >> 6);
+    pixel[1] = ClampToByte((yValue - c.gU * uValue - c.gV * vValue + 32) >> 6);
+    pixel[2] = ClampToByte((yValue + c.bU * uValue + 32) >> 6);
+    pixel[3] = 255;
+  }
+}
+
+std::shared_ptr<tgfx::ImageBuffer> I420ToRGBA(const uint8_t* const data[3], const int lineSize[3],
+                                              int width, int height,
+                                              tgfx::YUVColorSpace colorSpace) {
+  if (data == nullptr || lineSize == nullptr || width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  auto info = tgfx::ImageInfo::Make(width, height, tgfx::ColorType::RGBA_8888);
+  tgfx::Buffer buffer(info.byteSize());
+  if (buffer.isEmpty()) {
+    return nullptr;
+  }
+  auto coefficients = GetCoefficients(colorSpace);
+  auto dstPixels = buffer.bytes();
+  for (int y = 0; y < height; y++) {
+    auto yRow = data[0] + static_cast<size_t>(y) * lineSize[0];
+    auto uRow = data[1] + static_cast<size_t>(y / 2) * lineSize[1];
+    auto vRow = data[2] + static_cast<size_t>(y / 2) * lineSize[2];
+    ConvertRow(yRow, uRow, vRow, dstPixels + static_cast<size_t>(y) * info.rowBytes(), width,
+               coefficients);
+  }
+  return tgfx::ImageBuffer::MakeFrom(info, buffer.release());
+}
+}  // namespace pag
@@ -0,0 +1,34 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/ImageBuffer.h"
+#include "tgfx/core/YUVColorSpace.h"
+
+namespace pag {
+/**
+ * Converts the specified I420 planes to an RGBA_8888 image buffer on the CPU, using NEON or SSE2
+ * when available. It serves as a fallback for contexts that cannot sample YUV textures directly,
+ * such as headless server-side rendering. Returns nullptr if the size is empty or the allocation
+ * fails.
+ */
+std::shared_ptr<tgfx::ImageBuffer> I420ToRGBA(const uint8_t* const data[3], const int lineSize[3],
+                                              int width, int height,
+                                              tgfx::YUVColorSpace colorSpace);
+}  // namespace pag
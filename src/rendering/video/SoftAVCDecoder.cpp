@@ -17,7 +17,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "SoftAVCDecoder.h"
+#include <algorithm>
 #include <cstdlib>
+#include <thread>
 #include "tgfx/core/Buffer.h"
 
 #ifdef PAG_USE_LIBAVC
@@ -34,6 +36,12 @@
 #endif
 
 namespace pag {
+// libavc supports slice/frame parallel decoding on up to 4 cores.
+static constexpr UWORD32 MAX_NUM_CORES = 4;
+// Videos at or below this size decode fast enough on one core, and extra threads only add
+// synchronization overhead.
+static constexpr int SINGLE_CORE_SIZE = 262144;  // 512x512
+
 #ifdef _WIN32
 static void* ivd_aligned_malloc(void*, WORD32 alignment, WORD32 size) {
   return _aligned_malloc(size, alignment);
@@ -66,11 +74,15 @@ static void ivd_aligned_free(void*, void* block) {
 
 #endif
 
-bool SoftAVCDecoder::onConfigure(const std::vector<HeaderData>& headers, std::string mimeType, int,
-                                 int) {
+bool SoftAVCDecoder::onConfigure(const std::vector<HeaderData>& headers, std::string mimeType,
+                                 int width, int height) {
   if (mimeType != "video/avc") {
     return false;
   }
+  if (width * height > SINGLE_CORE_SIZE) {
+    auto coreCount = std::thread::hardware_concurrency();
+    numCores = std::min(coreCount > 0 ? coreCount : 1, MAX_NUM_CORES);
+  }
   if (!initDecoder()) {
     return false;
   }
@@ -279,7 +291,7 @@ bool SoftAVCDecoder::setNumCores() {
   ih264d_ctl_set_num_cores_op_t s_set_cores_op;
   s_set_cores_ip.e_cmd = IVD_CMD_VIDEO_CTL;
   s_set_cores_ip.e_sub_cmd = (IVD_CONTROL_API_COMMAND_TYPE_T)IH264D_CMD_CTL_SET_NUM_CORES;
-  s_set_cores_ip.u4_num_cores = 1;
+  s_set_cores_ip.u4_num_cores = numCores;
   s_set_cores_ip.u4_size = sizeof(ih264d_ctl_set_num_cores_ip_t);
   s_set_cores_op.u4_size = sizeof(ih264d_ctl_set_num_cores_op_t);
   auto status = ih264d_api_function(codecContext, &s_set_cores_ip, &s_set_cores_op);
@@ -64,6 +64,7 @@ class SoftAVCDecoder : public SoftwareDecoder {
   iv_obj_t* codecContext = nullptr;  // Codec context
   ivd_video_decode_ip_t decodeInput = {};
   ivd_video_decode_op_t decodeOutput = {};
+  UWORD32 numCores = 1;
   bool flushed = true;
 
   bool initDecoder();
@@ -17,13 +17,19 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "SoftwareDecoderWrapper.h"
+#include <cstring>
 #include "platform/Platform.h"
+#include "rendering/video/I420ToRGBA.h"
 #include "rendering/video/SoftwareData.h"
 
 namespace pag {
 
 #define I420_PLANE_COUNT 3
 
+// 完全静止的画面会被编码成整帧跳过的 P 帧，码流只有十几个字节。样本不超过这个大小时才值得去
+// 逐字节比对解码输出，比对是精确的，阈值只决定何时花这个比对成本，不影响正确性。
+static constexpr size_t UNCHANGED_SAMPLE_MAX_BYTES = 64;
+
 std::unique_ptr<VideoDecoder> SoftwareDecoderWrapper::Wrap(
     std::shared_ptr<SoftwareDecoder> softwareDecoder, const VideoFormat& format) {
   if (softwareDecoder == nullptr) {
@@ -43,6 +49,7 @@ SoftwareDecoderWrapper::SoftwareDecoderWrapper(std::shared_ptr<SoftwareDecoder>
 
 SoftwareDecoderWrapper::~SoftwareDecoderWrapper() {
   delete frameBuffer;
+  delete previousPlanes;
 }
 
 bool SoftwareDecoderWrapper::onConfigure(const VideoFormat& format) {
@@ -75,6 +82,13 @@ bool SoftwareDecoderWrapper::onConfigure(const VideoFormat& format) {
 
 DecodingResult SoftwareDecoderWrapper::onSendBytes(void* bytes, size_t length, int64_t time) {
   DecodingResult result = DecodingResult::Error;
+  if (bytes != nullptr && length > 0) {
+    lastSampleLength = length;
+    if (length <= UNCHANGED_SAMPLE_MAX_BYTES) {
+      // 码流里出现过整帧跳过的样本，说明内容有静止区段，从这里开始保留上一帧的解码输出用于比对。
+      trackUnchangedFrames = true;
+    }
+  }
   if (softwareDecoder != nullptr) {
     // External decoders only support AnnexB format.
     if (bytes != nullptr && length > 0 && Platform::Current()->naluType() != NALUType::AnnexB) {
@@ -119,6 +133,7 @@ DecodingResult SoftwareDecoderWrapper::onDecodeFrame() {
     result = static_cast<DecodingResult>(softwareDecoder->onDecodeFrame());
     currentDecodedTime = -1;
     if (result == DecodingResult::Success) {
+      lastSampleTiny = lastSampleLength > 0 && lastSampleLength <= UNCHANGED_SAMPLE_MAX_BYTES;
       if (!pendingFrames.empty()) {
         pendingFrames.sort();
         currentDecodedTime = pendingFrames.front();
@@ -133,6 +148,10 @@ void SoftwareDecoderWrapper::onFlush() {
   softwareDecoder->onFlush();
   pendingFrames.clear();
   currentDecodedTime = -1;
+  // seek 之后画面不连续，上一帧的拷贝作废。
+  hasPreviousPlanes = false;
+  lastRenderedBuffer = nullptr;
+  lastSampleTiny = false;
 }
 
 DecodingResult SoftwareDecoderWrapper::onEndOfStream() {
@@ -148,10 +167,74 @@ std::shared_ptr<tgfx::ImageBuffer> SoftwareDecoderWrapper::onRenderFrame() {
   if (frame == nullptr) {
     return nullptr;
   }
+  if (trackUnchangedFrames) {
+    // 解码输出和上一帧逐字节一致时返回上一帧的 ImageBuffer 实例，上层据此复用已上传的纹理。
+    if (lastSampleTiny && hasPreviousPlanes && lastRenderedBuffer != nullptr &&
+        comparePlanes(frame.get())) {
+      return lastRenderedBuffer;
+    }
+    copyPlanes(frame.get());
+  }
   auto yuvData =
       SoftwareData<SoftwareDecoder>::Make(videoFormat.width, videoFormat.height, frame->data,
                                           frame->lineSize, I420_PLANE_COUNT, softwareDecoder);
-  return tgfx::ImageBuffer::MakeI420(std::move(yuvData), videoFormat.colorSpace);
+  auto imageBuffer = tgfx::ImageBuffer::MakeI420(std::move(yuvData), videoFormat.colorSpace);
+  if (imageBuffer == nullptr) {
+    // The context may not support sampling YUV textures, e.g., when rendering headlessly on the
+    // CPU. Convert the planes to RGBA right away instead.
+    imageBuffer = I420ToRGBA(frame->data, frame->lineSize, videoFormat.width, videoFormat.height,
+                             videoFormat.colorSpace);
+  }
+  lastRenderedBuffer = imageBuffer;
+  return imageBuffer;
+}
+
+bool SoftwareDecoderWrapper::comparePlanes(const YUVBuffer* frame) const {
+  auto bytes = previousPlanes->bytes();
+  for (int plane = 0; plane < I420_PLANE_COUNT; plane++) {
+    auto width = plane == 0 ? videoFormat.width : (videoFormat.width + 1) / 2;
+    auto height = plane == 0 ? videoFormat.height : (videoFormat.height + 1) / 2;
+    auto rowBytes = static_cast<size_t>(width);
+    auto source = frame->data[plane];
+    for (int row = 0; row < height; row++) {
+      if (memcmp(bytes, source, rowBytes) != 0) {
+        return false;
+      }
+      bytes += rowBytes;
+      source += frame->lineSize[plane];
+    }
+  }
+  return true;
+}
+
+void SoftwareDecoderWrapper::copyPlanes(const YUVBuffer* frame) {
+  auto chromaWidth = (videoFormat.width + 1) / 2;
+  auto chromaHeight = (videoFormat.height + 1) / 2;
+  auto totalBytes = static_cast<size_t>(videoFormat.width) * videoFormat.height +
+                    static_cast<size_t>(chromaWidth) * chromaHeight * 2;
+  if (previousPlanes == nullptr) {
+    previousPlanes = new tgfx::Buffer(totalBytes);
+    if (previousPlanes->isEmpty()) {
+      // 内存不足时放弃静止帧检测，解码流程不受影响。
+      delete previousPlanes;
+      previousPlanes = nullptr;
+      trackUnchangedFrames = false;
+      return;
+    }
+  }
+  auto bytes = previousPlanes->bytes();
+  for (int plane = 0; plane < I420_PLANE_COUNT; plane++) {
+    auto width = plane == 0 ? videoFormat.width : chromaWidth;
+    auto height = plane == 0 ? videoFormat.height : chromaHeight;
+    auto rowBytes = static_cast<size_t>(width);
+    auto source = frame->data[plane];
+    for (int row = 0; row < height; row++) {
+      memcpy(bytes, source, rowBytes);
+      bytes += rowBytes;
+      source += frame->lineSize[plane];
+    }
+  }
+  hasPreviousPlanes = true;
 }
 
 int64_t SoftwareDecoderWrapper::presentationTime() {
@@ -51,7 +51,17 @@ class SoftwareDecoderWrapper : public VideoDecoder {
   tgfx::Buffer* frameBuffer = nullptr;
   int64_t currentDecodedTime = -1;
   std::list<int64_t> pendingFrames{};
+  size_t lastSampleLength = 0;
+  bool lastSampleTiny = false;
+  bool trackUnchangedFrames = false;
+  bool hasPreviousPlanes = false;
+  tgfx::Buffer* previousPlanes = nullptr;
+  std::shared_ptr<tgfx::ImageBuffer> lastRenderedBuffer = nullptr;
 
   explicit SoftwareDecoderWrapper(std::shared_ptr<SoftwareDecoder> externalDecoder);
+
+  bool comparePlanes(const YUVBuffer* frame) const;
+
+  void copyPlanes(const YUVBuffer* frame);
 };
 }  // namespace pag
@@ -65,6 +65,14 @@ class VideoDemuxer {
    */
   virtual void seekTo(int64_t targetTime) = 0;
 
+  /**
+   * Skips the upcoming samples that can be safely dropped without affecting the decoding of the
+   * specified target time. This is used as a catch-up policy when playback has fallen behind. The
+   * default implementation skips nothing.
+   */
+  virtual void skipDroppableSamples(int64_t) {
+  }
+
   /**
    * Resets the demuxer to its initial state.
    */
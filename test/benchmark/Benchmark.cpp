@@ -0,0 +1,168 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "nlohmann/json.hpp"
+
+namespace pag {
+using nlohmann::json;
+
+struct BenchmarkCase {
+  std::string name;
+  std::function<void()> body;
+  int iterations = 0;
+};
+
+static std::vector<BenchmarkCase>& BenchmarkCases() {
+  static auto& cases = *new std::vector<BenchmarkCase>();
+  return cases;
+}
+
+Benchmark::Benchmark(const std::string& name, std::function<void()> body, int iterations) {
+  BenchmarkCases().push_back({name, std::move(body), iterations});
+}
+
+static int64_t Now() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+struct BenchmarkResult {
+  std::string name;
+  int iterations = 0;
+  double meanTime = 0;
+  double medianTime = 0;
+};
+
+static BenchmarkResult RunCase(const BenchmarkCase& benchmarkCase, int iterationOverride) {
+  auto iterations = iterationOverride > 0 ? iterationOverride : benchmarkCase.iterations;
+  std::vector<double> samples = {};
+  samples.reserve(static_cast<size_t>(iterations));
+  for (int i = 0; i < iterations; i++) {
+    auto startTime = Now();
+    benchmarkCase.body();
+    samples.push_back(static_cast<double>(Now() - startTime));
+  }
+  BenchmarkResult result = {};
+  result.name = benchmarkCase.name;
+  result.iterations = iterations;
+  for (auto sample : samples) {
+    result.meanTime += sample;
+  }
+  result.meanTime /= static_cast<double>(samples.size());
+  std::sort(samples.begin(), samples.end());
+  result.medianTime = samples[samples.size() / 2];
+  return result;
+}
+
+static int CompareResults(const std::vector<BenchmarkResult>& results,
+                          const std::string& baselinePath, double threshold) {
+  std::ifstream baselineFile(baselinePath);
+  if (!baselineFile.is_open()) {
+    printf("Failed to open the baseline file: %s\n", baselinePath.c_str());
+    return 1;
+  }
+  auto baseline = json::parse(baselineFile, nullptr, false);
+  if (baseline.is_discarded() || !baseline.contains("benchmarks")) {
+    printf("Failed to parse the baseline file: %s\n", baselinePath.c_str());
+    return 1;
+  }
+  int regressionCount = 0;
+  for (auto& result : results) {
+    for (auto& item : baseline["benchmarks"]) {
+      if (item.value("name", "") != result.name) {
+        continue;
+      }
+      auto baseMedian = item.value("median_us", 0.0);
+      if (baseMedian <= 0) {
+        break;
+      }
+      auto change = (result.medianTime - baseMedian) * 100.0 / baseMedian;
+      if (change > threshold) {
+        printf("REGRESSION: %s median %.1fus -> %.1fus (%+.1f%%, threshold %.1f%%)\n",
+               result.name.c_str(), baseMedian, result.medianTime, change, threshold);
+        regressionCount++;
+      } else {
+        printf("OK: %s median %.1fus -> %.1fus (%+.1f%%)\n", result.name.c_str(), baseMedian,
+               result.medianTime, change);
+      }
+      break;
+    }
+  }
+  return regressionCount > 0 ? 1 : 0;
+}
+
+int Benchmark::RunAll(int argc, const char* argv[]) {
+  std::string filter = {};
+  std::string jsonPath = {};
+  std::string comparePath = {};
+  double threshold = 10.0;
+  int iterationOverride = 0;
+  for (int i = 1; i < argc - 1; i++) {
+    std::string arg = argv[i];
+    if (arg == "--filter") {
+      filter = argv[++i];
+    } else if (arg == "--iterations") {
+      iterationOverride = atoi(argv[++i]);
+    } else if (arg == "--json") {
+      jsonPath = argv[++i];
+    } else if (arg == "--compare") {
+      comparePath = argv[++i];
+    } else if (arg == "--threshold") {
+      threshold = atof(argv[++i]);
+    }
+  }
+  std::vector<BenchmarkResult> results = {};
+  for (auto& benchmarkCase : BenchmarkCases()) {
+    if (!filter.empty() && benchmarkCase.name.find(filter) == std::string::npos) {
+      continue;
+    }
+    auto result = RunCase(benchmarkCase, iterationOverride);
+    printf("%-32s iterations:%-4d mean:%.1fus median:%.1fus\n", result.name.c_str(),
+           result.iterations, result.meanTime, result.medianTime);
+    results.push_back(result);
+  }
+  if (!jsonPath.empty()) {
+    json output = {};
+    output["benchmarks"] = json::array();
+    for (auto& result : results) {
+      json item = {};
+      item["name"] = result.name;
+      item["iterations"] = result.iterations;
+      item["mean_us"] = result.meanTime;
+      item["median_us"] = result.medianTime;
+      output["benchmarks"].push_back(item);
+    }
+    std::ofstream outputFile(jsonPath);
+    outputFile << output.dump(2);
+  }
+  if (!comparePath.empty()) {
+    return CompareResults(results, comparePath, threshold);
+  }
+  return 0;
+}
+}  // namespace pag
+
+int main(int argc, const char* argv[]) {
+  return pag::Benchmark::RunAll(argc, argv);
+}
@@ -0,0 +1,50 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace pag {
+/**
+ * A named benchmark case registered through the PAG_BENCHMARK macro. The body is run for a number
+ * of timed iterations and the per-iteration wall times are aggregated into mean and median values.
+ */
+class Benchmark {
+ public:
+  Benchmark(const std::string& name, std::function<void()> body, int iterations = 20);
+
+  /**
+   * Runs the registered benchmarks and prints the results. Supported arguments:
+   *   --filter <substring>   only run benchmarks whose name contains the substring.
+   *   --iterations <count>   override the iteration count of every benchmark.
+   *   --json <path>          write the results to a JSON file.
+   *   --compare <path>       compare the results against a previously written JSON file.
+   *   --threshold <percent>  the maximum allowed median regression for --compare. The default
+   *                          value is 10.
+   * Returns 0 on success, or 1 if --compare found a regression above the threshold.
+   */
+  static int RunAll(int argc, const char* argv[]);
+};
+}  // namespace pag
+
+#define PAG_BENCHMARK(caseName)                                    \
+  static void Benchmark_##caseName();                              \
+  static pag::Benchmark benchmark_##caseName(#caseName, Benchmark_##caseName); \
+  static void Benchmark_##caseName()
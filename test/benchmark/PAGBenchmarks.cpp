@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <filesystem>
+#include "Benchmark.h"
+#include "pag/pag.h"
+#include "rendering/caches/SequenceFile.h"
+#include "rendering/utils/BitmapBuffer.h"
+#include "rendering/utils/shaper/TextShaper.h"
+
+namespace pag {
+static std::string ProjectPath(const std::string& relativePath) {
+  std::filesystem::path filePath = __FILE__;
+  static const auto rootPath = filePath.parent_path().string() + "/../../";
+  return std::filesystem::path(rootPath + relativePath).lexically_normal();
+}
+
+/**
+ * 用例描述: 完整解码一个 pag 文件的耗时。
+ */
+PAG_BENCHMARK(FileDecode) {
+  auto pagFile = PAGFile::Load(ProjectPath("assets/TZ2.pag"));
+  if (pagFile == nullptr) {
+    printf("FileDecode: failed to load assets/TZ2.pag!\n");
+  }
+}
+
+/**
+ * 用例描述: 从加载文件到首帧上屏的总耗时。
+ */
+PAG_BENCHMARK(FirstFrameLatency) {
+  auto pagFile = PAGFile::Load(ProjectPath("assets/TZ2.pag"));
+  if (pagFile == nullptr) {
+    return;
+  }
+  auto pagSurface = PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height());
+  if (pagSurface == nullptr) {
+    return;
+  }
+  auto pagPlayer = std::make_unique<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  pagPlayer->setProgress(0);
+  pagPlayer->flush();
+}
+
+/**
+ * 用例描述: 缓存预热后逐帧播放的单次 flush 耗时。
+ */
+PAG_BENCHMARK(SteadyStateFlush) {
+  static auto pagFile = PAGFile::Load(ProjectPath("assets/PAG_LOGO.pag"));
+  static auto pagSurface =
+      pagFile ? PAGSurface::MakeOffscreen(pagFile->width(), pagFile->height()) : nullptr;
+  static auto pagPlayer = [] {
+    auto player = std::make_unique<PAGPlayer>();
+    if (pagFile != nullptr && pagSurface != nullptr) {
+      player->setSurface(pagSurface);
+      player->setComposition(pagFile);
+      player->flush();
+    }
+    return player;
+  }();
+  if (pagFile == nullptr || pagSurface == nullptr) {
+    return;
+  }
+  static double progress = 0;
+  progress += 0.05;
+  if (progress > 1) {
+    progress -= 1;
+  }
+  pagPlayer->setProgress(progress);
+  pagPlayer->flush();
+}
+
+/**
+ * 用例描述: SequenceFile 全量写入再读出的磁盘缓存吞吐。
+ */
+PAG_BENCHMARK(SequenceFileReadWrite) {
+  static constexpr int FRAME_COUNT = 30;
+  auto info = tgfx::ImageInfo::Make(256, 256, tgfx::ColorType::RGBA_8888);
+  std::vector<uint8_t> pixels(info.byteSize());
+  auto cachePath = (std::filesystem::temp_directory_path() / "pag_benchmark.cache").string();
+  std::filesystem::remove(cachePath);
+  {
+    auto sequenceFile = SequenceFile::Open(cachePath, info, FRAME_COUNT, 30.0f, {});
+    if (sequenceFile == nullptr) {
+      printf("SequenceFileReadWrite: failed to open the sequence file!\n");
+      return;
+    }
+    for (int i = 0; i < FRAME_COUNT; i++) {
+      memset(pixels.data(), i + 1, pixels.size());
+      sequenceFile->writeFrame(i, BitmapBuffer::Wrap(info, pixels.data()));
+    }
+  }
+  auto sequenceFile = SequenceFile::Open(cachePath, info, FRAME_COUNT, 30.0f, {});
+  if (sequenceFile != nullptr) {
+    for (int i = 0; i < FRAME_COUNT; i++) {
+      sequenceFile->readFrame(i, BitmapBuffer::Wrap(info, pixels.data()));
+    }
+  }
+  sequenceFile = nullptr;
+  std::filesystem::remove(cachePath);
+}
+
+/**
+ * 用例描述: TextShaper 的整段文本塑形吞吐，每次拼接不同后缀避免命中塑形缓存。
+ */
+PAG_BENCHMARK(TextShaperThroughput) {
+  static int counter = 0;
+  auto text = "The quick brown fox jumps over the lazy dog, 我能吞下玻璃而不伤身体。#" +
+              std::to_string(counter++);
+  TextShaper::Shape(text, nullptr);
+}
+}  // namespace pag
@@ -18,6 +18,9 @@
 
 #ifndef SKIP_FRAME_COMPARE
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <map>
 #include <thread>
 #include <vector>
@@ -26,6 +29,7 @@
 #include "rendering/caches/RenderCache.h"
 #include "tgfx/core/Clock.h"
 #include "tgfx/core/Task.h"
+#include "utils/TestDir.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -43,6 +47,23 @@ struct RenderCost {
   std::string performance;
 };
 
+struct FileTiming {
+  std::string fileName;
+  int64_t totalTime = 0;
+  int64_t renderTime = 0;
+  int64_t readPixelsTime = 0;
+  int64_t compareTime = 0;
+  int frameCount = 0;
+};
+
+static std::mutex timingLocker = {};
+static std::vector<FileTiming> fileTimings = {};
+
+static int GetMaxThreads() {
+  auto count = static_cast<int>(std::thread::hardware_concurrency());
+  return count > 0 ? std::min(count, 16) : MAX_THREADS;
+}
+
 static void CompareFileFrames(Semaphore* semaphore, std::string pagPath) {
   Clock fileClock = {};
   auto fileName = pagPath.substr(pagPath.rfind('/') + 1, pagPath.size());
@@ -121,6 +142,21 @@ static void CompareFileFrames(Semaphore* semaphore, std::string pagPath) {
   }
   CompareFrame(currentFrame - 1);
 
+  FileTiming timing = {};
+  timing.fileName = fileName;
+  timing.totalTime = fileClock.measure();
+  for (auto& item : performanceMap) {
+    auto& renderCost = item.second;
+    timing.renderTime += renderCost.totalTime - renderCost.readPixelsCost - renderCost.compareCost;
+    timing.readPixelsTime += renderCost.readPixelsCost;
+    timing.compareTime += renderCost.compareCost;
+    timing.frameCount++;
+  }
+  {
+    std::lock_guard<std::mutex> autoLock(timingLocker);
+    fileTimings.push_back(timing);
+  }
+
   auto cost = static_cast<float>(fileClock.measure()) / 1000000;
   if (PrintPerformance) {
     LOGI(
@@ -145,12 +181,42 @@ static void CompareFileFrames(Semaphore* semaphore, std::string pagPath) {
   semaphore->signal();
 }
 
+// 按单文件耗时从高到低打印汇总，并把逐文件的渲染、读像素、比对耗时写成 JSON，供 CI 对比
+// 相邻两次运行，功能用例本身就能暴露性能回退。
+static void ReportFileTimings() {
+  std::lock_guard<std::mutex> autoLock(timingLocker);
+  std::sort(fileTimings.begin(), fileTimings.end(),
+            [](const FileTiming& a, const FileTiming& b) { return a.totalTime > b.totalTime; });
+  LOGI("================ PAGFrameCompareTest timing (slowest first) ================");
+  json timingJson = json::array();
+  for (auto& timing : fileTimings) {
+    LOGI("%8.2fs | %5d frames | %7.1fms[Render] %7.1fms[Pixels] %7.1fms[Compare] | %s",
+         timing.totalTime / 1000000.0, timing.frameCount, timing.renderTime / 1000.0,
+         timing.readPixelsTime / 1000.0, timing.compareTime / 1000.0, timing.fileName.c_str());
+    json item = {{"file", timing.fileName},
+                 {"totalTime", timing.totalTime},
+                 {"renderTime", timing.renderTime},
+                 {"readPixelsTime", timing.readPixelsTime},
+                 {"compareTime", timing.compareTime},
+                 {"frameCount", timing.frameCount}};
+    timingJson.push_back(item);
+  }
+  auto timingPath =
+      std::filesystem::path(TestDir::GetRoot() + "/out/PAGCompareFrameTest/timing.json");
+  std::filesystem::create_directories(timingPath.parent_path());
+  std::ofstream timingFile(timingPath);
+  timingFile << std::setw(4) << timingJson << std::endl;
+  timingFile.close();
+  fileTimings.clear();
+}
+
 /**
  * 用例描述: 校验 compare 文件夹中各个文件渲染结果
  */
 PAG_TEST(PAGFrameCompareTest, RenderFiles) {
   auto files = GetAllPAGFiles("resources/compare");
-  Semaphore semaphore(MAX_THREADS);
+  // 并发度跟随机器核数，固定的 6 线程在 CI 的多核机器上跑不满。
+  Semaphore semaphore(GetMaxThreads());
   std::vector<std::thread> threads = {};
   for (auto& file : files) {
     semaphore.wait();
@@ -159,6 +225,7 @@ PAG_TEST(PAGFrameCompareTest, RenderFiles) {
   for (auto& thread : threads) {
     thread.join();
   }
+  ReportFileTimings();
 }
 }  // namespace pag
 #endif
@@ -127,6 +127,29 @@ PAG_TEST(PAGFileTest, TestPAGFileEncodeDecode) {
   }
 }
 
+/**
+ * 用例描述: 增量编码测试，未修改的合成直接复用原始文件字节，结果可以重新解码
+ */
+PAG_TEST(PAGFileSimpleTest, EncodeIncrementally) {
+  auto byteData = ByteData::FromPath(ProjectPath::Absolute("resources/apitest/test.pag"));
+  ASSERT_NE(byteData, nullptr);
+  auto file = Codec::Decode(std::shared_ptr<ByteData>(byteData.release()), "");
+  ASSERT_NE(file, nullptr);
+  // 没有修改任何合成时，增量编码结果应当可以重新解码出同样结构的文件。
+  auto encoded = Codec::EncodeIncrementally(file, {});
+  ASSERT_NE(encoded, nullptr);
+  auto decoded = Codec::Decode(encoded->data(), static_cast<uint32_t>(encoded->length()), "");
+  ASSERT_NE(decoded, nullptr);
+  ASSERT_EQ(decoded->compositions.size(), file->compositions.size());
+  ASSERT_EQ(decoded->duration(), file->duration());
+  // 标记全部合成为已修改时退化为逐个重编码，结果同样有效。
+  auto allModified = Codec::EncodeIncrementally(file, file->compositions);
+  ASSERT_NE(allModified, nullptr);
+  decoded = Codec::Decode(allModified->data(), static_cast<uint32_t>(allModified->length()), "");
+  ASSERT_NE(decoded, nullptr);
+  ASSERT_EQ(decoded->compositions.size(), file->compositions.size());
+}
+
 /**
  * 用例描述: PAGFile numImages 接口
  */
@@ -0,0 +1,401 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2026 Tencent. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+// PAGBatchRender is a headless reference pipeline for server-side batch rendering. It reads a
+// JSON manifest of jobs and renders them across worker threads, for example:
+//
+//   PAGBatchRender manifest.json --workers 8 --pin-workers --encode-threads 3
+//
+// The manifest looks like this:
+//
+//   {
+//     "fonts": ["fonts/NotoSansSC-Regular.otf"],
+//     "jobs": [
+//       {
+//         "file": "templates/greeting.pag",
+//         "output": "out/greeting_%04d.png",
+//         "format": "png",
+//         "quality": "standard",
+//         "scale": 1.0,
+//         "maxFrameRate": 30,
+//         "texts": [{"index": 0, "text": "Hello"}],
+//         "images": [{"index": 0, "path": "photos/avatar.jpg"}]
+//       }
+//     ]
+//   }
+//
+// "output" is a printf-style pattern that receives the frame index, "format" is png, jpeg or webp
+// (the default is png), and "texts"/"images" address the editable indices of the template.
+// "quality" is either a preset name (draft, standard or best) or an explicit 0-100 value passed to
+// the encoder; lossy formats trade size and encode time against fidelity with it. Jobs that load
+// the same pag file share the decoded File through the process-wide cache of PAGFile::Load(), so a
+// farm rendering one template with many replacements parses it only once. Each worker overlaps
+// rendering with encoding: frames are handed to a pool of writer threads (--encode-threads per
+// worker) through a small ring of reusable buffers, so encoding of several frames runs in parallel
+// while the next frame renders. Frame encodes are independent of each other, which is what makes
+// the fan-out safe.
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ffavc.h"
+#include "nlohmann/json.hpp"
+#include "pag/pag.h"
+#include "tgfx/core/ImageCodec.h"
+#include "tgfx/core/Pixmap.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace pag {
+using nlohmann::json;
+
+struct TextReplacement {
+  int index = 0;
+  std::string text;
+};
+
+struct ImageReplacement {
+  int index = 0;
+  std::string path;
+};
+
+struct RenderJob {
+  std::string file;
+  std::string output;
+  tgfx::EncodedFormat format = tgfx::EncodedFormat::PNG;
+  int quality = 80;
+  float scale = 1.0f;
+  float maxFrameRate = 30.0f;
+  std::vector<TextReplacement> texts;
+  std::vector<ImageReplacement> images;
+};
+
+struct FrameBuffer {
+  std::vector<uint8_t> pixels;
+  std::string path;
+  int width = 0;
+  int height = 0;
+};
+
+class FrameWriter {
+ public:
+  // 每个渲染线程配一组写出线程。WebP 这类编码单帧就比渲染慢，多根线程同时编码不同的帧才能
+  // 让渲染不被编码堵住；缓冲数比线程数多一个，渲染第 N 帧时其余的帧还在编码落盘。
+  FrameWriter(tgfx::EncodedFormat format, int quality, size_t threadCount)
+      : format(format), quality(quality) {
+    threadCount = std::max<size_t>(1, threadCount);
+    for (size_t i = 0; i < threadCount + 1; i++) {
+      freeBuffers.push_back(std::make_unique<FrameBuffer>());
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+      threads.emplace_back(&FrameWriter::loop, this);
+    }
+  }
+
+  ~FrameWriter() {
+    {
+      std::lock_guard<std::mutex> autoLock(locker);
+      finished = true;
+    }
+    condition.notify_all();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  // 取一个空闲缓冲，写出线程落后太多时在这里阻塞，形成背压。
+  std::unique_ptr<FrameBuffer> acquire() {
+    std::unique_lock<std::mutex> autoLock(locker);
+    condition.wait(autoLock, [this] { return !freeBuffers.empty(); });
+    auto buffer = std::move(freeBuffers.front());
+    freeBuffers.pop_front();
+    return buffer;
+  }
+
+  void submit(std::unique_ptr<FrameBuffer> buffer) {
+    {
+      std::lock_guard<std::mutex> autoLock(locker);
+      pendingBuffers.push_back(std::move(buffer));
+    }
+    condition.notify_all();
+  }
+
+  bool success() {
+    std::lock_guard<std::mutex> autoLock(locker);
+    return !writeFailed;
+  }
+
+ private:
+  void loop() {
+    std::unique_lock<std::mutex> autoLock(locker);
+    while (true) {
+      condition.wait(autoLock, [this] { return !pendingBuffers.empty() || finished; });
+      if (pendingBuffers.empty()) {
+        return;
+      }
+      auto buffer = std::move(pendingBuffers.front());
+      pendingBuffers.pop_front();
+      autoLock.unlock();
+      if (!writeFrame(buffer.get())) {
+        autoLock.lock();
+        writeFailed = true;
+        autoLock.unlock();
+      }
+      autoLock.lock();
+      freeBuffers.push_back(std::move(buffer));
+      condition.notify_all();
+    }
+  }
+
+  bool writeFrame(FrameBuffer* buffer) {
+    auto info = tgfx::ImageInfo::Make(buffer->width, buffer->height, tgfx::ColorType::RGBA_8888,
+                                      tgfx::AlphaType::Premultiplied);
+    auto bytes =
+        tgfx::ImageCodec::Encode(tgfx::Pixmap(info, buffer->pixels.data()), format, quality);
+    if (bytes == nullptr) {
+      printf("Failed to encode the frame: %s\n", buffer->path.c_str());
+      return false;
+    }
+    std::ofstream out(buffer->path, std::ios::binary);
+    if (!out.is_open()) {
+      printf("Failed to open the output file: %s\n", buffer->path.c_str());
+      return false;
+    }
+    out.write(reinterpret_cast<const char*>(bytes->data()),
+              static_cast<std::streamsize>(bytes->size()));
+    return out.good();
+  }
+
+  tgfx::EncodedFormat format;
+  int quality = 80;
+  std::vector<std::thread> threads;
+  std::mutex locker;
+  std::condition_variable condition;
+  std::deque<std::unique_ptr<FrameBuffer>> freeBuffers;
+  std::deque<std::unique_ptr<FrameBuffer>> pendingBuffers;
+  bool finished = false;
+  bool writeFailed = false;
+};
+
+static bool RenderJobFrames(const RenderJob& job, size_t encodeThreads) {
+  auto pagFile = PAGFile::Load(job.file);
+  if (pagFile == nullptr) {
+    printf("Failed to load the pag file: %s\n", job.file.c_str());
+    return false;
+  }
+  for (auto& replacement : job.texts) {
+    auto textData = pagFile->getTextData(replacement.index);
+    if (textData == nullptr) {
+      printf("No editable text at index %d in %s\n", replacement.index, job.file.c_str());
+      return false;
+    }
+    textData->text = replacement.text;
+    pagFile->replaceText(replacement.index, textData);
+  }
+  for (auto& replacement : job.images) {
+    auto image = PAGImage::FromPath(replacement.path);
+    if (image == nullptr) {
+      printf("Failed to load the replacement image: %s\n", replacement.path.c_str());
+      return false;
+    }
+    pagFile->replaceImage(replacement.index, image);
+  }
+  auto decoder = PAGDecoder::MakeFrom(pagFile, job.maxFrameRate, job.scale);
+  if (decoder == nullptr) {
+    printf("Failed to create a decoder for: %s\n", job.file.c_str());
+    return false;
+  }
+  auto width = decoder->width();
+  auto height = decoder->height();
+  auto rowBytes = static_cast<size_t>(width) * 4;
+  FrameWriter writer(job.format, job.quality, encodeThreads);
+  auto numFrames = decoder->numFrames();
+  for (int i = 0; i < numFrames; i++) {
+    auto buffer = writer.acquire();
+    buffer->width = width;
+    buffer->height = height;
+    buffer->pixels.resize(rowBytes * static_cast<size_t>(height));
+    if (!decoder->readFrame(i, buffer->pixels.data(), rowBytes)) {
+      printf("Failed to render frame %d of %s\n", i, job.file.c_str());
+      return false;
+    }
+    char path[1024];
+    snprintf(path, sizeof(path), job.output.c_str(), i);
+    buffer->path = path;
+    writer.submit(std::move(buffer));
+  }
+  // FrameWriter 析构时会等写出线程清空队列，这里提前确认一下已写帧的状态即可。
+  return writer.success();
+}
+
+// 把工作线程按序号摊到各个核上，避免整批线程挤在同一个簇里。真正的 NUMA 内存绑定需要
+// libnuma，这里不引这个依赖；多路机器上建议配合 numactl 按结点各起一个进程。
+static void PinWorker(size_t workerIndex) {
+#ifdef __linux__
+  auto coreCount = std::thread::hardware_concurrency();
+  if (coreCount == 0) {
+    return;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(workerIndex % coreCount, &cpuSet);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+  (void)workerIndex;
+#endif
+}
+
+// 预设名对应发布流水线的三档画质；明确给数值时按 0-100 透传给编码器。
+static int ParseQuality(const json& quality) {
+  if (quality.is_number_integer()) {
+    return std::min(100, std::max(0, quality.get<int>()));
+  }
+  auto preset = quality.is_string() ? quality.get<std::string>() : "standard";
+  if (preset == "draft") {
+    return 60;
+  }
+  if (preset == "best") {
+    return 95;
+  }
+  return 80;
+}
+
+static tgfx::EncodedFormat ParseFormat(const std::string& format) {
+  if (format == "jpeg" || format == "jpg") {
+    return tgfx::EncodedFormat::JPEG;
+  }
+  if (format == "webp") {
+    return tgfx::EncodedFormat::WEBP;
+  }
+  return tgfx::EncodedFormat::PNG;
+}
+
+static bool ParseManifest(const std::string& path, std::vector<RenderJob>* jobs) {
+  std::ifstream manifestFile(path);
+  if (!manifestFile.is_open()) {
+    printf("Failed to open the manifest: %s\n", path.c_str());
+    return false;
+  }
+  auto manifest = json::parse(manifestFile, nullptr, false);
+  if (manifest.is_discarded() || !manifest.contains("jobs")) {
+    printf("Failed to parse the manifest: %s\n", path.c_str());
+    return false;
+  }
+  if (manifest.contains("fonts")) {
+    std::vector<std::string> fontPaths = manifest["fonts"];
+    std::vector<int> ttcIndices(fontPaths.size(), 0);
+    PAGFont::SetFallbackFontPaths(fontPaths, ttcIndices);
+  }
+  for (auto& entry : manifest["jobs"]) {
+    RenderJob job;
+    job.file = entry.value("file", "");
+    job.output = entry.value("output", "");
+    if (job.file.empty() || job.output.empty() || job.output.find('%') == std::string::npos) {
+      printf("Every job needs a \"file\" and a printf-style \"output\" pattern.\n");
+      return false;
+    }
+    job.format = ParseFormat(entry.value("format", "png"));
+    job.quality = ParseQuality(entry.value("quality", json("standard")));
+    job.scale = entry.value("scale", 1.0f);
+    job.maxFrameRate = entry.value("maxFrameRate", 30.0f);
+    for (auto& text : entry.value("texts", json::array())) {
+      job.texts.push_back({text.value("index", 0), text.value("text", "")});
+    }
+    for (auto& image : entry.value("images", json::array())) {
+      job.images.push_back({image.value("index", 0), image.value("path", "")});
+    }
+    jobs->push_back(std::move(job));
+  }
+  return true;
+}
+
+static int RunBatch(int argc, const char* argv[]) {
+  std::string manifestPath;
+  auto workerCount = std::max(1u, std::thread::hardware_concurrency() / 2);
+  size_t encodeThreads = 2;
+  bool pinWorkers = false;
+  for (int i = 1; i < argc; i++) {
+    std::string argument = argv[i];
+    if (argument == "--workers" && i + 1 < argc) {
+      workerCount = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+    } else if (argument == "--encode-threads" && i + 1 < argc) {
+      encodeThreads = static_cast<size_t>(std::max(1, atoi(argv[++i])));
+    } else if (argument == "--pin-workers") {
+      pinWorkers = true;
+    } else {
+      manifestPath = argument;
+    }
+  }
+  if (manifestPath.empty()) {
+    printf(
+        "Usage: PAGBatchRender <manifest.json> [--workers <count>] [--encode-threads <count>] "
+        "[--pin-workers]\n");
+    return 1;
+  }
+  std::vector<RenderJob> jobs;
+  if (!ParseManifest(manifestPath, &jobs)) {
+    return 1;
+  }
+  auto factory = ffavc::DecoderFactory::GetHandle();
+  PAGVideoDecoder::RegisterSoftwareDecoderFactory(
+      reinterpret_cast<SoftwareDecoderFactory*>(factory));
+  std::atomic_size_t nextJob = {0};
+  std::atomic_size_t failedJobs = {0};
+  std::vector<std::thread> workers;
+  workers.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; i++) {
+    workers.emplace_back([&, i] {
+      if (pinWorkers) {
+        PinWorker(i);
+      }
+      while (true) {
+        auto jobIndex = nextJob++;
+        if (jobIndex >= jobs.size()) {
+          return;
+        }
+        if (!RenderJobFrames(jobs[jobIndex], encodeThreads)) {
+          failedJobs++;
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  if (failedJobs > 0) {
+    printf("%zu of %zu jobs failed.\n", failedJobs.load(), jobs.size());
+    return 1;
+  }
+  printf("Rendered %zu jobs.\n", jobs.size());
+  return 0;
+}
+}  // namespace pag
+
+int main(int argc, const char* argv[]) {
+  return pag::RunBatch(argc, argv);
+}
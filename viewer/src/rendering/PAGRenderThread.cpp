@@ -25,7 +25,15 @@ namespace pag {
 PAGRenderThread::PAGRenderThread(PAGView* pagView) : pagView(pagView) {
 }
 
+void PAGRenderThread::requestFlush() {
+  if (flushRequested.exchange(true)) {
+    return;
+  }
+  QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+}
+
 void PAGRenderThread::flush() {
+  flushRequested.store(false);
   if (pagView->pagPlayer == nullptr || pagView->pagFile == nullptr) {
     return;
   }
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <QThread>
+#include <atomic>
 
 namespace pag {
 
@@ -29,6 +30,13 @@ class PAGRenderThread : public QThread {
  public:
   explicit PAGRenderThread(PAGView* pagView);
 
+  /**
+   * Schedules a flush on the render thread. Requests arriving while one is already queued are
+   * coalesced into it, so the render thread always draws the latest progress instead of working
+   * through a backlog when flushing is slower than the UI tick.
+   */
+  void requestFlush();
+
   Q_SIGNAL void frameTimeMetricsReady(int64_t frame, int64_t renderTime, int64_t presentTime,
                                       int64_t imageDecodeTime);
 
@@ -37,5 +45,6 @@ class PAGRenderThread : public QThread {
 
  private:
   PAGView* pagView = nullptr;
+  std::atomic_bool flushRequested = false;
 };
 }  // namespace pag
\ No newline at end of file
@@ -36,7 +36,7 @@ PAGView::PAGView(QQuickItem* parent) : QQuickItem(parent) {
 
 void PAGView::flush() const {
   if (isPlaying_) {
-    QMetaObject::invokeMethod(renderThread.get(), "flush", Qt::QueuedConnection);
+    renderThread->requestFlush();
   }
 }
 
@@ -169,7 +169,7 @@ void PAGView::setIsPlaying(bool isPlaying) {
   Q_EMIT isPlayingChanged(isPlaying);
   if (isPlaying) {
     lastPlayTime = tgfx::Clock::Now();
-    QMetaObject::invokeMethod(renderThread.get(), "flush", Qt::QueuedConnection);
+    renderThread->requestFlush();
   }
 }
 
@@ -187,7 +187,7 @@ void PAGView::setProgress(double progress) {
   pagPlayer->setProgress(progress);
   this->progress = progress;
   Q_EMIT progressChanged(progress);
-  QMetaObject::invokeMethod(renderThread.get(), "flush", Qt::QueuedConnection);
+  renderThread->requestFlush();
 }
 
 bool PAGView::setFile(const QString& filePath) {
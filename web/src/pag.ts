@@ -29,3 +29,6 @@ const PAGInit = (moduleOption: ModuleOption = {}): Promise<types.PAG> =>
     });
 
 export { PAGInit, types };
+export { WorkerPAGView } from './worker/worker-pag-view';
+export { setupRenderWorker } from './worker/render-worker';
+export { SharedProgressChannel } from './worker/shared-progress-channel';
@@ -0,0 +1,33 @@
+import type { PAGViewOptions } from '../pag-view';
+
+export const enum WorkerMessageType {
+  Init = 'PAGWorker.init',
+  Play = 'PAGWorker.play',
+  Pause = 'PAGWorker.pause',
+  Stop = 'PAGWorker.stop',
+  SetProgress = 'PAGWorker.setProgress',
+  SetRepeatCount = 'PAGWorker.setRepeatCount',
+  Destroy = 'PAGWorker.destroy',
+}
+
+export interface WorkerMessage {
+  type: WorkerMessageType;
+  /**
+   * Matches a reply to its request.
+   */
+  requestId: number;
+  data?: any;
+}
+
+export interface WorkerInitData {
+  fileBuffer: ArrayBuffer;
+  canvas: OffscreenCanvas;
+  progressBuffer: SharedArrayBuffer | null;
+  options: PAGViewOptions;
+}
+
+export interface WorkerReply {
+  requestId: number;
+  result?: any;
+  error?: string;
+}
@@ -0,0 +1,75 @@
+import { SharedProgressChannel } from './shared-progress-channel';
+import { WorkerMessage, WorkerMessageType, WorkerInitData } from './messages';
+
+import type { PAG } from '../types';
+import type { PAGView } from '../pag-view';
+
+/**
+ * Wires the render side of WorkerPAGView up inside a Web Worker. The worker script only needs to
+ * initialize the wasm module and hand the promise over:
+ *
+ *   import { PAGInit } from 'libpag';
+ *   import { setupRenderWorker } from 'libpag/lib/worker/render-worker';
+ *   setupRenderWorker(PAGInit());
+ *
+ * The UI thread transfers an OffscreenCanvas in, rendering and video decoding stay entirely on the
+ * worker, and per-frame progress flows back through a SharedProgressChannel instead of postMessage.
+ */
+export const setupRenderWorker = (moduleLoaded: Promise<PAG>) => {
+  const scope = self as unknown as Worker;
+  let pagView: PAGView | undefined;
+  let channel: SharedProgressChannel | null = null;
+
+  const init = async (data: WorkerInitData) => {
+    const module = await moduleLoaded;
+    const pagFile = module.PAGFile.loadFromBuffer(data.fileBuffer);
+    if (data.progressBuffer) {
+      channel = new SharedProgressChannel(data.progressBuffer);
+    }
+    pagView = await module.PAGView.init(pagFile, data.canvas, {
+      ...data.options,
+      useScale: false,
+    });
+    if (!pagView) throw new Error('Init PAGView fail!');
+    pagView.addListener('onAnimationUpdate', (view) => {
+      channel?.push(view.getProgress(), view.currentFrame());
+    });
+    return { duration: pagView.duration(), frameRate: pagFile.frameRate() };
+  };
+
+  scope.onmessage = async (event: MessageEvent<WorkerMessage>) => {
+    const { type, requestId, data } = event.data;
+    try {
+      let result;
+      switch (type) {
+        case WorkerMessageType.Init:
+          result = await init(data as WorkerInitData);
+          break;
+        case WorkerMessageType.Play:
+          await pagView?.play();
+          break;
+        case WorkerMessageType.Pause:
+          pagView?.pause();
+          break;
+        case WorkerMessageType.Stop:
+          await pagView?.stop();
+          break;
+        case WorkerMessageType.SetProgress:
+          pagView?.setProgress(data as number);
+          await pagView?.flush();
+          break;
+        case WorkerMessageType.SetRepeatCount:
+          pagView?.setRepeatCount(data as number);
+          break;
+        case WorkerMessageType.Destroy:
+          pagView?.destroy();
+          pagView = undefined;
+          channel = null;
+          break;
+      }
+      scope.postMessage({ requestId, result });
+    } catch (error: any) {
+      scope.postMessage({ requestId, error: error?.message ?? String(error) });
+    }
+  };
+};
@@ -0,0 +1,105 @@
+export interface ProgressRecord {
+  /**
+   * The progress of the play position, from 0.0 to 1.0.
+   */
+  progress: number;
+  /**
+   * The frame the progress was rendered at.
+   */
+  currentFrame: number;
+  /**
+   * The time the record was written, in milliseconds since the worker time origin.
+   */
+  timestamp: number;
+}
+
+const HEADER_LENGTH = 2; // [ writeIndex, readIndex ]
+const HEADER_BYTE_LENGTH = 8; // Keeps the Float64 records 8-byte aligned.
+const RECORD_LENGTH = 3; // [ progress, currentFrame, timestamp ]
+
+/**
+ * A single-writer single-reader ring buffer over a SharedArrayBuffer. The render worker pushes one
+ * record per flushed frame and the UI thread drains them without any postMessage traffic, so
+ * progress updates never contend with the structured-clone queue of a busy page. When the reader
+ * falls behind, the writer overwrites the oldest records; the reader detects the overrun from the
+ * index gap and re-reads, so it always ends up with consistent, most recent data.
+ */
+export class SharedProgressChannel {
+  /**
+   * Returns true if the current context can allocate shared memory. Requires the page to be
+   * cross-origin isolated (COOP/COEP headers).
+   */
+  public static isSupported() {
+    return typeof SharedArrayBuffer !== 'undefined';
+  }
+
+  /**
+   * Allocates the backing store for a channel with the specified record capacity.
+   */
+  public static alloc(capacity = 64) {
+    return new SharedArrayBuffer(HEADER_BYTE_LENGTH + capacity * RECORD_LENGTH * Float64Array.BYTES_PER_ELEMENT);
+  }
+
+  private header: Int32Array;
+  private records: Float64Array;
+  private capacity: number;
+
+  public constructor(buffer: SharedArrayBuffer) {
+    this.header = new Int32Array(buffer, 0, HEADER_LENGTH);
+    this.records = new Float64Array(buffer, HEADER_BYTE_LENGTH);
+    this.capacity = this.records.length / RECORD_LENGTH;
+  }
+
+  /**
+   * Appends a record, overwriting the oldest one when the buffer is full. Worker side only.
+   */
+  public push(progress: number, currentFrame: number) {
+    const writeIndex = Atomics.load(this.header, 0);
+    const offset = (writeIndex % this.capacity) * RECORD_LENGTH;
+    this.records[offset] = progress;
+    this.records[offset + 1] = currentFrame;
+    this.records[offset + 2] = performance.now();
+    // The index moves after the payload so the reader never sees a half-written record.
+    Atomics.store(this.header, 0, writeIndex + 1);
+  }
+
+  /**
+   * Removes and returns the oldest unread record, or null when the channel is empty. UI thread
+   * side only.
+   */
+  public pop(): ProgressRecord | null {
+    for (;;) {
+      const writeIndex = Atomics.load(this.header, 0);
+      let readIndex = Atomics.load(this.header, 1);
+      if (readIndex === writeIndex) return null;
+      if (writeIndex - readIndex > this.capacity) {
+        // The writer lapped us, skip ahead to the oldest record that still exists.
+        readIndex = writeIndex - this.capacity;
+      }
+      const offset = (readIndex % this.capacity) * RECORD_LENGTH;
+      const record = {
+        progress: this.records[offset],
+        currentFrame: this.records[offset + 1],
+        timestamp: this.records[offset + 2],
+      };
+      if (Atomics.load(this.header, 0) - readIndex > this.capacity) {
+        // The slot was overwritten while we were reading it, try again.
+        continue;
+      }
+      Atomics.store(this.header, 1, readIndex + 1);
+      return record;
+    }
+  }
+
+  /**
+   * Drains the channel and returns the most recent record, or null when nothing new arrived.
+   */
+  public latest(): ProgressRecord | null {
+    let record: ProgressRecord | null = null;
+    for (;;) {
+      const next = this.pop();
+      if (next === null) return record;
+      record = next;
+    }
+  }
+}
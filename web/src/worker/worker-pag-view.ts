@@ -0,0 +1,171 @@
+import { SharedProgressChannel, ProgressRecord } from './shared-progress-channel';
+import { WorkerMessage, WorkerMessageType, WorkerReply } from './messages';
+import { EventManager, Listener } from '../utils/event-manager';
+
+import type { PAGViewOptions } from '../pag-view';
+
+export interface WorkerPAGViewEventMap {
+  onAnimationUpdate: ProgressRecord;
+}
+
+/**
+ * A UI-thread proxy of PAGView that renders inside a Web Worker. The target canvas hands its
+ * surface to the worker through transferControlToOffscreen(), so decoding and rendering never
+ * block user input, and heavy templates cannot drop the editor below 60fps. Control calls go
+ * through postMessage, but per-frame progress comes back through a SharedArrayBuffer ring buffer
+ * polled once per animation frame, which keeps the message queue silent during playback. The
+ * worker script has to call setupRenderWorker() from render-worker.ts.
+ */
+export class WorkerPAGView {
+  /**
+   * Creates a WorkerPAGView rendering the specified pag file into the canvas. The file buffer and
+   * the canvas surface are transferred to the worker, so neither is usable on the UI thread
+   * afterwards. The progress channel silently degrades to empty when the page is not cross-origin
+   * isolated; playback still works, only onAnimationUpdate stays quiet.
+   */
+  public static async init(
+    worker: Worker,
+    fileBuffer: ArrayBuffer,
+    canvas: HTMLCanvasElement,
+    options: PAGViewOptions = {},
+  ): Promise<WorkerPAGView> {
+    const view = new WorkerPAGView(worker);
+    const progressBuffer = SharedProgressChannel.isSupported() ? SharedProgressChannel.alloc() : null;
+    if (progressBuffer) {
+      view.channel = new SharedProgressChannel(progressBuffer);
+    }
+    const offscreen = canvas.transferControlToOffscreen();
+    const result = await view.request(
+      WorkerMessageType.Init,
+      { fileBuffer, canvas: offscreen, progressBuffer, options },
+      [fileBuffer, offscreen],
+    );
+    view.viewDuration = result.duration;
+    return view;
+  }
+
+  /**
+   * The duration of the composition in microseconds.
+   */
+  public duration() {
+    return this.viewDuration;
+  }
+
+  private worker: Worker;
+  private channel: SharedProgressChannel | null = null;
+  private viewDuration = 0;
+  private requestId = 0;
+  private pollTimer: number | null = null;
+  private pendingRequests = new Map<number, { resolve: (result: any) => void; reject: (error: Error) => void }>();
+  private eventManager: EventManager<WorkerPAGViewEventMap, ProgressRecord> = new EventManager();
+
+  private constructor(worker: Worker) {
+    this.worker = worker;
+    this.worker.addEventListener('message', (event: MessageEvent<WorkerReply>) => {
+      const pending = this.pendingRequests.get(event.data.requestId);
+      if (!pending) return;
+      this.pendingRequests.delete(event.data.requestId);
+      if (event.data.error) {
+        pending.reject(new Error(event.data.error));
+      } else {
+        pending.resolve(event.data.result);
+      }
+    });
+  }
+
+  /**
+   * Adds a listener receiving the progress records drained from the shared channel.
+   */
+  public addListener<K extends keyof WorkerPAGViewEventMap>(
+    eventName: K,
+    listener: Listener<WorkerPAGViewEventMap[K]>,
+  ) {
+    return this.eventManager.on(eventName, listener);
+  }
+
+  /**
+   * Removes a listener from the set listening to this animation.
+   */
+  public removeListener<K extends keyof WorkerPAGViewEventMap>(
+    eventName: K,
+    listener?: Listener<WorkerPAGViewEventMap[K]>,
+  ) {
+    return this.eventManager.off(eventName, listener);
+  }
+
+  /**
+   * Start the animation.
+   */
+  public async play() {
+    this.startPolling();
+    await this.request(WorkerMessageType.Play);
+  }
+
+  /**
+   * Pause the animation.
+   */
+  public async pause() {
+    await this.request(WorkerMessageType.Pause);
+    this.stopPolling();
+  }
+
+  /**
+   * Stop the animation.
+   */
+  public async stop() {
+    await this.request(WorkerMessageType.Stop);
+    this.stopPolling();
+  }
+
+  /**
+   * Set the progress of play position, the value is from 0.0 to 1.0.
+   */
+  public async setProgress(progress: number) {
+    await this.request(WorkerMessageType.SetProgress, progress);
+  }
+
+  /**
+   * Set the number of times the animation will repeat. The default is 1, which means the animation
+   * will play only once. 0 means the animation will play infinity times.
+   */
+  public async setRepeatCount(repeatCount: number) {
+    await this.request(WorkerMessageType.SetRepeatCount, repeatCount);
+  }
+
+  /**
+   * Destroy the pag view inside the worker. The worker itself is owned by the caller and stays
+   * alive for reuse.
+   */
+  public async destroy() {
+    this.stopPolling();
+    await this.request(WorkerMessageType.Destroy);
+  }
+
+  private request(type: WorkerMessageType, data?: any, transfer: Transferable[] = []): Promise<any> {
+    const requestId = this.requestId++;
+    return new Promise((resolve, reject) => {
+      this.pendingRequests.set(requestId, { resolve, reject });
+      const message: WorkerMessage = { type, requestId, data };
+      this.worker.postMessage(message, transfer);
+    });
+  }
+
+  private startPolling() {
+    if (this.pollTimer !== null || this.channel === null) return;
+    const poll = () => {
+      const record = this.channel?.latest();
+      if (record) {
+        this.eventManager.emit('onAnimationUpdate', record);
+      }
+      this.pollTimer = window.requestAnimationFrame(poll);
+    };
+    this.pollTimer = window.requestAnimationFrame(poll);
+  }
+
+  private stopPolling() {
+    if (this.pollTimer !== null) {
+      window.cancelAnimationFrame(this.pollTimer);
+      this.pollTimer = null;
+    }
+  }
+}